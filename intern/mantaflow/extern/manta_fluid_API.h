@@ -61,6 +61,7 @@ int manta_update_mesh_structures(struct MANTA *fluid, struct MantaModifierData *
 int manta_update_particle_structures(struct MANTA *fluid,
                                      struct MantaModifierData *mmd,
                                      int framenr);
+void manta_flush_cache_writes(struct MANTA *fluid);
 int manta_bake_data(struct MANTA *fluid, struct MantaModifierData *mmd, int framenr);
 int manta_bake_noise(struct MANTA *fluid, struct MantaModifierData *mmd, int framenr);
 int manta_bake_mesh(struct MANTA *fluid, struct MantaModifierData *mmd, int framenr);
@@ -70,6 +71,7 @@ void manta_update_variables(struct MANTA *fluid, struct MantaModifierData *mmd);
 int manta_get_frame(struct MANTA *fluid);
 float manta_get_timestep(struct MANTA *fluid);
 void manta_adapt_timestep(struct MANTA *fluid);
+void manta_reset_pressure_warm_start(struct MANTA *fluid);
 bool manta_needs_realloc(struct MANTA *fluid, struct MantaModifierData *mmd);
 
 /* Fluid accessors */
@@ -175,6 +177,7 @@ float *manta_smoke_turbulence_get_flame(struct MANTA *smoke);
 int manta_smoke_turbulence_has_fuel(struct MANTA *smoke);
 int manta_smoke_turbulence_has_colors(struct MANTA *smoke);
 void manta_smoke_turbulence_get_res(struct MANTA *smoke, int *res);
+void manta_smoke_turbulence_set_uv_offset(struct MANTA *smoke, const int *res_min);
 int manta_smoke_turbulence_get_cells(struct MANTA *smoke);
 
 /* Liquid functions */
@@ -205,6 +208,13 @@ int manta_liquid_get_triangle_z_at(struct MANTA *liquid, int i);
 float manta_liquid_get_vertvel_x_at(struct MANTA *liquid, int i);
 float manta_liquid_get_vertvel_y_at(struct MANTA *liquid, int i);
 float manta_liquid_get_vertvel_z_at(struct MANTA *liquid, int i);
+int manta_liquid_get_num_vertvels(struct MANTA *liquid);
+/* Bulk access to the liquid mesh: every element is a triplet, consecutive elements are r_stride
+ * bytes apart. Pointers are NULL without mesh data and stay valid until the next mesh update. */
+const float *manta_liquid_get_vertices(struct MANTA *liquid, int *r_stride);
+const float *manta_liquid_get_normals(struct MANTA *liquid, int *r_stride);
+const int *manta_liquid_get_triangles(struct MANTA *liquid, int *r_stride);
+const float *manta_liquid_get_vertvels(struct MANTA *liquid, int *r_stride);
 int manta_liquid_get_num_flip_particles(struct MANTA *liquid);
 int manta_liquid_get_num_snd_particles(struct MANTA *liquid);
 int manta_liquid_get_flip_particle_flag_at(struct MANTA *liquid, int i);
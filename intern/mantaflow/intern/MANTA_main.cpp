@@ -27,6 +27,7 @@
  *  \ingroup mantaflow
  */
 
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include <iostream>
@@ -35,6 +36,11 @@
 
 #include "MANTA_main.h"
 #include "manta.h"
+#include "fluidsolver.h"
+#include "grid.h"
+#include "particle.h"
+#include "mesh.h"
+#include "timing.h"
 #include "Python.h"
 #include "fluid_script.h"
 #include "smoke_script.h"
@@ -551,6 +557,11 @@ void MANTA::initializeMantaflow()
   Pb::setup(filename, fill);  // Namespace from Mantaflow (registry)
   PyGILState_Release(gilstate);
   mantaInitialized = true;
+
+  // Plugin and kernel profiler, MANTA_PROFILE=<file>.json also writes a trace on termination
+  const char *profile = getenv("MANTA_PROFILE");
+  if (profile && profile[0] != '\0' && strcmp(profile, "0") != 0)
+    Manta::ProfileData::instance().enable(true);
 }
 
 void MANTA::terminateMantaflow()
@@ -558,6 +569,10 @@ void MANTA::terminateMantaflow()
   if (with_debug)
     std::cout << "Terminating Mantaflow" << std::endl;
 
+  const char *profile = getenv("MANTA_PROFILE");
+  if (Manta::ProfileData::enabled() && profile && BLI_path_extension_check(profile, ".json"))
+    Manta::ProfileData::instance().saveTrace(profile);
+
   PyGILState_STATE gilstate = PyGILState_Ensure();
   Pb::finalize();  // Namespace from Mantaflow (registry)
   PyGILState_Release(gilstate);
@@ -886,6 +901,21 @@ std::string MANTA::getRealValue(const std::string &varName, MantaModifierData *m
     if (ss.str().empty())
       ss << "0";
   }
+  else if (varName == "QUANTIZE_CHANNELS") {
+    tmpVar = mmd->domain->cache_quantize_channels;
+    ss << "[";
+    if (tmpVar & FLUID_DOMAIN_QUANTIZE_DENSITY)
+      ss << "'density', 'density_noise', ";
+    if (tmpVar & FLUID_DOMAIN_QUANTIZE_HEAT)
+      ss << "'heat', ";
+    if (tmpVar & FLUID_DOMAIN_QUANTIZE_FIRE)
+      ss << "'flame', 'fuel', 'react', 'flame_noise', 'fuel_noise', 'react_noise', ";
+    if (tmpVar & FLUID_DOMAIN_QUANTIZE_COLORS)
+      ss << "'color_r', 'color_g', 'color_b', 'color_r_noise', 'color_g_noise', 'color_b_noise'";
+    ss << "]";
+  }
+  else if (varName == "QUANTIZE_ERROR")
+    ss << mmd->domain->cache_quantize_error;
   else if (varName == "USING_SNDPARTS") {
     tmpVar = (FLUID_DOMAIN_PARTICLE_SPRAY | FLUID_DOMAIN_PARTICLE_BUBBLE |
               FLUID_DOMAIN_PARTICLE_FOAM | FLUID_DOMAIN_PARTICLE_TRACER);
@@ -909,6 +939,10 @@ std::string MANTA::getRealValue(const std::string &varName, MantaModifierData *m
     ss << (mmd->domain->flags & FLUID_DOMAIN_USE_ADAPTIVE_TIME ? "True" : "False");
   else if (varName == "USING_SPEEDVECTORS")
     ss << (mmd->domain->flags & FLUID_DOMAIN_USE_SPEED_VECTORS ? "True" : "False");
+  else if (varName == "USING_PRESSURE_WARMSTART")
+    ss << (mmd->domain->flags & FLUID_DOMAIN_USE_PRESSURE_WARMSTART ? "True" : "False");
+  else if (varName == "USING_COMPACT_MATRIX")
+    ss << (mmd->domain->flags & FLUID_DOMAIN_USE_COMPACT_MATRIX ? "True" : "False");
   else
     std::cout << "ERROR: Unknown option: " << varName << std::endl;
   return ss.str();
@@ -958,6 +992,8 @@ static std::string getCacheFileEnding(char cache_format)
   switch (cache_format) {
     case FLUID_DOMAIN_FILE_UNI:
       return ".uni";
+    case FLUID_DOMAIN_FILE_CHUNKED:
+      return ".mcc";
     case FLUID_DOMAIN_FILE_OPENVDB:
       return ".vdb";
     case FLUID_DOMAIN_FILE_RAW:
@@ -989,6 +1025,9 @@ int MANTA::updateFlipStructures(MantaModifierData *mmd, int framenr)
   if (BLI_path_is_rel(mmd->domain->cache_directory))
     return 0;
 
+  // Files of this frame might still be queued for writing
+  flushCacheWrites();
+
   std::ostringstream ss;
   char cacheDir[FILE_MAX], targetFile[FILE_MAX];
   cacheDir[0] = '\0';
@@ -1029,6 +1068,9 @@ int MANTA::updateMeshStructures(MantaModifierData *mmd, int framenr)
   if (BLI_path_is_rel(mmd->domain->cache_directory))
     return 0;
 
+  // Files of this frame might still be queued for writing
+  flushCacheWrites();
+
   // Ensure empty data structures at start
   if (mMeshNodes)
     mMeshNodes->clear();
@@ -1078,6 +1120,9 @@ int MANTA::updateParticleStructures(MantaModifierData *mmd, int framenr)
   if (BLI_path_is_rel(mmd->domain->cache_directory))
     return 0;
 
+  // Files of this frame might still be queued for writing
+  flushCacheWrites();
+
   // Ensure empty data structures at start
   if (mSndParticleData)
     mSndParticleData->clear();
@@ -1545,6 +1590,44 @@ int MANTA::readGuiding(MantaModifierData *mmd, int framenr, bool sourceDomain)
   return 1;
 }
 
+void MANTA::flushCacheWrites()
+{
+  if (with_debug)
+    std::cout << "MANTA::flushCacheWrites()" << std::endl;
+
+  std::vector<std::string> pythonCommands;
+  pythonCommands.push_back("flushAsyncWrites()");
+  runPythonString(pythonCommands);
+}
+
+void MANTA::setNoiseUvOffset(const int *resMin)
+{
+  if (with_debug)
+    std::cout << "MANTA::setNoiseUvOffset()" << std::endl;
+
+  if (!mUsingNoise)
+    return;
+
+  std::ostringstream ss;
+  std::vector<std::string> pythonCommands;
+  ss << "uvs_offset_s" << mCurrentID << " = vec3(" << resMin[0] << ", " << resMin[1] << ", "
+     << resMin[2] << ")";
+  pythonCommands.push_back(ss.str());
+  runPythonString(pythonCommands);
+}
+
+void MANTA::resetPressureWarmStart()
+{
+  if (with_debug)
+    std::cout << "MANTA::resetPressureWarmStart()" << std::endl;
+
+  std::ostringstream ss;
+  std::vector<std::string> pythonCommands;
+  ss << "resetPressureWarmStart(s" << mCurrentID << ")";
+  pythonCommands.push_back(ss.str());
+  runPythonString(pythonCommands);
+}
+
 int MANTA::bakeData(MantaModifierData *mmd, int framenr)
 {
   if (with_debug)
@@ -1582,6 +1665,8 @@ int MANTA::bakeData(MantaModifierData *mmd, int framenr)
   pythonCommands.push_back(ss.str());
 
   runPythonString(pythonCommands);
+  updatePressureStats();
+  updateProfileStats();
   return 1;
 }
 
@@ -1620,6 +1705,7 @@ int MANTA::bakeNoise(MantaModifierData *mmd, int framenr)
   pythonCommands.push_back(ss.str());
 
   runPythonString(pythonCommands);
+  updateProfileStats();
   return 1;
 }
 
@@ -2002,15 +2088,6 @@ static PyObject *callPythonFunction(std::string varName,
   return (!isAttribute) ? returnedValue : func;
 }
 
-static char *pyObjectToString(PyObject *inputObject)
-{
-  PyObject *encoded = PyUnicode_AsUTF8String(inputObject);
-  char *result = PyBytes_AsString(encoded);
-  Py_DECREF(encoded);
-  Py_DECREF(inputObject);
-  return result;
-}
-
 static double pyObjectToDouble(PyObject *inputObject)
 {
   // Cannot use PyFloat_AsDouble() since its error check crashes - likely because of Real (aka float) type in Mantaflow
@@ -2022,13 +2099,48 @@ static long pyObjectToLong(PyObject *inputObject)
   return PyLong_AsLong(inputObject);
 }
 
-static void *stringToPointer(char *inputString)
+/* Get the Mantaflow solver stored in the Python variable varName and (optionally) rebuild its
+ * registry of named objects. Lookups on the returned solver are native, no further interpreter
+ * calls are needed. Caller must hold the GIL. */
+static Manta::FluidSolver *getSolver(std::string varName, bool indexObjects = true)
 {
-  std::string str(inputString);
-  std::istringstream in(str);
-  void *dataPointer = NULL;
-  in >> dataPointer;
-  return dataPointer;
+  PyObject *main = PyImport_AddModule("__main__");
+  PyObject *var = (main) ? PyObject_GetAttrString(main, varName.c_str()) : NULL;
+  if (!var) {
+    PyErr_Clear();
+    if (MANTA::with_debug)
+      std::cout << "Missing Mantaflow solver: " << varName << std::endl;
+    return NULL;
+  }
+  Manta::FluidSolver *solver = dynamic_cast<Manta::FluidSolver *>(Pb::objFromPy(var));
+  Py_DECREF(var);
+
+  if (solver && indexObjects)
+    solver->indexObjects();
+  return solver;
+}
+
+/* Get an object of an indexed solver by its Python variable name, NULL if it does not exist */
+template<class T> static T *getSolverObject(Manta::FluidSolver *solver, std::string varName)
+{
+  T *object = (solver) ? solver->getObject<T>(varName) : NULL;
+  if (!object && MANTA::with_debug)
+    std::cout << "Missing Mantaflow object: " << varName << std::endl;
+  return object;
+}
+
+/* Get the data of a grid (T is the grid element type) */
+template<class T> static T *getGridData(Manta::FluidSolver *solver, std::string varName)
+{
+  Manta::Grid<T> *grid = getSolverObject<Manta::Grid<T>>(solver, varName);
+  return (grid) ? grid->getData() : NULL;
+}
+
+/* Get the data vector of a particle system, particle data or mesh data object */
+template<class T> static void *getVectorData(Manta::FluidSolver *solver, std::string varName)
+{
+  T *object = getSolverObject<T>(solver, varName);
+  return (object) ? (void *)&object->getData() : NULL;
 }
 
 int MANTA::getFrame()
@@ -2075,6 +2187,64 @@ void MANTA::adaptTimestep()
   runPythonString(pythonCommands);
 }
 
+void MANTA::updatePressureStats()
+{
+  if (with_debug)
+    std::cout << "MANTA::updatePressureStats()" << std::endl;
+
+  std::string id = std::to_string(mCurrentID);
+  std::string solver = "s" + id;
+
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  Manta::FluidSolver *base = getSolver(solver, false);
+
+  // Move solve records out of the solver so that they only cover the last bake call
+  mPressureStats.clear();
+  if (base) {
+    for (const Manta::PressureSolveInfo &info : base->getPressureSolveInfo()) {
+      PressureSolveInfo stats = {
+          info.frame, info.iterations, info.residualInitial, info.residualFinal, info.time};
+      mPressureStats.push_back(stats);
+    }
+    base->clearPressureSolveInfo();
+  }
+  PyGILState_Release(gilstate);
+
+  if (with_debug) {
+    for (const PressureSolveInfo &info : mPressureStats)
+      std::cout << "Pressure solve frame " << info.frame << ": " << info.iterations
+                << " iterations, residual " << info.residualInitial << " -> "
+                << info.residualFinal << ", " << info.time << " ms" << std::endl;
+  }
+}
+
+void MANTA::updateProfileStats()
+{
+  mProfileStats.clear();
+  if (!Manta::ProfileData::enabled())
+    return;
+  if (with_debug)
+    std::cout << "MANTA::updateProfileStats()" << std::endl;
+
+  // The profiler is shared by all domains, summarizing resets it to the next bake call
+  for (const Manta::ProfileData::Summary &sum : Manta::ProfileData::instance().summary(true)) {
+    ProfileScopeInfo stats = {sum.name,
+                              sum.kernel,
+                              sum.calls,
+                              (float)sum.total,
+                              (float)sum.self,
+                              (float)sum.utilization};
+    mProfileStats.push_back(stats);
+  }
+
+  if (with_debug) {
+    for (const ProfileScopeInfo &info : mProfileStats)
+      std::cout << (info.kernel ? "Kernel " : "Plugin ") << info.name << ": " << info.calls
+                << " calls, " << info.total << " ms (self " << info.self << " ms), "
+                << (int)(100 * info.utilization) << "% utilization" << std::endl;
+  }
+}
+
 void MANTA::updateMeshFromFile(const char *filename)
 {
   std::string fname(filename);
@@ -2098,14 +2268,32 @@ void MANTA::updateMeshFromFile(const char *filename)
   }
 }
 
+// Reads one triplet per element of vec into its field, gzread is called per block of elements
+// instead of per element
+template<class T, class V>
+static void readMeshTriplets(gzFile gzf, std::vector<T> &vec, V (T::*field)[3])
+{
+  const size_t blockSize = 1 << 16;
+  std::vector<V> buffer(3 * std::min(blockSize, vec.size()));
+
+  for (size_t start = 0; start < vec.size(); start += blockSize) {
+    const size_t num = std::min(blockSize, vec.size() - start);
+    gzread(gzf, buffer.data(), sizeof(V) * 3 * num);
+    for (size_t i = 0; i < num; i++) {
+      V *dst = vec[start + i].*field;
+      dst[0] = buffer[3 * i];
+      dst[1] = buffer[3 * i + 1];
+      dst[2] = buffer[3 * i + 2];
+    }
+  }
+}
+
 void MANTA::updateMeshFromBobj(const char *filename)
 {
   if (with_debug)
     std::cout << "MANTA::updateMeshFromBobj()" << std::endl;
 
   gzFile gzf;
-  float fbuffer[3];
-  int ibuffer[3];
   int numBuffer = 0;
 
   gzf = (gzFile)BLI_gzopen(filename, "rb1");  // do some compression
@@ -2121,12 +2309,7 @@ void MANTA::updateMeshFromBobj(const char *filename)
   if (numBuffer) {
     // Vertices
     mMeshNodes->resize(numBuffer);
-    for (std::vector<Node>::iterator it = mMeshNodes->begin(); it != mMeshNodes->end(); ++it) {
-      gzread(gzf, fbuffer, sizeof(float) * 3);
-      it->pos[0] = fbuffer[0];
-      it->pos[1] = fbuffer[1];
-      it->pos[2] = fbuffer[2];
-    }
+    readMeshTriplets(gzf, *mMeshNodes, &Node::pos);
   }
 
   // Num normals
@@ -2140,12 +2323,7 @@ void MANTA::updateMeshFromBobj(const char *filename)
     // Normals
     if (!getNumVertices())
       mMeshNodes->resize(numBuffer);
-    for (std::vector<Node>::iterator it = mMeshNodes->begin(); it != mMeshNodes->end(); ++it) {
-      gzread(gzf, fbuffer, sizeof(float) * 3);
-      it->normal[0] = fbuffer[0];
-      it->normal[1] = fbuffer[1];
-      it->normal[2] = fbuffer[2];
-    }
+    readMeshTriplets(gzf, *mMeshNodes, &Node::normal);
   }
 
   // Num triangles
@@ -2158,15 +2336,7 @@ void MANTA::updateMeshFromBobj(const char *filename)
   if (numBuffer) {
     // Triangles
     mMeshTriangles->resize(numBuffer);
-    MANTA::Triangle *bufferTriangle;
-    for (std::vector<Triangle>::iterator it = mMeshTriangles->begin(); it != mMeshTriangles->end();
-         ++it) {
-      gzread(gzf, ibuffer, sizeof(int) * 3);
-      bufferTriangle = (MANTA::Triangle *)ibuffer;
-      it->c[0] = bufferTriangle->c[0];
-      it->c[1] = bufferTriangle->c[1];
-      it->c[2] = bufferTriangle->c[2];
-    }
+    readMeshTriplets(gzf, *mMeshTriangles, &Triangle::c);
   }
   gzclose(gzf);
 }
@@ -2257,7 +2427,6 @@ void MANTA::updateMeshFromUni(const char *filename)
     std::cout << "MANTA::updateMeshFromUni()" << std::endl;
 
   gzFile gzf;
-  float fbuffer[4];
   int ibuffer[4];
 
   gzf = (gzFile)BLI_gzopen(filename, "rb1");  // do some compression
@@ -2305,15 +2474,7 @@ void MANTA::updateMeshFromUni(const char *filename)
     numParticles = ibuffer[0];
 
     velocityPointer->resize(numParticles);
-    MANTA::pVel *bufferPVel;
-    for (std::vector<pVel>::iterator it = velocityPointer->begin(); it != velocityPointer->end();
-         ++it) {
-      gzread(gzf, fbuffer, sizeof(float) * 3);
-      bufferPVel = (MANTA::pVel *)fbuffer;
-      it->pos[0] = bufferPVel->pos[0];
-      it->pos[1] = bufferPVel->pos[1];
-      it->pos[2] = bufferPVel->pos[2];
-    }
+    readMeshTriplets(gzf, *velocityPointer, &pVel::pos);
   }
 
   gzclose(gzf);
@@ -2452,10 +2613,6 @@ void MANTA::updatePointers()
   if (with_debug)
     std::cout << "MANTA::updatePointers()" << std::endl;
 
-  std::string func = "getDataPointer";
-  std::string funcNodes = "getNodesDataPointer";
-  std::string funcTris = "getTrisDataPointer";
-
   std::string id = std::to_string(mCurrentID);
   std::string solver = "s" + id;
   std::string parts = "pp" + id;
@@ -2468,141 +2625,111 @@ void MANTA::updatePointers()
   std::string mesh_ext = "_" + mesh;
   std::string mesh_ext2 = "_" + mesh2;
 
-  mObstacle = (int *)stringToPointer(
-      pyObjectToString(callPythonFunction("flags" + solver_ext, func)));
-  mPhiIn = (float *)stringToPointer(
-      pyObjectToString(callPythonFunction("phiIn" + solver_ext, func)));
-
-  mVelocityX = (float *)stringToPointer(
-      pyObjectToString(callPythonFunction("x_vel" + solver_ext, func)));
-  mVelocityY = (float *)stringToPointer(
-      pyObjectToString(callPythonFunction("y_vel" + solver_ext, func)));
-  mVelocityZ = (float *)stringToPointer(
-      pyObjectToString(callPythonFunction("z_vel" + solver_ext, func)));
-
-  mForceX = (float *)stringToPointer(
-      pyObjectToString(callPythonFunction("x_force" + solver_ext, func)));
-  mForceY = (float *)stringToPointer(
-      pyObjectToString(callPythonFunction("y_force" + solver_ext, func)));
-  mForceZ = (float *)stringToPointer(
-      pyObjectToString(callPythonFunction("z_force" + solver_ext, func)));
+  // All lookups below are native, only indexing the solvers needs the interpreter
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  Manta::FluidSolver *base = getSolver(solver);
+  Manta::FluidSolver *sndSolver = NULL;
+  Manta::FluidSolver *meshSolver = NULL;
+  if (mUsingLiquid && mUsingMesh)
+    meshSolver = getSolver(mesh);
+  if (mUsingLiquid && (mUsingDrops || mUsingBubbles || mUsingFloats || mUsingTracers))
+    sndSolver = getSolver(snd);
+  PyGILState_Release(gilstate);
+
+  mObstacle = getGridData<int>(base, "flags" + solver_ext);
+  mPhiIn = getGridData<float>(base, "phiIn" + solver_ext);
+
+  mVelocityX = getGridData<float>(base, "x_vel" + solver_ext);
+  mVelocityY = getGridData<float>(base, "y_vel" + solver_ext);
+  mVelocityZ = getGridData<float>(base, "z_vel" + solver_ext);
+
+  mForceX = getGridData<float>(base, "x_force" + solver_ext);
+  mForceY = getGridData<float>(base, "y_force" + solver_ext);
+  mForceZ = getGridData<float>(base, "z_force" + solver_ext);
 
   if (mUsingOutflow) {
-    mPhiOutIn = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("phiOutIn" + solver_ext, func)));
+    mPhiOutIn = getGridData<float>(base, "phiOutIn" + solver_ext);
   }
 
   if (mUsingObstacle) {
-    mPhiObsIn = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("phiObsIn" + solver_ext, func)));
-    mNumObstacle = (int *)stringToPointer(
-        pyObjectToString(callPythonFunction("numObs" + solver_ext, func)));
+    mPhiObsIn = getGridData<float>(base, "phiObsIn" + solver_ext);
+    mNumObstacle = getGridData<int>(base, "numObs" + solver_ext);
 
-    mObVelocityX = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("x_obvel" + solver_ext, func)));
-    mObVelocityY = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("y_obvel" + solver_ext, func)));
-    mObVelocityZ = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("z_obvel" + solver_ext, func)));
+    mObVelocityX = getGridData<float>(base, "x_obvel" + solver_ext);
+    mObVelocityY = getGridData<float>(base, "y_obvel" + solver_ext);
+    mObVelocityZ = getGridData<float>(base, "z_obvel" + solver_ext);
   }
 
   if (mUsingGuiding) {
-    mPhiGuideIn = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("phiGuideIn" + solver_ext, func)));
-    mNumGuide = (int *)stringToPointer(
-        pyObjectToString(callPythonFunction("numGuides" + solver_ext, func)));
+    mPhiGuideIn = getGridData<float>(base, "phiGuideIn" + solver_ext);
+    mNumGuide = getGridData<int>(base, "numGuides" + solver_ext);
 
-    mGuideVelocityX = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("x_guidevel" + solver_ext, func)));
-    mGuideVelocityY = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("y_guidevel" + solver_ext, func)));
-    mGuideVelocityZ = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("z_guidevel" + solver_ext, func)));
+    mGuideVelocityX = getGridData<float>(base, "x_guidevel" + solver_ext);
+    mGuideVelocityY = getGridData<float>(base, "y_guidevel" + solver_ext);
+    mGuideVelocityZ = getGridData<float>(base, "z_guidevel" + solver_ext);
   }
 
   if (mUsingInvel) {
-    mInVelocityX = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("x_invel" + solver_ext, func)));
-    mInVelocityY = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("y_invel" + solver_ext, func)));
-    mInVelocityZ = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("z_invel" + solver_ext, func)));
+    mInVelocityX = getGridData<float>(base, "x_invel" + solver_ext);
+    mInVelocityY = getGridData<float>(base, "y_invel" + solver_ext);
+    mInVelocityZ = getGridData<float>(base, "z_invel" + solver_ext);
   }
 
   // Liquid
   if (mUsingLiquid) {
-    mPhi = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("phi" + solver_ext, func)));
+    mPhi = getGridData<float>(base, "phi" + solver_ext);
 
-    mFlipParticleData = (std::vector<pData> *)stringToPointer(
-        pyObjectToString(callPythonFunction("pp" + solver_ext, func)));
-    mFlipParticleVelocity = (std::vector<pVel> *)stringToPointer(
-        pyObjectToString(callPythonFunction("pVel" + parts_ext, func)));
+    mFlipParticleData = (std::vector<pData> *)getVectorData<Manta::BasicParticleSystem>(
+        base, "pp" + solver_ext);
+    mFlipParticleVelocity = (std::vector<pVel> *)
+        getVectorData<Manta::ParticleDataImpl<Manta::Vec3>>(base, "pVel" + parts_ext);
 
     if (mUsingMesh) {
-      mMeshNodes = (std::vector<Node> *)stringToPointer(
-          pyObjectToString(callPythonFunction("mesh" + mesh_ext, funcNodes)));
-      mMeshTriangles = (std::vector<Triangle> *)stringToPointer(
-          pyObjectToString(callPythonFunction("mesh" + mesh_ext, funcTris)));
+      Manta::Mesh *meshObj = getSolverObject<Manta::Mesh>(meshSolver, "mesh" + mesh_ext);
+      mMeshNodes = (meshObj) ? (std::vector<Node> *)&meshObj->getNodeData() : NULL;
+      mMeshTriangles = (meshObj) ? (std::vector<Triangle> *)&meshObj->getTriData() : NULL;
       if (mUsingMVel)
-        mMeshVelocities = (std::vector<pVel> *)stringToPointer(
-            pyObjectToString(callPythonFunction("mVel" + mesh_ext2, func)));
+        mMeshVelocities = (std::vector<pVel> *)
+            getVectorData<Manta::MeshDataImpl<Manta::Vec3>>(meshSolver, "mVel" + mesh_ext2);
     }
 
     if (mUsingDrops || mUsingBubbles || mUsingFloats || mUsingTracers) {
-      mSndParticleData = (std::vector<pData> *)stringToPointer(
-          pyObjectToString(callPythonFunction("ppSnd" + snd_ext, func)));
-      mSndParticleVelocity = (std::vector<pVel> *)stringToPointer(
-          pyObjectToString(callPythonFunction("pVelSnd" + parts_ext, func)));
-      mSndParticleLife = (std::vector<float> *)stringToPointer(
-          pyObjectToString(callPythonFunction("pLifeSnd" + parts_ext, func)));
+      mSndParticleData = (std::vector<pData> *)getVectorData<Manta::BasicParticleSystem>(
+          sndSolver, "ppSnd" + snd_ext);
+      mSndParticleVelocity = (std::vector<pVel> *)
+          getVectorData<Manta::ParticleDataImpl<Manta::Vec3>>(sndSolver, "pVelSnd" + parts_ext);
+      mSndParticleLife = (std::vector<float> *)getVectorData<Manta::ParticleDataImpl<float>>(
+          sndSolver, "pLifeSnd" + parts_ext);
     }
   }
 
   // Smoke
   if (mUsingSmoke) {
-    mDensity = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("density" + solver_ext, func)));
-    mDensityIn = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("densityIn" + solver_ext, func)));
-    mShadow = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("shadow" + solver_ext, func)));
-    mEmissionIn = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("emissionIn" + solver_ext, func)));
+    mDensity = getGridData<float>(base, "density" + solver_ext);
+    mDensityIn = getGridData<float>(base, "densityIn" + solver_ext);
+    mShadow = getGridData<float>(base, "shadow" + solver_ext);
+    mEmissionIn = getGridData<float>(base, "emissionIn" + solver_ext);
 
     if (mUsingHeat) {
-      mHeat = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("heat" + solver_ext, func)));
-      mHeatIn = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("heatIn" + solver_ext, func)));
+      mHeat = getGridData<float>(base, "heat" + solver_ext);
+      mHeatIn = getGridData<float>(base, "heatIn" + solver_ext);
     }
     if (mUsingFire) {
-      mFlame = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("flame" + solver_ext, func)));
-      mFuel = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("fuel" + solver_ext, func)));
-      mReact = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("react" + solver_ext, func)));
-
-      mFuelIn = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("fuelIn" + solver_ext, func)));
-      mReactIn = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("reactIn" + solver_ext, func)));
+      mFlame = getGridData<float>(base, "flame" + solver_ext);
+      mFuel = getGridData<float>(base, "fuel" + solver_ext);
+      mReact = getGridData<float>(base, "react" + solver_ext);
+
+      mFuelIn = getGridData<float>(base, "fuelIn" + solver_ext);
+      mReactIn = getGridData<float>(base, "reactIn" + solver_ext);
     }
     if (mUsingColors) {
-      mColorR = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_r" + solver_ext, func)));
-      mColorG = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_g" + solver_ext, func)));
-      mColorB = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_b" + solver_ext, func)));
-
-      mColorRIn = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_r_in" + solver_ext, func)));
-      mColorGIn = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_g_in" + solver_ext, func)));
-      mColorBIn = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_b_in" + solver_ext, func)));
+      mColorR = getGridData<float>(base, "color_r" + solver_ext);
+      mColorG = getGridData<float>(base, "color_g" + solver_ext);
+      mColorB = getGridData<float>(base, "color_b" + solver_ext);
+
+      mColorRIn = getGridData<float>(base, "color_r_in" + solver_ext);
+      mColorGIn = getGridData<float>(base, "color_g_in" + solver_ext);
+      mColorBIn = getGridData<float>(base, "color_b_in" + solver_ext);
     }
   }
 }
@@ -2612,7 +2739,6 @@ void MANTA::updatePointersNoise()
   if (with_debug)
     std::cout << "MANTA::updatePointersHigh()" << std::endl;
 
-  std::string func = "getDataPointer";
   std::string id = std::to_string(mCurrentID);
   std::string solver = "s" + id;
   std::string solver_ext = "_" + solver;
@@ -2620,6 +2746,11 @@ void MANTA::updatePointersNoise()
   std::string noise = "sn" + id;
   std::string noise_ext = "_" + noise;
 
+  PyGILState_STATE gilstate = PyGILState_Ensure();
+  Manta::FluidSolver *base = getSolver(solver);
+  Manta::FluidSolver *noiseSolver = getSolver(noise);
+  PyGILState_Release(gilstate);
+
   // Liquid
   if (mUsingLiquid) {
     // Nothing to do here
@@ -2627,38 +2758,24 @@ void MANTA::updatePointersNoise()
 
   // Smoke
   if (mUsingSmoke) {
-    mDensityHigh = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("density" + noise_ext, func)));
-    mShadow = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("shadow" + solver_ext, func)));
-    mTextureU = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("texture_u" + solver_ext, func)));
-    mTextureV = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("texture_v" + solver_ext, func)));
-    mTextureW = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("texture_w" + solver_ext, func)));
-    mTextureU2 = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("texture_u2" + solver_ext, func)));
-    mTextureV2 = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("texture_v2" + solver_ext, func)));
-    mTextureW2 = (float *)stringToPointer(
-        pyObjectToString(callPythonFunction("texture_w2" + solver_ext, func)));
+    mDensityHigh = getGridData<float>(noiseSolver, "density" + noise_ext);
+    mShadow = getGridData<float>(base, "shadow" + solver_ext);
+    mTextureU = getGridData<float>(base, "texture_u" + solver_ext);
+    mTextureV = getGridData<float>(base, "texture_v" + solver_ext);
+    mTextureW = getGridData<float>(base, "texture_w" + solver_ext);
+    mTextureU2 = getGridData<float>(base, "texture_u2" + solver_ext);
+    mTextureV2 = getGridData<float>(base, "texture_v2" + solver_ext);
+    mTextureW2 = getGridData<float>(base, "texture_w2" + solver_ext);
 
     if (mUsingFire) {
-      mFlameHigh = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("flame" + noise_ext, func)));
-      mFuelHigh = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("fuel" + noise_ext, func)));
-      mReactHigh = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("react" + noise_ext, func)));
+      mFlameHigh = getGridData<float>(noiseSolver, "flame" + noise_ext);
+      mFuelHigh = getGridData<float>(noiseSolver, "fuel" + noise_ext);
+      mReactHigh = getGridData<float>(noiseSolver, "react" + noise_ext);
     }
     if (mUsingColors) {
-      mColorRHigh = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_r" + noise_ext, func)));
-      mColorGHigh = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_g" + noise_ext, func)));
-      mColorBHigh = (float *)stringToPointer(
-          pyObjectToString(callPythonFunction("color_b" + noise_ext, func)));
+      mColorRHigh = getGridData<float>(noiseSolver, "color_r" + noise_ext);
+      mColorGHigh = getGridData<float>(noiseSolver, "color_g" + noise_ext);
+      mColorBHigh = getGridData<float>(noiseSolver, "color_b" + noise_ext);
     }
   }
 }
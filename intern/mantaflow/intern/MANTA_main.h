@@ -59,6 +59,23 @@ struct MANTA {
     int flags;
   } Triangle;
 
+  // Mirroring Mantaflow structure for pressure solve statistics
+  typedef struct PressureSolveInfo {
+    int frame;
+    int iterations;
+    float residualInitial, residualFinal;
+    float time; /* milliseconds */
+  } PressureSolveInfo;
+
+  // Mirroring Mantaflow structure for profiler summaries (plugin or kernel scope)
+  typedef struct ProfileScopeInfo {
+    std::string name;
+    bool kernel;
+    int calls;
+    float total, self; /* milliseconds */
+    float utilization;
+  } ProfileScopeInfo;
+
   // Manta step, handling everything
   void step(struct MantaModifierData *mmd, int startFrame);
 
@@ -100,6 +117,14 @@ struct MANTA {
   int updateParticleStructures(MantaModifierData *mmd, int framenr);
   void updateVariables(MantaModifierData *mmd);
 
+  // Wait for cache files that are still being written asynchronously
+  void flushCacheWrites();
+
+  // Noise texture coordinates are relative to the domain minimum, update it after a shift
+  void setNoiseUvOffset(const int *resMin);
+  // Previous pressure solutions no longer match shifted grids, don't warm start from them
+  void resetPressureWarmStart();
+
   // Bake cache
   int bakeData(MantaModifierData *mmd, int framenr);
   int bakeNoise(MantaModifierData *mmd, int framenr);
@@ -489,6 +514,24 @@ struct MANTA {
                mMeshVelocities->at(i).pos[2] :
                0.f;
   }
+  inline int getNumVertVels()
+  {
+    return (mMeshVelocities && !mMeshVelocities->empty()) ? mMeshVelocities->size() : 0;
+  }
+
+  // Mesh buffers for bulk copies, NULL if there is no mesh
+  inline const Node *getMeshNodes()
+  {
+    return (mMeshNodes && !mMeshNodes->empty()) ? mMeshNodes->data() : NULL;
+  }
+  inline const Triangle *getMeshTriangles()
+  {
+    return (mMeshTriangles && !mMeshTriangles->empty()) ? mMeshTriangles->data() : NULL;
+  }
+  inline const pVel *getMeshVelocities()
+  {
+    return (mMeshVelocities && !mMeshVelocities->empty()) ? mMeshVelocities->data() : NULL;
+  }
 
   // Particle getters
   inline int getFlipParticleFlagAt(int i)
@@ -630,6 +673,18 @@ struct MANTA {
   float getTimestep();
   void adaptTimestep();
 
+  // Pressure solves of the last bake call, one entry per solve
+  inline const std::vector<PressureSolveInfo> &getPressureStats()
+  {
+    return mPressureStats;
+  }
+
+  // Profiled plugins and kernels of the last bake call, empty unless MANTA_PROFILE is set
+  inline const std::vector<ProfileScopeInfo> &getProfileStats()
+  {
+    return mProfileStats;
+  }
+
   bool needsRealloc(MantaModifierData *mmd);
 
  private:
@@ -752,6 +807,10 @@ struct MANTA {
   std::vector<pVel> *mSndParticleVelocity;
   std::vector<float> *mSndParticleLife;
 
+  // Solver statistics
+  std::vector<PressureSolveInfo> mPressureStats;
+  std::vector<ProfileScopeInfo> mProfileStats;
+
   void initDomain(struct MantaModifierData *mmd);
   void initNoise(struct MantaModifierData *mmd);
   void initMesh(struct MantaModifierData *mmd);
@@ -769,6 +828,8 @@ struct MANTA {
   void updateParticlesFromUni(const char *filename, bool isSecondarySys, bool isVelData);
   void updateMeshFromFile(const char *filename);
   void updateParticlesFromFile(const char *filename, bool isSecondarySys, bool isVelData);
+  void updatePressureStats();
+  void updateProfileStats();
 };
 
 #endif
@@ -39,14 +39,20 @@ namespace Manta {
 
 void pbPreparePlugin(FluidSolver *parent, const string &name, bool doTime)
 {
-  if (doTime)
+  if (doTime) {
     TimingData::instance().start(parent, name);
+    if (ProfileData::enabled())
+      ProfileData::instance().beginPlugin(name);
+  }
 }
 
 void pbFinalizePlugin(FluidSolver *parent, const string &name, bool doTime)
 {
-  if (doTime)
+  if (doTime) {
+    if (ProfileData::enabled())
+      ProfileData::instance().endPlugin(name);
     TimingData::instance().stop(parent, name);
+  }
 
   // GUI update, also print name of parent if there's more than one
   std::ostringstream msg;
@@ -65,6 +71,8 @@ void pbFinalizePlugin(FluidSolver *parent, const string &name, bool doTime)
 void pbSetError(const string &fn, const string &ex)
 {
   debMsg("Error in " << fn, 1);
+  if (ProfileData::enabled())
+    ProfileData::instance().endPlugin(fn);
   if (!ex.empty())
     PyErr_SetString(PyExc_RuntimeError, ex.c_str());
 }
@@ -244,6 +244,22 @@ template<> PbTypeVec fromPy<PbTypeVec>(PyObject *obj)
     errMsg("argument is not a type tuple");
   return vec;
 }
+template<> PbClassVec fromPy<PbClassVec>(PyObject *obj)
+{
+  PbClassVec vec;
+  const bool isList = PyList_Check(obj);
+  if (!isList && !PyTuple_Check(obj))
+    errMsg("argument is not a list or tuple");
+  const Py_ssize_t sz = isList ? PyList_Size(obj) : PyTuple_Size(obj);
+  for (Py_ssize_t i = 0; i < sz; i++) {
+    PyObject *item = isList ? PyList_GetItem(obj, i) : PyTuple_GetItem(obj, i);
+    PbClass *pbo = Pb::objFromPy(item);
+    if (!pbo)
+      errMsg("list entry " << i << " is not a manta object");
+    vec.push_back(pbo);
+  }
+  return vec;
+}
 
 template<class T> T *tmpAlloc(PyObject *obj, std::vector<void *> *tmp)
 {
@@ -100,6 +100,10 @@ template<> Vec4i fromPy<Vec4i>(PyObject *obj);
 template<> PbType fromPy<PbType>(PyObject *obj);
 template<> PbTypeVec fromPy<PbTypeVec>(PyObject *obj);
 
+// list or tuple of manta objects, e.g. several grids for one plugin call
+typedef std::vector<PbClass *> PbClassVec;
+template<> PbClassVec fromPy<PbClassVec>(PyObject *obj);
+
 template<> PyObject *toPy<int>(const int &v);
 template<> PyObject *toPy<std::string>(const std::string &val);
 template<> PyObject *toPy<float>(const float &v);
@@ -126,6 +126,44 @@ inline Real interpolComponent(const Vec3 *data, const Vec3i &size, const int Z,
              f1;
 }
 
+//! Trilinear weights for a single lookup position. Lets several grids of the same size be
+//! sampled at one point while building the index only once; get() gives the same result as
+//! interpol() for each of them
+struct InterpolWeights {
+  InterpolWeights(const Vec3i &size, const int Z, const Vec3 &pos)
+  {
+    BUILD_INDEX
+    mIdx = (IndexInt)xi + (IndexInt)Y * yi + (IndexInt)Z * zi;
+    DEBUG_ONLY(checkIndexInterpol(size, mIdx));
+    DEBUG_ONLY(checkIndexInterpol(size, mIdx + X + Y + Z));
+    (void)X;  // only read by the debug check, get() uses a stride of 1
+    mY = Y;
+    mZ = Z;
+    mS0 = s0;
+    mS1 = s1;
+    mT0 = t0;
+    mT1 = t1;
+    mF0 = f0;
+    mF1 = f1;
+  }
+
+  template<class T> inline T get(const T *data) const
+  {
+    const IndexInt idx = mIdx;
+    const int X = 1, Y = mY, Z = mZ;
+    return ((data[idx] * mT0 + data[idx + Y] * mT1) * mS0 +
+            (data[idx + X] * mT0 + data[idx + X + Y] * mT1) * mS1) *
+               mF0 +
+           ((data[idx + Z] * mT0 + data[idx + Y + Z] * mT1) * mS0 +
+            (data[idx + X + Z] * mT0 + data[idx + X + Y + Z] * mT1) * mS1) *
+               mF1;
+  }
+
+  IndexInt mIdx;
+  int mY, mZ;
+  Real mS0, mS1, mT0, mT1, mF0, mF1;
+};
+
 template<class T>
 inline void setInterpol(
     T *data, const Vec3i &size, const int Z, const Vec3 &pos, const T &v, Real *sumBuffer)
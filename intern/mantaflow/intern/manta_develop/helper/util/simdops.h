@@ -0,0 +1,532 @@
+/******************************************************************************
+ *
+ * MantaFlow fluid solver framework
+ * Copyright 2011 Tobias Pfaff, Nils Thuerey
+ *
+ * This program is free software, distributed under the terms of the
+ * Apache License, Version 2.0
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * SIMD row kernels for the CG solver, with runtime instruction set dispatch
+ *
+ ******************************************************************************/
+
+#ifndef _SIMDOPS_H_
+#define _SIMDOPS_H_
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include "vectorbase.h"
+
+// vector paths are only used for single precision on x86-64, SSE2 is always available there.
+// AVX2 / AVX-512 variants are compiled with target attributes and selected at runtime, which
+// needs gcc or clang.
+#if FLOATINGPOINT_PRECISION == 1 && (defined(__x86_64__) || defined(_M_X64))
+#  define MANTA_SIMD_SSE2 1
+#  include <emmintrin.h>
+#  if defined(__GNUC__)
+#    define MANTA_SIMD_AVX 1
+#    include <immintrin.h>
+#    define MANTA_TARGET_AVX2 __attribute__((target("avx2")))
+#    define MANTA_TARGET_AVX512 __attribute__((target("avx512f")))
+#  endif
+#endif
+
+namespace Manta {
+
+enum SimdLevel { SimdNone = 0, SimdSSE2, SimdAVX2, SimdAVX512 };
+
+inline SimdLevel detectSimdLevel()
+{
+#ifdef MANTA_SIMD_AVX
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return SimdAVX512;
+  if (__builtin_cpu_supports("avx2"))
+    return SimdAVX2;
+#endif
+#ifdef MANTA_SIMD_SSE2
+  return SimdSSE2;
+#else
+  return SimdNone;
+#endif
+}
+
+//! best instruction set supported by compiler and cpu, detected once
+inline SimdLevel getSimdLevel()
+{
+  static const SimdLevel level = detectSimdLevel();
+  return level;
+}
+
+inline const char *getSimdLevelName(SimdLevel level)
+{
+  switch (level) {
+    case SimdSSE2:
+      return "SSE2";
+    case SimdAVX2:
+      return "AVX2";
+    case SimdAVX512:
+      return "AVX-512";
+    default:
+      return "none";
+  }
+}
+
+//! Bits of the compact poisson stencil, one byte per cell.
+/*! A set neighbor bit means a coefficient of -1 towards that neighbor, otherwise it is zero. */
+enum StencilBits {
+  StencilXp = 1,
+  StencilXm = 2,
+  StencilYp = 4,
+  StencilYm = 8,
+  StencilZp = 16,
+  StencilZm = 32,
+  StencilFluid = 128
+};
+
+//*****************************************************************************
+// Vector variants, each processes the first n - (n % width) entries and returns that count.
+// Evaluation order per cell is the same as in the scalar code. Stencil results are identical since
+// all off-diagonal coefficients are 0 or -1, the compiler may fuse multiply-adds elsewhere though.
+
+#ifdef MANTA_SIMD_SSE2
+
+inline __m128i simdLoadStencilSSE2(const unsigned char *mask)
+{
+  int bytes;
+  memcpy(&bytes, mask, 4);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i bits = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+  return _mm_unpacklo_epi16(bits, zero);
+}
+
+inline __m128 simdStencilCoeffSSE2(__m128i bits, int bit)
+{
+  const __m128i b = _mm_set1_epi32(bit);
+  const __m128i set = _mm_cmpeq_epi32(_mm_and_si128(bits, b), b);
+  return _mm_and_ps(_mm_castsi128_ps(set), _mm_set1_ps(-1.f));
+}
+
+inline __m128 simdStencilTermSSE2(const Real *src, __m128i bits, int bit)
+{
+  return _mm_mul_ps(_mm_loadu_ps(src), simdStencilCoeffSSE2(bits, bit));
+}
+
+inline int simdStencilRowSSE2(Real *dst,
+                              const Real *src,
+                              const Real *A0,
+                              const unsigned char *mask,
+                              int n,
+                              IndexInt Y,
+                              IndexInt Z,
+                              bool is3D)
+{
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128i bits = simdLoadStencilSSE2(mask + i);
+    const __m128 s = _mm_loadu_ps(src + i);
+    __m128 sum = _mm_mul_ps(s, _mm_loadu_ps(A0 + i));
+    sum = _mm_add_ps(sum, simdStencilTermSSE2(src + i - 1, bits, StencilXm));
+    sum = _mm_add_ps(sum, simdStencilTermSSE2(src + i + 1, bits, StencilXp));
+    sum = _mm_add_ps(sum, simdStencilTermSSE2(src + i - Y, bits, StencilYm));
+    sum = _mm_add_ps(sum, simdStencilTermSSE2(src + i + Y, bits, StencilYp));
+    if (is3D) {
+      sum = _mm_add_ps(sum, simdStencilTermSSE2(src + i - Z, bits, StencilZm));
+      sum = _mm_add_ps(sum, simdStencilTermSSE2(src + i + Z, bits, StencilZp));
+    }
+    const __m128 fluid = _mm_castsi128_ps(_mm_cmpeq_epi32(
+        _mm_and_si128(bits, _mm_set1_epi32(StencilFluid)), _mm_set1_epi32(StencilFluid)));
+    _mm_storeu_ps(dst + i, _mm_or_ps(_mm_and_ps(fluid, sum), _mm_andnot_ps(fluid, s)));
+  }
+  return i;
+}
+
+inline int simdDotRowSSE2(const Real *a, const Real *b, int n, double &result)
+{
+  __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 p = _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+    acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(p));
+    acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(p, p)));
+  }
+  double partial[2];
+  _mm_storeu_pd(partial, _mm_add_pd(acc0, acc1));
+  result += partial[0] + partial[1];
+  return i;
+}
+
+inline int simdSumSqrRowSSE2(const Real *a, int n, double &result)
+{
+  __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 v = _mm_loadu_ps(a + i);
+    const __m128d lo = _mm_cvtps_pd(v), hi = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+    acc0 = _mm_add_pd(acc0, _mm_mul_pd(lo, lo));
+    acc1 = _mm_add_pd(acc1, _mm_mul_pd(hi, hi));
+  }
+  double partial[2];
+  _mm_storeu_pd(partial, _mm_add_pd(acc0, acc1));
+  result += partial[0] + partial[1];
+  return i;
+}
+
+inline int simdMaxAbsRowSSE2(const Real *a, int n, Real &result)
+{
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  __m128 acc = _mm_set1_ps(result);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    acc = _mm_max_ps(acc, _mm_and_ps(_mm_loadu_ps(a + i), absMask));
+  float partial[4];
+  _mm_storeu_ps(partial, acc);
+  result = std::max(std::max(partial[0], partial[1]), std::max(partial[2], partial[3]));
+  return i;
+}
+
+inline int simdScaledAddRowSSE2(Real *dst, const Real *src, Real factor, int n)
+{
+  const __m128 f = _mm_set1_ps(factor);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(f, _mm_loadu_ps(src + i))));
+  return i;
+}
+
+inline int simdUpdateSearchRowSSE2(Real *dst, const Real *src, Real factor, int n)
+{
+  const __m128 f = _mm_set1_ps(factor);
+  int i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(dst + i,
+                  _mm_add_ps(_mm_loadu_ps(src + i), _mm_mul_ps(f, _mm_loadu_ps(dst + i))));
+  return i;
+}
+
+#endif  // MANTA_SIMD_SSE2
+
+#ifdef MANTA_SIMD_AVX
+
+MANTA_TARGET_AVX2 inline __m256 simdStencilCoeffAVX2(__m256i bits, int bit)
+{
+  const __m256i b = _mm256_set1_epi32(bit);
+  const __m256i set = _mm256_cmpeq_epi32(_mm256_and_si256(bits, b), b);
+  return _mm256_and_ps(_mm256_castsi256_ps(set), _mm256_set1_ps(-1.f));
+}
+
+MANTA_TARGET_AVX2 inline __m256 simdStencilTermAVX2(const Real *src, __m256i bits, int bit)
+{
+  return _mm256_mul_ps(_mm256_loadu_ps(src), simdStencilCoeffAVX2(bits, bit));
+}
+
+MANTA_TARGET_AVX2 inline int simdStencilRowAVX2(Real *dst,
+                                                const Real *src,
+                                                const Real *A0,
+                                                const unsigned char *mask,
+                                                int n,
+                                                IndexInt Y,
+                                                IndexInt Z,
+                                                bool is3D)
+{
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i bits = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(mask + i)));
+    const __m256 s = _mm256_loadu_ps(src + i);
+    __m256 sum = _mm256_mul_ps(s, _mm256_loadu_ps(A0 + i));
+    sum = _mm256_add_ps(sum, simdStencilTermAVX2(src + i - 1, bits, StencilXm));
+    sum = _mm256_add_ps(sum, simdStencilTermAVX2(src + i + 1, bits, StencilXp));
+    sum = _mm256_add_ps(sum, simdStencilTermAVX2(src + i - Y, bits, StencilYm));
+    sum = _mm256_add_ps(sum, simdStencilTermAVX2(src + i + Y, bits, StencilYp));
+    if (is3D) {
+      sum = _mm256_add_ps(sum, simdStencilTermAVX2(src + i - Z, bits, StencilZm));
+      sum = _mm256_add_ps(sum, simdStencilTermAVX2(src + i + Z, bits, StencilZp));
+    }
+    const __m256 fluid = simdStencilCoeffAVX2(bits, StencilFluid);
+    // coefficient is -1 for fluid cells, so the sign bit selects between sum and src
+    _mm256_storeu_ps(dst + i, _mm256_blendv_ps(s, sum, fluid));
+  }
+  return i;
+}
+
+MANTA_TARGET_AVX2 inline int simdDotRowAVX2(const Real *a, const Real *b, int n, double &result)
+{
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 p = _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(p)));
+    acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(p, 1)));
+  }
+  double partial[4];
+  _mm256_storeu_pd(partial, _mm256_add_pd(acc0, acc1));
+  result += (partial[0] + partial[1]) + (partial[2] + partial[3]);
+  return i;
+}
+
+MANTA_TARGET_AVX2 inline int simdSumSqrRowAVX2(const Real *a, int n, double &result)
+{
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 v = _mm256_loadu_ps(a + i);
+    const __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+    const __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(lo, lo));
+    acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(hi, hi));
+  }
+  double partial[4];
+  _mm256_storeu_pd(partial, _mm256_add_pd(acc0, acc1));
+  result += (partial[0] + partial[1]) + (partial[2] + partial[3]);
+  return i;
+}
+
+MANTA_TARGET_AVX2 inline int simdMaxAbsRowAVX2(const Real *a, int n, Real &result)
+{
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  __m256 acc = _mm256_set1_ps(result);
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    acc = _mm256_max_ps(acc, _mm256_and_ps(_mm256_loadu_ps(a + i), absMask));
+  float partial[8];
+  _mm256_storeu_ps(partial, acc);
+  for (int k = 0; k < 8; k++)
+    result = std::max(result, partial[k]);
+  return i;
+}
+
+MANTA_TARGET_AVX2 inline int simdScaledAddRowAVX2(Real *dst, const Real *src, Real factor, int n)
+{
+  const __m256 f = _mm256_set1_ps(factor);
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(
+        dst + i,
+        _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(f, _mm256_loadu_ps(src + i))));
+  return i;
+}
+
+MANTA_TARGET_AVX2 inline int simdUpdateSearchRowAVX2(Real *dst,
+                                                     const Real *src,
+                                                     Real factor,
+                                                     int n)
+{
+  const __m256 f = _mm256_set1_ps(factor);
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(
+        dst + i,
+        _mm256_add_ps(_mm256_loadu_ps(src + i), _mm256_mul_ps(f, _mm256_loadu_ps(dst + i))));
+  return i;
+}
+
+MANTA_TARGET_AVX512 inline __m512 simdStencilCoeffAVX512(__m512i bits, int bit)
+{
+  return _mm512_maskz_mov_ps(_mm512_test_epi32_mask(bits, _mm512_set1_epi32(bit)),
+                             _mm512_set1_ps(-1.f));
+}
+
+MANTA_TARGET_AVX512 inline __m512 simdStencilTermAVX512(const Real *src, __m512i bits, int bit)
+{
+  return _mm512_mul_ps(_mm512_loadu_ps(src), simdStencilCoeffAVX512(bits, bit));
+}
+
+MANTA_TARGET_AVX512 inline int simdStencilRowAVX512(Real *dst,
+                                                    const Real *src,
+                                                    const Real *A0,
+                                                    const unsigned char *mask,
+                                                    int n,
+                                                    IndexInt Y,
+                                                    IndexInt Z,
+                                                    bool is3D)
+{
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512i bits = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(mask + i)));
+    const __m512 s = _mm512_loadu_ps(src + i);
+    // explicit rounding keeps the compiler from fusing this product with the next addition
+    __m512 sum = _mm512_mul_round_ps(
+        s, _mm512_loadu_ps(A0 + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    sum = _mm512_add_ps(sum, simdStencilTermAVX512(src + i - 1, bits, StencilXm));
+    sum = _mm512_add_ps(sum, simdStencilTermAVX512(src + i + 1, bits, StencilXp));
+    sum = _mm512_add_ps(sum, simdStencilTermAVX512(src + i - Y, bits, StencilYm));
+    sum = _mm512_add_ps(sum, simdStencilTermAVX512(src + i + Y, bits, StencilYp));
+    if (is3D) {
+      sum = _mm512_add_ps(sum, simdStencilTermAVX512(src + i - Z, bits, StencilZm));
+      sum = _mm512_add_ps(sum, simdStencilTermAVX512(src + i + Z, bits, StencilZp));
+    }
+    const __mmask16 fluid = _mm512_test_epi32_mask(bits, _mm512_set1_epi32(StencilFluid));
+    _mm512_storeu_ps(dst + i, _mm512_mask_blend_ps(fluid, s, sum));
+  }
+  return i;
+}
+
+MANTA_TARGET_AVX512 inline int simdDotRowAVX512(const Real *a, const Real *b, int n, double &result)
+{
+  __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 p = _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    acc0 = _mm512_add_pd(acc0, _mm512_cvtps_pd(_mm512_castps512_ps256(p)));
+    acc1 = _mm512_add_pd(
+        acc1,
+        _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(p), 1))));
+  }
+  result += _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+  return i;
+}
+
+MANTA_TARGET_AVX512 inline int simdSumSqrRowAVX512(const Real *a, int n, double &result)
+{
+  __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 v = _mm512_loadu_ps(a + i);
+    const __m512d lo = _mm512_cvtps_pd(_mm512_castps512_ps256(v));
+    const __m512d hi = _mm512_cvtps_pd(
+        _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)));
+    acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(lo, lo));
+    acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(hi, hi));
+  }
+  result += _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+  return i;
+}
+
+MANTA_TARGET_AVX512 inline int simdMaxAbsRowAVX512(const Real *a, int n, Real &result)
+{
+  __m512 acc = _mm512_set1_ps(result);
+  int i = 0;
+  for (; i + 16 <= n; i += 16)
+    acc = _mm512_max_ps(acc, _mm512_abs_ps(_mm512_loadu_ps(a + i)));
+  result = _mm512_reduce_max_ps(acc);
+  return i;
+}
+
+MANTA_TARGET_AVX512 inline int simdScaledAddRowAVX512(Real *dst,
+                                                      const Real *src,
+                                                      Real factor,
+                                                      int n)
+{
+  const __m512 f = _mm512_set1_ps(factor);
+  int i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm512_storeu_ps(
+        dst + i,
+        _mm512_add_ps(_mm512_loadu_ps(dst + i), _mm512_mul_ps(f, _mm512_loadu_ps(src + i))));
+  return i;
+}
+
+MANTA_TARGET_AVX512 inline int simdUpdateSearchRowAVX512(Real *dst,
+                                                         const Real *src,
+                                                         Real factor,
+                                                         int n)
+{
+  const __m512 f = _mm512_set1_ps(factor);
+  int i = 0;
+  for (; i + 16 <= n; i += 16)
+    _mm512_storeu_ps(
+        dst + i,
+        _mm512_add_ps(_mm512_loadu_ps(src + i), _mm512_mul_ps(f, _mm512_loadu_ps(dst + i))));
+  return i;
+}
+
+#endif  // MANTA_SIMD_AVX
+
+// dispatch to best vector variant, returns number of processed entries
+#ifdef MANTA_SIMD_AVX
+#  define MANTA_SIMD_DISPATCH(func, ...) \
+    (getSimdLevel() == SimdAVX512 ? \
+         func##AVX512(__VA_ARGS__) : \
+         (getSimdLevel() == SimdAVX2 ? func##AVX2(__VA_ARGS__) : func##SSE2(__VA_ARGS__)))
+#elif defined(MANTA_SIMD_SSE2)
+#  define MANTA_SIMD_DISPATCH(func, ...) func##SSE2(__VA_ARGS__)
+#else
+#  define MANTA_SIMD_DISPATCH(func, ...) 0
+#endif
+
+//*****************************************************************************
+// Row kernels, data pointers point to the first cell of the row
+
+//! dst = A * src for a row of n cells with compact stencil and diagonal A0.
+//! Neighbors in x, y (and z) direction need to exist, i.e. the row may not touch the boundary.
+inline void simdStencilRow(Real *dst,
+                           const Real *src,
+                           const Real *A0,
+                           const unsigned char *mask,
+                           int n,
+                           IndexInt Y,
+                           IndexInt Z,
+                           bool is3D)
+{
+  int i = MANTA_SIMD_DISPATCH(simdStencilRow, dst, src, A0, mask, n, Y, Z, is3D);
+  for (; i < n; i++) {
+    const unsigned char m = mask[i];
+    if (!(m & StencilFluid)) {
+      dst[i] = src[i];
+      continue;
+    }
+    Real sum = src[i] * A0[i] + src[i - 1] * Real((m & StencilXm) ? -1 : 0) +
+               src[i + 1] * Real((m & StencilXp) ? -1 : 0) +
+               src[i - Y] * Real((m & StencilYm) ? -1 : 0) +
+               src[i + Y] * Real((m & StencilYp) ? -1 : 0);
+    if (is3D)
+      sum = sum + src[i - Z] * Real((m & StencilZm) ? -1 : 0) +
+            src[i + Z] * Real((m & StencilZp) ? -1 : 0);
+    dst[i] = sum;
+  }
+}
+
+//! dot product of two rows, products in Real, accumulated in double
+inline double simdDotRow(const Real *a, const Real *b, int n)
+{
+  double result = 0.;
+  int i = MANTA_SIMD_DISPATCH(simdDotRow, a, b, n, result);
+  for (; i < n; i++)
+    result += a[i] * b[i];
+  return result;
+}
+
+//! sum of squares of a row, accumulated in double
+inline double simdSumSqrRow(const Real *a, int n)
+{
+  double result = 0.;
+  int i = MANTA_SIMD_DISPATCH(simdSumSqrRow, a, n, result);
+  for (; i < n; i++)
+    result += (double)a[i] * (double)a[i];
+  return result;
+}
+
+//! maximum absolute value of a row
+inline Real simdMaxAbsRow(const Real *a, int n)
+{
+  Real result = 0.;
+  int i = MANTA_SIMD_DISPATCH(simdMaxAbsRow, a, n, result);
+  for (; i < n; i++)
+    result = std::max(result, (Real)fabs(a[i]));
+  return result;
+}
+
+//! dst += factor * src
+inline void simdScaledAddRow(Real *dst, const Real *src, Real factor, int n)
+{
+  int i = MANTA_SIMD_DISPATCH(simdScaledAddRow, dst, src, factor, n);
+  for (; i < n; i++)
+    dst[i] += factor * src[i];
+}
+
+//! dst = src + factor * dst
+inline void simdUpdateSearchRow(Real *dst, const Real *src, Real factor, int n)
+{
+  int i = MANTA_SIMD_DISPATCH(simdUpdateSearchRow, dst, src, factor, n);
+  for (; i < n; i++)
+    dst[i] = src[i] + factor * dst[i];
+}
+
+#undef MANTA_SIMD_DISPATCH
+
+}  // namespace Manta
+
+#endif
@@ -0,0 +1,260 @@
+/******************************************************************************
+ *
+ * MantaFlow fluid solver framework
+ * Copyright 2011 Tobias Pfaff, Nils Thuerey
+ *
+ * This program is free software, distributed under the terms of the
+ * Apache License, Version 2.0
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Tile mask for the CG pressure solver, tracks active 8^3 tiles of a dense grid
+ *
+ ******************************************************************************/
+
+#ifndef _TILEMASK_H_
+#define _TILEMASK_H_
+
+#include <vector>
+#include <algorithm>
+#include "vectorbase.h"
+#include "kernel.h"
+
+namespace Manta {
+
+//! Splits a grid into cubic tiles and keeps track of the ones that are in use
+/*! This is not a sparse grid backend: Grid, MACGrid, FlagGrid and LevelsetGrid storage stays
+ *  dense (Blender accesses the raw arrays) and FOR_IJK kernels still sweep every cell. The mask
+ *  only lets the CG solver loops skip tiles that do not contain any active cells. A sparse,
+ *  tiled storage backend for narrow-band grids is still to be done, it would have to replace
+ *  the raw array access of Blender and the generated kernels first. */
+class TileMask {
+ public:
+  static const int TILE_BITS = 3;
+  static const int TILE_SIZE = 1 << TILE_BITS;
+
+  TileMask() : mGridSize(0), mTileRes(0)
+  {
+  }
+  TileMask(const Vec3i &gridSize)
+  {
+    resize(gridSize);
+  }
+
+  //! set grid size, all tiles are inactive afterwards
+  void resize(const Vec3i &gridSize)
+  {
+    mGridSize = gridSize;
+    mTileRes = Vec3i((gridSize.x + TILE_SIZE - 1) >> TILE_BITS,
+                     (gridSize.y + TILE_SIZE - 1) >> TILE_BITS,
+                     (gridSize.z + TILE_SIZE - 1) >> TILE_BITS);
+    mActive.assign((size_t)mTileRes.x * mTileRes.y * mTileRes.z, 0);
+    mList.clear();
+  }
+
+  //! deactivate all tiles
+  void clear()
+  {
+    std::fill(mActive.begin(), mActive.end(), 0);
+    mList.clear();
+  }
+
+  //! activate all tiles that contain a cell with (flags & typeMask) != 0,
+  //! plus all tiles within 'band' cells of those
+  template<class GRID> void activateFromFlags(const GRID &flags, int typeMask, int band = 0)
+  {
+    assertMsg(flags.getSize() == mGridSize, "TileMask: grid size mismatch");
+    const GRID *pFlags = &flags;
+    activateCells([&](int i, int j, int k) { return ((*pFlags)(i, j, k) & typeMask) != 0; },
+                  band);
+  }
+
+  //! activate all tiles that contain a cell for which test(i, j, k) is true,
+  //! plus all tiles within 'band' cells of those
+  template<class FUNC> void activateCells(const FUNC &test, int band = 0)
+  {
+    const int num = numTiles();
+    std::vector<char> &active = mActive;
+    forEachTile(num, [&](int tile) {
+      if (active[tile])
+        return;
+      Vec3i lo, hi;
+      getTileBounds(tile, lo, hi);
+      for (int k = lo.z; k < hi.z; k++)
+        for (int j = lo.y; j < hi.y; j++)
+          for (int i = lo.x; i < hi.x; i++)
+            if (test(i, j, k)) {
+              active[tile] = 1;
+              return;
+            }
+    });
+    if (band > 0)
+      dilate((band + TILE_SIZE - 1) >> TILE_BITS);
+    rebuildList();
+  }
+
+  //! grow the active region by n tiles in each direction
+  void dilate(int n)
+  {
+    std::vector<char> grown(mActive.size(), 0);
+    const Vec3i res = mTileRes;
+    const std::vector<char> &active = mActive;
+    forEachTile(numTiles(), [&](int tile) {
+      const Vec3i t = tileCoord(tile);
+      const Vec3i lo(std::max(t.x - n, 0), std::max(t.y - n, 0), std::max(t.z - n, 0));
+      const Vec3i hi(std::min(t.x + n, res.x - 1),
+                     std::min(t.y + n, res.y - 1),
+                     std::min(t.z + n, res.z - 1));
+      for (int k = lo.z; k <= hi.z; k++)
+        for (int j = lo.y; j <= hi.y; j++)
+          for (int i = lo.x; i <= hi.x; i++)
+            if (active[i + res.x * (j + res.y * k)]) {
+              grown[tile] = 1;
+              return;
+            }
+    });
+    mActive.swap(grown);
+    rebuildList();
+  }
+
+  //! rebuild ordered list of active tiles, needs to be called after modifying tiles directly
+  void rebuildList()
+  {
+    mList.clear();
+    for (int tile = 0; tile < numTiles(); tile++)
+      if (mActive[tile])
+        mList.push_back(tile);
+  }
+
+  inline void activateTile(int tile)
+  {
+    mActive[tile] = 1;
+  }
+  inline bool isTileActive(int tile) const
+  {
+    return mActive[tile] != 0;
+  }
+  inline bool isCellActive(int i, int j, int k) const
+  {
+    return mActive[tileIndex(i, j, k)] != 0;
+  }
+  inline int tileIndex(int i, int j, int k) const
+  {
+    return (i >> TILE_BITS) + mTileRes.x * ((j >> TILE_BITS) + mTileRes.y * (k >> TILE_BITS));
+  }
+  inline Vec3i tileCoord(int tile) const
+  {
+    return Vec3i(
+        tile % mTileRes.x, (tile / mTileRes.x) % mTileRes.y, tile / (mTileRes.x * mTileRes.y));
+  }
+  //! cell range [lo, hi) covered by a tile, clamped to the grid
+  inline void getTileBounds(int tile, Vec3i &lo, Vec3i &hi) const
+  {
+    const Vec3i t = tileCoord(tile);
+    lo = t * TILE_SIZE;
+    hi = Vec3i(std::min(lo.x + TILE_SIZE, mGridSize.x),
+               std::min(lo.y + TILE_SIZE, mGridSize.y),
+               std::min(lo.z + TILE_SIZE, mGridSize.z));
+  }
+
+  inline int numTiles() const
+  {
+    return (int)mActive.size();
+  }
+  inline int numActiveTiles() const
+  {
+    return (int)mList.size();
+  }
+  inline const std::vector<int> &getActiveTiles() const
+  {
+    return mList;
+  }
+  inline Real getActiveFraction() const
+  {
+    return mActive.empty() ? 0. : (Real)mList.size() / (Real)mActive.size();
+  }
+  inline const Vec3i &getGridSize() const
+  {
+    return mGridSize;
+  }
+  inline const Vec3i &getTileRes() const
+  {
+    return mTileRes;
+  }
+
+  //! run func(lo, hi) for all active tiles in parallel, [lo, hi) is the cell range of the tile
+  template<class FUNC> void forEachActiveTile(const FUNC &func) const
+  {
+    const std::vector<int> &list = mList;
+    forEachTile((int)list.size(), [&](int n) {
+      Vec3i lo, hi;
+      getTileBounds(list[n], lo, hi);
+      func(lo, hi);
+    });
+  }
+
+  //! sum double-valued func(lo, hi) over all active tiles
+  /*! partial sums are stored per tile and added in tile order, so the result does not depend
+   *  on the number of threads */
+  template<class FUNC> double sumActiveTiles(const FUNC &func) const
+  {
+    std::vector<double> partial;
+    evalActiveTiles(func, partial);
+    double sum = 0.;
+    for (size_t n = 0; n < partial.size(); n++)
+      sum += partial[n];
+    return sum;
+  }
+
+  //! maximum of double-valued func(lo, hi) over all active tiles, 0 if there are none
+  template<class FUNC> double maxActiveTiles(const FUNC &func) const
+  {
+    std::vector<double> partial;
+    evalActiveTiles(func, partial);
+    double result = 0.;
+    for (size_t n = 0; n < partial.size(); n++)
+      result = std::max(result, partial[n]);
+    return result;
+  }
+
+ protected:
+  //! evaluate func(lo, hi) for all active tiles in parallel, one result per tile
+  template<class FUNC> void evalActiveTiles(const FUNC &func, std::vector<double> &partial) const
+  {
+    const std::vector<int> &list = mList;
+    partial.assign(list.size(), 0.);
+    forEachTile((int)list.size(), [&](int n) {
+      Vec3i lo, hi;
+      getTileBounds(list[n], lo, hi);
+      partial[n] = func(lo, hi);
+    });
+  }
+
+  //! parallel loop over [0, num), one tile per task
+  template<class FUNC> static void forEachTile(int num, const FUNC &func)
+  {
+#if TBB == 1
+    tbb::parallel_for(tbb::blocked_range<int>(0, num), [&](const tbb::blocked_range<int> &r) {
+      for (int n = r.begin(); n != r.end(); n++)
+        func(n);
+    });
+#elif OPENMP == 1
+#  pragma omp parallel for schedule(dynamic, 4)
+    for (int n = 0; n < num; n++)
+      func(n);
+#else
+    for (int n = 0; n < num; n++)
+      func(n);
+#endif
+  }
+
+  Vec3i mGridSize;
+  Vec3i mTileRes;
+  //! one byte per tile, non-zero if active
+  std::vector<char> mActive;
+  //! indices of active tiles in ascending (z, y, x) order
+  std::vector<int> mList;
+};
+
+}  // namespace Manta
+
+#endif
@@ -33,6 +33,7 @@ struct InvertCheckFluid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const FlagGrid &flags, Grid<Real> &grid)
   {
@@ -55,6 +56,7 @@ struct InvertCheckFluid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("InvertCheckFluid");
   };
   void run()
   {
@@ -78,6 +80,7 @@ struct GridSumSqr : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &grid, double &sum)
   {
@@ -102,6 +105,7 @@ struct GridSumSqr : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GridSumSqr");
   };
   void run()
   {
@@ -129,6 +133,7 @@ struct CurlOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Vec3> &grid, Grid<Vec3> &dst)
   {
@@ -160,9 +165,21 @@ struct CurlOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CurlOp");
   };
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1)
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, grid, dst);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     const int _maxX = maxX;
     const int _maxY = maxY;
     if (maxZ > 1) {
@@ -201,6 +218,7 @@ struct DivergenceOpMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &div, const MACGrid &grid)
   {
@@ -227,9 +245,21 @@ struct DivergenceOpMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("DivergenceOpMAC");
   };
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1)
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, div, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     const int _maxX = maxX;
     const int _maxY = maxY;
     if (maxZ > 1) {
@@ -267,6 +297,7 @@ struct GradientOpMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, MACGrid &gradient, const Grid<Real> &grid)
   {
@@ -293,9 +324,21 @@ struct GradientOpMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GradientOpMAC");
   };
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1)
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, gradient, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     const int _maxX = maxX;
     const int _maxY = maxY;
     if (maxZ > 1) {
@@ -333,6 +376,7 @@ struct GradientOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &gradient, const Grid<Real> &grid)
   {
@@ -359,9 +403,21 @@ struct GradientOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GradientOp");
   };
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1)
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, gradient, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     const int _maxX = maxX;
     const int _maxY = maxY;
     if (maxZ > 1) {
@@ -399,6 +455,7 @@ struct LaplaceOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &laplace, const Grid<Real> &grid)
   {
@@ -424,9 +481,21 @@ struct LaplaceOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("LaplaceOp");
   };
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1)
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, laplace, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     const int _maxX = maxX;
     const int _maxY = maxY;
     if (maxZ > 1) {
@@ -464,6 +533,7 @@ struct CurvatureOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &curv, const Grid<Real> &grid, const Real h)
   {
@@ -519,6 +589,7 @@ struct CurvatureOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CurvatureOp");
   };
   void run()
   {
@@ -560,6 +631,7 @@ struct GetShiftedComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Vec3> &grid, Grid<Real> &comp, int dim)
   {
@@ -588,6 +660,7 @@ struct GetShiftedComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetShiftedComponent");
   };
   void run()
   {
@@ -630,6 +703,7 @@ struct GetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &grid, Grid<Real> &comp, int dim)
   {
@@ -656,6 +730,7 @@ struct GetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetComponent");
   };
   void run()
   {
@@ -680,6 +755,7 @@ struct GridNorm : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Real> &n, const Grid<Vec3> &grid)
   {
@@ -701,6 +777,7 @@ struct GridNorm : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GridNorm");
   };
   void run()
   {
@@ -725,6 +802,7 @@ struct SetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Vec3> &grid, const Grid<Real> &comp, int dim)
   {
@@ -751,6 +829,7 @@ struct SetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SetComponent");
   };
   void run()
   {
@@ -776,6 +855,7 @@ struct GetCentered : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &center, const MACGrid &vel)
   {
@@ -802,6 +882,7 @@ struct GetCentered : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetCentered");
   };
   void run()
   {
@@ -842,6 +923,7 @@ struct GetMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, MACGrid &vel, const Grid<Vec3> &center)
   {
@@ -868,6 +950,7 @@ struct GetMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetMAC");
   };
   void run()
   {
@@ -908,6 +991,7 @@ struct FillInBoundary : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &grid, int g)
   {
@@ -940,6 +1024,7 @@ struct FillInBoundary : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("FillInBoundary");
   };
   void run()
   {
@@ -985,6 +1070,7 @@ struct kn_conv_mex_in_to_MAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const double *p_lin_array, MACGrid *p_result)
   {
@@ -1011,6 +1097,7 @@ struct kn_conv_mex_in_to_MAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_mex_in_to_MAC");
   };
   void run()
   {
@@ -1050,6 +1137,7 @@ struct kn_conv_MAC_to_mex_out : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid *p_mac, double *p_result)
   {
@@ -1076,6 +1164,7 @@ struct kn_conv_MAC_to_mex_out : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_MAC_to_mex_out");
   };
   void run()
   {
@@ -1117,6 +1206,7 @@ struct kn_conv_mex_in_to_Vec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const double *p_lin_array, Grid<Vec3> *p_result)
   {
@@ -1143,6 +1233,7 @@ struct kn_conv_mex_in_to_Vec3 : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_mex_in_to_Vec3");
   };
   void run()
   {
@@ -1182,6 +1273,7 @@ struct kn_conv_Vec3_to_mex_out : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Vec3> *p_Vec3, double *p_result)
   {
@@ -1208,6 +1300,7 @@ struct kn_conv_Vec3_to_mex_out : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_Vec3_to_mex_out");
   };
   void run()
   {
@@ -1249,6 +1342,7 @@ struct kn_conv_mex_in_to_Real : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const double *p_lin_array, Grid<Real> *p_result)
   {
@@ -1272,6 +1366,7 @@ struct kn_conv_mex_in_to_Real : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_mex_in_to_Real");
   };
   void run()
   {
@@ -1311,6 +1406,7 @@ struct kn_conv_Real_to_mex_out : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Real> *p_grid, double *p_result)
   {
@@ -1334,6 +1430,7 @@ struct kn_conv_Real_to_mex_out : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_Real_to_mex_out");
   };
   void run()
   {
@@ -23,6 +23,8 @@
 #include "grid.h"
 #include "kernel.h"
 #include "multigrid.h"
+#include "tilemask.h"
+#include "simdops.h"
 
 namespace Manta {
 
@@ -33,7 +35,7 @@ class GridCgInterface {
  public:
   enum PreconditionType { PC_None = 0, PC_ICP, PC_mICP, PC_MGP };
 
-  GridCgInterface() : mUseL2Norm(true){};
+  GridCgInterface() : mUseL2Norm(true), mWarmStart(false){};
   virtual ~GridCgInterface(){};
 
   // solving functions
@@ -41,14 +43,24 @@ class GridCgInterface {
   virtual void solve(int maxIter) = 0;
 
   // precond
-  virtual void setICPreconditioner(
-      PreconditionType method, Grid<Real> *A0, Grid<Real> *Ai, Grid<Real> *Aj, Grid<Real> *Ak) = 0;
+  virtual void setICPreconditioner(PreconditionType method,
+                                   Grid<Real> *A0,
+                                   Grid<Real> *Ai,
+                                   Grid<Real> *Aj,
+                                   Grid<Real> *Ak,
+                                   bool reuse = false) = 0;
   virtual void setMGPreconditioner(PreconditionType method, GridMg *MG) = 0;
 
+  //! restrict solver to active tiles, all cells outside of these need to be non-fluid
+  virtual void setActiveTiles(const TileMask *tiles) = 0;
+  //! apply the matrix with a compact stencil (see buildCompactStencil) and use SIMD kernels
+  virtual void setCompactStencil(const std::vector<unsigned char> *stencil) = 0;
+
   // access
   virtual Real getSigma() const = 0;
   virtual Real getIterations() const = 0;
   virtual Real getResNorm() const = 0;
+  virtual Real getInitialResNorm() const = 0;
   virtual void setAccuracy(Real set) = 0;
   virtual Real getAccuracy() const = 0;
 
@@ -60,9 +72,22 @@ class GridCgInterface {
     mUseL2Norm = set;
   }
 
+  //! start from current content of dst instead of zero, dst needs to be zero in non-fluid cells
+  void setWarmStart(bool set)
+  {
+    mWarmStart = set;
+  }
+
  protected:
   // use l2 norm of residualfor threshold? (otherwise uses max norm)
   bool mUseL2Norm;
+  // use initial guess from dst?
+  bool mWarmStart;
+};
+
+//! Box of cells [lo, hi) handled by one task of the compact stencil CG path
+struct CgSpan {
+  Vec3i lo, hi;
 };
 
 //! Run single iteration of the cg solver
@@ -90,9 +115,24 @@ template<class APPLYMAT> class GridCg : public GridCgInterface {
   bool iterate();
   void solve(int maxIter);
   //! init pointers, and copy values from "normal" matrix
-  void setICPreconditioner(
-      PreconditionType method, Grid<Real> *A0, Grid<Real> *Ai, Grid<Real> *Aj, Grid<Real> *Ak);
+  //! with reuse, the grids already hold the factors of the current matrix and are not rebuilt
+  void setICPreconditioner(PreconditionType method,
+                           Grid<Real> *A0,
+                           Grid<Real> *Ai,
+                           Grid<Real> *Aj,
+                           Grid<Real> *Ak,
+                           bool reuse = false);
   void setMGPreconditioner(PreconditionType method, GridMg *MG);
+  //! only supported for the poisson matrices of ApplyMatrix and ApplyMatrix2D
+  void setActiveTiles(const TileMask *tiles)
+  {
+    mpTiles = tiles;
+  }
+  //! only supported for the poisson matrices of ApplyMatrix and ApplyMatrix2D
+  void setCompactStencil(const std::vector<unsigned char> *stencil)
+  {
+    mpStencil = stencil;
+  }
   void forceReinit()
   {
     mInited = false;
@@ -112,6 +152,11 @@ template<class APPLYMAT> class GridCg : public GridCgInterface {
   {
     return mResNorm;
   }
+  //! residual norm of the initial guess
+  Real getInitialResNorm() const
+  {
+    return mResNormInit;
+  }
 
   void setAccuracy(Real set)
   {
@@ -138,7 +183,15 @@ template<class APPLYMAT> class GridCg : public GridCgInterface {
   PreconditionType mPcMethod;
   //! preconditioning grids
   Grid<Real> *mpPCA0, *mpPCAi, *mpPCAj, *mpPCAk;
+  //! skip the (m)ICP factorization in doInit, see setICPreconditioner
+  bool mPcReuse;
   GridMg *mMG;
+  //! optional mask of tiles containing fluid cells, loops skip all other tiles
+  const TileMask *mpTiles;
+  //! optional compact stencil, replaces Ai/Aj/Ak in matrix applications
+  const std::vector<unsigned char> *mpStencil;
+  //! work split for the compact stencil path, set up in doInit
+  std::vector<CgSpan> mSpans;
 
   //! sigma / residual
   Real mSigma;
@@ -146,8 +199,19 @@ template<class APPLYMAT> class GridCg : public GridCgInterface {
   Real mAccuracy;
   //! norm of the residual
   Real mResNorm;
+  //! norm of the residual before the first iteration
+  Real mResNormInit;
 };  // GridCg
 
+//! Convert off-diagonals of a poisson matrix into neighbor bits, see StencilBits
+/*! Returns false if the matrix can not be represented, i.e. if an off-diagonal entry of a fluid
+ *  cell is neither 0 nor -1 (e.g. with fractions) or if fluid cells touch the domain boundary */
+bool buildCompactStencil(const FlagGrid &flags,
+                         const Grid<Real> &Ai,
+                         const Grid<Real> &Aj,
+                         const Grid<Real> &Ak,
+                         std::vector<unsigned char> &stencil);
+
 //! Kernel: Apply symmetric stored Matrix
 
 struct ApplyMatrix : public KernelBase {
@@ -162,6 +226,7 @@ struct ApplyMatrix : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const FlagGrid &flags,
@@ -222,6 +287,7 @@ struct ApplyMatrix : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyMatrix");
   };
   void run()
   {
@@ -257,6 +323,7 @@ struct ApplyMatrix2D : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const FlagGrid &flags,
@@ -318,6 +385,7 @@ struct ApplyMatrix2D : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyMatrix2D");
   };
   void run()
   {
@@ -352,6 +420,7 @@ struct MakeLaplaceMatrix : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -445,9 +514,21 @@ struct MakeLaplaceMatrix : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MakeLaplaceMatrix");
   };
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1)
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, flags, A0, Ai, Aj, Ak, fractions);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     const int _maxX = maxX;
     const int _maxY = maxY;
     if (maxZ > 1) {
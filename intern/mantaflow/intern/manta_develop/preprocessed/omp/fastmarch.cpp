@@ -211,6 +211,7 @@ struct SetLevelsetBoundaries : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &phi)
   {
@@ -242,6 +243,7 @@ struct SetLevelsetBoundaries : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SetLevelsetBoundaries");
   };
   void run()
   {
@@ -290,59 +292,108 @@ template class FastMarch<FmHeapEntryOut, +1>;
 /*****************************************************************************/
 // simpler extrapolation functions (primarily for FLIP)
 
-struct knExtrapolateMACSimple : public KernelBase {
-  knExtrapolateMACSimple(MACGrid &vel, int distance, Grid<int> &tmp, const int d, const int c)
-      : KernelBase(&vel, 1), vel(vel), distance(distance), tmp(tmp), d(d), c(c)
+static const Vec3i nb[6] = {Vec3i(1, 0, 0),
+                            Vec3i(-1, 0, 0),
+                            Vec3i(0, 1, 0),
+                            Vec3i(0, -1, 0),
+                            Vec3i(0, 0, 1),
+                            Vec3i(0, 0, -1)};
+
+// the simple extrapolations grow layer by layer (tmp holds the layer id of each cell, 0 for
+// untouched ones). Instead of sweeping the whole grid for every layer, only the neighbors of
+// the previous layer (the front) are visited, and marching stops once the front is empty
+
+//! mark all untouched inner cells next to the initial region (layer 1) as layer 2
+
+static void firstFront(Grid<int> &tmp, std::vector<Vec3i> &front)
+{
+  const int dim = (tmp.is3D() ? 3 : 2);
+  front.clear();
+  FOR_IJK_BND(tmp, 1)
+  {
+    Vec3i p(i, j, k);
+    if (tmp(p))
+      continue;
+    for (int n = 0; n < 2 * dim; ++n) {
+      if (tmp(p + nb[n]) == 1) {
+        tmp(p) = 2;
+        front.push_back(p);
+        break;
+      }
+    }
+  }
+}
+
+//! mark all untouched inner neighbors of layer d (front) as layer d+1, and collect them in next
+
+static void advanceFront(Grid<int> &tmp,
+                         const std::vector<Vec3i> &front,
+                         std::vector<Vec3i> &next,
+                         const int d)
+{
+  const int dim = (tmp.is3D() ? 3 : 2);
+  next.clear();
+  for (size_t f = 0; f < front.size(); ++f) {
+    for (int n = 0; n < 2 * dim; ++n) {
+      const Vec3i p = front[f] + nb[n];
+      if (tmp.isInBounds(p, 1) && tmp(p) == 0) {
+        tmp(p) = d + 1;
+        next.push_back(p);
+      }
+    }
+  }
+}
+
+//! extrapolate velocity component c into the cells of layer d+1 (front)
+
+struct knExtrapolateMACFront : public KernelBase {
+  knExtrapolateMACFront(MACGrid &vel,
+                        const Grid<int> &tmp,
+                        const std::vector<Vec3i> &front,
+                        const int d,
+                        const int c)
+      : KernelBase(front.size()), vel(vel), tmp(tmp), front(front), d(d), c(c)
   {
     runMessage();
     run();
+    profileEnd();
   }
-  inline void op(
-      int i, int j, int k, MACGrid &vel, int distance, Grid<int> &tmp, const int d, const int c)
+  inline void op(IndexInt idx,
+                 MACGrid &vel,
+                 const Grid<int> &tmp,
+                 const std::vector<Vec3i> &front,
+                 const int d,
+                 const int c)
   {
-    static const Vec3i nb[6] = {Vec3i(1, 0, 0),
-                                Vec3i(-1, 0, 0),
-                                Vec3i(0, 1, 0),
-                                Vec3i(0, -1, 0),
-                                Vec3i(0, 0, 1),
-                                Vec3i(0, 0, -1)};
     const int dim = (vel.is3D() ? 3 : 2);
-
-    if (tmp(i, j, k) != 0)
-      return;
+    const Vec3i p = front[idx];
 
     // copy from initialized neighbors
-    Vec3i p(i, j, k);
     int nbs = 0;
     Real avgVel = 0.;
     for (int n = 0; n < 2 * dim; ++n) {
       if (tmp(p + nb[n]) == d) {
-        // vel(p)[c] = (c+1.)*0.1;
         avgVel += vel(p + nb[n])[c];
         nbs++;
       }
     }
-
-    if (nbs > 0) {
-      tmp(p) = d + 1;
-      vel(p)[c] = avgVel / nbs;
-    }
+    vel(p)[c] = avgVel / nbs;
   }
   inline MACGrid &getArg0()
   {
     return vel;
   }
   typedef MACGrid type0;
-  inline int &getArg1()
+  inline const Grid<int> &getArg1()
   {
-    return distance;
+    return tmp;
   }
-  typedef int type1;
-  inline Grid<int> &getArg2()
+  typedef Grid<int> type1;
+  inline const std::vector<Vec3i> &getArg2()
   {
-    return tmp;
+    return front;
   }
-  typedef Grid<int> type2;
+  typedef std::vector<Vec3i> type2;
   inline const int &getArg3()
   {
     return d;
@@ -355,42 +406,26 @@ struct knExtrapolateMACSimple : public KernelBase {
   typedef int type4;
   void runMessage()
   {
-    debMsg("Executing kernel knExtrapolateMACSimple ", 3);
+    debMsg("Executing kernel knExtrapolateMACFront ", 3);
     debMsg("Kernel range"
-               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+               << " size " << size << " ",
            4);
+    profileBegin("knExtrapolateMACFront");
   };
   void run()
   {
-    const int _maxX = maxX;
-    const int _maxY = maxY;
-    if (maxZ > 1) {
-
-#pragma omp parallel
-      {
-
-#pragma omp for
-        for (int k = minZ; k < maxZ; k++)
-          for (int j = 1; j < _maxY; j++)
-            for (int i = 1; i < _maxX; i++)
-              op(i, j, k, vel, distance, tmp, d, c);
-      }
-    }
-    else {
-      const int k = 0;
+    const IndexInt _sz = size;
 #pragma omp parallel
-      {
+    {
 
 #pragma omp for
-        for (int j = 1; j < _maxY; j++)
-          for (int i = 1; i < _maxX; i++)
-            op(i, j, k, vel, distance, tmp, d, c);
-      }
+      for (IndexInt i = 0; i < _sz; i++)
+        op(i, vel, tmp, front, d, c);
     }
   }
   MACGrid &vel;
-  int distance;
-  Grid<int> &tmp;
+  const Grid<int> &tmp;
+  const std::vector<Vec3i> &front;
   const int d;
   const int c;
 };
@@ -402,6 +437,7 @@ struct knExtrapolateIntoBnd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, FlagGrid &flags, MACGrid &vel, const MACGrid &velTmp)
   {
@@ -471,6 +507,7 @@ struct knExtrapolateIntoBnd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knExtrapolateIntoBnd");
   };
   void run()
   {
@@ -539,6 +576,7 @@ struct knUnprojectNormalComp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, FlagGrid &flags, MACGrid &vel, Grid<Real> &phi, Real maxDist)
   {
@@ -580,6 +618,7 @@ struct knUnprojectNormalComp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knUnprojectNormalComp");
   };
   void run()
   {
@@ -626,6 +665,7 @@ void extrapolateMACSimple(FlagGrid &flags,
                           bool intoObs = false)
 {
   Grid<int> tmp(flags.getParent());
+  std::vector<Vec3i> front, next;
   int dim = (flags.is3D() ? 3 : 2);
 
   for (int c = 0; c < dim; ++c) {
@@ -654,7 +694,14 @@ void extrapolateMACSimple(FlagGrid &flags,
 
     // extrapolate for distance
     for (int d = 1; d < 1 + distance; ++d) {
-      knExtrapolateMACSimple(vel, distance, tmp, d, c);
+      if (d == 1)
+        firstFront(tmp, next);
+      else
+        advanceFront(tmp, front, next, d);
+      if (next.empty())
+        break;
+      knExtrapolateMACFront(vel, tmp, next, d, c);
+      front.swap(next);
     }  // d
   }
 
@@ -709,6 +756,7 @@ struct knExtrapolateMACFromWeight : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -777,6 +825,7 @@ struct knExtrapolateMACFromWeight : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knExtrapolateMACFromWeight");
   };
   void run()
   {
@@ -876,29 +925,31 @@ void PbRegister_extrapolateMACFromWeight()
 
 // simple extrapolation functions for levelsets
 
-static const Vec3i nb[6] = {Vec3i(1, 0, 0),
-                            Vec3i(-1, 0, 0),
-                            Vec3i(0, 1, 0),
-                            Vec3i(0, -1, 0),
-                            Vec3i(0, 0, 1),
-                            Vec3i(0, 0, -1)};
+//! extrapolate values into the cells of layer d+1 (front)
 
-template<class S> struct knExtrapolateLsSimple : public KernelBase {
-  knExtrapolateLsSimple(Grid<S> &val, int distance, Grid<int> &tmp, const int d, S direction)
-      : KernelBase(&val, 1), val(val), distance(distance), tmp(tmp), d(d), direction(direction)
+template<class S> struct knExtrapolateLsFront : public KernelBase {
+  knExtrapolateLsFront(Grid<S> &val,
+                       const Grid<int> &tmp,
+                       const std::vector<Vec3i> &front,
+                       const int d,
+                       S direction)
+      : KernelBase(front.size()), val(val), tmp(tmp), front(front), d(d), direction(direction)
   {
     runMessage();
     run();
+    profileEnd();
   }
-  inline void op(
-      int i, int j, int k, Grid<S> &val, int distance, Grid<int> &tmp, const int d, S direction)
+  inline void op(IndexInt idx,
+                 Grid<S> &val,
+                 const Grid<int> &tmp,
+                 const std::vector<Vec3i> &front,
+                 const int d,
+                 S direction)
   {
     const int dim = (val.is3D() ? 3 : 2);
-    if (tmp(i, j, k) != 0)
-      return;
+    const Vec3i p = front[idx];
 
     // copy from initialized neighbors
-    Vec3i p(i, j, k);
     int nbs = 0;
     S avg(0.);
     for (int n = 0; n < 2 * dim; ++n) {
@@ -907,27 +958,23 @@ template<class S> struct knExtrapolateLsSimple : public KernelBase {
         nbs++;
       }
     }
-
-    if (nbs > 0) {
-      tmp(p) = d + 1;
-      val(p) = avg / nbs + direction;
-    }
+    val(p) = avg / nbs + direction;
   }
   inline Grid<S> &getArg0()
   {
     return val;
   }
   typedef Grid<S> type0;
-  inline int &getArg1()
+  inline const Grid<int> &getArg1()
   {
-    return distance;
+    return tmp;
   }
-  typedef int type1;
-  inline Grid<int> &getArg2()
+  typedef Grid<int> type1;
+  inline const std::vector<Vec3i> &getArg2()
   {
-    return tmp;
+    return front;
   }
-  typedef Grid<int> type2;
+  typedef std::vector<Vec3i> type2;
   inline const int &getArg3()
   {
     return d;
@@ -940,42 +987,26 @@ template<class S> struct knExtrapolateLsSimple : public KernelBase {
   typedef S type4;
   void runMessage()
   {
-    debMsg("Executing kernel knExtrapolateLsSimple ", 3);
+    debMsg("Executing kernel knExtrapolateLsFront ", 3);
     debMsg("Kernel range"
-               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+               << " size " << size << " ",
            4);
+    profileBegin("knExtrapolateLsFront");
   };
   void run()
   {
-    const int _maxX = maxX;
-    const int _maxY = maxY;
-    if (maxZ > 1) {
-
-#pragma omp parallel
-      {
-
-#pragma omp for
-        for (int k = minZ; k < maxZ; k++)
-          for (int j = 1; j < _maxY; j++)
-            for (int i = 1; i < _maxX; i++)
-              op(i, j, k, val, distance, tmp, d, direction);
-      }
-    }
-    else {
-      const int k = 0;
+    const IndexInt _sz = size;
 #pragma omp parallel
-      {
+    {
 
 #pragma omp for
-        for (int j = 1; j < _maxY; j++)
-          for (int i = 1; i < _maxX; i++)
-            op(i, j, k, val, distance, tmp, d, direction);
-      }
+      for (IndexInt i = 0; i < _sz; i++)
+        op(i, val, tmp, front, d, direction);
     }
   }
   Grid<S> &val;
-  int distance;
-  Grid<int> &tmp;
+  const Grid<int> &tmp;
+  const std::vector<Vec3i> &front;
   const int d;
   S direction;
 };
@@ -986,6 +1017,7 @@ template<class S> struct knSetRemaining : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<S> &phi, Grid<int> &tmp, S distance)
   {
@@ -1014,6 +1046,7 @@ template<class S> struct knSetRemaining : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetRemaining");
   };
   void run()
   {
@@ -1052,7 +1085,6 @@ void extrapolateLsSimple(Grid<Real> &phi, int distance = 4, bool inside = false)
 {
   Grid<int> tmp(phi.getParent());
   tmp.clear();
-  const int dim = (phi.is3D() ? 3 : 2);
 
   // by default, march outside
   Real direction = 1.;
@@ -1075,22 +1107,14 @@ void extrapolateLsSimple(Grid<Real> &phi, int distance = 4, bool inside = false)
     }
   }
   // + first layer around
-  FOR_IJK_BND(phi, 1)
-  {
-    Vec3i p(i, j, k);
-    if (tmp(p))
-      continue;
-    for (int n = 0; n < 2 * dim; ++n) {
-      if (tmp(p + nb[n]) == 1) {
-        tmp(i, j, k) = 2;
-        n = 2 * dim;
-      }
-    }
-  }
+  std::vector<Vec3i> front, next;
+  firstFront(tmp, front);
 
   // extrapolate for distance
-  for (int d = 2; d < 1 + distance; ++d) {
-    knExtrapolateLsSimple<Real>(phi, distance, tmp, d, direction);
+  for (int d = 2; d < 1 + distance && !front.empty(); ++d) {
+    advanceFront(tmp, front, next, d);
+    knExtrapolateLsFront<Real>(phi, tmp, next, d, direction);
+    front.swap(next);
   }
 
   // set all remaining cells to max
@@ -1135,7 +1159,6 @@ void extrapolateVec3Simple(Grid<Vec3> &vel, Grid<Real> &phi, int distance = 4, b
 {
   Grid<int> tmp(vel.getParent());
   tmp.clear();
-  const int dim = (vel.is3D() ? 3 : 2);
 
   // mark initial cells, by default, march outside
   if (!inside) {
@@ -1156,21 +1179,13 @@ void extrapolateVec3Simple(Grid<Vec3> &vel, Grid<Real> &phi, int distance = 4, b
     }
   }
   // + first layer next to initial cells
-  FOR_IJK_BND(vel, 1)
-  {
-    Vec3i p(i, j, k);
-    if (tmp(p))
-      continue;
-    for (int n = 0; n < 2 * dim; ++n) {
-      if (tmp(p + nb[n]) == 1) {
-        tmp(i, j, k) = 2;
-        n = 2 * dim;
-      }
-    }
-  }
+  std::vector<Vec3i> front, next;
+  firstFront(tmp, front);
 
-  for (int d = 2; d < 1 + distance; ++d) {
-    knExtrapolateLsSimple<Vec3>(vel, distance, tmp, d, Vec3(0.));
+  for (int d = 2; d < 1 + distance && !front.empty(); ++d) {
+    advanceFront(tmp, front, next, d);
+    knExtrapolateLsFront<Vec3>(vel, tmp, next, d, Vec3(0.));
+    front.swap(next);
   }
   knSetRemaining<Vec3>(vel, tmp, Vec3(0.));
 }
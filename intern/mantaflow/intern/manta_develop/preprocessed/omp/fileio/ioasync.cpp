@@ -0,0 +1,408 @@
+
+
+// DO NOT EDIT !
+// This file is generated using the MantaFlow preprocessor (prep generate).
+
+/******************************************************************************
+ *
+ * MantaFlow fluid solver framework
+ * Copyright 2020 Sebastian Barschkis, Nils Thuerey
+ *
+ * This program is free software, distributed under the terms of the
+ * Apache License, Version 2.0
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Asynchronous writing of grids and particle data, the simulation only pays
+ * for a snapshot copy while compression and disk I/O run on writer threads
+ *
+ ******************************************************************************/
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "mantaio.h"
+#include "grid.h"
+#include "particle.h"
+
+using namespace std;
+
+namespace Manta {
+
+//! memory held by a snapshot of the given object
+template<class T> static IndexInt snapshotBytes(const Grid<T> &grid)
+{
+  return (IndexInt)sizeof(T) * grid.getSizeX() * grid.getSizeY() * grid.getSizeZ();
+}
+static IndexInt snapshotBytes(const BasicParticleSystem &parts)
+{
+  return (IndexInt)sizeof(BasicParticleData) * parts.size();
+}
+template<class T> static IndexInt snapshotBytes(const ParticleDataImpl<T> &pdata)
+{
+  return (IndexInt)sizeof(T) * pdata.size();
+}
+
+//! a pending write, owns a snapshot of the object it saves
+class AsyncWriteJob {
+ public:
+  AsyncWriteJob(const string &name, IndexInt bytes) : mName(name), mBytes(bytes)
+  {
+  }
+  virtual ~AsyncWriteJob()
+  {
+  }
+  virtual void write() = 0;
+
+  string mName;
+  IndexInt mBytes;
+  string mError;
+};
+
+template<class T> class GridWriteJob : public AsyncWriteJob {
+ public:
+  GridWriteJob(const string &name, Grid<T> &grid, float maxError)
+      : AsyncWriteJob(name, snapshotBytes(grid)), mGrid(grid), mMaxError(maxError)
+  {
+    mGrid.setName(grid.getName());
+  }
+  void write()
+  {
+    // lossy quantization is only supported by the chunked format
+    const size_t dot = mName.find_last_of('.');
+    if (mMaxError > 0 && dot != string::npos && mName.substr(dot) == ".mcc")
+      writeGridMcc(mName, &mGrid, mMaxError);
+    else
+      mGrid.save(mName);
+  }
+  Grid<T> mGrid;
+  float mMaxError;
+};
+
+class PartsWriteJob : public AsyncWriteJob {
+ public:
+  PartsWriteJob(const string &name, BasicParticleSystem &parts)
+      : AsyncWriteJob(name, snapshotBytes(parts)), mParts(parts.getParent())
+  {
+    mParts.getData() = parts.getData();
+    mParts.setName(parts.getName());
+  }
+  void write()
+  {
+    mParts.save(mName);
+  }
+  BasicParticleSystem mParts;
+};
+
+template<class T> class PdataWriteJob : public AsyncWriteJob {
+ public:
+  PdataWriteJob(const string &name, ParticleDataImpl<T> &pdata)
+      : AsyncWriteJob(name, snapshotBytes(pdata)), mPdata(pdata.getParent(), &pdata)
+  {
+  }
+  void write()
+  {
+    mPdata.save(mName);
+  }
+  ParticleDataImpl<T> mPdata;
+};
+
+//! Writer threads and their queue. Snapshots are allocated from the solver's grid pool,
+//! so jobs are only created and deleted on the main thread; writer threads just save them.
+class AsyncWriter {
+ public:
+  AsyncWriter() : mNumThreads(2), mMaxBytes((IndexInt)1024 << 20), mPending(0), mShutdown(false)
+  {
+  }
+  ~AsyncWriter()
+  {
+    // remaining snapshots are leaked on purpose, their solvers may already be gone at exit
+    stopThreads();
+  }
+
+  void configure(int threads, int maxMemory)
+  {
+    flush();
+    stopThreads();
+    mNumThreads = std::max(threads, 0);
+    mMaxBytes = (IndexInt)std::max(maxMemory, 1) << 20;
+  }
+  bool enabled() const
+  {
+    return mNumThreads > 0;
+  }
+
+  //! block until a snapshot of the given size fits into the memory budget
+  void reserve(IndexInt bytes)
+  {
+    unique_lock<mutex> lock(mMutex);
+    reapLocked();
+    while (mPending > 0 && mPending + bytes > mMaxBytes) {
+      mDone.wait(lock);
+      reapLocked();
+    }
+  }
+
+  void push(AsyncWriteJob *job)
+  {
+    unique_lock<mutex> lock(mMutex);
+    if (mThreads.empty()) {
+      mShutdown = false;
+      for (int i = 0; i < mNumThreads; ++i)
+        mThreads.push_back(thread(&AsyncWriter::work, this));
+    }
+    mPending += job->mBytes;
+    mQueue.push_back(job);
+    mWake.notify_one();
+  }
+
+  //! wait for all queued writes, throws if any of them failed
+  void flush()
+  {
+    string errors;
+    {
+      unique_lock<mutex> lock(mMutex);
+      reapLocked();
+      while (mPending > 0) {
+        mDone.wait(lock);
+        reapLocked();
+      }
+      errors.swap(mErrors);
+    }
+    if (!errors.empty())
+      errMsg("flushAsyncWrites: " << errors);
+  }
+
+ private:
+  void work()
+  {
+    for (;;) {
+      AsyncWriteJob *job;
+      {
+        unique_lock<mutex> lock(mMutex);
+        while (!mShutdown && mQueue.empty())
+          mWake.wait(lock);
+        if (mQueue.empty())
+          return;
+        job = mQueue.front();
+        mQueue.pop_front();
+      }
+      try {
+        job->write();
+      }
+      catch (std::exception &e) {
+        job->mError = e.what();
+      }
+      {
+        unique_lock<mutex> lock(mMutex);
+        mFinished.push_back(job);
+      }
+      mDone.notify_all();
+    }
+  }
+
+  //! delete finished jobs (and their snapshots), main thread only
+  void reapLocked()
+  {
+    for (size_t i = 0; i < mFinished.size(); ++i) {
+      AsyncWriteJob *job = mFinished[i];
+      mPending -= job->mBytes;
+      if (!job->mError.empty())
+        mErrors += "\n  " + job->mName + ": " + job->mError;
+      delete job;
+    }
+    mFinished.clear();
+  }
+
+  void stopThreads()
+  {
+    {
+      unique_lock<mutex> lock(mMutex);
+      mShutdown = true;
+    }
+    mWake.notify_all();
+    for (size_t i = 0; i < mThreads.size(); ++i)
+      mThreads[i].join();
+    mThreads.clear();
+  }
+
+  int mNumThreads;
+  IndexInt mMaxBytes;
+  IndexInt mPending;
+  bool mShutdown;
+  string mErrors;
+  mutex mMutex;
+  condition_variable mWake, mDone;
+  deque<AsyncWriteJob *> mQueue;
+  vector<AsyncWriteJob *> mFinished;
+  vector<thread> mThreads;
+};
+
+static AsyncWriter gAsyncWriter;
+
+template<class J, class O> static void queueWrite(const string &name, O &obj)
+{
+  gAsyncWriter.reserve(snapshotBytes(obj));
+  gAsyncWriter.push(new J(name, obj));
+}
+template<class T> static void queueGridWrite(const string &name, Grid<T> &grid, float maxError)
+{
+  gAsyncWriter.reserve(snapshotBytes(grid));
+  gAsyncWriter.push(new GridWriteJob<T>(name, grid, maxError));
+}
+
+//! Configure the asynchronous writer: number of writer threads (0 writes synchronously) and
+//! memory budget in MB for snapshots waiting to be written
+
+void setAsyncWriter(int threads = 2, int maxMemory = 1024)
+{
+  gAsyncWriter.configure(threads, maxMemory);
+}
+static PyObject *_W_0(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "setAsyncWriter", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      int threads = _args.getOpt<int>("threads", 0, 2, &_lock);
+      int maxMemory = _args.getOpt<int>("maxMemory", 1, 1024, &_lock);
+      _retval = getPyNone();
+      setAsyncWriter(threads, maxMemory);
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "setAsyncWriter", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("setAsyncWriter", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_setAsyncWriter("", "setAsyncWriter", _W_0);
+extern "C" {
+void PbRegister_setAsyncWriter()
+{
+  KEEP_UNUSED(_RP_setAsyncWriter);
+}
+}
+
+//! Queue a snapshot of a grid, particle system or particle data for writing in the background.
+//! Returns false if the object type is not supported (or the writer is disabled), the caller
+//! then has to save it synchronously. maxError > 0 quantizes Real grids in .mcc files, see
+//! saveQuantized
+
+bool saveAsync(PyObject *obj, std::string name, Real maxError = 0)
+{
+  if (!gAsyncWriter.enabled())
+    return false;
+  PbClass *pbo = Pb::objFromPy(obj);
+  if (!pbo)
+    return false;
+
+#if FLOATINGPOINT_PRECISION == 1
+  // double precision writers convert via temporary pool grids, keep those synchronous
+  if (Grid<int> *g = dynamic_cast<Grid<int> *>(pbo)) {
+    queueGridWrite(name, *g, maxError);
+    return true;
+  }
+  if (Grid<Real> *g = dynamic_cast<Grid<Real> *>(pbo)) {
+    queueGridWrite(name, *g, maxError);
+    return true;
+  }
+  if (Grid<Vec3> *g = dynamic_cast<Grid<Vec3> *>(pbo)) {
+    queueGridWrite(name, *g, maxError);
+    return true;
+  }
+#endif
+  if (BasicParticleSystem *p = dynamic_cast<BasicParticleSystem *>(pbo)) {
+    queueWrite<PartsWriteJob>(name, *p);
+    return true;
+  }
+  if (ParticleDataImpl<int> *p = dynamic_cast<ParticleDataImpl<int> *>(pbo)) {
+    queueWrite<PdataWriteJob<int>>(name, *p);
+    return true;
+  }
+  if (ParticleDataImpl<Real> *p = dynamic_cast<ParticleDataImpl<Real> *>(pbo)) {
+    queueWrite<PdataWriteJob<Real>>(name, *p);
+    return true;
+  }
+  if (ParticleDataImpl<Vec3> *p = dynamic_cast<ParticleDataImpl<Vec3> *>(pbo)) {
+    queueWrite<PdataWriteJob<Vec3>>(name, *p);
+    return true;
+  }
+  return false;
+}
+static PyObject *_W_1(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "saveAsync", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      PyObject *obj = _args.get<PyObject *>("obj", 0, &_lock);
+      std::string name = _args.get<std::string>("name", 1, &_lock);
+      Real maxError = _args.getOpt<Real>("maxError", 2, 0, &_lock);
+      _retval = toPy(saveAsync(obj, name, maxError));
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "saveAsync", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("saveAsync", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_saveAsync("", "saveAsync", _W_1);
+extern "C" {
+void PbRegister_saveAsync()
+{
+  KEEP_UNUSED(_RP_saveAsync);
+}
+}
+
+//! Wait until all queued writes are on disk, reports failed writes as an error
+
+void flushAsyncWrites()
+{
+  gAsyncWriter.flush();
+}
+static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "flushAsyncWrites", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      _retval = getPyNone();
+      flushAsyncWrites();
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "flushAsyncWrites", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("flushAsyncWrites", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_flushAsyncWrites("", "flushAsyncWrites", _W_2);
+extern "C" {
+void PbRegister_flushAsyncWrites()
+{
+  KEEP_UNUSED(_RP_flushAsyncWrites);
+}
+}
+
+}  // namespace Manta
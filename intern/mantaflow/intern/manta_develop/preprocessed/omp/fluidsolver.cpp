@@ -18,6 +18,7 @@
 
 #include "fluidsolver.h"
 #include "grid.h"
+#include "pythonInclude.h"
 #include <sstream>
 #include <fstream>
 
@@ -216,6 +217,36 @@ void FluidSolver::printMemInfo()
   printf("%s\n", msg.str().c_str());
 }
 
+void FluidSolver::indexObjects()
+{
+  mObjectIndex.clear();
+
+  PyObject *sys_mod_dict = PyImport_GetModuleDict();
+  PyObject *loc_mod = PyMapping_GetItemString(sys_mod_dict, (char *)"__main__");
+  if (!loc_mod)
+    return;
+  PyObject *locdict = PyObject_GetAttrString(loc_mod, "__dict__");
+  Py_DECREF(loc_mod);
+  if (!locdict)
+    return;
+
+  // single pass over the module variables, aliases of one object are all registered
+  PyObject *lkey, *lvalue;
+  Py_ssize_t lpos = 0;
+  while (PyDict_Next(locdict, &lpos, &lkey, &lvalue)) {
+    PbClass *obj = Pb::objFromPy(lvalue);
+    if (obj && obj->getParent() == this && PyUnicode_Check(lkey))
+      mObjectIndex[fromPy<std::string>(lkey)] = obj;
+  }
+  Py_DECREF(locdict);
+}
+
+PbClass *FluidSolver::findObject(const std::string &name) const
+{
+  std::map<std::string, PbClass *>::const_iterator it = mObjectIndex.find(name);
+  return (it != mObjectIndex.end()) ? it->second : NULL;
+}
+
 //! warning, uses 10^-4 epsilon values, thus only use around "regular" FPS time scales, e.g. 30
 //! frames per time unit pass max magnitude of current velocity as maxvel, not yet scaled by dt!
 void FluidSolver::adaptTimestep(Real maxVel)
@@ -27,6 +27,16 @@
 
 namespace Manta {
 
+//! Convergence data of a single pressure solve
+struct PressureSolveInfo {
+  int frame;
+  int iterations;
+  Real residualInitial;
+  Real residualFinal;
+  //! wall time of the solve in milliseconds
+  Real time;
+};
+
 //! Encodes grid size, timstep etc.
 
 class FluidSolver : public PbClass {
@@ -223,6 +233,31 @@ class FluidSolver : public PbClass {
   template<class T> T *getGridPointer();
   template<class T> void freeGridPointer(T *ptr);
 
+  //! pressure solves since the last clearPressureSolveInfo() call, filled by solvePressure
+  void addPressureSolveInfo(const PressureSolveInfo &info)
+  {
+    mPressureSolveInfo.push_back(info);
+  }
+  const std::vector<PressureSolveInfo> &getPressureSolveInfo() const
+  {
+    return mPressureSolveInfo;
+  }
+  void clearPressureSolveInfo()
+  {
+    mPressureSolveInfo.clear();
+  }
+
+  //! registry of the script variables holding objects of this solver, lets host applications
+  //! fetch grids, particles and meshes by name without calling into the interpreter per object.
+  //! indexObjects() rebuilds it from __main__ (needs the GIL), entries stay valid until the
+  //! script deletes objects
+  void indexObjects();
+  PbClass *findObject(const std::string &name) const;
+  template<class T> T *getObject(const std::string &name) const
+  {
+    return dynamic_cast<T *>(findObject(name));
+  }
+
   //! expose animation time to python
   Real mDt;
   static PyObject *_GET_mDt(PyObject *self, void *cl)
@@ -354,6 +389,12 @@ class FluidSolver : public PbClass {
   GridStorage<Real> mGridsReal;
   GridStorage<Vec3> mGridsVec;
 
+  //! pressure solve statistics
+  std::vector<PressureSolveInfo> mPressureSolveInfo;
+
+  //! objects of this solver by script variable name, see indexObjects()
+  std::map<std::string, PbClass *> mObjectIndex;
+
   //! 4d data section, only required for simulations working with space-time data
 
  public:
@@ -131,6 +131,8 @@ template<class T> void Grid<T>::load(string name)
     readGridRaw(name, this);
   else if (ext == ".uni")
     readGridUni(name, this);
+  else if (ext == ".mcc")
+    readGridMcc(name, this);
   else if (ext == ".vol")
     readGridVol(name, this);
   else if (ext == ".npz")
@@ -152,6 +154,8 @@ template<class T> void Grid<T>::save(string name)
     writeGridRaw(name, this);
   else if (ext == ".uni")
     writeGridUni(name, this);
+  else if (ext == ".mcc")
+    writeGridMcc(name, this);
   else if (ext == ".vol")
     writeGridVol(name, this);
 #if OPENVDB == 1
@@ -177,6 +181,7 @@ struct CompMinReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &val, Real &minVal)
   {
@@ -202,6 +207,7 @@ struct CompMinReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMinReal");
   };
   void run()
   {
@@ -230,6 +236,7 @@ struct CompMaxReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &val, Real &maxVal)
   {
@@ -255,6 +262,7 @@ struct CompMaxReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMaxReal");
   };
   void run()
   {
@@ -283,6 +291,7 @@ struct CompMinInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<int> &val, int &minVal)
   {
@@ -308,6 +317,7 @@ struct CompMinInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMinInt");
   };
   void run()
   {
@@ -336,6 +346,7 @@ struct CompMaxInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<int> &val, int &maxVal)
   {
@@ -361,6 +372,7 @@ struct CompMaxInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMaxInt");
   };
   void run()
   {
@@ -389,6 +401,7 @@ struct CompMinVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &val, Real &minVal)
   {
@@ -415,6 +428,7 @@ struct CompMinVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMinVec");
   };
   void run()
   {
@@ -443,6 +457,7 @@ struct CompMaxVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &val, Real &maxVal)
   {
@@ -469,6 +484,7 @@ struct CompMaxVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMaxVec");
   };
   void run()
   {
@@ -507,6 +523,7 @@ template<class T> struct knGridSetConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, T val)
   {
@@ -528,6 +545,7 @@ template<class T> struct knGridSetConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridSetConstReal");
   };
   void run()
   {
@@ -548,6 +566,7 @@ template<class T> struct knGridAddConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, T val)
   {
@@ -569,6 +588,7 @@ template<class T> struct knGridAddConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridAddConstReal");
   };
   void run()
   {
@@ -589,6 +609,7 @@ template<class T> struct knGridMultConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, T val)
   {
@@ -610,6 +631,7 @@ template<class T> struct knGridMultConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridMultConst");
   };
   void run()
   {
@@ -631,6 +653,7 @@ template<class T> struct knGridSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<T> &other)
   {
@@ -652,6 +675,7 @@ template<class T> struct knGridSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridSafeDiv");
   };
   void run()
   {
@@ -676,6 +700,7 @@ template<class T> struct knGridClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const T &min, const T &max)
   {
@@ -702,6 +727,7 @@ template<class T> struct knGridClamp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridClamp");
   };
   void run()
   {
@@ -738,6 +764,7 @@ template<class T> struct knGridStomp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const T &threshold)
   {
@@ -759,6 +786,7 @@ template<class T> struct knGridStomp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridStomp");
   };
   void run()
   {
@@ -781,6 +809,7 @@ template<class T> struct knPermuteAxes : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, Grid<T> &self, Grid<T> &target, int axis0, int axis1, int axis2)
@@ -821,6 +850,7 @@ template<class T> struct knPermuteAxes : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knPermuteAxes");
   };
   void run()
   {
@@ -1009,6 +1039,7 @@ struct knCountCells : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, int flag, int bnd, Grid<Real> *mask, int &cnt)
@@ -1057,6 +1088,7 @@ struct knCountCells : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCountCells");
   };
   void run()
   {
@@ -1697,6 +1729,7 @@ struct knResetUvGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &target, const Vec3 *offset)
   {
@@ -1721,6 +1754,7 @@ struct knResetUvGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knResetUvGrid");
   };
   void run()
   {
@@ -1865,6 +1899,7 @@ template<class T> struct knSetBoundary : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<T> &grid, T value, int w)
   {
@@ -1894,6 +1929,7 @@ template<class T> struct knSetBoundary : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundary");
   };
   void run()
   {
@@ -1938,6 +1974,7 @@ template<class T> struct knSetBoundaryNeumann : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<T> &grid, int w)
   {
@@ -1988,6 +2025,7 @@ template<class T> struct knSetBoundaryNeumann : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundaryNeumann");
   };
   void run()
   {
@@ -2033,6 +2071,7 @@ struct knSetBoundaryMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &grid, Vec3 value, int w)
   {
@@ -2067,6 +2106,7 @@ struct knSetBoundaryMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundaryMAC");
   };
   void run()
   {
@@ -2108,6 +2148,7 @@ struct knSetBoundaryMACNorm : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &grid, Vec3 value, int w)
   {
@@ -2139,6 +2180,7 @@ struct knSetBoundaryMACNorm : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundaryMACNorm");
   };
   void run()
   {
@@ -2191,6 +2233,7 @@ struct knGridTotalSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &a, FlagGrid *flags, double &result)
   {
@@ -2226,6 +2269,7 @@ struct knGridTotalSum : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridTotalSum");
   };
   void run()
   {
@@ -2252,6 +2296,7 @@ struct knCountFluidCells : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, FlagGrid &flags, int &numEmpty)
   {
@@ -2277,6 +2322,7 @@ struct knCountFluidCells : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCountFluidCells");
   };
   void run()
   {
@@ -2356,6 +2402,7 @@ struct knGetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &source, Grid<Real> &target, int component)
   {
@@ -2382,6 +2429,7 @@ struct knGetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGetComponent");
   };
   void run()
   {
@@ -2441,6 +2489,7 @@ struct knSetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &source, Grid<Vec3> &target, int component)
   {
@@ -2467,6 +2516,7 @@ struct knSetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetComponent");
   };
   void run()
   {
@@ -2817,6 +2867,7 @@ struct knMarkIsolatedFluidCell : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, FlagGrid &flags, const int mark)
   {
@@ -2839,6 +2890,7 @@ struct knMarkIsolatedFluidCell : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knMarkIsolatedFluidCell");
   };
   void run()
   {
@@ -553,6 +553,15 @@ template<class T> class Grid : public GridBase {
     DEBUG_ONLY(checkIndex(idx));
     return mData[idx];
   }
+  //! raw data pointer, e.g. for vectorized loops
+  inline T *getData()
+  {
+    return mData;
+  }
+  inline const T *getData() const
+  {
+    return mData;
+  }
 
   // interpolated access
   inline T getInterpolated(const Vec3 &pos) const
@@ -1739,6 +1748,7 @@ template<class T, class S> struct gridAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other)
   {
@@ -1760,6 +1770,7 @@ template<class T, class S> struct gridAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridAdd");
   };
   void run()
   {
@@ -1780,6 +1791,7 @@ template<class T, class S> struct gridSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other)
   {
@@ -1801,6 +1813,7 @@ template<class T, class S> struct gridSub : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridSub");
   };
   void run()
   {
@@ -1821,6 +1834,7 @@ template<class T, class S> struct gridMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other)
   {
@@ -1842,6 +1856,7 @@ template<class T, class S> struct gridMult : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridMult");
   };
   void run()
   {
@@ -1862,6 +1877,7 @@ template<class T, class S> struct gridDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other)
   {
@@ -1883,6 +1899,7 @@ template<class T, class S> struct gridDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridDiv");
   };
   void run()
   {
@@ -1903,6 +1920,7 @@ template<class T, class S> struct gridAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const S &other)
   {
@@ -1924,6 +1942,7 @@ template<class T, class S> struct gridAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridAddScalar");
   };
   void run()
   {
@@ -1944,6 +1963,7 @@ template<class T, class S> struct gridMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const S &other)
   {
@@ -1965,6 +1985,7 @@ template<class T, class S> struct gridMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridMultScalar");
   };
   void run()
   {
@@ -1986,6 +2007,7 @@ template<class T, class S> struct gridScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<T> &other, const S &factor)
   {
@@ -2012,6 +2034,7 @@ template<class T, class S> struct gridScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridScaledAdd");
   };
   void run()
   {
@@ -2034,6 +2057,7 @@ template<class T> struct gridSetConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &grid, T value)
   {
@@ -2055,6 +2079,7 @@ template<class T> struct gridSetConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridSetConst");
   };
   void run()
   {
@@ -2159,6 +2184,7 @@ template<class S> struct knInterpolateGridTempl : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2205,6 +2231,7 @@ template<class S> struct knInterpolateGridTempl : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knInterpolateGridTempl");
   };
   void run()
   {
@@ -158,6 +158,7 @@ struct kn4dMinReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<Real> &val, Real &minVal)
   {
@@ -183,6 +184,7 @@ struct kn4dMinReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMinReal");
   };
   void run()
   {
@@ -211,6 +213,7 @@ struct kn4dMaxReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<Real> &val, Real &maxVal)
   {
@@ -236,6 +239,7 @@ struct kn4dMaxReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMaxReal");
   };
   void run()
   {
@@ -264,6 +268,7 @@ struct kn4dMinInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<int> &val, int &minVal)
   {
@@ -289,6 +294,7 @@ struct kn4dMinInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMinInt");
   };
   void run()
   {
@@ -317,6 +323,7 @@ struct kn4dMaxInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<int> &val, int &maxVal)
   {
@@ -342,6 +349,7 @@ struct kn4dMaxInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMaxInt");
   };
   void run()
   {
@@ -370,6 +378,7 @@ template<class VEC> struct kn4dMinVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<VEC> &val, Real &minVal)
   {
@@ -396,6 +405,7 @@ template<class VEC> struct kn4dMinVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMinVec");
   };
   void run()
   {
@@ -424,6 +434,7 @@ template<class VEC> struct kn4dMaxVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<VEC> &val, Real &maxVal)
   {
@@ -450,6 +461,7 @@ template<class VEC> struct kn4dMaxVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMaxVec");
   };
   void run()
   {
@@ -494,6 +506,7 @@ template<class T> struct kn4dSetConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T val)
   {
@@ -515,6 +528,7 @@ template<class T> struct kn4dSetConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dSetConstReal");
   };
   void run()
   {
@@ -535,6 +549,7 @@ template<class T> struct kn4dAddConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T val)
   {
@@ -556,6 +571,7 @@ template<class T> struct kn4dAddConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dAddConstReal");
   };
   void run()
   {
@@ -576,6 +592,7 @@ template<class T> struct kn4dMultConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T val)
   {
@@ -597,6 +614,7 @@ template<class T> struct kn4dMultConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMultConst");
   };
   void run()
   {
@@ -617,6 +635,7 @@ template<class T> struct kn4dClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T min, T max)
   {
@@ -643,6 +662,7 @@ template<class T> struct kn4dClamp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dClamp");
   };
   void run()
   {
@@ -783,6 +803,7 @@ struct knGetComp4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid4d<Vec4> &src, Grid4d<Real> &dst, int c)
   {
@@ -809,6 +830,7 @@ struct knGetComp4d : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGetComp4d");
   };
   void run()
   {
@@ -832,6 +854,7 @@ struct knSetComp4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid4d<Real> &src, Grid4d<Vec4> &dst, int c)
   {
@@ -858,6 +881,7 @@ struct knSetComp4d : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetComp4d");
   };
   void run()
   {
@@ -958,6 +982,7 @@ template<class T> struct knSetBnd4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, int t, Grid4d<T> &grid, T value, int w)
   {
@@ -990,6 +1015,7 @@ template<class T> struct knSetBnd4d : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knSetBnd4d");
   };
   void run()
   {
@@ -1048,6 +1074,7 @@ template<class T> struct knSetBnd4dNeumann : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, int t, Grid4d<T> &grid, int w)
   {
@@ -1107,6 +1134,7 @@ template<class T> struct knSetBnd4dNeumann : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knSetBnd4dNeumann");
   };
   void run()
   {
@@ -1340,6 +1368,7 @@ template<class S> struct knSetRegion4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, int t, Grid4d<S> &dst, Vec4 start, Vec4 end, S value)
   {
@@ -1378,6 +1407,7 @@ template<class S> struct knSetRegion4d : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knSetRegion4d");
   };
   void run()
   {
@@ -1629,6 +1659,7 @@ template<class S> struct knInterpol4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1671,6 +1702,7 @@ template<class S> struct knInterpol4d : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knInterpol4d");
   };
   void run()
   {
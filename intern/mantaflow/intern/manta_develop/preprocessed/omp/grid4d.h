@@ -1026,6 +1026,7 @@ template<class T, class S> struct Grid4dAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other)
   {
@@ -1047,6 +1048,7 @@ template<class T, class S> struct Grid4dAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dAdd");
   };
   void run()
   {
@@ -1067,6 +1069,7 @@ template<class T, class S> struct Grid4dSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other)
   {
@@ -1088,6 +1091,7 @@ template<class T, class S> struct Grid4dSub : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dSub");
   };
   void run()
   {
@@ -1108,6 +1112,7 @@ template<class T, class S> struct Grid4dMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other)
   {
@@ -1129,6 +1134,7 @@ template<class T, class S> struct Grid4dMult : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dMult");
   };
   void run()
   {
@@ -1149,6 +1155,7 @@ template<class T, class S> struct Grid4dDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other)
   {
@@ -1170,6 +1177,7 @@ template<class T, class S> struct Grid4dDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dDiv");
   };
   void run()
   {
@@ -1190,6 +1198,7 @@ template<class T, class S> struct Grid4dAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const S &other)
   {
@@ -1211,6 +1220,7 @@ template<class T, class S> struct Grid4dAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dAddScalar");
   };
   void run()
   {
@@ -1231,6 +1241,7 @@ template<class T, class S> struct Grid4dMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const S &other)
   {
@@ -1252,6 +1263,7 @@ template<class T, class S> struct Grid4dMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dMultScalar");
   };
   void run()
   {
@@ -1273,6 +1285,7 @@ template<class T, class S> struct Grid4dScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<T> &other, const S &factor)
   {
@@ -1299,6 +1312,7 @@ template<class T, class S> struct Grid4dScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dScaledAdd");
   };
   void run()
   {
@@ -1321,6 +1335,7 @@ template<class T> struct Grid4dSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<T> &other)
   {
@@ -1342,6 +1357,7 @@ template<class T> struct Grid4dSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dSafeDiv");
   };
   void run()
   {
@@ -1362,6 +1378,7 @@ template<class T> struct Grid4dSetConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T value)
   {
@@ -1383,6 +1400,7 @@ template<class T> struct Grid4dSetConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dSetConst");
   };
   void run()
   {
@@ -1483,6 +1501,7 @@ template<class S> struct KnInterpolateGrid4dTempl : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1529,6 +1548,7 @@ template<class S> struct KnInterpolateGrid4dTempl : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("KnInterpolateGrid4dTempl");
   };
   void run()
   {
@@ -21,6 +21,7 @@
 #include "kernel.h"
 #include "mcubes.h"
 #include "mesh.h"
+#include "tilemask.h"
 #include <stack>
 
 using namespace std;
@@ -54,6 +55,7 @@ struct InitFmIn : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -110,6 +112,7 @@ struct InitFmIn : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("InitFmIn");
   };
   void run()
   {
@@ -161,6 +164,7 @@ struct InitFmOut : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -215,6 +219,7 @@ struct InitFmOut : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("InitFmOut");
   };
   void run()
   {
@@ -268,6 +273,7 @@ struct SetUninitialized : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -325,6 +331,7 @@ struct SetUninitialized : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SetUninitialized");
   };
   void run()
   {
@@ -405,6 +412,7 @@ struct KnJoin : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Real> &a, const Grid<Real> &b)
   {
@@ -426,6 +434,7 @@ struct KnJoin : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnJoin");
   };
   void run()
   {
@@ -452,6 +461,7 @@ struct KnSubtract : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Real> &a, const Grid<Real> &b)
   {
@@ -474,6 +484,7 @@ struct KnSubtract : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnSubtract");
   };
   void run()
   {
@@ -613,6 +624,474 @@ static void doReinitMarch(Grid<Real> &phi,
   SetUninitialized(flags, fmFlags, phi, +maxTime + 1., ignoreWalls, obstacleType);
 }
 
+//************************************************************************
+// Parallel fast sweeping
+
+static const int SweepIgnore = 0;  // not part of the current side
+static const int SweepFixed = 1;   // known value, input of the current side
+static const int SweepFree = 2;    // distance is computed
+static const Real SweepInf = 1e10;
+
+//! set up one side (dir -1 inside, +1 outside) for sweeping, u holds dir * phi
+
+struct knInitSweep : public KernelBase {
+  knInitSweep(const FlagGrid &flags,
+              Grid<Real> &phi,
+              Grid<int> &state,
+              Grid<Real> &u,
+              const Real dir,
+              const bool correctOuterLayer,
+              const bool ignoreWalls,
+              const int obstacleType)
+      : KernelBase(&flags, 0),
+        flags(flags),
+        phi(phi),
+        state(state),
+        u(u),
+        dir(dir),
+        correctOuterLayer(correctOuterLayer),
+        ignoreWalls(ignoreWalls),
+        obstacleType(obstacleType)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(int i,
+                 int j,
+                 int k,
+                 const FlagGrid &flags,
+                 Grid<Real> &phi,
+                 Grid<int> &state,
+                 Grid<Real> &u,
+                 const Real dir,
+                 const bool correctOuterLayer,
+                 const bool ignoreWalls,
+                 const int obstacleType) const
+  {
+    const IndexInt idx = flags.index(i, j, k);
+    // the outer layer is not marched either, see knFinishSweep
+    if (!flags.isInBounds(Vec3i(i, j, k), 1)) {
+      state[idx] = SweepIgnore;
+      u[idx] = SweepInf;
+      return;
+    }
+    if (ignoreWalls && (flags[idx] & obstacleType) != 0) {
+      // as in InitFmOut, obstacle values are cleared for the outward pass
+      if (dir > 0)
+        phi[idx] = 0.;
+      state[idx] = SweepIgnore;
+      u[idx] = SweepInf;
+      return;
+    }
+    const Real v = phi[idx];
+    if ((dir < 0) != (v < 0.)) {
+      // other side, the inside distances are the input of the outward pass
+      state[idx] = (dir > 0) ? SweepFixed : SweepIgnore;
+      u[idx] = (dir > 0) ? v : SweepInf;
+      return;
+    }
+
+    // cells at the interface keep their value, unless the outer layer is recomputed
+    bool atInterface = false;
+    if (dir < 0 || !correctOuterLayer) {
+      const int numNb = phi.is3D() ? 6 : 4;
+      for (int nb = 0; nb < numNb && !atInterface; nb++) {
+        const Vec3i pn(Vec3i(i, j, k) + neighbors[nb]);
+        if (!phi.isInBounds(pn, 1))
+          continue;
+        if (ignoreWalls && (flags(pn) & obstacleType) != 0)
+          continue;
+        atInterface = (dir < 0) ? (phi(pn) >= 0.) : (phi(pn) < 0.);
+      }
+    }
+    state[idx] = atInterface ? SweepFixed : SweepFree;
+    u[idx] = atInterface ? dir * v : SweepInf;
+  }
+  inline const FlagGrid &getArg0()
+  {
+    return flags;
+  }
+  typedef FlagGrid type0;
+  inline Grid<Real> &getArg1()
+  {
+    return phi;
+  }
+  typedef Grid<Real> type1;
+  inline Grid<int> &getArg2()
+  {
+    return state;
+  }
+  typedef Grid<int> type2;
+  inline Grid<Real> &getArg3()
+  {
+    return u;
+  }
+  typedef Grid<Real> type3;
+  inline const Real &getArg4()
+  {
+    return dir;
+  }
+  typedef Real type4;
+  inline const bool &getArg5()
+  {
+    return correctOuterLayer;
+  }
+  typedef bool type5;
+  inline const bool &getArg6()
+  {
+    return ignoreWalls;
+  }
+  typedef bool type6;
+  inline const int &getArg7()
+  {
+    return obstacleType;
+  }
+  typedef int type7;
+  void runMessage()
+  {
+    debMsg("Executing kernel knInitSweep ", 3);
+    debMsg("Kernel range"
+               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+           4);
+    profileBegin("knInitSweep");
+  };
+  void run()
+  {
+    const int _maxX = maxX;
+    const int _maxY = maxY;
+    if (maxZ > 1) {
+
+#pragma omp parallel
+      {
+
+#pragma omp for
+        for (int k = minZ; k < maxZ; k++)
+          for (int j = 0; j < _maxY; j++)
+            for (int i = 0; i < _maxX; i++)
+              op(i, j, k, flags, phi, state, u, dir, correctOuterLayer, ignoreWalls, obstacleType);
+      }
+    }
+    else {
+      const int k = 0;
+#pragma omp parallel
+      {
+
+#pragma omp for
+        for (int j = 0; j < _maxY; j++)
+          for (int i = 0; i < _maxX; i++)
+            op(i, j, k, flags, phi, state, u, dir, correctOuterLayer, ignoreWalls, obstacleType);
+      }
+    }
+  }
+  const FlagGrid &flags;
+  Grid<Real> &phi;
+  Grid<int> &state;
+  Grid<Real> &u;
+  const Real dir;
+  const bool correctOuterLayer;
+  const bool ignoreWalls;
+  const int obstacleType;
+};
+
+//! write back the distances of one side, cells that were not reached get maxTime + 1 as in
+//! SetUninitialized
+
+struct knFinishSweep : public KernelBase {
+  knFinishSweep(const FlagGrid &flags,
+                Grid<Real> &phi,
+                const Grid<int> &state,
+                const Grid<Real> &u,
+                const Real dir,
+                const Real maxTime)
+      : KernelBase(&flags, 0),
+        flags(flags),
+        phi(phi),
+        state(state),
+        u(u),
+        dir(dir),
+        maxTime(maxTime)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(int i,
+                 int j,
+                 int k,
+                 const FlagGrid &flags,
+                 Grid<Real> &phi,
+                 const Grid<int> &state,
+                 const Grid<Real> &u,
+                 const Real dir,
+                 const Real maxTime) const
+  {
+    const IndexInt idx = flags.index(i, j, k);
+    if (state[idx] == SweepFree)
+      phi[idx] = dir * ((u[idx] < SweepInf) ? u[idx] : maxTime + 1);
+    if (flags.isInBounds(Vec3i(i, j, k), 1))
+      return;
+
+    // outer layer copies the closest inner cell, as SetLevelsetBoundaries
+    const Vec3i pn(clamp(i, 1, maxX - 2),
+                   clamp(j, 1, maxY - 2),
+                   phi.is3D() ? clamp(k, 1, maxZ - 2) : k);
+    const IndexInt nidx = flags.index(pn);
+    if (state[nidx] == SweepFree)
+      phi[idx] = dir * ((u[nidx] < SweepInf) ? u[nidx] : maxTime + 1);
+    else
+      phi[idx] = phi[nidx];
+  }
+  inline const FlagGrid &getArg0()
+  {
+    return flags;
+  }
+  typedef FlagGrid type0;
+  inline Grid<Real> &getArg1()
+  {
+    return phi;
+  }
+  typedef Grid<Real> type1;
+  inline const Grid<int> &getArg2()
+  {
+    return state;
+  }
+  typedef Grid<int> type2;
+  inline const Grid<Real> &getArg3()
+  {
+    return u;
+  }
+  typedef Grid<Real> type3;
+  inline const Real &getArg4()
+  {
+    return dir;
+  }
+  typedef Real type4;
+  inline const Real &getArg5()
+  {
+    return maxTime;
+  }
+  typedef Real type5;
+  void runMessage()
+  {
+    debMsg("Executing kernel knFinishSweep ", 3);
+    debMsg("Kernel range"
+               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+           4);
+    profileBegin("knFinishSweep");
+  };
+  void run()
+  {
+    const int _maxX = maxX;
+    const int _maxY = maxY;
+    if (maxZ > 1) {
+
+#pragma omp parallel
+      {
+
+#pragma omp for
+        for (int k = minZ; k < maxZ; k++)
+          for (int j = 0; j < _maxY; j++)
+            for (int i = 0; i < _maxX; i++)
+              op(i, j, k, flags, phi, state, u, dir, maxTime);
+      }
+    }
+    else {
+      const int k = 0;
+#pragma omp parallel
+      {
+
+#pragma omp for
+        for (int j = 0; j < _maxY; j++)
+          for (int i = 0; i < _maxX; i++)
+            op(i, j, k, flags, phi, state, u, dir, maxTime);
+      }
+    }
+  }
+  const FlagGrid &flags;
+  Grid<Real> &phi;
+  const Grid<int> &state;
+  const Grid<Real> &u;
+  const Real dir;
+  const Real maxTime;
+};
+
+//! Godunov update for |grad u| = 1 from the smallest neighbour value along each axis, same
+//! closed forms as FastMarch::calculateDistance, but only with the upwind axes
+static inline Real sweepUpdate(Real a, Real b, Real c)
+{
+  if (a > b)
+    std::swap(a, b);
+  if (b > c)
+    std::swap(b, c);
+  if (a > b)
+    std::swap(a, b);
+  Real t = a + 1.;
+  if (t > b) {
+    t = 0.5 * (a + b + sqrt(std::max(Real(0), Real(2. - (b - a) * (b - a)))));
+    if (t > c) {
+      const Real csqrt = std::max(
+          Real(0), Real(-2. * (a * a + b * b - b * c + c * c - a * (b + c)) + 3.));
+      t = 0.333333 * (a + b + c + sqrt(csqrt));
+    }
+  }
+  return t;
+}
+
+//! one iteration of block parallel fast sweeping: each tile runs Gauss-Seidel sweeps in all
+//! orderings, values outside of the tile are taken from the previous iteration. tiles are
+//! independent, the result does not depend on the thread count. only tiles next to a tile that
+//! changed by more than tolerance in the last iteration (dirty) are swept again
+static bool sweepTiles(Grid<Real> &u,
+                       Grid<Real> &prev,
+                       const Grid<int> &state,
+                       const TileMask &mask,
+                       Real maxTime,
+                       Real tolerance,
+                       std::vector<char> &dirty)
+{
+  const std::vector<int> &tiles = mask.getActiveTiles();
+  const Vec3i res = mask.getTileRes();
+  std::vector<char> update(dirty.size(), 0);
+  for (size_t n = 0; n < tiles.size(); n++) {
+    if (!dirty[tiles[n]])
+      continue;
+    const Vec3i t = mask.tileCoord(tiles[n]);
+    for (int k = std::max(t.z - 1, 0); k <= std::min(t.z + 1, res.z - 1); k++)
+      for (int j = std::max(t.y - 1, 0); j <= std::min(t.y + 1, res.y - 1); j++)
+        for (int i = std::max(t.x - 1, 0); i <= std::min(t.x + 1, res.x - 1); i++)
+          update[i + res.x * (j + res.y * k)] = 1;
+  }
+
+  mask.forEachActiveTile([&](const Vec3i &lo, const Vec3i &hi) {
+    if (!dirty[mask.tileIndex(lo.x, lo.y, lo.z)])
+      return;
+    for (int k = lo.z; k < hi.z; k++)
+      for (int j = lo.y; j < hi.y; j++)
+        for (int i = lo.x; i < hi.x; i++)
+          prev(i, j, k) = u(i, j, k);
+  });
+
+  const Vec3i size = u.getSize();
+  const bool is3D = u.is3D();
+  const double change = mask.maxActiveTiles([&](const Vec3i &lo, const Vec3i &hi) {
+    const int tile = mask.tileIndex(lo.x, lo.y, lo.z);
+    dirty[tile] = 0;
+    if (!update[tile])
+      return 0.;
+
+    // local copy of the tile with a one cell halo from the previous iteration
+    const int N = TileMask::TILE_SIZE + 2;
+    Real buf[N * N * N];
+    bool isFree[N * N * N];
+    const Vec3i n(hi.x - lo.x + 2, hi.y - lo.y + 2, is3D ? hi.z - lo.z + 2 : 1);
+    const int sy = n.x, sz = n.x * n.y;
+    const int kOff = is3D ? 1 : 0;
+    for (int kk = 0; kk < n.z; kk++)
+      for (int jj = 0; jj < n.y; jj++)
+        for (int ii = 0; ii < n.x; ii++) {
+          const int i = lo.x + ii - 1, j = lo.y + jj - 1, k = lo.z + kk - kOff;
+          Real v = SweepInf;
+          bool inTile = false;
+          int s = SweepIgnore;
+          if (i >= 0 && j >= 0 && k >= 0 && i < size.x && j < size.y && k < size.z) {
+            const IndexInt idx = u.index(i, j, k);
+            inTile = i >= lo.x && i < hi.x && j >= lo.y && j < hi.y && k >= lo.z && k < hi.z;
+            s = state[idx];
+            if (s != SweepIgnore)
+              v = inTile ? u[idx] : prev[idx];
+          }
+          buf[ii + sy * jj + sz * kk] = v;
+          isFree[ii + sy * jj + sz * kk] = inTile && s == SweepFree;
+        }
+
+    for (int order = 0; order < (is3D ? 8 : 4); order++) {
+      for (int kk = lo.z; kk < hi.z; kk++) {
+        const int k = (order & 4) ? hi.z - 1 - (kk - lo.z) : kk;
+        for (int jj = lo.y; jj < hi.y; jj++) {
+          const int j = (order & 2) ? hi.y - 1 - (jj - lo.y) : jj;
+          for (int ii = lo.x; ii < hi.x; ii++) {
+            const int i = (order & 1) ? hi.x - 1 - (ii - lo.x) : ii;
+            const int c = (i - lo.x + 1) + sy * (j - lo.y + 1) + sz * (k - lo.z + kOff);
+            if (!isFree[c])
+              continue;
+            const Real a = std::min(buf[c - 1], buf[c + 1]);
+            const Real b = std::min(buf[c - sy], buf[c + sy]);
+            const Real cz = is3D ? std::min(buf[c - sz], buf[c + sz]) : SweepInf;
+            // as in FastMarch::addToList, cells next to the band still get a value
+            if (std::min(a, std::min(b, cz)) > maxTime)
+              continue;
+            buf[c] = std::min(buf[c], sweepUpdate(a, b, cz));
+          }
+        }
+      }
+    }
+
+    double tileChange = 0.;
+    for (int k = lo.z; k < hi.z; k++)
+      for (int j = lo.y; j < hi.y; j++)
+        for (int i = lo.x; i < hi.x; i++) {
+          const int c = (i - lo.x + 1) + sy * (j - lo.y + 1) + sz * (k - lo.z + kOff);
+          const IndexInt idx = u.index(i, j, k);
+          if (!isFree[c] || buf[c] >= u[idx])
+            continue;
+          const Real v = buf[c];
+          tileChange = std::max(tileChange, (u[idx] >= SweepInf) ? 1. : (double)(u[idx] - v));
+          u[idx] = v;
+        }
+    dirty[tile] = (tileChange > tolerance);
+    return tileChange;
+  });
+  return change > tolerance;
+}
+
+//! parallel alternative to doReinitMarch, same inward and outward passes, but the distances
+//! of each side are computed by fast sweeping within the narrow band of maxTime cells
+static void doReinitSweep(Grid<Real> &phi,
+                          const FlagGrid &flags,
+                          Real maxTime,
+                          bool ignoreWalls,
+                          bool correctOuterLayer,
+                          int obstacleType)
+{
+  const int maxIter = 100;
+  const Real tolerance = 1e-4;  // in cells
+  Grid<int> state(phi.getParent());
+  Grid<Real> u(phi.getParent()), prev(phi.getParent());
+  TileMask mask(phi.getSize());
+
+  for (int pass = 0; pass < 2; pass++) {
+    // inside first, the outward pass starts from the new inside values
+    const Real dir = (pass == 0) ? -1. : 1.;
+    knInitSweep(flags, phi, state, u, dir, correctOuterLayer, ignoreWalls, obstacleType);
+    prev.copyFrom(u);
+
+    mask.clear();
+    mask.activateCells(
+        [&](int i, int j, int k) {
+          if (state(i, j, k) != SweepFree)
+            return false;
+          for (int nb = 0; nb < (phi.is3D() ? 6 : 4); nb++) {
+            const Vec3i pn(Vec3i(i, j, k) + neighbors[nb]);
+            if (state.isInBounds(pn) && state(pn) == SweepFixed)
+              return true;
+          }
+          return false;
+        },
+        (int)ceil(maxTime) + 1);
+
+    std::vector<char> dirty(mask.numTiles(), 1);
+    int iter = 0;
+    while (iter < maxIter && sweepTiles(u, prev, state, mask, maxTime, tolerance, dirty))
+      iter++;
+    debMsg("Fast sweeping " << (pass == 0 ? "inside" : "outside") << ", " << iter + 1
+                            << " iterations over " << mask.numActiveTiles() << " tiles",
+           2);
+
+    knFinishSweep(flags, phi, state, u, dir, maxTime);
+  }
+}
+
 //! call for levelset grids & external real grids
 
 void LevelsetGrid::reinitMarching(const FlagGrid &flags,
@@ -620,8 +1099,16 @@ void LevelsetGrid::reinitMarching(const FlagGrid &flags,
                                   MACGrid *velTransport,
                                   bool ignoreWalls,
                                   bool correctOuterLayer,
-                                  int obstacleType)
+                                  int obstacleType,
+                                  int method)
 {
+  if (method == RdFastSweeping) {
+    if (!velTransport) {
+      doReinitSweep(*this, flags, maxTime, ignoreWalls, correctOuterLayer, obstacleType);
+      return;
+    }
+    debMsg("LevelsetGrid::reinitMarching: velocity transport needs fast marching", 1);
+  }
   doReinitMarch(*this, flags, maxTime, velTransport, ignoreWalls, correctOuterLayer, obstacleType);
 }
 
@@ -755,7 +1242,214 @@ void LevelsetGrid::fillHoles(int maxDepth, int boundaryWidth)
   }
 }
 
+//************************************************************************
+// Parallel marching cubes
+
+//! size of the blocks of cubes that are skipped if they do not contain the surface, the z slabs
+//! that are meshed in parallel are one block thick
+static const int McBlock = 8;
+
+//! axis and offset within the cube of the grid edge of each cube edge, x and y edges lie in the
+//! lower (dz 0) or upper (dz 1) plane of a cube layer, z edges belong to a single layer
+static const int mcEdgeAxis[12] = {0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2};
+static const int mcEdgeDx[12] = {0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0};
+static const int mcEdgeDy[12] = {0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1};
+static const int mcEdgeDz[12] = {0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0};
+
+//! vertices and triangles of one z slab, node indices are local to the slab
+struct McSlab {
+  std::vector<Node> nodes;
+  std::vector<Triangle> tris;
+  //! (edge key, local node) of the x and y edge vertices on the lower and upper slab plane
+  std::vector<std::pair<IndexInt, int>> lower, upper;
+  //! local node in the previous slab that a lower plane vertex is shared with, or -1
+  std::vector<int> shared;
+  //! index of each local node in the final mesh
+  std::vector<int> remap;
+  int numShared;
+};
+
+//! flag all blocks of cubes that contain both values below and above the iso value
+static void mcActiveBlocks(const LevelsetGrid &phi,
+                           Real isoValue,
+                           const Vec3i &blockRes,
+                           std::vector<char> &active)
+{
+  const Vec3i size = phi.getSize();
+  active.assign((size_t)blockRes.x * blockRes.y * blockRes.z, 0);
+  parallelForRange(
+      active.size(),
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt b = begin; b < end; b++) {
+          const int bx = b % blockRes.x, by = (b / blockRes.x) % blockRes.y,
+                    bz = b / (blockRes.x * blockRes.y);
+          // cubes of the block plus their upper corner points
+          const Vec3i lo(bx * McBlock, by * McBlock, bz * McBlock);
+          const Vec3i hi(std::min(lo.x + McBlock, size.x - 1),
+                         std::min(lo.y + McBlock, size.y - 1),
+                         std::min(lo.z + McBlock, size.z - 1));
+          bool in = false, out = false;
+          for (int k = lo.z; k <= hi.z && !(in && out); k++)
+            for (int j = lo.y; j <= hi.y; j++)
+              for (int i = lo.x; i <= hi.x; i++) {
+                if (-phi(i, j, k) < isoValue)
+                  in = true;
+                else
+                  out = true;
+              }
+          active[b] = in && out;
+        }
+      },
+      16);
+}
+
+//! marching cubes for the cube layers [k0, k1). layers are visited in order, each one with
+//! index planes for the vertices of its edges, so memory stays at a few xy planes per slab
+static void mcMeshSlab(const LevelsetGrid &phi,
+                       Real isoValue,
+                       int k0,
+                       int k1,
+                       const Vec3i &blockRes,
+                       Real invalidTime,
+                       const std::vector<char> &active,
+                       McSlab &slab)
+{
+  const Vec3i size = phi.getSize();
+  const IndexInt planeSize = (IndexInt)size.x * size.y;
+
+  // vertex index + 1 of the x and y edges in both planes of the current layer and of the z
+  // edges of the layer. touched entries are reset before a plane is reused
+  std::vector<int> edgeX[2], edgeY[2], edgeZ(planeSize, 0);
+  std::vector<IndexInt> touched[2], touchedZ;
+  for (int p = 0; p < 2; p++) {
+    edgeX[p].assign(planeSize, 0);
+    edgeY[p].assign(planeSize, 0);
+  }
+
+  const int bz = k0 / McBlock;
+  for (int k = k0; k < k1; k++) {
+    const int lo = (k - k0) & 1;
+    int *edgeSlot[3][2] = {{&edgeX[lo][0], &edgeX[1 - lo][0]},
+                           {&edgeY[lo][0], &edgeY[1 - lo][0]},
+                           {&edgeZ[0], &edgeZ[0]}};
+    std::vector<IndexInt> *touchedList[3][2] = {
+        {&touched[lo], &touched[1 - lo]}, {&touched[lo], &touched[1 - lo]}, {&touchedZ, &touchedZ}};
+
+    for (int j = 0; j < size.y - 1; j++) {
+      const int by = j / McBlock;
+      for (int bx = 0; bx < blockRes.x; bx++) {
+        if (!active[bx + (IndexInt)blockRes.x * (by + (IndexInt)blockRes.y * bz)])
+          continue;
+        for (int i = bx * McBlock, iEnd = std::min(i + McBlock, size.x - 1); i < iEnd; i++) {
+          Real value[8] = {phi(i, j, k),
+                           phi(i + 1, j, k),
+                           phi(i + 1, j + 1, k),
+                           phi(i, j + 1, k),
+                           phi(i, j, k + 1),
+                           phi(i + 1, j, k + 1),
+                           phi(i + 1, j + 1, k + 1),
+                           phi(i, j + 1, k + 1)};
+
+          // build lookup index, check for invalid times
+          bool skip = false;
+          int cubeIdx = 0;
+          for (int l = 0; l < 8; l++) {
+            value[l] *= -1;
+            if (-value[l] <= invalidTime)
+              skip = true;
+            if (value[l] < isoValue)
+              cubeIdx |= 1 << l;
+          }
+          if (skip || (mcEdgeTable[cubeIdx] == 0))
+            continue;
+
+          const Vec3 pos[8] = {Vec3(i, j, k),
+                               Vec3(i + 1, j, k),
+                               Vec3(i + 1, j + 1, k),
+                               Vec3(i, j + 1, k),
+                               Vec3(i, j, k + 1),
+                               Vec3(i + 1, j, k + 1),
+                               Vec3(i + 1, j + 1, k + 1),
+                               Vec3(i, j + 1, k + 1)};
+
+          int triIndices[12];
+          for (int e = 0; e < 12; e++) {
+            if (!(mcEdgeTable[cubeIdx] & (1 << e)))
+              continue;
+            const int axis = mcEdgeAxis[e], dz = mcEdgeDz[e];
+            const IndexInt p = (i + mcEdgeDx[e]) + (IndexInt)size.x * (j + mcEdgeDy[e]);
+            int &slot = edgeSlot[axis][dz][p];
+
+            // vertex already calculated ?
+            if (slot != 0) {
+              triIndices[e] = slot - 1;
+              continue;
+            }
+
+            // interpolate edge
+            const int e1 = mcEdges[e * 2];
+            const int e2 = mcEdges[e * 2 + 1];
+            const Vec3 p1 = pos[e1];        // scalar field pos 1
+            const Vec3 p2 = pos[e2];        // scalar field pos 2
+            const float valp1 = value[e1];  // scalar field val 1
+            const float valp2 = value[e2];  // scalar field val 2
+            const float mu = (isoValue - valp1) / (valp2 - valp1);
+
+            // init isolevel vertex
+            Node vertex;
+            vertex.pos = p1 + (p2 - p1) * mu + Vec3(Real(0.5));
+            vertex.normal = getNormalized(
+                getGradient(
+                    phi, i + cubieOffsetX[e1], j + cubieOffsetY[e1], k + cubieOffsetZ[e1]) *
+                    (1.0 - mu) +
+                getGradient(
+                    phi, i + cubieOffsetX[e2], j + cubieOffsetY[e2], k + cubieOffsetZ[e2]) *
+                    (mu));
+
+            triIndices[e] = (int)slab.nodes.size();
+            slab.nodes.push_back(vertex);
+            slot = triIndices[e] + 1;
+            touchedList[axis][dz]->push_back(p);
+
+            // x and y edges on the slab planes may also be created by the neighboring slab
+            if (axis != 2) {
+              const IndexInt key = 2 * p + axis;
+              if (k + dz == k0 && k0 > 0)
+                slab.lower.push_back(std::make_pair(key, triIndices[e]));
+              else if (k + dz == k1 && k1 < size.z - 1)
+                slab.upper.push_back(std::make_pair(key, triIndices[e]));
+            }
+          }
+
+          // Create the triangles...
+          for (int e = 0; mcTriTable[cubeIdx][e] != -1; e += 3) {
+            slab.tris.push_back(Triangle(triIndices[mcTriTable[cubeIdx][e + 0]],
+                                         triIndices[mcTriTable[cubeIdx][e + 1]],
+                                         triIndices[mcTriTable[cubeIdx][e + 2]]));
+          }
+        }
+      }
+    }
+
+    // the upper plane becomes the lower one of the next layer, clear the old lower plane
+    for (size_t n = 0; n < touched[lo].size(); n++) {
+      edgeX[lo][touched[lo][n]] = 0;
+      edgeY[lo][touched[lo][n]] = 0;
+    }
+    touched[lo].clear();
+    for (size_t n = 0; n < touchedZ.size(); n++)
+      edgeZ[touchedZ[n]] = 0;
+    touchedZ.clear();
+  }
+
+  std::sort(slab.lower.begin(), slab.lower.end());
+  std::sort(slab.upper.begin(), slab.upper.end());
+}
+
 //! run marching cubes to create a mesh for the 0-levelset
+/*! z slabs of cubes are meshed in parallel, vertices on the plane between two slabs are merged
+ *  into the ones of the lower slab. blocks of cubes without a sign change are skipped. the
+ *  result does not depend on the number of threads */
 void LevelsetGrid::createMesh(Mesh &mesh)
 {
   assertMsg(is3D(), "Only 3D grids supported so far");
@@ -765,103 +1459,97 @@ void LevelsetGrid::createMesh(Mesh &mesh)
   const Real invalidTime = invalidTimeValue();
   const Real isoValue = 1e-4;
 
-  // create some temp grids
-  Grid<int> edgeVX(mParent);
-  Grid<int> edgeVY(mParent);
-  Grid<int> edgeVZ(mParent);
-
-  for (int i = 0; i < mSize.x - 1; i++)
-    for (int j = 0; j < mSize.y - 1; j++)
-      for (int k = 0; k < mSize.z - 1; k++) {
-        Real value[8] = {get(i, j, k),
-                         get(i + 1, j, k),
-                         get(i + 1, j + 1, k),
-                         get(i, j + 1, k),
-                         get(i, j, k + 1),
-                         get(i + 1, j, k + 1),
-                         get(i + 1, j + 1, k + 1),
-                         get(i, j + 1, k + 1)};
-
-        // build lookup index, check for invalid times
-        bool skip = false;
-        int cubeIdx = 0;
-        for (int l = 0; l < 8; l++) {
-          value[l] *= -1;
-          if (-value[l] <= invalidTime)
-            skip = true;
-          if (value[l] < isoValue)
-            cubeIdx |= 1 << l;
+  const Vec3i blockRes((mSize.x - 1 + McBlock - 1) / McBlock,
+                       (mSize.y - 1 + McBlock - 1) / McBlock,
+                       (mSize.z - 1 + McBlock - 1) / McBlock);
+  std::vector<char> active;
+  mcActiveBlocks(*this, isoValue, blockRes, active);
+
+  const int numSlabs = blockRes.z;
+  std::vector<McSlab> slabs(numSlabs);
+  parallelForRange(
+      numSlabs,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt s = begin; s < end; s++) {
+          const int k0 = s * McBlock, k1 = std::min(k0 + McBlock, mSize.z - 1);
+          mcMeshSlab(*this, isoValue, k0, k1, blockRes, invalidTime, active, slabs[s]);
         }
-        if (skip || (mcEdgeTable[cubeIdx] == 0))
-          continue;
-
-        // where to look up if this point already exists
-        int triIndices[12];
-        int *eVert[12] = {&edgeVX(i, j, k),
-                          &edgeVY(i + 1, j, k),
-                          &edgeVX(i, j + 1, k),
-                          &edgeVY(i, j, k),
-                          &edgeVX(i, j, k + 1),
-                          &edgeVY(i + 1, j, k + 1),
-                          &edgeVX(i, j + 1, k + 1),
-                          &edgeVY(i, j, k + 1),
-                          &edgeVZ(i, j, k),
-                          &edgeVZ(i + 1, j, k),
-                          &edgeVZ(i + 1, j + 1, k),
-                          &edgeVZ(i, j + 1, k)};
-
-        const Vec3 pos[9] = {Vec3(i, j, k),
-                             Vec3(i + 1, j, k),
-                             Vec3(i + 1, j + 1, k),
-                             Vec3(i, j + 1, k),
-                             Vec3(i, j, k + 1),
-                             Vec3(i + 1, j, k + 1),
-                             Vec3(i + 1, j + 1, k + 1),
-                             Vec3(i, j + 1, k + 1)};
-
-        for (int e = 0; e < 12; e++) {
-          if (mcEdgeTable[cubeIdx] & (1 << e)) {
-            // vertex already calculated ?
-            if (*eVert[e] == 0) {
-              // interpolate edge
-              const int e1 = mcEdges[e * 2];
-              const int e2 = mcEdges[e * 2 + 1];
-              const Vec3 p1 = pos[e1];        // scalar field pos 1
-              const Vec3 p2 = pos[e2];        // scalar field pos 2
-              const float valp1 = value[e1];  // scalar field val 1
-              const float valp2 = value[e2];  // scalar field val 2
-              const float mu = (isoValue - valp1) / (valp2 - valp1);
-
-              // init isolevel vertex
-              Node vertex;
-              vertex.pos = p1 + (p2 - p1) * mu + Vec3(Real(0.5));
-              vertex.normal = getNormalized(
-                  getGradient(
-                      *this, i + cubieOffsetX[e1], j + cubieOffsetY[e1], k + cubieOffsetZ[e1]) *
-                      (1.0 - mu) +
-                  getGradient(
-                      *this, i + cubieOffsetX[e2], j + cubieOffsetY[e2], k + cubieOffsetZ[e2]) *
-                      (mu));
-
-              triIndices[e] = mesh.addNode(vertex) + 1;
-
-              // store vertex
-              *eVert[e] = triIndices[e];
-            }
-            else {
-              // retrieve  from vert array
-              triIndices[e] = *eVert[e];
+      },
+      1);
+
+  // match lower plane vertices with the upper plane vertices of the previous slab
+  parallelForRange(
+      numSlabs,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt s = begin; s < end; s++) {
+          McSlab &slab = slabs[s];
+          slab.shared.assign(slab.nodes.size(), -1);
+          slab.numShared = 0;
+          if (s == 0)
+            continue;
+          const std::vector<std::pair<IndexInt, int>> &upper = slabs[s - 1].upper;
+          size_t u = 0;
+          for (size_t l = 0; l < slab.lower.size(); l++) {
+            while (u < upper.size() && upper[u].first < slab.lower[l].first)
+              u++;
+            if (u < upper.size() && upper[u].first == slab.lower[l].first) {
+              slab.shared[slab.lower[l].second] = upper[u].second;
+              slab.numShared++;
             }
           }
         }
+      },
+      1);
 
-        // Create the triangles...
-        for (int e = 0; mcTriTable[cubeIdx][e] != -1; e += 3) {
-          mesh.addTri(Triangle(triIndices[mcTriTable[cubeIdx][e + 0]] - 1,
-                               triIndices[mcTriTable[cubeIdx][e + 1]] - 1,
-                               triIndices[mcTriTable[cubeIdx][e + 2]] - 1));
+  std::vector<int> nodeStart(numSlabs + 1, 0), triStart(numSlabs + 1, 0);
+  for (int s = 0; s < numSlabs; s++) {
+    nodeStart[s + 1] = nodeStart[s] + (int)slabs[s].nodes.size() - slabs[s].numShared;
+    triStart[s + 1] = triStart[s] + (int)slabs[s].tris.size();
+  }
+
+  // number the nodes that are not shared, upper plane vertices are never shared, so the shared
+  // ones can then look up their index in the previous slab
+  parallelForRange(
+      numSlabs,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt s = begin; s < end; s++) {
+          McSlab &slab = slabs[s];
+          slab.remap.resize(slab.nodes.size());
+          int next = nodeStart[s];
+          for (size_t n = 0; n < slab.nodes.size(); n++)
+            slab.remap[n] = (slab.shared[n] < 0) ? next++ : -1;
         }
-      }
+      },
+      1);
+
+  mesh.resizeNodes(nodeStart[numSlabs]);
+  mesh.resizeTris(triStart[numSlabs]);
+  std::vector<Node> &nodes = mesh.getNodeData();
+  std::vector<Triangle> &tris = mesh.getTriData();
+  parallelForRange(
+      numSlabs,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt s = begin; s < end; s++) {
+          McSlab &slab = slabs[s];
+          for (size_t n = 0; n < slab.nodes.size(); n++) {
+            if (slab.shared[n] < 0)
+              nodes[slab.remap[n]] = slab.nodes[n];
+            else
+              slab.remap[n] = slabs[s - 1].remap[slab.shared[n]];
+          }
+          for (size_t t = 0; t < slab.tris.size(); t++) {
+            Triangle &tri = tris[triStart[s] + t];
+            for (int c = 0; c < 3; c++)
+              tri.c[c] = slab.remap[slab.tris[t].c[c]];
+          }
+        }
+      },
+      1);
+
+  // zero init mdata for all nodes, as addNode would do
+  for (IndexInt md = 0; md < mesh.getNumMdata(); ++md)
+    mesh.getMdata(md)->resize(nodes.size());
+  mesh.rebuildLookupFromTris();
 
   // mesh.rebuildCorners();
   // mesh.rebuildLookup();
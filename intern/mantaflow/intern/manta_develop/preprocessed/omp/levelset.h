@@ -24,6 +24,9 @@
 namespace Manta {
 class Mesh;
 
+//! redistancing methods of LevelsetGrid::reinitMarching
+enum RedistanceMethod { RdFastMarching = 0, RdFastSweeping = 1 };
+
 //! Special function for levelsets
 class LevelsetGrid : public Grid<Real> {
  public:
@@ -56,14 +59,16 @@ class LevelsetGrid : public Grid<Real> {
 
   LevelsetGrid(FluidSolver *parent, Real *data, bool show = true);
 
-  //! reconstruct the levelset using fast marching
+  //! reconstruct the levelset using fast marching, or parallel fast sweeping with
+  //! method=RdFastSweeping (without velocity transport)
 
   void reinitMarching(const FlagGrid &flags,
                       Real maxTime = 4.0,
                       MACGrid *velTransport = NULL,
                       bool ignoreWalls = false,
                       bool correctOuterLayer = true,
-                      int obstacleType = FlagGrid::TypeObstacle);
+                      int obstacleType = FlagGrid::TypeObstacle,
+                      int method = RdFastMarching);
   static PyObject *_W_1(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
   {
     try {
@@ -80,10 +85,11 @@ class LevelsetGrid : public Grid<Real> {
         bool ignoreWalls = _args.getOpt<bool>("ignoreWalls", 3, false, &_lock);
         bool correctOuterLayer = _args.getOpt<bool>("correctOuterLayer", 4, true, &_lock);
         int obstacleType = _args.getOpt<int>("obstacleType", 5, FlagGrid::TypeObstacle, &_lock);
+        int method = _args.getOpt<int>("method", 6, RdFastMarching, &_lock);
         pbo->_args.copy(_args);
         _retval = getPyNone();
         pbo->reinitMarching(
-            flags, maxTime, velTransport, ignoreWalls, correctOuterLayer, obstacleType);
+            flags, maxTime, velTransport, ignoreWalls, correctOuterLayer, obstacleType, method);
         pbo->_args.check();
       }
       pbFinalizePlugin(pbo->getParent(), "LevelsetGrid::reinitMarching", !noTiming);
@@ -288,26 +288,44 @@ void Mesh::rebuildCorners(int from, int to)
     }
   }
 
-  // set opposite info
-  int maxc = to * 3;
-  for (int c = from * 3; c < maxc; c++) {
-    int next = mCorners[mCorners[c].next].node;
-    int prev = mCorners[mCorners[c].prev].node;
-
-    // find corner with same next/prev nodes
-    for (int c2 = c + 1; c2 < maxc; c2++) {
-      int next2 = mCorners[mCorners[c2].next].node;
-      if (next2 != next && next2 != prev)
-        continue;
-      int prev2 = mCorners[mCorners[c2].prev].node;
-      if (prev2 != next && prev2 != prev)
-        continue;
+  // set opposite info: corners are grouped by the lower node of their opposite edge, then
+  // sorted by the other node within each group in parallel. corners on the same edge are
+  // paired in index order, as a search for the next corner with the same edge would do
+  const int numNodes = mNodes.size();
+  const int minc = from * 3, maxc = to * 3;
+  std::vector<int> start(numNodes + 1, 0), edgeCorners(maxc - minc);
+  for (int c = minc; c < maxc; c++)
+    start[std::min(mCorners[mCorners[c].next].node, mCorners[mCorners[c].prev].node) + 1]++;
+  for (int n = 0; n < numNodes; n++)
+    start[n + 1] += start[n];
+  std::vector<int> fill(start.begin(), start.end() - 1);
+  for (int c = minc; c < maxc; c++)
+    edgeCorners[fill[std::min(mCorners[mCorners[c].next].node,
+                              mCorners[mCorners[c].prev].node)]++] = c;
+
+  parallelForRange(
+      numNodes,
+      [&](IndexInt begin, IndexInt end) {
+        std::vector<std::pair<int, int>> group;
+        for (IndexInt n = begin; n < end; n++) {
+          group.clear();
+          for (int i = start[n]; i < start[n + 1]; i++) {
+            const int c = edgeCorners[i];
+            group.push_back(std::make_pair(
+                std::max(mCorners[mCorners[c].next].node, mCorners[mCorners[c].prev].node), c));
+          }
+          std::sort(group.begin(), group.end());
+          for (size_t i = 0; i + 1 < group.size(); i++) {
+            if (group[i].first != group[i + 1].first)
+              continue;
+            mCorners[group[i].second].opposite = group[i + 1].second;
+            mCorners[group[i + 1].second].opposite = group[i].second;
+          }
+        }
+      },
+      1024);
 
-      // found
-      mCorners[c].opposite = c2;
-      mCorners[c2].opposite = c;
-      break;
-    }
+  for (int c = minc; c < maxc; c++) {
     if (mCorners[c].opposite < 0) {
       // didn't find opposite
       errMsg("can't rebuild corners, index without an opposite");
@@ -319,8 +337,10 @@ void Mesh::rebuildCorners(int from, int to)
 
 void Mesh::rebuildLookup(int from, int to)
 {
-  if (from == 0 && to < 0)
-    m1RingLookup.clear();
+  if (from == 0 && to < 0) {
+    rebuildLookupFromTris();
+    return;
+  }
   m1RingLookup.resize(mNodes.size());
   if (to < 0)
     to = mTris.size();
@@ -334,6 +354,84 @@ void Mesh::rebuildLookup(int from, int to)
   }
 }
 
+void Mesh::buildAdjacency(MeshAdjacency &adj, bool withNodes) const
+{
+  // counting sort of the corners by node. the two passes are serial, they are cheap compared to
+  // the work per node afterwards
+  const int numNodes = mNodes.size();
+  const int numCorners = 3 * mTris.size();
+  adj.cornerStart.assign(numNodes + 1, 0);
+  adj.corners.resize(numCorners);
+  for (int i = 0; i < numCorners; i++)
+    adj.cornerStart[mTris[i / 3].c[i % 3] + 1]++;
+  for (int n = 0; n < numNodes; n++)
+    adj.cornerStart[n + 1] += adj.cornerStart[n];
+  std::vector<int> fill(adj.cornerStart.begin(), adj.cornerStart.end() - 1);
+  for (int i = 0; i < numCorners; i++)
+    adj.corners[fill[mTris[i / 3].c[i % 3]]++] = i;
+
+  adj.nodeStart.clear();
+  adj.nodes.clear();
+  if (!withNodes)
+    return;
+
+  // next and prev nodes of all corners of a node, sorted and made unique in place
+  std::vector<int> ring(2 * numCorners), count(numNodes);
+  parallelForRange(
+      numNodes,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++) {
+          int *r = ring.data() + 2 * adj.cornerStart[n];
+          int num = 0;
+          for (int i = adj.cornerStart[n]; i < adj.cornerStart[n + 1]; i++) {
+            const int tri = adj.corners[i] / 3, c = adj.corners[i] % 3;
+            r[num++] = mTris[tri].c[(c + 1) % 3];
+            r[num++] = mTris[tri].c[(c + 2) % 3];
+          }
+          std::sort(r, r + num);
+          count[n] = std::unique(r, r + num) - r;
+        }
+      },
+      1024);
+
+  adj.nodeStart.resize(numNodes + 1);
+  adj.nodeStart[0] = 0;
+  for (int n = 0; n < numNodes; n++)
+    adj.nodeStart[n + 1] = adj.nodeStart[n] + count[n];
+  adj.nodes.resize(adj.nodeStart[numNodes]);
+  parallelForRange(
+      numNodes,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++)
+          std::copy(ring.begin() + 2 * adj.cornerStart[n],
+                    ring.begin() + 2 * adj.cornerStart[n] + count[n],
+                    adj.nodes.begin() + adj.nodeStart[n]);
+      },
+      1024);
+}
+
+void Mesh::rebuildLookupFromTris()
+{
+  MeshAdjacency adj;
+  buildAdjacency(adj);
+
+  m1RingLookup.clear();
+  m1RingLookup.resize(mNodes.size());
+  parallelForRange(
+      mNodes.size(),
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++) {
+          // both lists are sorted, so every insert goes to the end
+          OneRing &ring = m1RingLookup[n];
+          for (int i = adj.nodeStart[n]; i < adj.nodeStart[n + 1]; i++)
+            ring.nodes.insert(ring.nodes.end(), adj.nodes[i]);
+          for (int i = adj.cornerStart[n]; i < adj.cornerStart[n + 1]; i++)
+            ring.tris.insert(ring.tris.end(), adj.corners[i] / 3);
+        }
+      },
+      1024);
+}
+
 void Mesh::rebuildChannels()
 {
   for (size_t i = 0; i < mTriChannels.size(); i++)
@@ -348,6 +446,7 @@ struct KnAdvectMeshInGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  vector<Node> &nodes,
@@ -397,6 +496,7 @@ struct KnAdvectMeshInGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnAdvectMeshInGrid");
   };
   void run()
   {
@@ -705,23 +805,34 @@ int Mesh::addNode(Node a)
 
 void Mesh::computeVertexNormals()
 {
-  for (size_t i = 0; i < mNodes.size(); i++) {
-    mNodes[i].normal = 0.0;
-  }
-  for (size_t t = 0; t < mTris.size(); t++) {
-    Vec3 p0 = getNode(t, 0), p1 = getNode(t, 1), p2 = getNode(t, 2);
-    Vec3 n0 = p0 - p1, n1 = p1 - p2, n2 = p2 - p0;
-    Real l0 = normSquare(n0), l1 = normSquare(n1), l2 = normSquare(n2);
-
-    Vec3 nm = cross(n0, n1);
-
-    mNodes[mTris[t].c[0]].normal += nm * (1.0 / (l0 * l2));
-    mNodes[mTris[t].c[1]].normal += nm * (1.0 / (l0 * l1));
-    mNodes[mTris[t].c[2]].normal += nm * (1.0 / (l1 * l2));
-  }
-  for (size_t i = 0; i < mNodes.size(); i++) {
-    normalize(mNodes[i].normal);
-  }
+  // gather the weighted face normals per node, in the same triangle order as a serial loop over
+  // the triangles would add them
+  MeshAdjacency adj;
+  buildAdjacency(adj, false);
+  parallelForRange(
+      mNodes.size(),
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++) {
+          Vec3 normal(0.0);
+          for (int i = adj.cornerStart[n]; i < adj.cornerStart[n + 1]; i++) {
+            const int t = adj.corners[i] / 3, c = adj.corners[i] % 3;
+            Vec3 p0 = getNode(t, 0), p1 = getNode(t, 1), p2 = getNode(t, 2);
+            Vec3 n0 = p0 - p1, n1 = p1 - p2, n2 = p2 - p0;
+            Real l0 = normSquare(n0), l1 = normSquare(n1), l2 = normSquare(n2);
+
+            Vec3 nm = cross(n0, n1);
+            if (c == 0)
+              normal += nm * (1.0 / (l0 * l2));
+            else if (c == 1)
+              normal += nm * (1.0 / (l0 * l1));
+            else
+              normal += nm * (1.0 / (l1 * l2));
+          }
+          normalize(normal);
+          mNodes[n].normal = normal;
+        }
+      },
+      1024);
 }
 
 void Mesh::fastNodeLookupRebuild(int corner)
@@ -981,6 +1092,7 @@ template<class T> struct ApplyMeshToGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, Grid<T> *grid, Grid<Real> &sdf, T value, FlagGrid *respectFlags)
@@ -1017,6 +1129,7 @@ template<class T> struct ApplyMeshToGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyMeshToGrid");
   };
   void run()
   {
@@ -1403,6 +1516,7 @@ template<class T> struct knSetMdataConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &mdata, T value)
   {
@@ -1424,6 +1538,7 @@ template<class T> struct knSetMdataConst : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetMdataConst");
   };
   void run()
   {
@@ -1446,6 +1561,7 @@ template<class T, class S> struct knMdataSet : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other)
   {
@@ -1467,6 +1583,7 @@ template<class T, class S> struct knMdataSet : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSet");
   };
   void run()
   {
@@ -1488,6 +1605,7 @@ template<class T, class S> struct knMdataAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other)
   {
@@ -1509,6 +1627,7 @@ template<class T, class S> struct knMdataAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataAdd");
   };
   void run()
   {
@@ -1530,6 +1649,7 @@ template<class T, class S> struct knMdataSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other)
   {
@@ -1551,6 +1671,7 @@ template<class T, class S> struct knMdataSub : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSub");
   };
   void run()
   {
@@ -1572,6 +1693,7 @@ template<class T, class S> struct knMdataMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other)
   {
@@ -1593,6 +1715,7 @@ template<class T, class S> struct knMdataMult : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataMult");
   };
   void run()
   {
@@ -1614,6 +1737,7 @@ template<class T, class S> struct knMdataDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other)
   {
@@ -1635,6 +1759,7 @@ template<class T, class S> struct knMdataDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataDiv");
   };
   void run()
   {
@@ -1657,6 +1782,7 @@ template<class T, class S> struct knMdataSetScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const S &other)
   {
@@ -1678,6 +1804,7 @@ template<class T, class S> struct knMdataSetScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSetScalar");
   };
   void run()
   {
@@ -1699,6 +1826,7 @@ template<class T, class S> struct knMdataAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const S &other)
   {
@@ -1720,6 +1848,7 @@ template<class T, class S> struct knMdataAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataAddScalar");
   };
   void run()
   {
@@ -1741,6 +1870,7 @@ template<class T, class S> struct knMdataMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const S &other)
   {
@@ -1762,6 +1892,7 @@ template<class T, class S> struct knMdataMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataMultScalar");
   };
   void run()
   {
@@ -1783,6 +1914,7 @@ template<class T, class S> struct knMdataScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<T> &other, const S &factor)
   {
@@ -1809,6 +1941,7 @@ template<class T, class S> struct knMdataScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataScaledAdd");
   };
   void run()
   {
@@ -1832,6 +1965,7 @@ template<class T> struct knMdataSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<T> &other)
   {
@@ -1853,6 +1987,7 @@ template<class T> struct knMdataSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSafeDiv");
   };
   void run()
   {
@@ -1874,6 +2009,7 @@ template<class T> struct knMdataSetConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &mdata, T value)
   {
@@ -1895,6 +2031,7 @@ template<class T> struct knMdataSetConst : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSetConst");
   };
   void run()
   {
@@ -1917,6 +2054,7 @@ template<class T> struct knMdataClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, T min, T max)
   {
@@ -1943,6 +2081,7 @@ template<class T> struct knMdataClamp : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClamp");
   };
   void run()
   {
@@ -1964,6 +2103,7 @@ template<class T> struct knMdataClampMin : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const T vmin)
   {
@@ -1985,6 +2125,7 @@ template<class T> struct knMdataClampMin : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMin");
   };
   void run()
   {
@@ -2005,6 +2146,7 @@ template<class T> struct knMdataClampMax : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const T vmax)
   {
@@ -2026,6 +2168,7 @@ template<class T> struct knMdataClampMax : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMax");
   };
   void run()
   {
@@ -2047,6 +2190,7 @@ struct knMdataClampMinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<Vec3> &me, const Real vmin)
   {
@@ -2070,6 +2214,7 @@ struct knMdataClampMinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMinVec3");
   };
   void run()
   {
@@ -2091,6 +2236,7 @@ struct knMdataClampMaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<Vec3> &me, const Real vmax)
   {
@@ -2114,6 +2260,7 @@ struct knMdataClampMaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMaxVec3");
   };
   void run()
   {
@@ -2161,6 +2308,7 @@ template<class T, class S> struct knMdataSetScalarIntFlag : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  MeshDataImpl<T> &me,
@@ -2197,6 +2345,7 @@ template<class T, class S> struct knMdataSetScalarIntFlag : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSetScalarIntFlag");
   };
   void run()
   {
@@ -2283,6 +2432,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const MeshDataImpl<T> &val,
@@ -2323,6 +2473,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSum");
   };
   void run()
   {
@@ -2349,6 +2500,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &result)
   {
@@ -2373,6 +2525,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumSquare");
   };
   void run()
   {
@@ -2397,6 +2550,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &result)
   {
@@ -2421,6 +2575,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumMagnitude");
   };
   void run()
   {
@@ -2462,6 +2617,7 @@ struct CompMdata_Min : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &minVal)
   {
@@ -2487,6 +2643,7 @@ struct CompMdata_Min : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_Min");
   };
   void run()
   {
@@ -2515,6 +2672,7 @@ struct CompMdata_Max : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &maxVal)
   {
@@ -2540,6 +2698,7 @@ struct CompMdata_Max : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_Max");
   };
   void run()
   {
@@ -2610,6 +2769,7 @@ struct CompMdata_MinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<Vec3> &val, Real &minVal)
   {
@@ -2636,6 +2796,7 @@ struct CompMdata_MinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_MinVec3");
   };
   void run()
   {
@@ -2662,6 +2823,7 @@ struct CompMdata_MaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<Vec3> &val, Real &maxVal)
   {
@@ -2688,6 +2850,7 @@ struct CompMdata_MaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_MaxVec3");
   };
   void run()
   {
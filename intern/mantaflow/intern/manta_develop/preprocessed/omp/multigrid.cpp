@@ -257,7 +257,8 @@ GridMg::GridMg(const Vec3i &gridSize)
       mCoarsestLevelAccuracy(Real(1E-8)),
       mTrivialEquationScale(Real(1E-6)),
       mIsASet(false),
-      mIsRhsSet(false)
+      mIsRhsSet(false),
+      mHasCoarseGrids(false)
 {
   MG_TIMINGS(MuTime time;)
 
@@ -419,6 +420,7 @@ struct knCopyA : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<Real> &sizeRef,
@@ -482,6 +484,7 @@ struct knCopyA : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCopyA");
   };
   void run()
   {
@@ -519,6 +522,7 @@ struct knActivateVertices : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<GridMg::VertexType> &type_0,
@@ -580,6 +584,7 @@ struct knActivateVertices : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knActivateVertices");
   };
   void run()
   {
@@ -609,12 +614,20 @@ void GridMg::setA(const Grid<Real> *pA0,
   // Copy level 0
   knCopyA(mx[0], mA[0], mStencilSize0, mIs3D, pA0, pAi, pAj, pAk);
 
+  // Keep previous vertex types, coarse grids only need to be regenerated if they change
+  if (mHasCoarseGrids)
+    mPrevType0 = mType[0];
+
   // Determine active vertices and scale trivial equations
   bool nonZeroStencilSumFound = false;
   bool trivialEquationsFound = false;
 
   knActivateVertices(mType[0], mA[0], nonZeroStencilSumFound, trivialEquationsFound, *this);
 
+  const bool genCoarseGrids = !mHasCoarseGrids || mPrevType0 != mType[0];
+  if (!genCoarseGrids)
+    debMsg("GridMg::setA: Active vertices unchanged, reusing coarse grids", 2);
+
   if (trivialEquationsFound)
     debMsg("GridMg::setA: Found at least one trivial equation", 2);
 
@@ -629,12 +642,18 @@ void GridMg::setA(const Grid<Real> *pA0,
   // Create coarse grids and operators on levels >0
   for (int l = 1; l < mA.size(); l++) {
     MG_TIMINGS(time.get();)
-    genCoarseGrid(l);
+    if (genCoarseGrids) {
+      // start from cleared operators as in a newly created hierarchy
+      if (mHasCoarseGrids)
+        std::fill(mA[l].begin(), mA[l].end(), Real(0));
+      genCoarseGrid(l);
+    }
     MG_TIMINGS(debMsg("GridMg: Generated level " << l << " in " << time.update(), 1);)
     genCoraseGridOperator(l);
     MG_TIMINGS(debMsg("GridMg: Generated operator " << l << " in " << time.update(), 1);)
   }
 
+  mHasCoarseGrids = true;
   mIsASet = true;
   mIsRhsSet = false;  // invalidate rhs
 }
@@ -645,6 +664,7 @@ struct knSetRhs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<Real> &b, const Grid<Real> &rhs, const GridMg &mg)
   {
@@ -676,6 +696,7 @@ struct knSetRhs : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetRhs");
   };
   void run()
   {
@@ -707,6 +728,7 @@ template<class T> struct knSet : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<T> &data, T value)
   {
@@ -728,6 +750,7 @@ template<class T> struct knSet : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSet");
   };
   void run()
   {
@@ -750,6 +773,7 @@ template<class T> struct knCopyToVector : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<T> &dst, const Grid<T> &src)
   {
@@ -771,6 +795,7 @@ template<class T> struct knCopyToVector : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCopyToVector");
   };
   void run()
   {
@@ -793,6 +818,7 @@ template<class T> struct knCopyToGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const std::vector<T> &src, Grid<T> &dst)
   {
@@ -814,6 +840,7 @@ template<class T> struct knCopyToGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCopyToGrid");
   };
   void run()
   {
@@ -836,6 +863,7 @@ template<class T> struct knAddAssign : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<T> &dst, const std::vector<T> &src)
   {
@@ -857,6 +885,7 @@ template<class T> struct knAddAssign : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knAddAssign");
   };
   void run()
   {
@@ -943,6 +972,7 @@ struct knActivateCoarseVertices : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<GridMg::VertexType> &type, int unused)
   {
@@ -972,6 +1002,7 @@ struct knActivateCoarseVertices : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knActivateCoarseVertices");
   };
   void run()
   {
@@ -1067,6 +1098,7 @@ struct knGenCoarseGridOperator : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       IndexInt idx, std::vector<Real> &sizeRef, std::vector<Real> &A, int l, const GridMg &mg)
@@ -1197,6 +1229,7 @@ struct knGenCoarseGridOperator : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knGenCoarseGridOperator");
   };
   void run()
   {
@@ -1240,6 +1273,7 @@ struct knSmoothColor : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ThreadSize &numBlocks,
@@ -1339,6 +1373,7 @@ struct knSmoothColor : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSmoothColor");
   };
   void run()
   {
@@ -1402,6 +1437,7 @@ struct knCalcResidual : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<Real> &r, int l, const GridMg &mg)
   {
@@ -1466,6 +1502,7 @@ struct knCalcResidual : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCalcResidual");
   };
   void run()
   {
@@ -1494,6 +1531,7 @@ struct knResidualNormSumSqr : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const vector<Real> &r, int l, const GridMg &mg, Real &result)
   {
@@ -1531,6 +1569,7 @@ struct knResidualNormSumSqr : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knResidualNormSumSqr");
   };
   void run()
   {
@@ -1712,6 +1751,7 @@ struct knRestrict : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<Real> &dst,
@@ -1769,6 +1809,7 @@ struct knRestrict : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knRestrict");
   };
   void run()
   {
@@ -1798,6 +1839,7 @@ struct knInterpolate : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<Real> &dst,
@@ -1852,6 +1894,7 @@ struct knInterpolate : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knInterpolate");
   };
   void run()
   {
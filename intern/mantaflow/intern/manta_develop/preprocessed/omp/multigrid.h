@@ -52,6 +52,13 @@ class GridMg {
   {
     return mIsASet;
   }
+
+  //! request an update of A with the next setA() call. The coarse grids are kept and only
+  //! regenerated if the active vertices of A changed, otherwise just the operators are rebuilt
+  void invalidateA()
+  {
+    mIsASet = false;
+  }
   bool isRhsSet() const
   {
     return mIsRhsSet;
@@ -169,6 +176,10 @@ class GridMg {
   bool mIsASet;
   bool mIsRhsSet;
 
+  //! coarse grids have been generated, and level 0 vertex types they were generated for
+  bool mHasCoarseGrids;
+  std::vector<VertexType> mPrevType0;
+
   // provide kernels with access
   friend struct knActivateVertices;
   friend struct knActivateCoarseVertices;
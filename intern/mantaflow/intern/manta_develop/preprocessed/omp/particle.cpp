@@ -337,6 +337,15 @@ template<class T> void ParticleDataImpl<T>::copyValueSlow(IndexInt from, IndexIn
 {
   this->copyValue(from, to);
 }
+template<class T> void ParticleDataImpl<T>::permute(const std::vector<IndexInt> &order)
+{
+  std::vector<T> data(order.size());
+  parallelForRange(order.size(), [&](IndexInt begin, IndexInt end) {
+    for (IndexInt i = begin; i < end; i++)
+      data[i] = mData[order[i]];
+  });
+  mData.swap(data);
+}
 template<class T> ParticleDataBase *ParticleDataImpl<T>::clone()
 {
   ParticleDataImpl<T> *npd = new ParticleDataImpl<T>(getParent(), this);
@@ -424,6 +433,7 @@ template<class T, class S> struct knPdataAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other)
   {
@@ -445,6 +455,7 @@ template<class T, class S> struct knPdataAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataAdd");
   };
   void run()
   {
@@ -466,6 +477,7 @@ template<class T, class S> struct knPdataSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other)
   {
@@ -487,6 +499,7 @@ template<class T, class S> struct knPdataSub : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSub");
   };
   void run()
   {
@@ -508,6 +521,7 @@ template<class T, class S> struct knPdataMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other)
   {
@@ -529,6 +543,7 @@ template<class T, class S> struct knPdataMult : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataMult");
   };
   void run()
   {
@@ -550,6 +565,7 @@ template<class T, class S> struct knPdataDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other)
   {
@@ -571,6 +587,7 @@ template<class T, class S> struct knPdataDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataDiv");
   };
   void run()
   {
@@ -592,6 +609,7 @@ template<class T> struct knPdataSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<T> &other)
   {
@@ -613,6 +631,7 @@ template<class T> struct knPdataSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSafeDiv");
   };
   void run()
   {
@@ -635,6 +654,7 @@ template<class T, class S> struct knPdataSetScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const S &other)
   {
@@ -656,6 +676,7 @@ template<class T, class S> struct knPdataSetScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSetScalar");
   };
   void run()
   {
@@ -677,6 +698,7 @@ template<class T, class S> struct knPdataAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const S &other)
   {
@@ -698,6 +720,7 @@ template<class T, class S> struct knPdataAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataAddScalar");
   };
   void run()
   {
@@ -719,6 +742,7 @@ template<class T, class S> struct knPdataMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const S &other)
   {
@@ -740,6 +764,7 @@ template<class T, class S> struct knPdataMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataMultScalar");
   };
   void run()
   {
@@ -761,6 +786,7 @@ template<class T, class S> struct knPdataScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<T> &me,
@@ -790,6 +816,7 @@ template<class T, class S> struct knPdataScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataScaledAdd");
   };
   void run()
   {
@@ -813,6 +840,7 @@ template<class T> struct knPdataClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const T vmin, const T vmax)
   {
@@ -839,6 +867,7 @@ template<class T> struct knPdataClamp : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClamp");
   };
   void run()
   {
@@ -861,6 +890,7 @@ template<class T> struct knPdataClampMin : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const T vmin)
   {
@@ -882,6 +912,7 @@ template<class T> struct knPdataClampMin : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMin");
   };
   void run()
   {
@@ -903,6 +934,7 @@ template<class T> struct knPdataClampMax : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const T vmax)
   {
@@ -924,6 +956,7 @@ template<class T> struct knPdataClampMax : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMax");
   };
   void run()
   {
@@ -946,6 +979,7 @@ struct knPdataClampMinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<Vec3> &me, const Real vmin)
   {
@@ -969,6 +1003,7 @@ struct knPdataClampMinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMinVec3");
   };
   void run()
   {
@@ -991,6 +1026,7 @@ struct knPdataClampMaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<Vec3> &me, const Real vmax)
   {
@@ -1014,6 +1050,7 @@ struct knPdataClampMaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMaxVec3");
   };
   void run()
   {
@@ -1064,6 +1101,7 @@ template<class T, class S> struct knPdataSetScalarIntFlag : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<T> &me,
@@ -1100,6 +1138,7 @@ template<class T, class S> struct knPdataSetScalarIntFlag : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSetScalarIntFlag");
   };
   void run()
   {
@@ -1189,6 +1228,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const ParticleDataImpl<T> &val,
@@ -1229,6 +1269,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSum");
   };
   void run()
   {
@@ -1255,6 +1296,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &result)
   {
@@ -1279,6 +1321,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumSquare");
   };
   void run()
   {
@@ -1303,6 +1346,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &result)
   {
@@ -1327,6 +1371,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumMagnitude");
   };
   void run()
   {
@@ -1369,6 +1414,7 @@ struct CompPdata_Min : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &minVal)
   {
@@ -1394,6 +1440,7 @@ struct CompPdata_Min : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_Min");
   };
   void run()
   {
@@ -1422,6 +1469,7 @@ struct CompPdata_Max : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &maxVal)
   {
@@ -1447,6 +1495,7 @@ struct CompPdata_Max : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_Max");
   };
   void run()
   {
@@ -1517,6 +1566,7 @@ struct CompPdata_MinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<Vec3> &val, Real &minVal)
   {
@@ -1543,6 +1593,7 @@ struct CompPdata_MinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_MinVec3");
   };
   void run()
   {
@@ -1569,6 +1620,7 @@ struct CompPdata_MaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<Vec3> &val, Real &maxVal)
   {
@@ -1595,6 +1647,7 @@ struct CompPdata_MaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_MaxVec3");
   };
   void run()
   {
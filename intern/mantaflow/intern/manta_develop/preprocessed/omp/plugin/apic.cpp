@@ -44,6 +44,7 @@ struct knApicMapLinearVec3ToMACGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -174,12 +175,13 @@ struct knApicMapLinearVec3ToMACGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knApicMapLinearVec3ToMACGrid");
   };
   void run()
   {
-    const IndexInt _sz = size;
-    for (IndexInt i = 0; i < _sz; i++)
+    parallelParticleScatter(p, vg, ptype, exclude, [&](IndexInt i) {
       op(i, p, mg, vg, vp, cpx, cpy, cpz, ptype, exclude);
+    });
   }
   const BasicParticleSystem &p;
   MACGrid &mg;
@@ -284,6 +286,7 @@ struct knApicMapLinearMACGridToVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<Vec3> &vp,
@@ -419,6 +422,7 @@ struct knApicMapLinearMACGridToVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knApicMapLinearMACGridToVec3");
   };
   void run()
   {
@@ -43,6 +43,7 @@ struct KnApplyForceField : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -111,6 +112,7 @@ struct KnApplyForceField : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyForceField");
   };
   void run()
   {
@@ -161,6 +163,7 @@ struct KnApplyForce : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -216,6 +219,7 @@ struct KnApplyForce : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyForce");
   };
   void run()
   {
@@ -345,6 +349,7 @@ struct KnAddBuoyancy : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -389,6 +394,7 @@ struct KnAddBuoyancy : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddBuoyancy");
   };
   void run()
   {
@@ -666,6 +672,7 @@ struct KnSetInflow : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, MACGrid &vel, int dim, int p0, const Vec3 &val)
   {
@@ -699,6 +706,7 @@ struct KnSetInflow : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnSetInflow");
   };
   void run()
   {
@@ -792,6 +800,7 @@ struct KnSetWallBcs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const FlagGrid &flags, MACGrid &vel, const MACGrid *obvel)
   {
@@ -862,6 +871,7 @@ struct KnSetWallBcs : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnSetWallBcs");
   };
   void run()
   {
@@ -915,6 +925,7 @@ struct KnSetWallBcsFrac : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1055,6 +1066,7 @@ struct KnSetWallBcsFrac : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnSetWallBcsFrac");
   };
   void run()
   {
@@ -1154,6 +1166,7 @@ struct KnAddForceIfLower : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const FlagGrid &flags, MACGrid &vel, const Grid<Vec3> &force)
   {
@@ -1205,6 +1218,7 @@ struct KnAddForceIfLower : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddForceIfLower");
   };
   void run()
   {
@@ -1284,6 +1298,7 @@ struct KnConfForce : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1327,6 +1342,7 @@ struct KnConfForce : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnConfForce");
   };
   void run()
   {
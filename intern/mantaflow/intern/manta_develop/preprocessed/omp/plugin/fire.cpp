@@ -55,6 +55,7 @@ struct KnProcessBurn : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -185,6 +186,7 @@ struct KnProcessBurn : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnProcessBurn");
   };
   void run()
   {
@@ -347,6 +349,7 @@ struct KnUpdateFlame : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Real> &react, Grid<Real> &flame)
   {
@@ -371,6 +374,7 @@ struct KnUpdateFlame : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnUpdateFlame");
   };
   void run()
   {
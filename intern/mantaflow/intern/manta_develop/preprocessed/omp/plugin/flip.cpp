@@ -281,6 +281,7 @@ struct knClearFluidFlags : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, FlagGrid &flags, int dummy = 0)
   {
@@ -304,6 +305,7 @@ struct knClearFluidFlags : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knClearFluidFlags");
   };
   void run()
   {
@@ -343,6 +345,7 @@ struct knSetNbObstacle : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, FlagGrid &nflags, const FlagGrid &flags, const Grid<Real> &phiObs)
@@ -390,6 +393,7 @@ struct knSetNbObstacle : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetNbObstacle");
   };
   void run()
   {
@@ -815,6 +819,7 @@ struct ComputeUnionLevelsetPindex : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -899,6 +904,7 @@ struct ComputeUnionLevelsetPindex : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ComputeUnionLevelsetPindex");
   };
   void run()
   {
@@ -1018,6 +1024,7 @@ struct ComputeAveragedLevelsetWeight : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1134,6 +1141,7 @@ struct ComputeAveragedLevelsetWeight : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ComputeAveragedLevelsetWeight");
   };
   void run()
   {
@@ -1198,6 +1206,7 @@ template<class T> struct knSmoothGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<T> &me, Grid<T> &tmp, Real factor)
   {
@@ -1228,6 +1237,7 @@ template<class T> struct knSmoothGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSmoothGrid");
   };
   void run()
   {
@@ -1268,6 +1278,7 @@ template<class T> struct knSmoothGridNeg : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<T> &me, Grid<T> &tmp, Real factor)
   {
@@ -1302,6 +1313,7 @@ template<class T> struct knSmoothGridNeg : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSmoothGridNeg");
   };
   void run()
   {
@@ -1429,6 +1441,7 @@ struct correctLevelset : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1512,6 +1525,7 @@ struct correctLevelset : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("correctLevelset");
   };
   void run()
   {
@@ -1663,6 +1677,7 @@ struct knPushOutofObs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystem &parts,
@@ -1728,6 +1743,7 @@ struct knPushOutofObs : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPushOutofObs");
   };
   void run()
   {
@@ -1807,6 +1823,7 @@ template<class T> struct knSafeDivReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<Real> &other, Real cutoff = VECTOR_EPSILON)
   {
@@ -1839,6 +1856,7 @@ template<class T> struct knSafeDivReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSafeDivReal");
   };
   void run()
   {
@@ -1877,6 +1895,7 @@ struct knMapLinearVec3ToMACGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -1933,12 +1952,13 @@ struct knMapLinearVec3ToMACGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinearVec3ToMACGrid");
   };
   void run()
   {
-    const IndexInt _sz = size;
-    for (IndexInt i = 0; i < _sz; i++)
+    parallelParticleScatter(p, flags, ptype, exclude, [&](IndexInt i) {
       op(i, p, flags, vel, tmp, pvel, ptype, exclude);
+    });
   }
   const BasicParticleSystem &p;
   const FlagGrid &flags;
@@ -2032,6 +2052,7 @@ template<class T> struct knMapLinear : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2076,12 +2097,12 @@ template<class T> struct knMapLinear : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinear");
   };
   void run()
   {
-    const IndexInt _sz = size;
-    for (IndexInt i = 0; i < _sz; i++)
-      op(i, p, flags, target, gtmp, psource);
+    parallelParticleScatter(
+        p, flags, NULL, 0, [&](IndexInt i) { op(i, p, flags, target, gtmp, psource); });
   }
   const BasicParticleSystem &p;
   const FlagGrid &flags;
@@ -2197,6 +2218,7 @@ template<class T> struct knMapFromGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2228,6 +2250,7 @@ template<class T> struct knMapFromGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapFromGrid");
   };
   void run()
   {
@@ -2341,6 +2364,7 @@ struct knMapLinearMACGridToVec3_PIC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2391,6 +2415,7 @@ struct knMapLinearMACGridToVec3_PIC : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinearMACGridToVec3_PIC");
   };
   void run()
   {
@@ -2481,6 +2506,7 @@ struct knMapLinearMACGridToVec3_FLIP : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2544,6 +2570,7 @@ struct knMapLinearMACGridToVec3_FLIP : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinearMACGridToVec3_FLIP");
   };
   void run()
   {
@@ -2637,6 +2664,7 @@ struct knCombineVels : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2708,6 +2736,7 @@ struct knCombineVels : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCombineVels");
   };
   void run()
   {
@@ -2866,4 +2895,44 @@ void PbRegister_getCurvature()
 }
 }
 
+//! sort particles by 8^3 grid tiles, so that particle-grid transfers (mapPartsToMAC,
+//! mapGridToParts, advectInGrid) touch grid memory coherently; deleted particles are removed.
+//! Particle indices change, rebuild index systems (gridParticleIndex) afterwards
+
+void sortParticlesByTile(BasicParticleSystem &parts, const FlagGrid &flags)
+{
+  parts.sortByTile(flags.getSize());
+}
+static PyObject *_W_22(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "sortParticlesByTile", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      BasicParticleSystem &parts = *_args.getPtr<BasicParticleSystem>("parts", 0, &_lock);
+      const FlagGrid &flags = *_args.getPtr<FlagGrid>("flags", 1, &_lock);
+      _retval = getPyNone();
+      sortParticlesByTile(parts, flags);
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "sortParticlesByTile", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("sortParticlesByTile", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_sortParticlesByTile("", "sortParticlesByTile", _W_22);
+extern "C" {
+void PbRegister_sortParticlesByTile()
+{
+  KEEP_UNUSED(_RP_sortParticlesByTile);
+}
+}
+
 }  // namespace Manta
@@ -61,6 +61,7 @@ struct apply1DKernelDirX : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid &in, MACGrid &out, const Matrix &kernel)
   {
@@ -97,6 +98,7 @@ struct apply1DKernelDirX : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("apply1DKernelDirX");
   };
   void run()
   {
@@ -139,6 +141,7 @@ struct apply1DKernelDirY : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid &in, MACGrid &out, const Matrix &kernel)
   {
@@ -175,6 +178,7 @@ struct apply1DKernelDirY : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("apply1DKernelDirY");
   };
   void run()
   {
@@ -217,6 +221,7 @@ struct apply1DKernelDirZ : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid &in, MACGrid &out, const Matrix &kernel)
   {
@@ -253,6 +258,7 @@ struct apply1DKernelDirZ : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("apply1DKernelDirZ");
   };
   void run()
   {
@@ -599,7 +605,10 @@ void solvePressure(MACGrid &vel,
                    bool zeroPressureFixing = false,
                    const Grid<Real> *curv = NULL,
                    const Real surfTens = 0.0,
-                   Grid<Real> *retRhs = NULL);
+                   Grid<Real> *retRhs = NULL,
+                   const bool warmStart = false,
+                   const bool warmStartExtrapolate = false,
+                   const bool compactMatrix = false);
 
 //! Main function for fluid guiding , includes "regular" pressure solve
 
@@ -47,6 +47,7 @@ struct KnApplyNoiseInfl : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -102,6 +103,7 @@ struct KnApplyNoiseInfl : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyNoiseInfl");
   };
   void run()
   {
@@ -198,6 +200,7 @@ struct KnAddNoise : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -243,6 +246,7 @@ struct KnAddNoise : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddNoise");
   };
   void run()
   {
@@ -332,6 +336,7 @@ template<class T> struct knSetPdataNoise : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &parts,
@@ -367,6 +372,7 @@ template<class T> struct knSetPdataNoise : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetPdataNoise");
   };
   void run()
   {
@@ -394,6 +400,7 @@ template<class T> struct knSetPdataNoiseVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &parts,
@@ -429,6 +436,7 @@ template<class T> struct knSetPdataNoiseVec : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetPdataNoiseVec");
   };
   void run()
   {
@@ -691,6 +699,7 @@ struct KnApplyEmission : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -751,6 +760,7 @@ struct KnApplyEmission : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyEmission");
   };
   void run()
   {
@@ -845,6 +855,7 @@ struct KnApplyDensity : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -890,6 +901,7 @@ struct KnApplyDensity : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyDensity");
   };
   void run()
   {
@@ -1448,6 +1460,7 @@ struct KnUpdateFractions : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1551,6 +1564,7 @@ struct KnUpdateFractions : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnUpdateFractions");
   };
   void run()
   {
@@ -1644,6 +1658,7 @@ struct KnUpdateFlagsObs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1721,6 +1736,7 @@ struct KnUpdateFlagsObs : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnUpdateFlagsObs");
   };
   void run()
   {
@@ -1812,6 +1828,7 @@ struct kninitVortexVelocity : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1873,6 +1890,7 @@ struct kninitVortexVelocity : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kninitVortexVelocity");
   };
   void run()
   {
@@ -2067,6 +2085,7 @@ template<class T> struct knBlurGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2104,6 +2123,7 @@ template<class T> struct knBlurGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knBlurGrid");
   };
   void run()
   {
@@ -2165,6 +2185,7 @@ struct KnBlurMACGridGauss : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2228,6 +2249,7 @@ struct KnBlurMACGridGauss : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnBlurMACGridGauss");
   };
   void run()
   {
@@ -54,6 +54,7 @@ struct KnTurbulenceClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  Grid<Real> &kgrid,
@@ -110,6 +111,7 @@ struct KnTurbulenceClamp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnTurbulenceClamp");
   };
   void run()
   {
@@ -154,6 +156,7 @@ struct KnComputeProduction : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -242,6 +245,7 @@ struct KnComputeProduction : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnComputeProduction");
   };
   void run()
   {
@@ -349,6 +353,7 @@ struct KnAddTurbulenceSource : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       IndexInt idx, Grid<Real> &kgrid, Grid<Real> &egrid, const Grid<Real> &pgrid, Real dt)
@@ -391,6 +396,7 @@ struct KnAddTurbulenceSource : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddTurbulenceSource");
   };
   void run()
   {
@@ -42,57 +42,58 @@ void smoothMesh(Mesh &mesh, Real strength, int steps = 1, Real minLength = 1e-5)
 {
   const Real dt = mesh.getParent()->getDt();
   const Real str = min(dt * strength, (Real)1);
-  mesh.rebuildQuickCheck();
+
+  // one-rings in CSR form, built once for all steps. neighbors are visited in ascending order
+  MeshAdjacency adj;
+  mesh.buildAdjacency(adj);
 
   // calculate original mesh volume
   Vec3 origCM;
   Real origVolume = mesh.computeCenterOfMass(origCM);
 
   // temp vertices
-  const int numCorners = mesh.numTris() * 3;
   const int numNodes = mesh.numNodes();
   vector<Vec3> temp(numNodes);
-  vector<bool> visited(numNodes);
 
   for (int s = 0; s < steps; s++) {
-    // reset markers
-    for (size_t i = 0; i < visited.size(); i++)
-      visited[i] = false;
-
-    for (int c = 0; c < numCorners; c++) {
-      const int node = mesh.corners(c).node;
-      if (visited[node])
-        continue;
-
-      const Vec3 pos = mesh.nodes(node).pos;
-      Vec3 dx(0.0);
-      Real totalLen = 0;
-
-      // rotate around vertex
-      set<int> &ring = mesh.get1Ring(node).nodes;
-      for (set<int>::iterator it = ring.begin(); it != ring.end(); it++) {
-        Vec3 edge = mesh.nodes(*it).pos - pos;
-        Real len = norm(edge);
-
-        if (len > minLength) {
-          dx += edge * (1.0 / len);
-          totalLen += len;
-        }
-        else {
-          totalLen = 0.0;
-          break;
-        }
-      }
-      visited[node] = true;
-      temp[node] = pos;
-      if (totalLen != 0)
-        temp[node] += dx * (str / totalLen);
-    }
+    parallelForRange(
+        numNodes,
+        [&](IndexInt begin, IndexInt end) {
+          for (IndexInt node = begin; node < end; node++) {
+            const Vec3 pos = mesh.nodes(node).pos;
+            Vec3 dx(0.0);
+            Real totalLen = 0;
+
+            // rotate around vertex
+            for (int i = adj.nodeStart[node]; i < adj.nodeStart[node + 1]; i++) {
+              Vec3 edge = mesh.nodes(adj.nodes[i]).pos - pos;
+              Real len = norm(edge);
+
+              if (len > minLength) {
+                dx += edge * (1.0 / len);
+                totalLen += len;
+              }
+              else {
+                totalLen = 0.0;
+                break;
+              }
+            }
+            temp[node] = pos;
+            if (totalLen != 0)
+              temp[node] += dx * (str / totalLen);
+          }
+        },
+        1024);
 
     // copy back
-    for (int n = 0; n < numNodes; n++)
-      if (!mesh.isNodeFixed(n))
-        mesh.nodes(n).pos = temp[n];
+    parallelForRange(
+        numNodes,
+        [&](IndexInt begin, IndexInt end) {
+          for (IndexInt n = begin; n < end; n++)
+            if (!mesh.isNodeFixed(n))
+              mesh.nodes(n).pos = temp[n];
+        },
+        4096);
   }
 
   // calculate new mesh volume
@@ -107,9 +108,14 @@ void smoothMesh(Mesh &mesh, Real strength, int steps = 1, Real minLength = 1e-5)
   beta = cbrt(origVolume / newVolume);
 #endif
 
-  for (int n = 0; n < numNodes; n++)
-    if (!mesh.isNodeFixed(n))
-      mesh.nodes(n).pos = origCM + (mesh.nodes(n).pos - newCM) * beta;
+  parallelForRange(
+      numNodes,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++)
+          if (!mesh.isNodeFixed(n))
+            mesh.nodes(n).pos = origCM + (mesh.nodes(n).pos - newCM) * beta;
+      },
+      4096);
 }
 static PyObject *_W_0(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
 {
@@ -291,17 +297,26 @@ void subdivideMesh(
   // EDGE SUBDIVISION //
   //////////////////////
 
+  // longest edge of all triangles in parallel, the queue order does not depend on the order
+  // of insertion
   Real maxLength2 = maxLength * maxLength;
+  vector<Real> longestEdge(mesh.numTris());
+  parallelForRange(
+      mesh.numTris(),
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt t = begin; t < end; t++) {
+          // first we find the maximum length edge in this triangle
+          Vec3 e0 = mesh.getEdge(t, 0), e1 = mesh.getEdge(t, 1), e2 = mesh.getEdge(t, 2);
+          Real d0 = normSquare(e0);
+          Real d1 = normSquare(e1);
+          Real d2 = normSquare(e2);
+          longestEdge[t] = max(d0, max(d1, d2));
+        }
+      },
+      4096);
   for (int t = 0; t < mesh.numTris(); t++) {
-    // first we find the maximum length edge in this triangle
-    Vec3 e0 = mesh.getEdge(t, 0), e1 = mesh.getEdge(t, 1), e2 = mesh.getEdge(t, 2);
-    Real d0 = normSquare(e0);
-    Real d1 = normSquare(e1);
-    Real d2 = normSquare(e2);
-
-    Real longest = max(d0, max(d1, d2));
-    if (longest > maxLength2) {
-      pq.push(pair<Real, int>(longest, t));
+    if (longestEdge[t] > maxLength2) {
+      pq.push(pair<Real, int>(longestEdge[t], t));
     }
   }
   if (maxLength > 0) {
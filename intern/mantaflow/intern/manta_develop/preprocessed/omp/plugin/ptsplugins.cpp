@@ -29,6 +29,7 @@ struct KnAddForcePvel : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<Vec3> &v,
@@ -66,6 +67,7 @@ struct KnAddForcePvel : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnAddForcePvel");
   };
   void run()
   {
@@ -145,6 +147,7 @@ struct KnUpdateVelocityFromDeltaPos : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -194,6 +197,7 @@ struct KnUpdateVelocityFromDeltaPos : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnUpdateVelocityFromDeltaPos");
   };
   void run()
   {
@@ -271,6 +275,7 @@ struct KnStepEuler : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystem &p,
@@ -314,6 +319,7 @@ struct KnStepEuler : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnStepEuler");
   };
   void run()
   {
@@ -392,6 +398,7 @@ struct KnSetPartType : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<int> &ptype,
@@ -441,6 +448,7 @@ struct KnSetPartType : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnSetPartType");
   };
   void run()
   {
@@ -78,83 +78,37 @@ SurfaceTurbulenceParameters params;
 //
 struct ParticleAccelGrid {
   int res;
-  vector<int> ***indices;
+  ParticleNeighborGrid grid;
 
   void init(int inRes)
   {
     res = inRes;
-    indices = new vector<int> **[res];
-    for (int i = 0; i < res; i++) {
-      indices[i] = new vector<int> *[res];
-      for (int j = 0; j < res; j++) {
-        indices[i][j] = new vector<int>[res];
-      }
-    }
+    grid.init(Vec3(params.res), res);
   }
 
   void fillWith(const BasicParticleSystem &particles)
   {
-    // clear
-    for (int i = 0; i < res; i++) {
-      for (int j = 0; j < res; j++) {
-        for (int k = 0; k < res; k++) {
-          indices[i][j][k].clear();
-        }
-      }
-    }
-
-    // fill
-    for (int id = 0; id < particles.size(); id++) {
-      Vec3 pos = particles.getPos(id);
-      int i = clamp<int>(floor(pos.x / params.res * res), 0, res - 1);
-      int j = clamp<int>(floor(pos.y / params.res * res), 0, res - 1);
-      int k = clamp<int>(floor(pos.z / params.res * res), 0, res - 1);
-      indices[i][j][k].push_back(id);
-    }
+    grid.fill(particles.size(), [&](IndexInt id) { return particles.getPos(id); });
   }
 
   void fillWith(const ParticleDataImpl<Vec3> &particles)
   {
-    // clear
-    for (int i = 0; i < res; i++) {
-      for (int j = 0; j < res; j++) {
-        for (int k = 0; k < res; k++) {
-          indices[i][j][k].clear();
-        }
-      }
-    }
-
-    // fill
-    for (int id = 0; id < particles.size(); id++) {
-      Vec3 pos = particles[id];
-      int i = clamp<int>(floor(pos.x / params.res * res), 0, res - 1);
-      int j = clamp<int>(floor(pos.y / params.res * res), 0, res - 1);
-      int k = clamp<int>(floor(pos.z / params.res * res), 0, res - 1);
-      indices[i][j][k].push_back(id);
-    }
+    grid.fill(particles.size(), [&](IndexInt id) { return particles[id]; });
   }
 };
 
 #define LOOP_NEIGHBORS_BEGIN(points, center, radius) \
-  int minI = clamp<int>( \
-      floor((center.x - radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int maxI = clamp<int>( \
-      floor((center.x + radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int minJ = clamp<int>( \
-      floor((center.y - radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int maxJ = clamp<int>( \
-      floor((center.y + radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int minK = clamp<int>( \
-      floor((center.z - radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int maxK = clamp<int>( \
-      floor((center.z + radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  for (int i = minI; i <= maxI; i++) { \
-    for (int j = minJ; j <= maxJ; j++) { \
-      for (int k = minK; k <= maxK; k++) { \
-        for (int idLOOPNEIGHBORS = 0; \
-             idLOOPNEIGHBORS < (int)points.accel->indices[i][j][k].size(); \
+  const ParticleNeighborGrid &gridLOOPNEIGHBORS = points.accel->grid; \
+  const Vec3i minLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellOf(center - Vec3(radius)); \
+  const Vec3i maxLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellOf(center + Vec3(radius)); \
+  for (int i = minLOOPNEIGHBORS.x; i <= maxLOOPNEIGHBORS.x; i++) { \
+    for (int j = minLOOPNEIGHBORS.y; j <= maxLOOPNEIGHBORS.y; j++) { \
+      for (int k = minLOOPNEIGHBORS.z; k <= maxLOOPNEIGHBORS.z; k++) { \
+        const int cellLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellIndex(i, j, k); \
+        for (IndexInt idLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellBegin(cellLOOPNEIGHBORS); \
+             idLOOPNEIGHBORS < gridLOOPNEIGHBORS.cellEnd(cellLOOPNEIGHBORS); \
              idLOOPNEIGHBORS++) { \
-          int idn = points.accel->indices[i][j][k][idLOOPNEIGHBORS]; \
+          int idn = gridLOOPNEIGHBORS.getId(idLOOPNEIGHBORS); \
           if (points.isActive(idn)) {
 #define LOOP_NEIGHBORS_END \
   } \
@@ -307,66 +261,17 @@ struct BasicParticleSystemWrapper : PointSetWrapper {
 
   bool hasNeighbor(Vec3 pos, Real radius) const
   {
-    bool answer = false;
-    int minI = clamp<int>(floor((pos.x - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxI = clamp<int>(floor((pos.x + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minJ = clamp<int>(floor((pos.y - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxJ = clamp<int>(floor((pos.y + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minK = clamp<int>(floor((pos.z - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxK = clamp<int>(floor((pos.z + radius) / params.res * accel->res), 0, accel->res - 1);
-    for (int i = minI; i <= maxI; i++) {
-      for (int j = minJ; j <= maxJ; j++) {
-        for (int k = minK; k <= maxK; k++) {
-          for (int id = 0; id < (int)accel->indices[i][j][k].size(); id++) {
-            if (points->isActive(accel->indices[i][j][k][id]) &&
-                norm(points->getPos(accel->indices[i][j][k][id]) - pos) <= radius) {
-              answer = true;
-              break;
-            }
-          }
-          if (answer)
-            break;
-        }
-        if (answer)
-          break;
-      }
-      if (answer)
-        break;
-    }
-    return answer;
+    return !accel->grid.forEachCandidate(pos, radius, [&](int id) {
+      return !(points->isActive(id) && norm(points->getPos(id) - pos) <= radius);
+    });
   }
 
   bool hasNeighborOtherThanItself(int idx, Real radius) const
   {
-    bool answer = false;
     Vec3 pos = points->getPos(idx);
-    int minI = clamp<int>(floor((pos.x - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxI = clamp<int>(floor((pos.x + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minJ = clamp<int>(floor((pos.y - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxJ = clamp<int>(floor((pos.y + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minK = clamp<int>(floor((pos.z - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxK = clamp<int>(floor((pos.z + radius) / params.res * accel->res), 0, accel->res - 1);
-    for (int i = minI; i <= maxI; i++) {
-      for (int j = minJ; j <= maxJ; j++) {
-        for (int k = minK; k <= maxK; k++) {
-          for (int id = 0; id < (int)accel->indices[i][j][k].size(); id++) {
-            if (accel->indices[i][j][k][id] != idx &&
-                points->isActive(accel->indices[i][j][k][id]) &&
-                norm(points->getPos(accel->indices[i][j][k][id]) - pos) <= radius) {
-              answer = true;
-              break;
-            }
-          }
-          if (answer)
-            break;
-        }
-        if (answer)
-          break;
-      }
-      if (answer)
-        break;
-    }
-    return answer;
+    return !accel->grid.forEachCandidate(pos, radius, [&](int id) {
+      return !(id != idx && points->isActive(id) && norm(points->getPos(id) - pos) <= radius);
+    });
   }
 
   void removeInvalidIndices(vector<int> &indices)
@@ -565,6 +470,7 @@ struct advectSurfacePoints : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystemWrapper &surfacePoints,
@@ -612,6 +518,7 @@ struct advectSurfacePoints : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("advectSurfacePoints");
   };
   void run()
   {
@@ -671,6 +578,7 @@ struct computeSurfaceNormals : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -751,6 +659,7 @@ struct computeSurfaceNormals : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceNormals");
   };
   void run()
   {
@@ -781,6 +690,7 @@ struct computeAveragedNormals : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -810,6 +720,7 @@ struct computeAveragedNormals : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeAveragedNormals");
   };
   void run()
   {
@@ -835,6 +746,7 @@ struct assignNormals : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -858,6 +770,7 @@ struct assignNormals : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("assignNormals");
   };
   void run()
   {
@@ -970,6 +883,7 @@ struct computeSurfaceDensities : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const BasicParticleSystemWrapper &surfacePoints, void *dummy)
   {
@@ -998,6 +912,7 @@ struct computeSurfaceDensities : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceDensities");
   };
   void run()
   {
@@ -1023,6 +938,7 @@ struct computeSurfaceDisplacements : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1084,6 +1000,7 @@ struct computeSurfaceDisplacements : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceDisplacements");
   };
   void run()
   {
@@ -1106,6 +1023,7 @@ struct applySurfaceDisplacements : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, BasicParticleSystemWrapper &surfacePoints, void *dummy)
   {
@@ -1127,6 +1045,7 @@ struct applySurfaceDisplacements : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("applySurfaceDisplacements");
   };
   void run()
   {
@@ -1163,6 +1082,7 @@ struct constrainSurface : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystemWrapper &surfacePoints,
@@ -1199,6 +1119,7 @@ struct constrainSurface : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("constrainSurface");
   };
   void run()
   {
@@ -1230,6 +1151,7 @@ struct interpolateNewWaveData : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1292,6 +1214,7 @@ struct interpolateNewWaveData : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("interpolateNewWaveData");
   };
   void run()
   {
@@ -1359,6 +1282,7 @@ struct addSeed : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1388,6 +1312,7 @@ struct addSeed : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("addSeed");
   };
   void run()
   {
@@ -1416,6 +1341,7 @@ struct computeSurfaceWaveNormal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1490,6 +1416,7 @@ struct computeSurfaceWaveNormal : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceWaveNormal");
   };
   void run()
   {
@@ -1518,6 +1445,7 @@ struct computeSurfaceWaveLaplacians : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1589,6 +1517,7 @@ struct computeSurfaceWaveLaplacians : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceWaveLaplacians");
   };
   void run()
   {
@@ -1619,6 +1548,7 @@ struct evolveWave : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1665,6 +1595,7 @@ struct evolveWave : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("evolveWave");
   };
   void run()
   {
@@ -1692,6 +1623,7 @@ struct computeSurfaceCurvature : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1742,6 +1674,7 @@ struct computeSurfaceCurvature : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceCurvature");
   };
   void run()
   {
@@ -1767,6 +1700,7 @@ struct smoothCurvature : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1802,6 +1736,7 @@ struct smoothCurvature : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("smoothCurvature");
   };
   void run()
   {
@@ -1831,6 +1766,7 @@ struct seedWaves : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1886,6 +1822,7 @@ struct seedWaves : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("seedWaves");
   };
   void run()
   {
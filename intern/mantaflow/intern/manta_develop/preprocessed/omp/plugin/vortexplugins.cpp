@@ -187,6 +187,7 @@ struct KnAcceleration : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MACGrid &a, const MACGrid &v1, const MACGrid &v0, const Real idt)
   {
@@ -218,6 +219,7 @@ struct KnAcceleration : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAcceleration");
   };
   void run()
   {
@@ -162,6 +162,7 @@ struct KnInterpolateMACGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -213,6 +214,7 @@ struct KnInterpolateMACGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnInterpolateMACGrid");
   };
   void run()
   {
@@ -315,6 +317,7 @@ struct knApplySimpleNoiseVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -363,6 +366,7 @@ struct knApplySimpleNoiseVec3 : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knApplySimpleNoiseVec3");
   };
   void run()
   {
@@ -461,6 +465,7 @@ struct knApplySimpleNoiseReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -509,6 +514,7 @@ struct knApplySimpleNoiseReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knApplySimpleNoiseReal");
   };
   void run()
   {
@@ -615,6 +621,7 @@ struct knApplyNoiseVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -712,6 +719,7 @@ struct knApplyNoiseVec3 : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knApplyNoiseVec3");
   };
   void run()
   {
@@ -848,6 +856,7 @@ struct KnApplyComputeEnergy : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, const MACGrid &vel, Grid<Real> &energy)
@@ -880,6 +889,7 @@ struct KnApplyComputeEnergy : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyComputeEnergy");
   };
   void run()
   {
@@ -1037,6 +1047,7 @@ struct KnComputeStrainRateMag : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const MACGrid &vel, const Grid<Vec3> &velCenter, Grid<Real> &prod)
@@ -1082,6 +1093,7 @@ struct KnComputeStrainRateMag : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnComputeStrainRateMag");
   };
   void run()
   {
@@ -37,6 +37,7 @@ struct knCalcSecDeriv2d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Real> &v, Grid<Real> &ret)
   {
@@ -59,6 +60,7 @@ struct knCalcSecDeriv2d : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCalcSecDeriv2d");
   };
   void run()
   {
@@ -137,6 +139,7 @@ struct knTotalSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &h, double &sum)
   {
@@ -161,6 +164,7 @@ struct knTotalSum : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knTotalSum");
   };
   void run()
   {
@@ -296,6 +300,7 @@ struct MakeRhsWE : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -349,6 +354,7 @@ struct MakeRhsWE : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MakeRhsWE");
   };
   void run()
   {
@@ -40,13 +40,18 @@ extern void PbRegister_extrapolateMACSimple();
 extern void PbRegister_extrapolateMACFromWeight();
 extern void PbRegister_extrapolateLsSimple();
 extern void PbRegister_extrapolateVec3Simple();
+extern void PbRegister_setAsyncWriter();
+extern void PbRegister_saveAsync();
+extern void PbRegister_flushAsyncWrites();
 extern void PbRegister_getUniFileSize();
 extern void PbRegister_printUniFileInfoString();
 extern void PbRegister_getNpzFileSize();
 extern void PbRegister_quantizeGrid();
 extern void PbRegister_quantizeGridVec3();
+extern void PbRegister_saveQuantized();
 extern void PbRegister_resetPhiInObs();
 extern void PbRegister_advectSemiLagrange();
+extern void PbRegister_advectSemiLagrangeMulti();
 extern void PbRegister_addGravity();
 extern void PbRegister_addGravityNoScale();
 extern void PbRegister_addBuoyancy();
@@ -83,6 +88,7 @@ extern void PbRegister_flipVelocityUpdate();
 extern void PbRegister_combineGridVel();
 extern void PbRegister_getLaplacian();
 extern void PbRegister_getCurvature();
+extern void PbRegister_sortParticlesByTile();
 extern void PbRegister_processBurn();
 extern void PbRegister_updateFlame();
 extern void PbRegister_getSpiralVelocity();
@@ -118,6 +124,7 @@ extern void PbRegister_smoothMesh();
 extern void PbRegister_subdivideMesh();
 extern void PbRegister_killSmallComponents();
 extern void PbRegister_releaseMG();
+extern void PbRegister_resetPressureWarmStart();
 extern void PbRegister_computePressureRhs();
 extern void PbRegister_solvePressureSystem();
 extern void PbRegister_correctVelocity();
@@ -126,6 +133,8 @@ extern void PbRegister_addForcePvel();
 extern void PbRegister_updateVelocityFromDeltaPos();
 extern void PbRegister_eulerStep();
 extern void PbRegister_setPartType();
+extern void PbRegister_setKernelScheduling();
+extern void PbRegister_benchmarkKernelScheduling();
 extern void PbRegister_flipComputeSecondaryParticlePotentials();
 extern void PbRegister_flipSampleSecondaryParticles();
 extern void PbRegister_flipUpdateSecondaryParticles();
@@ -232,13 +241,18 @@ void MantaEnsureRegistration()
   PbRegister_extrapolateMACFromWeight();
   PbRegister_extrapolateLsSimple();
   PbRegister_extrapolateVec3Simple();
+  PbRegister_setAsyncWriter();
+  PbRegister_saveAsync();
+  PbRegister_flushAsyncWrites();
   PbRegister_getUniFileSize();
   PbRegister_printUniFileInfoString();
   PbRegister_getNpzFileSize();
   PbRegister_quantizeGrid();
   PbRegister_quantizeGridVec3();
+  PbRegister_saveQuantized();
   PbRegister_resetPhiInObs();
   PbRegister_advectSemiLagrange();
+  PbRegister_advectSemiLagrangeMulti();
   PbRegister_addGravity();
   PbRegister_addGravityNoScale();
   PbRegister_addBuoyancy();
@@ -275,6 +289,7 @@ void MantaEnsureRegistration()
   PbRegister_combineGridVel();
   PbRegister_getLaplacian();
   PbRegister_getCurvature();
+  PbRegister_sortParticlesByTile();
   PbRegister_processBurn();
   PbRegister_updateFlame();
   PbRegister_getSpiralVelocity();
@@ -310,6 +325,7 @@ void MantaEnsureRegistration()
   PbRegister_subdivideMesh();
   PbRegister_killSmallComponents();
   PbRegister_releaseMG();
+  PbRegister_resetPressureWarmStart();
   PbRegister_computePressureRhs();
   PbRegister_solvePressureSystem();
   PbRegister_correctVelocity();
@@ -318,6 +334,8 @@ void MantaEnsureRegistration()
   PbRegister_updateVelocityFromDeltaPos();
   PbRegister_eulerStep();
   PbRegister_setPartType();
+  PbRegister_setKernelScheduling();
+  PbRegister_benchmarkKernelScheduling();
   PbRegister_flipComputeSecondaryParticlePotentials();
   PbRegister_flipSampleSecondaryParticles();
   PbRegister_flipUpdateSecondaryParticles();
@@ -51,6 +51,7 @@ template<class T> struct ApplyShapeToGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<T> *grid, Shape *shape, T value, FlagGrid *respectFlags)
   {
@@ -85,6 +86,7 @@ template<class T> struct ApplyShapeToGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyShapeToGrid");
   };
   void run()
   {
@@ -135,6 +137,7 @@ template<class T> struct ApplyShapeToGridSmooth : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -190,6 +193,7 @@ template<class T> struct ApplyShapeToGridSmooth : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyShapeToGridSmooth");
   };
   void run()
   {
@@ -235,6 +239,7 @@ struct ApplyShapeToMACGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, MACGrid *grid, Shape *shape, Vec3 value, FlagGrid *respectFlags)
@@ -274,6 +279,7 @@ struct ApplyShapeToMACGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyShapeToMACGrid");
   };
   void run()
   {
@@ -439,6 +445,7 @@ struct BoxSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &phi, const Vec3 &p1, const Vec3 &p2)
   {
@@ -522,6 +529,7 @@ struct BoxSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("BoxSDF");
   };
   void run()
   {
@@ -661,6 +669,7 @@ struct SphereSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &phi, Vec3 center, Real radius, Vec3 scale)
   {
@@ -692,6 +701,7 @@ struct SphereSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SphereSDF");
   };
   void run()
   {
@@ -791,6 +801,7 @@ struct CylinderSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, Grid<Real> &phi, Vec3 center, Real radius, Vec3 zaxis, Real maxz)
@@ -845,6 +856,7 @@ struct CylinderSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CylinderSDF");
   };
   void run()
   {
@@ -942,6 +954,7 @@ struct SlopeSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const Vec3 &n, Grid<Real> &phiObs, const Real &fac, const Real &origin)
@@ -975,6 +988,7 @@ struct SlopeSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SlopeSDF");
   };
   void run()
   {
@@ -20,7 +20,10 @@
 #define _TIMING_H
 
 #include "manta.h"
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <stdint.h>
 namespace Manta {
 
 class TimingData {
@@ -60,6 +63,79 @@ class TimingData {
   std::map<std::string, std::vector<TimingSet>> mData;
 };
 
+//! Hierarchical profiler for plugins and kernels. Every thread records its scopes into its own
+//! fixed size ring buffer (the oldest scopes get overwritten) and interns plugin names in its
+//! buffer, so recording never locks and only allocates for a new thread or plugin name.
+//! Disabled by default, a scope then costs one branch. Summaries and traces may be read while
+//! other threads record, e.g. async cache writers, scopes those overwrite meanwhile are skipped
+class ProfileData {
+ public:
+  //! a finished plugin or kernel scope, times in ns since the profiler was enabled
+  struct Scope {
+    const char *name;
+    bool kernel;
+    int depth;
+    IndexInt range;  // kernel iterations, 0 for plugins
+    int64_t begin, end;
+    int64_t child;  // time spent in nested scopes of the same thread
+    int64_t cpu;    // process cpu time used during the scope, by all threads
+  };
+  //! accumulated scopes with the same name, times in ms
+  struct Summary {
+    Summary() : kernel(false), calls(0), range(0), total(0), self(0), utilization(0)
+    {
+    }
+    std::string name;
+    bool kernel;
+    int calls;
+    IndexInt range;
+    double total, self;
+    //! process cpu time / (wall time * threads), 0 to 1. Counts all threads of the process,
+    //! i.e. also workers spinning for work and concurrent scopes of other threads
+    double utilization;
+  };
+
+  static ProfileData &instance()
+  {
+    static ProfileData a;
+    return a;
+  }
+  static inline bool enabled()
+  {
+    return sEnabled;
+  }
+
+  //! enabling clears all recorded scopes, bufferSize is the number of scopes kept per thread
+  void enable(bool on, int bufferSize = 65536);
+
+  void beginPlugin(const std::string &name);
+  void endPlugin(const std::string &name);
+  void beginKernel(const char *name, IndexInt range);
+  void endKernel();
+
+  //! scopes finished since the last summary with reset, sorted by total time
+  std::vector<Summary> summary(bool reset = true);
+  std::string summaryString(bool reset = true);
+  //! write all buffered scopes as Chrome trace event JSON (chrome://tracing, Perfetto)
+  void saveTrace(const std::string &filename);
+
+ private:
+  ProfileData();
+  struct ThreadBuffer;
+  ThreadBuffer *threadBuffer();
+  void begin(const char *name, bool kernel, IndexInt range);
+  void end();
+  static bool readScope(ThreadBuffer *b, uint64_t n, Scope &s);
+
+  static std::atomic<bool> sEnabled;
+  static thread_local ThreadBuffer *sBuffer;
+  int mBufferSize;
+  int mThreads;
+  int64_t mEpoch;
+  std::mutex mMutex;
+  std::vector<ThreadBuffer *> mBuffers;
+};
+
 // Python interface
 class Timings : public PbClass {
  public:
@@ -146,6 +222,96 @@ class Timings : public PbClass {
     }
   }
 
+  //! record plugin and kernel scopes, bufferSize is the number of scopes kept per thread
+  void enableProfiler(bool enable = true, int bufferSize = 65536)
+  {
+    ProfileData::instance().enable(enable, bufferSize);
+  }
+  static PyObject *_W_3(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+  {
+    try {
+      PbArgs _args(_linargs, _kwds);
+      Timings *pbo = dynamic_cast<Timings *>(Pb::objFromPy(_self));
+      bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+      pbPreparePlugin(pbo->getParent(), "Timings::enableProfiler", !noTiming);
+      PyObject *_retval = 0;
+      {
+        ArgLocker _lock;
+        bool enable = _args.getOpt<bool>("enable", 0, true, &_lock);
+        int bufferSize = _args.getOpt<int>("bufferSize", 1, 65536, &_lock);
+        pbo->_args.copy(_args);
+        _retval = getPyNone();
+        pbo->enableProfiler(enable, bufferSize);
+        pbo->_args.check();
+      }
+      pbFinalizePlugin(pbo->getParent(), "Timings::enableProfiler", !noTiming);
+      return _retval;
+    }
+    catch (std::exception &e) {
+      pbSetError("Timings::enableProfiler", e.what());
+      return 0;
+    }
+  }
+
+  //! write the recorded scopes as Chrome trace event JSON
+  void saveTrace(std::string file)
+  {
+    ProfileData::instance().saveTrace(file);
+  }
+  static PyObject *_W_4(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+  {
+    try {
+      PbArgs _args(_linargs, _kwds);
+      Timings *pbo = dynamic_cast<Timings *>(Pb::objFromPy(_self));
+      bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+      pbPreparePlugin(pbo->getParent(), "Timings::saveTrace", !noTiming);
+      PyObject *_retval = 0;
+      {
+        ArgLocker _lock;
+        std::string file = _args.get<std::string>("file", 0, &_lock);
+        pbo->_args.copy(_args);
+        _retval = getPyNone();
+        pbo->saveTrace(file);
+        pbo->_args.check();
+      }
+      pbFinalizePlugin(pbo->getParent(), "Timings::saveTrace", !noTiming);
+      return _retval;
+    }
+    catch (std::exception &e) {
+      pbSetError("Timings::saveTrace", e.what());
+      return 0;
+    }
+  }
+
+  //! table of the scopes recorded since the last reset, sorted by total time
+  std::string profileSummary(bool reset = true)
+  {
+    return ProfileData::instance().summaryString(reset);
+  }
+  static PyObject *_W_5(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+  {
+    try {
+      PbArgs _args(_linargs, _kwds);
+      Timings *pbo = dynamic_cast<Timings *>(Pb::objFromPy(_self));
+      bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+      pbPreparePlugin(pbo->getParent(), "Timings::profileSummary", !noTiming);
+      PyObject *_retval = 0;
+      {
+        ArgLocker _lock;
+        bool reset = _args.getOpt<bool>("reset", 0, true, &_lock);
+        pbo->_args.copy(_args);
+        _retval = toPy(pbo->profileSummary(reset));
+        pbo->_args.check();
+      }
+      pbFinalizePlugin(pbo->getParent(), "Timings::profileSummary", !noTiming);
+      return _retval;
+    }
+    catch (std::exception &e) {
+      pbSetError("Timings::profileSummary", e.what());
+      return 0;
+    }
+  }
+
  public:
   PbArgs _args;
 }
@@ -11,6 +11,9 @@ template<> const char *Namify<Timings>::S = "Timings";
 static const Pb::Register _R_17("Timings", "Timings", Timings::_W_0);
 static const Pb::Register _R_18("Timings", "display", Timings::_W_1);
 static const Pb::Register _R_19("Timings", "saveMean", Timings::_W_2);
+static const Pb::Register _R_20("Timings", "enableProfiler", Timings::_W_3);
+static const Pb::Register _R_21("Timings", "saveTrace", Timings::_W_4);
+static const Pb::Register _R_22("Timings", "profileSummary", Timings::_W_5);
 #endif
 extern "C" {
 void PbRegister_file_16()
@@ -19,6 +22,9 @@ void PbRegister_file_16()
   KEEP_UNUSED(_R_17);
   KEEP_UNUSED(_R_18);
   KEEP_UNUSED(_R_19);
+  KEEP_UNUSED(_R_20);
+  KEEP_UNUSED(_R_21);
+  KEEP_UNUSED(_R_22);
 }
 }
 }  // namespace Manta
\ No newline at end of file
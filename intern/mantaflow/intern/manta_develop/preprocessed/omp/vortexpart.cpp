@@ -66,6 +66,7 @@ struct KnVpAdvectMesh : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  vector<Node> &nodes,
@@ -107,6 +108,7 @@ struct KnVpAdvectMesh : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnVpAdvectMesh");
   };
   void run()
   {
@@ -131,6 +133,7 @@ struct KnVpAdvectSelf : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, vector<VortexParticleData> &vp, Real scale, vector<Vec3> &u)
   {
@@ -163,6 +166,7 @@ struct KnVpAdvectSelf : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnVpAdvectSelf");
   };
   void run()
   {
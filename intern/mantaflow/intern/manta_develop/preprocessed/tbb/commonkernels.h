@@ -33,6 +33,7 @@ struct InvertCheckFluid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const FlagGrid &flags, Grid<Real> &grid) const
   {
@@ -55,6 +56,7 @@ struct InvertCheckFluid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("InvertCheckFluid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -76,6 +78,7 @@ struct GridSumSqr : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &grid, double &sum)
   {
@@ -100,6 +103,7 @@ struct GridSumSqr : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GridSumSqr");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -128,6 +132,7 @@ struct CurlOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Vec3> &grid, Grid<Vec3> &dst) const
   {
@@ -159,6 +164,7 @@ struct CurlOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CurlOp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -177,8 +183,19 @@ struct CurlOp : public KernelBase {
           op(i, j, k, grid, dst);
     }
   }
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1) const
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, grid, dst);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     if (maxZ > 1)
       tbb::parallel_for(tbb::blocked_range<IndexInt>(minZ, maxZ), *this);
     else
@@ -196,6 +213,7 @@ struct DivergenceOpMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &div, const MACGrid &grid) const
   {
@@ -222,6 +240,7 @@ struct DivergenceOpMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("DivergenceOpMAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -240,8 +259,19 @@ struct DivergenceOpMAC : public KernelBase {
           op(i, j, k, div, grid);
     }
   }
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1) const
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, div, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     if (maxZ > 1)
       tbb::parallel_for(tbb::blocked_range<IndexInt>(minZ, maxZ), *this);
     else
@@ -258,6 +288,7 @@ struct GradientOpMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, MACGrid &gradient, const Grid<Real> &grid) const
   {
@@ -284,6 +315,7 @@ struct GradientOpMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GradientOpMAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -302,8 +334,19 @@ struct GradientOpMAC : public KernelBase {
           op(i, j, k, gradient, grid);
     }
   }
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1) const
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, gradient, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     if (maxZ > 1)
       tbb::parallel_for(tbb::blocked_range<IndexInt>(minZ, maxZ), *this);
     else
@@ -320,6 +363,7 @@ struct GradientOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &gradient, const Grid<Real> &grid) const
   {
@@ -346,6 +390,7 @@ struct GradientOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GradientOp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -364,8 +409,19 @@ struct GradientOp : public KernelBase {
           op(i, j, k, gradient, grid);
     }
   }
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1) const
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, gradient, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     if (maxZ > 1)
       tbb::parallel_for(tbb::blocked_range<IndexInt>(minZ, maxZ), *this);
     else
@@ -382,6 +438,7 @@ struct LaplaceOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &laplace, const Grid<Real> &grid) const
   {
@@ -407,6 +464,7 @@ struct LaplaceOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("LaplaceOp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -425,8 +483,19 @@ struct LaplaceOp : public KernelBase {
           op(i, j, k, laplace, grid);
     }
   }
+  void runTile(int i0, int i1, int j0, int j1, int k0, int k1) const
+  {
+    for (int k = k0; k < k1; k++)
+      for (int j = j0; j < j1; j++)
+        for (int i = i0; i < i1; i++)
+          op(i, j, k, laplace, grid);
+  }
   void run()
   {
+    if (maxZ > 1 && gKernelScheduling.blocked3D) {
+      runBlocked3D(*this);
+      return;
+    }
     if (maxZ > 1)
       tbb::parallel_for(tbb::blocked_range<IndexInt>(minZ, maxZ), *this);
     else
@@ -443,6 +512,7 @@ struct CurvatureOp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &curv, const Grid<Real> &grid, const Real h) const
   {
@@ -498,6 +568,7 @@ struct CurvatureOp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CurvatureOp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -535,6 +606,7 @@ struct GetShiftedComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Vec3> &grid, Grid<Real> &comp, int dim) const
   {
@@ -563,6 +635,7 @@ struct GetShiftedComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetShiftedComponent");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -601,6 +674,7 @@ struct GetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &grid, Grid<Real> &comp, int dim) const
   {
@@ -627,6 +701,7 @@ struct GetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetComponent");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -649,6 +724,7 @@ struct GridNorm : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Real> &n, const Grid<Vec3> &grid) const
   {
@@ -670,6 +746,7 @@ struct GridNorm : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GridNorm");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -692,6 +769,7 @@ struct SetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Vec3> &grid, const Grid<Real> &comp, int dim) const
   {
@@ -718,6 +796,7 @@ struct SetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SetComponent");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -741,6 +820,7 @@ struct GetCentered : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &center, const MACGrid &vel) const
   {
@@ -767,6 +847,7 @@ struct GetCentered : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetCentered");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -803,6 +884,7 @@ struct GetMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, MACGrid &vel, const Grid<Vec3> &center) const
   {
@@ -829,6 +911,7 @@ struct GetMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GetMAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -865,6 +948,7 @@ struct FillInBoundary : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &grid, int g) const
   {
@@ -897,6 +981,7 @@ struct FillInBoundary : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("FillInBoundary");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -938,6 +1023,7 @@ struct kn_conv_mex_in_to_MAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const double *p_lin_array, MACGrid *p_result) const
   {
@@ -964,6 +1050,7 @@ struct kn_conv_mex_in_to_MAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_mex_in_to_MAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -999,6 +1086,7 @@ struct kn_conv_MAC_to_mex_out : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid *p_mac, double *p_result) const
   {
@@ -1025,6 +1113,7 @@ struct kn_conv_MAC_to_mex_out : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_MAC_to_mex_out");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1062,6 +1151,7 @@ struct kn_conv_mex_in_to_Vec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const double *p_lin_array, Grid<Vec3> *p_result) const
   {
@@ -1088,6 +1178,7 @@ struct kn_conv_mex_in_to_Vec3 : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_mex_in_to_Vec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1123,6 +1214,7 @@ struct kn_conv_Vec3_to_mex_out : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Vec3> *p_Vec3, double *p_result) const
   {
@@ -1149,6 +1241,7 @@ struct kn_conv_Vec3_to_mex_out : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_Vec3_to_mex_out");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1186,6 +1279,7 @@ struct kn_conv_mex_in_to_Real : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const double *p_lin_array, Grid<Real> *p_result) const
   {
@@ -1209,6 +1303,7 @@ struct kn_conv_mex_in_to_Real : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_mex_in_to_Real");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1244,6 +1339,7 @@ struct kn_conv_Real_to_mex_out : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Real> *p_grid, double *p_result) const
   {
@@ -1267,6 +1363,7 @@ struct kn_conv_Real_to_mex_out : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn_conv_Real_to_mex_out");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -27,6 +27,51 @@ const int CG_DEBUGLEVEL = 3;
 //*****************************************************************************
 //  Precondition helpers
 
+//! Serial loop over all cells, or only those of active tiles, in (z, y, x) order or reversed
+/*! Visiting tiles in order keeps the i-1, j-1, k-1 neighbors of a cell ahead of it, so the
+ *  triangular solves below give the same result as with a full grid sweep */
+template<class FUNC>
+static void loopCellsOrdered(const Grid<Real> &grid,
+                             const TileMask *tiles,
+                             bool reverse,
+                             const FUNC &func)
+{
+  if (!tiles) {
+    if (!reverse) {
+      FOR_IJK(grid)
+      {
+        func(i, j, k);
+      }
+    }
+    else {
+      FOR_IJK_REVERSE(grid)
+      {
+        func(i, j, k);
+      }
+    }
+    return;
+  }
+
+  const std::vector<int> &list = tiles->getActiveTiles();
+  const int num = (int)list.size();
+  for (int n = 0; n < num; n++) {
+    Vec3i lo, hi;
+    tiles->getTileBounds(list[reverse ? num - 1 - n : n], lo, hi);
+    if (!reverse) {
+      for (int k = lo.z; k < hi.z; k++)
+        for (int j = lo.y; j < hi.y; j++)
+          for (int i = lo.x; i < hi.x; i++)
+            func(i, j, k);
+    }
+    else {
+      for (int k = hi.z - 1; k >= lo.z; k--)
+        for (int j = hi.y - 1; j >= lo.y; j--)
+          for (int i = hi.x - 1; i >= lo.x; i--)
+            func(i, j, k);
+    }
+  }
+}
+
 //! Preconditioning a la Wavelet Turbulence (needs 4 add. grids)
 void InitPreconditionIncompCholesky(const FlagGrid &flags,
                                     Grid<Real> &A0,
@@ -134,28 +179,27 @@ void ApplyPreconditionIncompCholesky(Grid<Real> &dst,
                                      Grid<Real> &orgA0,
                                      Grid<Real> &orgAi,
                                      Grid<Real> &orgAj,
-                                     Grid<Real> &orgAk)
+                                     Grid<Real> &orgAk,
+                                     const TileMask *tiles = nullptr)
 {
 
   // forward substitution
-  FOR_IJK(dst)
-  {
+  loopCellsOrdered(dst, tiles, false, [&](int i, int j, int k) {
     if (!flags.isFluid(i, j, k))
-      continue;
+      return;
     dst(i, j, k) = A0(i, j, k) *
                    (Var1(i, j, k) - dst(i - 1, j, k) * Ai(i - 1, j, k) -
                     dst(i, j - 1, k) * Aj(i, j - 1, k) - dst(i, j, k - 1) * Ak(i, j, k - 1));
-  }
+  });
 
   // backward substitution
-  FOR_IJK_REVERSE(dst)
-  {
+  loopCellsOrdered(dst, tiles, true, [&](int i, int j, int k) {
     const IndexInt idx = A0.index(i, j, k);
     if (!flags.isFluid(idx))
-      continue;
+      return;
     dst[idx] = A0[idx] * (dst[idx] - dst(i + 1, j, k) * Ai[idx] - dst(i, j + 1, k) * Aj[idx] -
                           dst(i, j, k + 1) * Ak[idx]);
-  }
+  });
 }
 
 //! Apply Bridson-style mICP
@@ -166,30 +210,29 @@ void ApplyPreconditionModifiedIncompCholesky2(Grid<Real> &dst,
                                               Grid<Real> &A0,
                                               Grid<Real> &Ai,
                                               Grid<Real> &Aj,
-                                              Grid<Real> &Ak)
+                                              Grid<Real> &Ak,
+                                              const TileMask *tiles = nullptr)
 {
   // forward substitution
-  FOR_IJK(dst)
-  {
+  loopCellsOrdered(dst, tiles, false, [&](int i, int j, int k) {
     if (!flags.isFluid(i, j, k))
-      continue;
+      return;
     const Real p = Aprecond(i, j, k);
     dst(i, j, k) = p *
                    (Var1(i, j, k) - dst(i - 1, j, k) * Ai(i - 1, j, k) * Aprecond(i - 1, j, k) -
                     dst(i, j - 1, k) * Aj(i, j - 1, k) * Aprecond(i, j - 1, k) -
                     dst(i, j, k - 1) * Ak(i, j, k - 1) * Aprecond(i, j, k - 1));
-  }
+  });
 
   // backward substitution
-  FOR_IJK_REVERSE(dst)
-  {
+  loopCellsOrdered(dst, tiles, true, [&](int i, int j, int k) {
     const IndexInt idx = A0.index(i, j, k);
     if (!flags.isFluid(idx))
-      continue;
+      return;
     const Real p = Aprecond[idx];
     dst[idx] = p * (dst[idx] - dst(i + 1, j, k) * Ai[idx] * p - dst(i, j + 1, k) * Aj[idx] * p -
                     dst(i, j, k + 1) * Ak[idx] * p);
-  }
+  });
 }
 
 //! Perform one Multigrid VCycle
@@ -212,6 +255,7 @@ struct GridDotProduct : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &a, const Grid<Real> &b, double &result)
   {
@@ -241,6 +285,7 @@ struct GridDotProduct : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("GridDotProduct");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -272,6 +317,7 @@ struct InitSigma : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const FlagGrid &flags,
@@ -321,6 +367,7 @@ struct InitSigma : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("InitSigma");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -355,6 +402,7 @@ struct UpdateSearchVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Real> &dst, Grid<Real> &src, Real factor) const
   {
@@ -381,6 +429,7 @@ struct UpdateSearchVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("UpdateSearchVec");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -396,6 +445,318 @@ struct UpdateSearchVec : public KernelBase {
   Real factor;
 };
 
+//*****************************************************************************
+// Compact stencil variants of the CG operations. The matrix is stored as diagonal A0 plus one
+// byte of neighbor bits per cell, vector operations use the SIMD row kernels of simdops.h and
+// accumulate reductions in double. Loops only run over spans of interior cells, as fluid cells
+// at the domain boundary are rejected by buildCompactStencil.
+
+//! Parallel loop over all spans, func(n, span)
+template<class FUNC> static void cgForEachSpan(const std::vector<CgSpan> &spans, const FUNC &func)
+{
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, spans.size()),
+                    [&](const tbb::blocked_range<size_t> &r) {
+                      for (size_t n = r.begin(); n != r.end(); n++)
+                        func(n, spans[n]);
+                    });
+}
+
+//! Run func(idx, n) for all x-rows of a span, idx is the first cell of a row with n cells
+template<class FUNC>
+static inline void cgForEachRow(const Grid<Real> &grid, const CgSpan &span, const FUNC &func)
+{
+  const int n = span.hi.x - span.lo.x;
+  for (int k = span.lo.z; k < span.hi.z; k++)
+    for (int j = span.lo.y; j < span.hi.y; j++)
+      func(grid.index(span.lo.x, j, k), n);
+}
+
+//! Sum of double-valued func(span) over all spans, independent of the number of threads
+template<class FUNC>
+static double cgSumSpans(const std::vector<CgSpan> &spans, const FUNC &func)
+{
+  std::vector<double> partial(spans.size(), 0.);
+  cgForEachSpan(spans, [&](size_t n, const CgSpan &span) { partial[n] = func(span); });
+  double sum = 0.;
+  for (size_t n = 0; n < partial.size(); n++)
+    sum += partial[n];
+  return sum;
+}
+
+bool buildCompactStencil(const FlagGrid &flags,
+                         const Grid<Real> &Ai,
+                         const Grid<Real> &Aj,
+                         const Grid<Real> &Ak,
+                         std::vector<unsigned char> &stencil)
+{
+  const Vec3i size = flags.getSize();
+  const bool is3D = flags.is3D();
+  const IndexInt X = flags.getStrideX(), Y = flags.getStrideY(), Z = flags.getStrideZ();
+  stencil.assign((size_t)size.x * size.y * size.z, 0);
+
+  // one task per slice, each one records whether its coefficients fit into the compact format
+  std::vector<CgSpan> slices(size.z);
+  for (int k = 0; k < size.z; k++) {
+    slices[k].lo = Vec3i(0, 0, k);
+    slices[k].hi = Vec3i(size.x, size.y, k + 1);
+  }
+  std::vector<char> valid(size.z, 1);
+  cgForEachSpan(slices, [&](size_t n, const CgSpan &span) {
+    const int k = span.lo.z;
+    for (int j = 0; j < size.y; j++)
+      for (int i = 0; i < size.x; i++) {
+        const IndexInt idx = flags.index(i, j, k);
+        if (!flags.isFluid(idx))
+          continue;
+        // the stencil kernels do not check bounds, fluid cells need all neighbors
+        if (i == 0 || j == 0 || i == size.x - 1 || j == size.y - 1 ||
+            (is3D && (k == 0 || k == size.z - 1))) {
+          valid[n] = 0;
+          return;
+        }
+        const Real coeff[6] = {Ai[idx],
+                               Ai[idx - X],
+                               Aj[idx],
+                               Aj[idx - Y],
+                               is3D ? Ak[idx] : Real(0),
+                               is3D ? Ak[idx - Z] : Real(0)};
+        unsigned char bits = StencilFluid;
+        for (int c = 0; c < 6; c++) {
+          if (coeff[c] == Real(-1))
+            bits |= (1 << c);
+          else if (coeff[c] != Real(0)) {
+            valid[n] = 0;
+            return;
+          }
+        }
+        stencil[idx] = bits;
+      }
+  });
+  return std::find(valid.begin(), valid.end(), 0) == valid.end();
+}
+
+//! Split the interior cells into spans, one per slice, or one per x-run of active tiles
+static void cgBuildSpans(const Grid<Real> &grid, const TileMask *tiles, std::vector<CgSpan> &spans)
+{
+  const Vec3i size = grid.getSize();
+  const Vec3i lo(1, 1, grid.is3D() ? 1 : 0);
+  const Vec3i hi(size.x - 1, size.y - 1, grid.is3D() ? size.z - 1 : 1);
+  spans.clear();
+  CgSpan span;
+  if (!tiles) {
+    for (int k = lo.z; k < hi.z; k++) {
+      span.lo = Vec3i(lo.x, lo.y, k);
+      span.hi = Vec3i(hi.x, hi.y, k + 1);
+      spans.push_back(span);
+    }
+    return;
+  }
+
+  const Vec3i res = tiles->getTileRes();
+  const int T = TileMask::TILE_SIZE;
+  for (int tz = 0; tz < res.z; tz++)
+    for (int ty = 0; ty < res.y; ty++) {
+      const int rowStart = res.x * (ty + res.y * tz);
+      for (int tx = 0; tx < res.x;) {
+        if (!tiles->isTileActive(rowStart + tx)) {
+          tx++;
+          continue;
+        }
+        int end = tx + 1;
+        while (end < res.x && tiles->isTileActive(rowStart + end))
+          end++;
+        span.lo = Vec3i(std::max(tx * T, lo.x), std::max(ty * T, lo.y), std::max(tz * T, lo.z));
+        span.hi = Vec3i(std::min(end * T, hi.x),
+                        std::min((ty + 1) * T, hi.y),
+                        std::min((tz + 1) * T, hi.z));
+        if (span.lo.x < span.hi.x && span.lo.y < span.hi.y && span.lo.z < span.hi.z)
+          spans.push_back(span);
+        tx = end;
+      }
+    }
+}
+
+//! Apply poisson matrix with compact stencil
+static void ApplyMatrixCompact(const std::vector<CgSpan> &spans,
+                               const std::vector<unsigned char> &stencil,
+                               Grid<Real> &dst,
+                               const Grid<Real> &src,
+                               const Grid<Real> &A0)
+{
+  const bool is3D = dst.is3D();
+  const IndexInt Y = dst.getStrideY(), Z = dst.getStrideZ();
+  Real *d = dst.getData();
+  const Real *s = src.getData(), *a0 = A0.getData();
+  cgForEachSpan(spans, [&](size_t, const CgSpan &span) {
+    cgForEachRow(dst, span, [&](IndexInt idx, int n) {
+      simdStencilRow(d + idx, s + idx, a0 + idx, &stencil[idx], n, Y, Z, is3D);
+    });
+  });
+}
+
+//*****************************************************************************
+// Active tile variants of the CG vector operations. All CG vectors are zero in non-fluid cells,
+// so skipping tiles without fluid cells does not change the result.
+
+//! Apply poisson matrix on active tiles only, same as ApplyMatrix / ApplyMatrix2D
+static void ApplyMatrixTiles(const TileMask &tiles,
+                             const FlagGrid &flags,
+                             Grid<Real> &dst,
+                             const Grid<Real> &src,
+                             const Grid<Real> &A0,
+                             const Grid<Real> &Ai,
+                             const Grid<Real> &Aj,
+                             const Grid<Real> &Ak)
+{
+  const bool is3D = flags.is3D();
+  const IndexInt X = flags.getStrideX(), Y = flags.getStrideY(), Z = flags.getStrideZ();
+  tiles.forEachActiveTile([&](const Vec3i &lo, const Vec3i &hi) {
+    for (int k = lo.z; k < hi.z; k++)
+      for (int j = lo.y; j < hi.y; j++) {
+        IndexInt idx = flags.index(lo.x, j, k);
+        for (int i = lo.x; i < hi.x; i++, idx++) {
+          if (!flags.isFluid(idx)) {
+            dst[idx] = src[idx];
+            continue;
+          }
+          Real sum = src[idx] * A0[idx] + src[idx - X] * Ai[idx - X] + src[idx + X] * Ai[idx] +
+                     src[idx - Y] * Aj[idx - Y] + src[idx + Y] * Aj[idx];
+          if (is3D)
+            sum = sum + src[idx - Z] * Ak[idx - Z] + src[idx + Z] * Ak[idx];
+          dst[idx] = sum;
+        }
+      }
+  });
+}
+
+//! Dot product, on spans or active tiles if given
+static double cgDotProduct(const TileMask *tiles,
+                           const std::vector<CgSpan> *spans,
+                           const Grid<Real> &a,
+                           const Grid<Real> &b)
+{
+  if (spans) {
+    const Real *pa = a.getData(), *pb = b.getData();
+    return cgSumSpans(*spans, [&](const CgSpan &span) {
+      double result = 0.;
+      cgForEachRow(
+          a, span, [&](IndexInt idx, int n) { result += simdDotRow(pa + idx, pb + idx, n); });
+      return result;
+    });
+  }
+  if (!tiles)
+    return GridDotProduct(a, b);
+  return tiles->sumActiveTiles([&](const Vec3i &lo, const Vec3i &hi) {
+    double result = 0.;
+    for (int k = lo.z; k < hi.z; k++)
+      for (int j = lo.y; j < hi.y; j++)
+        for (IndexInt idx = a.index(lo.x, j, k), end = idx + hi.x - lo.x; idx < end; idx++)
+          result += (a[idx] * b[idx]);
+    return result;
+  });
+}
+
+//! dst += src * factor, on spans or active tiles if given
+static void cgScaledAdd(const TileMask *tiles,
+                        const std::vector<CgSpan> *spans,
+                        Grid<Real> &dst,
+                        const Grid<Real> &src,
+                        Real factor)
+{
+  if (spans) {
+    Real *d = dst.getData();
+    const Real *s = src.getData();
+    cgForEachSpan(*spans, [&](size_t, const CgSpan &span) {
+      cgForEachRow(dst, span, [&](IndexInt idx, int n) {
+        simdScaledAddRow(d + idx, s + idx, factor, n);
+      });
+    });
+    return;
+  }
+  if (!tiles) {
+    gridScaledAdd<Real, Real>(dst, src, factor);
+    return;
+  }
+  tiles->forEachActiveTile([&](const Vec3i &lo, const Vec3i &hi) {
+    for (int k = lo.z; k < hi.z; k++)
+      for (int j = lo.y; j < hi.y; j++)
+        for (IndexInt idx = dst.index(lo.x, j, k), end = idx + hi.x - lo.x; idx < end; idx++)
+          dst[idx] += factor * src[idx];
+  });
+}
+
+//! dst = src + factor * dst, on spans or active tiles if given
+static void cgUpdateSearchVec(const TileMask *tiles,
+                              const std::vector<CgSpan> *spans,
+                              Grid<Real> &dst,
+                              Grid<Real> &src,
+                              Real factor)
+{
+  if (spans) {
+    Real *d = dst.getData();
+    const Real *s = src.getData();
+    cgForEachSpan(*spans, [&](size_t, const CgSpan &span) {
+      cgForEachRow(dst, span, [&](IndexInt idx, int n) {
+        simdUpdateSearchRow(d + idx, s + idx, factor, n);
+      });
+    });
+    return;
+  }
+  if (!tiles) {
+    UpdateSearchVec(dst, src, factor);
+    return;
+  }
+  tiles->forEachActiveTile([&](const Vec3i &lo, const Vec3i &hi) {
+    for (int k = lo.z; k < hi.z; k++)
+      for (int j = lo.y; j < hi.y; j++)
+        for (IndexInt idx = dst.index(lo.x, j, k), end = idx + hi.x - lo.x; idx < end; idx++)
+          dst[idx] = src[idx] + factor * dst[idx];
+  });
+}
+
+//! Squared l2 norm or max norm of the residual, on spans or active tiles if given
+static Real cgResidualNorm(const TileMask *tiles,
+                           const std::vector<CgSpan> *spans,
+                           const Grid<Real> &residual,
+                           bool useL2Norm)
+{
+  const Real *r = residual.getData();
+  if (spans && useL2Norm)
+    return cgSumSpans(*spans, [&](const CgSpan &span) {
+      double result = 0.;
+      cgForEachRow(residual, span, [&](IndexInt idx, int n) {
+        result += simdSumSqrRow(r + idx, n);
+      });
+      return result;
+    });
+  if (spans) {
+    std::vector<Real> partial(spans->size(), 0.);
+    cgForEachSpan(*spans, [&](size_t s, const CgSpan &span) {
+      cgForEachRow(residual, span, [&](IndexInt idx, int n) {
+        partial[s] = std::max(partial[s], simdMaxAbsRow(r + idx, n));
+      });
+    });
+    return partial.empty() ? 0. : *std::max_element(partial.begin(), partial.end());
+  }
+  if (!tiles)
+    return useL2Norm ? GridSumSqr(residual).sum : residual.getMaxAbs();
+
+  auto tileNorm = [&](const Vec3i &lo, const Vec3i &hi) {
+    double result = 0.;
+    for (int k = lo.z; k < hi.z; k++)
+      for (int j = lo.y; j < hi.y; j++)
+        for (IndexInt idx = residual.index(lo.x, j, k), end = idx + hi.x - lo.x; idx < end;
+             idx++) {
+          if (useL2Norm)
+            result += square((double)residual[idx]);
+          else
+            result = std::max(result, (double)fabs(residual[idx]));
+        }
+    return result;
+  };
+  return useL2Norm ? tiles->sumActiveTiles(tileNorm) : tiles->maxActiveTiles(tileNorm);
+}
+
 //*****************************************************************************
 //  CG class
 
@@ -428,10 +789,14 @@ GridCg<APPLYMAT>::GridCg(Grid<Real> &dst,
       mpPCAi(nullptr),
       mpPCAj(nullptr),
       mpPCAk(nullptr),
+      mPcReuse(false),
       mMG(nullptr),
+      mpTiles(nullptr),
+      mpStencil(nullptr),
       mSigma(0.),
       mAccuracy(VECTOR_EPSILON),
-      mResNorm(1e20)
+      mResNorm(1e20),
+      mResNormInit(0.)
 {
 }
 
@@ -440,21 +805,50 @@ template<class APPLYMAT> void GridCg<APPLYMAT>::doInit()
   mInited = true;
   mIterations = 0;
 
-  mDst.clear();
-  mResidual.copyFrom(mRhs);  // p=0, residual = b
+  if (mpStencil)
+    cgBuildSpans(mDst, mpTiles, mSpans);
+  const std::vector<CgSpan> *spans = mpStencil ? &mSpans : nullptr;
+
+  if (this->mWarmStart) {
+    // residual = b - A*p for the initial guess in dst
+    if (mpStencil)
+      ApplyMatrixCompact(mSpans, *mpStencil, mTmp, mDst, *mpA0);
+    else if (mpTiles)
+      ApplyMatrixTiles(*mpTiles, mFlags, mTmp, mDst, *mpA0, *mpAi, *mpAj, *mpAk);
+    else
+      APPLYMAT(mFlags, mTmp, mDst, *mpA0, *mpAi, *mpAj, *mpAk);
+    InitSigma(mFlags, mResidual, mRhs, mTmp);
+  }
+  else {
+    mDst.clear();
+    mResidual.copyFrom(mRhs);  // p=0, residual = b
+  }
+  mResNormInit = cgResidualNorm(mpTiles, spans, mResidual, this->mUseL2Norm);
 
   if (mPcMethod == PC_ICP) {
     assertMsg(mDst.is3D(), "ICP only supports 3D grids so far");
-    InitPreconditionIncompCholesky(
-        mFlags, *mpPCA0, *mpPCAi, *mpPCAj, *mpPCAk, *mpA0, *mpAi, *mpAj, *mpAk);
-    ApplyPreconditionIncompCholesky(
-        mTmp, mResidual, mFlags, *mpPCA0, *mpPCAi, *mpPCAj, *mpPCAk, *mpA0, *mpAi, *mpAj, *mpAk);
+    if (!mPcReuse)
+      InitPreconditionIncompCholesky(
+          mFlags, *mpPCA0, *mpPCAi, *mpPCAj, *mpPCAk, *mpA0, *mpAi, *mpAj, *mpAk);
+    ApplyPreconditionIncompCholesky(mTmp,
+                                    mResidual,
+                                    mFlags,
+                                    *mpPCA0,
+                                    *mpPCAi,
+                                    *mpPCAj,
+                                    *mpPCAk,
+                                    *mpA0,
+                                    *mpAi,
+                                    *mpAj,
+                                    *mpAk,
+                                    mpTiles);
   }
   else if (mPcMethod == PC_mICP) {
     assertMsg(mDst.is3D(), "mICP only supports 3D grids so far");
-    InitPreconditionModifiedIncompCholesky2(mFlags, *mpPCA0, *mpA0, *mpAi, *mpAj, *mpAk);
+    if (!mPcReuse)
+      InitPreconditionModifiedIncompCholesky2(mFlags, *mpPCA0, *mpA0, *mpAi, *mpAj, *mpAk);
     ApplyPreconditionModifiedIncompCholesky2(
-        mTmp, mResidual, mFlags, *mpPCA0, *mpA0, *mpAi, *mpAj, *mpAk);
+        mTmp, mResidual, mFlags, *mpPCA0, *mpA0, *mpAi, *mpAj, *mpAk, mpTiles);
   }
   else if (mPcMethod == PC_MGP) {
     InitPreconditionMultigrid(mMG, *mpA0, *mpAi, *mpAj, *mpAk, mAccuracy);
@@ -466,7 +860,7 @@ template<class APPLYMAT> void GridCg<APPLYMAT>::doInit()
 
   mSearch.copyFrom(mTmp);
 
-  mSigma = GridDotProduct(mTmp, mResidual);
+  mSigma = cgDotProduct(mpTiles, spans, mTmp, mResidual);
 }
 
 template<class APPLYMAT> bool GridCg<APPLYMAT>::iterate()
@@ -480,23 +874,39 @@ template<class APPLYMAT> bool GridCg<APPLYMAT>::iterate()
   // this could reinterpret the mpA pointers (not so clean right now)
   // tmp = applyMat(search)
 
-  APPLYMAT(mFlags, mTmp, mSearch, *mpA0, *mpAi, *mpAj, *mpAk);
+  const std::vector<CgSpan> *spans = mpStencil ? &mSpans : nullptr;
+  if (mpStencil)
+    ApplyMatrixCompact(mSpans, *mpStencil, mTmp, mSearch, *mpA0);
+  else if (mpTiles)
+    ApplyMatrixTiles(*mpTiles, mFlags, mTmp, mSearch, *mpA0, *mpAi, *mpAj, *mpAk);
+  else
+    APPLYMAT(mFlags, mTmp, mSearch, *mpA0, *mpAi, *mpAj, *mpAk);
 
   // alpha = sigma/dot(tmp, search)
-  Real dp = GridDotProduct(mTmp, mSearch);
+  Real dp = cgDotProduct(mpTiles, spans, mTmp, mSearch);
   Real alpha = 0.;
   if (fabs(dp) > 0.)
     alpha = mSigma / (Real)dp;
 
-  gridScaledAdd<Real, Real>(mDst, mSearch, alpha);     // dst += search * alpha
-  gridScaledAdd<Real, Real>(mResidual, mTmp, -alpha);  // residual += tmp * -alpha
+  cgScaledAdd(mpTiles, spans, mDst, mSearch, alpha);     // dst += search * alpha
+  cgScaledAdd(mpTiles, spans, mResidual, mTmp, -alpha);  // residual += tmp * -alpha
 
   if (mPcMethod == PC_ICP)
-    ApplyPreconditionIncompCholesky(
-        mTmp, mResidual, mFlags, *mpPCA0, *mpPCAi, *mpPCAj, *mpPCAk, *mpA0, *mpAi, *mpAj, *mpAk);
+    ApplyPreconditionIncompCholesky(mTmp,
+                                    mResidual,
+                                    mFlags,
+                                    *mpPCA0,
+                                    *mpPCAi,
+                                    *mpPCAj,
+                                    *mpPCAk,
+                                    *mpA0,
+                                    *mpAi,
+                                    *mpAj,
+                                    *mpAk,
+                                    mpTiles);
   else if (mPcMethod == PC_mICP)
     ApplyPreconditionModifiedIncompCholesky2(
-        mTmp, mResidual, mFlags, *mpPCA0, *mpA0, *mpAi, *mpAj, *mpAk);
+        mTmp, mResidual, mFlags, *mpPCA0, *mpA0, *mpAi, *mpAj, *mpAk, mpTiles);
   else if (mPcMethod == PC_MGP)
     ApplyPreconditionMultigrid(mMG, mTmp, mResidual);
   else
@@ -504,12 +914,7 @@ template<class APPLYMAT> bool GridCg<APPLYMAT>::iterate()
 
   // use the l2 norm of the residual for convergence check? (usually max norm is recommended
   // instead)
-  if (this->mUseL2Norm) {
-    mResNorm = GridSumSqr(mResidual).sum;
-  }
-  else {
-    mResNorm = mResidual.getMaxAbs();
-  }
+  mResNorm = cgResidualNorm(mpTiles, spans, mResidual, this->mUseL2Norm);
 
   // abort here to safe some work...
   if (mResNorm < mAccuracy) {
@@ -517,11 +922,11 @@ template<class APPLYMAT> bool GridCg<APPLYMAT>::iterate()
     return false;
   }
 
-  Real sigmaNew = GridDotProduct(mTmp, mResidual);
+  Real sigmaNew = cgDotProduct(mpTiles, spans, mTmp, mResidual);
   Real beta = sigmaNew / mSigma;
 
   // search =  tmp + beta * search
-  UpdateSearchVec(mSearch, mTmp, beta);
+  cgUpdateSearchVec(mpTiles, spans, mSearch, mTmp, beta);
 
   debMsg("GridCg::iterate i=" << mIterations << " sigmaNew=" << sigmaNew << " sigmaLast=" << mSigma
                               << " alpha=" << alpha << " beta=" << beta << " ",
@@ -558,8 +963,12 @@ template<class APPLYMAT> void GridCg<APPLYMAT>::solve(int maxIter)
 
 static bool gPrint2dWarning = true;
 template<class APPLYMAT>
-void GridCg<APPLYMAT>::setICPreconditioner(
-    PreconditionType method, Grid<Real> *A0, Grid<Real> *Ai, Grid<Real> *Aj, Grid<Real> *Ak)
+void GridCg<APPLYMAT>::setICPreconditioner(PreconditionType method,
+                                           Grid<Real> *A0,
+                                           Grid<Real> *Ai,
+                                           Grid<Real> *Aj,
+                                           Grid<Real> *Ak,
+                                           bool reuse)
 {
   assertMsg(method == PC_ICP || method == PC_mICP,
             "GridCg<APPLYMAT>::setICPreconditioner: Invalid method specified.");
@@ -576,6 +985,7 @@ void GridCg<APPLYMAT>::setICPreconditioner(
   mpPCAi = Ai;
   mpPCAj = Aj;
   mpPCAk = Ak;
+  mPcReuse = reuse;
 }
 
 template<class APPLYMAT>
@@ -27,6 +27,14 @@ extern "C" {
 }
 #endif
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#endif
+
 #if OPENVDB == 1
 #  include "openvdb/openvdb.h"
 #endif
@@ -616,6 +624,678 @@ template<class T> void readGridUni(const string &name, Grid<T> *grid)
 #endif
 };
 
+#if NO_ZLIB != 1
+
+//*****************************************************************************
+// chunked cache files (.mcc): the grid data is split into fixed size chunks that are
+// compressed independently, so that encoding and decoding run in parallel. An offset table
+// after the header locates the compressed chunks. Real grids can optionally be quantized
+// with an error bound before compression, the uncompressed chunk sizes then follow the
+// offset table.
+//*****************************************************************************
+
+//! mcc file header
+typedef struct {
+  int dimX, dimY, dimZ;                        // grid size
+  int gridType, elementType, bytesPerElement;  // data type info
+  char info[STR_LEN_GRID];                     // mantaflow build information
+  int codec;                                   // chunk compression, see MccCodec
+  int numChunks;                               // number of entries in the offset table - 1
+  unsigned long long chunkSize;                // uncompressed bytes per chunk, last may be smaller
+  unsigned long long timestamp;                // creation time
+  float maxError;                              // quantization error bound, 0 if lossless
+  int quantBlock;                              // values per quantized block, 0 if lossless
+} MccHeader;
+
+enum MccCodec { MccRaw = 0, MccZlib = 1, MccLzo = 2 };
+
+//! uncompressed size of a chunk, large enough for the codecs to be efficient
+static const IndexInt MCC_CHUNK_SIZE = 1 << 20;
+
+//! compress one chunk, stores it uncompressed if the codec doesn't reduce the size
+static void mccCompress(int codec, const char *in, IndexInt len, std::vector<char> &out)
+{
+  if (codec == MccZlib) {
+    uLongf outLen = compressBound(len);
+    out.resize(outLen);
+    if (compress2((Bytef *)&out[0], &outLen, (const Bytef *)in, len, 1) == Z_OK &&
+        (IndexInt)outLen < len) {
+      out.resize(outLen);
+      return;
+    }
+  }
+#  ifdef WITH_LZO
+  if (codec == MccLzo) {
+    lzo_uint outLen = len + len / 16 + 64 + 3;
+    std::vector<char> wrkmem(LZO1X_1_MEM_COMPRESS);
+    out.resize(outLen);
+    if (lzo1x_1_compress((const lzo_bytep)in, len, (lzo_bytep)&out[0], &outLen, &wrkmem[0]) ==
+            LZO_E_OK &&
+        (IndexInt)outLen < len) {
+      out.resize(outLen);
+      return;
+    }
+  }
+#  endif
+  out.assign(in, in + len);
+}
+
+//! decompress one chunk, chunks with the uncompressed size are stored as is
+static bool mccDecompress(int codec, const char *in, IndexInt inLen, char *out, IndexInt outLen)
+{
+  if (inLen == outLen) {
+    memcpy(out, in, outLen);
+    return true;
+  }
+  if (codec == MccZlib) {
+    uLongf len = outLen;
+    return uncompress((Bytef *)out, &len, (const Bytef *)in, inLen) == Z_OK &&
+           (IndexInt)len == outLen;
+  }
+#  ifdef WITH_LZO
+  if (codec == MccLzo) {
+    lzo_uint len = outLen;
+    return lzo1x_decompress_safe((const lzo_bytep)in, inLen, (lzo_bytep)out, &len, NULL) ==
+               LZO_E_OK &&
+           (IndexInt)len == outLen;
+  }
+#  endif
+  return false;
+}
+
+//! codecs this build can decode
+static bool mccCodecSupported(int codec)
+{
+#  ifdef WITH_LZO
+  if (codec == MccLzo)
+    return true;
+#  endif
+  return codec == MccRaw || codec == MccZlib;
+}
+
+//! header of a quantized block, the values are stored as min + code * step with 0, 8 or 16
+//! bit codes. 32 bits keep the floats unchanged, e.g. if the range is too large for the bound
+typedef struct {
+  float min, step;
+  int bits;
+} MccQuantBlock;
+
+//! values per quantization block, each block stores its own range
+static const int MCC_QUANT_BLOCK = 4096;
+
+//! quantize n floats blockwise, each value is reconstructed within maxError
+static void mccQuantize(
+    const float *in, IndexInt n, float maxError, int blockSize, std::vector<char> &out)
+{
+  out.clear();
+  for (IndexInt b = 0; b < n; b += blockSize) {
+    const IndexInt cnt = std::min((IndexInt)blockSize, n - b);
+    const float *v = in + b;
+    float lo = v[0], hi = v[0];
+    bool finite = true;
+    for (IndexInt i = 0; i < cnt; ++i) {
+      finite = finite && std::isfinite(v[i]);
+      lo = std::min(lo, v[i]);
+      hi = std::max(hi, v[i]);
+    }
+    MccQuantBlock block;
+    block.min = lo;
+    block.step = 0.;
+    block.bits = 32;
+    const float range = hi - lo;
+    if (finite && range == 0.) {
+      block.bits = 0;
+    }
+    else if (finite && range <= 255. * 2. * maxError) {
+      block.bits = 8;
+      block.step = range / 255.;
+    }
+    else if (finite && range <= 65535. * 2. * maxError) {
+      block.bits = 16;
+      block.step = range / 65535.;
+    }
+
+    const size_t pos = out.size();
+    out.resize(pos + sizeof(MccQuantBlock) + cnt * (block.bits / 8));
+    memcpy(&out[pos], &block, sizeof(MccQuantBlock));
+    char *dst = &out[pos + sizeof(MccQuantBlock)];
+    if (block.bits == 32) {
+      memcpy(dst, v, cnt * sizeof(float));
+    }
+    else if (block.bits == 8) {
+      for (IndexInt i = 0; i < cnt; ++i)
+        dst[i] = (unsigned char)std::min((v[i] - lo) / block.step + 0.5f, 255.f);
+    }
+    else if (block.bits == 16) {
+      for (IndexInt i = 0; i < cnt; ++i) {
+        const unsigned short code = (unsigned short)std::min((v[i] - lo) / block.step + 0.5f,
+                                                             65535.f);
+        memcpy(dst + 2 * i, &code, 2);
+      }
+    }
+  }
+}
+
+//! reconstruct n floats from quantized blocks, fails on inconsistent block data
+static bool mccDequantize(const char *in, IndexInt inLen, int blockSize, float *out, IndexInt n)
+{
+  IndexInt pos = 0;
+  for (IndexInt b = 0; b < n; b += blockSize) {
+    const IndexInt cnt = std::min((IndexInt)blockSize, n - b);
+    MccQuantBlock block;
+    if (pos + (IndexInt)sizeof(MccQuantBlock) > inLen)
+      return false;
+    memcpy(&block, in + pos, sizeof(MccQuantBlock));
+    pos += sizeof(MccQuantBlock);
+    if (block.bits != 0 && block.bits != 8 && block.bits != 16 && block.bits != 32)
+      return false;
+    if (pos + cnt * (block.bits / 8) > inLen)
+      return false;
+
+    const unsigned char *src = (const unsigned char *)(in + pos);
+    float *v = out + b;
+    if (block.bits == 0) {
+      for (IndexInt i = 0; i < cnt; ++i)
+        v[i] = block.min;
+    }
+    else if (block.bits == 8) {
+      for (IndexInt i = 0; i < cnt; ++i)
+        v[i] = block.min + src[i] * block.step;
+    }
+    else if (block.bits == 16) {
+      for (IndexInt i = 0; i < cnt; ++i) {
+        unsigned short code;
+        memcpy(&code, src + 2 * i, 2);
+        v[i] = block.min + code * block.step;
+      }
+    }
+    else {
+      memcpy(v, src, cnt * sizeof(float));
+    }
+    pos += cnt * (block.bits / 8);
+  }
+  return pos == inLen;
+}
+
+//! check the chunk tables against the grid size: offsets start at 0 and don't decrease, each
+//! chunk covers its part of the grid and is never larger than its raw or quantized data
+static bool mccValidTables(const MccHeader &head,
+                           IndexInt bytes,
+                           const std::vector<unsigned long long> &offsets,
+                           const std::vector<unsigned long long> &rawSizes)
+{
+  if (offsets[0] != 0)
+    return false;
+  for (int c = 0; c < head.numChunks; ++c) {
+    const IndexInt len = std::min((IndexInt)head.chunkSize, bytes - c * (IndexInt)head.chunkSize);
+    IndexInt maxLen = len;
+    if (head.quantBlock > 0) {
+      // a chunk can't grow by more than its block headers
+      const IndexInt maxRaw = len + (len / sizeof(float) / head.quantBlock + 1) *
+                                        sizeof(MccQuantBlock);
+      if (rawSizes[c] > (unsigned long long)maxRaw)
+        return false;
+      maxLen = rawSizes[c];
+    }
+    if (offsets[c + 1] < offsets[c] || offsets[c + 1] - offsets[c] > (unsigned long long)maxLen)
+      return false;
+  }
+  return true;
+}
+
+//! compress all chunks of the data, quantizes them first if quantBlock > 0
+
+struct knMccEncode : public KernelBase {
+  knMccEncode(const char *data,
+              const IndexInt bytes,
+              const IndexInt chunkSize,
+              const int codec,
+              const float maxError,
+              const int quantBlock,
+              std::vector<std::vector<char>> &chunks,
+              std::vector<unsigned long long> &rawSizes)
+      : KernelBase(chunks.size()),
+        data(data),
+        bytes(bytes),
+        chunkSize(chunkSize),
+        codec(codec),
+        maxError(maxError),
+        quantBlock(quantBlock),
+        chunks(chunks),
+        rawSizes(rawSizes)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(IndexInt idx,
+                 const char *data,
+                 const IndexInt bytes,
+                 const IndexInt chunkSize,
+                 const int codec,
+                 const float maxError,
+                 const int quantBlock,
+                 std::vector<std::vector<char>> &chunks,
+                 std::vector<unsigned long long> &rawSizes) const
+  {
+    const IndexInt start = idx * chunkSize;
+    const IndexInt len = std::min(chunkSize, bytes - start);
+    if (quantBlock > 0) {
+      std::vector<char> quantized;
+      mccQuantize(
+          (const float *)(data + start), len / sizeof(float), maxError, quantBlock, quantized);
+      rawSizes[idx] = quantized.size();
+      mccCompress(codec, &quantized[0], quantized.size(), chunks[idx]);
+    }
+    else {
+      rawSizes[idx] = len;
+      mccCompress(codec, data + start, len, chunks[idx]);
+    }
+  }
+  inline const char *&getArg0()
+  {
+    return data;
+  }
+  typedef const char *type0;
+  inline const IndexInt &getArg1()
+  {
+    return bytes;
+  }
+  typedef IndexInt type1;
+  inline const IndexInt &getArg2()
+  {
+    return chunkSize;
+  }
+  typedef IndexInt type2;
+  inline const int &getArg3()
+  {
+    return codec;
+  }
+  typedef int type3;
+  inline const float &getArg4()
+  {
+    return maxError;
+  }
+  typedef float type4;
+  inline const int &getArg5()
+  {
+    return quantBlock;
+  }
+  typedef int type5;
+  inline std::vector<std::vector<char>> &getArg6()
+  {
+    return chunks;
+  }
+  typedef std::vector<std::vector<char>> type6;
+  inline std::vector<unsigned long long> &getArg7()
+  {
+    return rawSizes;
+  }
+  typedef std::vector<unsigned long long> type7;
+  void runMessage()
+  {
+    debMsg("Executing kernel knMccEncode ", 3);
+    debMsg("Kernel range"
+               << " size " << size << " ",
+           4);
+    profileBegin("knMccEncode");
+  };
+  void operator()(const tbb::blocked_range<IndexInt> &__r) const
+  {
+    for (IndexInt idx = __r.begin(); idx != (IndexInt)__r.end(); idx++)
+      op(idx, data, bytes, chunkSize, codec, maxError, quantBlock, chunks, rawSizes);
+  }
+  void run()
+  {
+    tbb::parallel_for(tbb::blocked_range<IndexInt>(0, size), *this);
+  }
+  const char *data;
+  const IndexInt bytes;
+  const IndexInt chunkSize;
+  const int codec;
+  const float maxError;
+  const int quantBlock;
+  std::vector<std::vector<char>> &chunks;
+  std::vector<unsigned long long> &rawSizes;
+};
+
+//! decompress all chunks into data, marks the chunks that failed to decode
+
+struct knMccDecode : public KernelBase {
+  knMccDecode(const std::vector<char> &compressed,
+              const std::vector<unsigned long long> &offsets,
+              const std::vector<unsigned long long> &rawSizes,
+              char *data,
+              const IndexInt bytes,
+              const IndexInt chunkSize,
+              const int codec,
+              const int quantBlock,
+              std::vector<char> &failed)
+      : KernelBase(failed.size()),
+        compressed(compressed),
+        offsets(offsets),
+        rawSizes(rawSizes),
+        data(data),
+        bytes(bytes),
+        chunkSize(chunkSize),
+        codec(codec),
+        quantBlock(quantBlock),
+        failed(failed)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(IndexInt idx,
+                 const std::vector<char> &compressed,
+                 const std::vector<unsigned long long> &offsets,
+                 const std::vector<unsigned long long> &rawSizes,
+                 char *data,
+                 const IndexInt bytes,
+                 const IndexInt chunkSize,
+                 const int codec,
+                 const int quantBlock,
+                 std::vector<char> &failed) const
+  {
+    const IndexInt start = idx * chunkSize;
+    const IndexInt len = std::min(chunkSize, bytes - start);
+    const char *in = &compressed[offsets[idx]];
+    const IndexInt inLen = offsets[idx + 1] - offsets[idx];
+    if (quantBlock > 0) {
+      std::vector<char> quantized(rawSizes[idx]);
+      failed[idx] = quantized.empty() ||
+                    !mccDecompress(codec, in, inLen, &quantized[0], quantized.size()) ||
+                    !mccDequantize(&quantized[0],
+                                   quantized.size(),
+                                   quantBlock,
+                                   (float *)(data + start),
+                                   len / sizeof(float));
+    }
+    else {
+      failed[idx] = !mccDecompress(codec, in, inLen, data + start, len);
+    }
+  }
+  inline const std::vector<char> &getArg0()
+  {
+    return compressed;
+  }
+  typedef std::vector<char> type0;
+  inline const std::vector<unsigned long long> &getArg1()
+  {
+    return offsets;
+  }
+  typedef std::vector<unsigned long long> type1;
+  inline const std::vector<unsigned long long> &getArg2()
+  {
+    return rawSizes;
+  }
+  typedef std::vector<unsigned long long> type2;
+  inline char *&getArg3()
+  {
+    return data;
+  }
+  typedef char *type3;
+  inline const IndexInt &getArg4()
+  {
+    return bytes;
+  }
+  typedef IndexInt type4;
+  inline const IndexInt &getArg5()
+  {
+    return chunkSize;
+  }
+  typedef IndexInt type5;
+  inline const int &getArg6()
+  {
+    return codec;
+  }
+  typedef int type6;
+  inline const int &getArg7()
+  {
+    return quantBlock;
+  }
+  typedef int type7;
+  inline std::vector<char> &getArg8()
+  {
+    return failed;
+  }
+  typedef std::vector<char> type8;
+  void runMessage()
+  {
+    debMsg("Executing kernel knMccDecode ", 3);
+    debMsg("Kernel range"
+               << " size " << size << " ",
+           4);
+    profileBegin("knMccDecode");
+  };
+  void operator()(const tbb::blocked_range<IndexInt> &__r) const
+  {
+    for (IndexInt idx = __r.begin(); idx != (IndexInt)__r.end(); idx++)
+      op(idx, compressed, offsets, rawSizes, data, bytes, chunkSize, codec, quantBlock, failed);
+  }
+  void run()
+  {
+    tbb::parallel_for(tbb::blocked_range<IndexInt>(0, size), *this);
+  }
+  const std::vector<char> &compressed;
+  const std::vector<unsigned long long> &offsets;
+  const std::vector<unsigned long long> &rawSizes;
+  char *data;
+  const IndexInt bytes;
+  const IndexInt chunkSize;
+  const int codec;
+  const int quantBlock;
+  std::vector<char> &failed;
+};
+
+#  if FLOATINGPOINT_PRECISION != 1
+//! mcc files store single precision values like uni files, number of floats per element
+template<class T> static int mccFloatsPerElement()
+{
+  return 0;
+}
+template<> int mccFloatsPerElement<Real>()
+{
+  return 1;
+}
+template<> int mccFloatsPerElement<Vec3>()
+{
+  return 3;
+}
+#  endif
+
+#endif  // NO_ZLIB!=1
+
+template<class T> void writeGridMcc(const string &name, Grid<T> *grid, float maxError)
+{
+  debMsg("Writing grid " << grid->getName() << " to mcc file " << name, 1);
+
+#if NO_ZLIB != 1
+  char ID[5] = "MCC1";
+  MccHeader head;
+  head.dimX = grid->getSizeX();
+  head.dimY = grid->getSizeY();
+  head.dimZ = grid->getSizeZ();
+  head.gridType = grid->getType();
+  head.bytesPerElement = sizeof(T);
+  snprintf(head.info, STR_LEN_GRID, "%s", buildInfoString().c_str());
+  MuTime stamp;
+  head.timestamp = stamp.time;
+#  ifdef WITH_LZO
+  head.codec = MccLzo;
+#  else
+  head.codec = MccZlib;
+#  endif
+
+  if (grid->getType() & GridBase::TypeInt)
+    head.elementType = 0;
+  else if (grid->getType() & GridBase::TypeReal)
+    head.elementType = 1;
+  else if (grid->getType() & GridBase::TypeVec3)
+    head.elementType = 2;
+  else
+    errMsg("writeGridMcc: unknown element type");
+
+  // only Real data is quantized, other types are always written lossless
+  const bool quantize = maxError > 0 && head.elementType == 1;
+  head.maxError = quantize ? maxError : 0;
+  head.quantBlock = quantize ? MCC_QUANT_BLOCK : 0;
+
+  const IndexInt numCells = (IndexInt)head.dimX * head.dimY * head.dimZ;
+  const char *data = (const char *)&((*grid)[0]);
+#  if FLOATINGPOINT_PRECISION != 1
+  std::vector<float> converted;
+  const int floats = mccFloatsPerElement<T>();
+  if (floats > 0) {
+    const Real *ptr = (const Real *)data;
+    converted.resize(numCells * floats);
+    for (IndexInt i = 0; i < numCells * floats; ++i)
+      converted[i] = (float)ptr[i];
+    head.bytesPerElement = floats * sizeof(float);
+    data = (const char *)&converted[0];
+  }
+#  endif
+
+  const IndexInt bytes = numCells * head.bytesPerElement;
+  head.chunkSize = MCC_CHUNK_SIZE;
+  head.numChunks = (bytes + MCC_CHUNK_SIZE - 1) / MCC_CHUNK_SIZE;
+  std::vector<std::vector<char>> chunks(head.numChunks);
+  std::vector<unsigned long long> rawSizes(head.numChunks);
+  knMccEncode(data,
+              bytes,
+              MCC_CHUNK_SIZE,
+              head.codec,
+              head.maxError,
+              head.quantBlock,
+              chunks,
+              rawSizes);
+
+  std::vector<unsigned long long> offsets(head.numChunks + 1, 0);
+  for (int c = 0; c < head.numChunks; ++c)
+    offsets[c + 1] = offsets[c] + chunks[c].size();
+
+  FILE *fp = fopen(name.c_str(), "wb");
+  if (!fp)
+    errMsg("writeGridMcc: can't open file " << name);
+  bool ok = fwrite(ID, 4, 1, fp) == 1 && fwrite(&head, sizeof(MccHeader), 1, fp) == 1 &&
+            fwrite(&offsets[0], sizeof(unsigned long long), offsets.size(), fp) == offsets.size();
+  if (ok && quantize)
+    ok = fwrite(&rawSizes[0], sizeof(unsigned long long), rawSizes.size(), fp) == rawSizes.size();
+  for (int c = 0; c < head.numChunks && ok; ++c)
+    ok = fwrite(&chunks[c][0], 1, chunks[c].size(), fp) == chunks[c].size();
+  fclose(fp);
+  if (!ok)
+    errMsg("writeGridMcc: can't write file " << name);
+#else
+  errMsg("writeGridMcc: mcc files are not supported without zlib");
+#endif
+};
+
+template<class T> void readGridMcc(const string &name, Grid<T> *grid)
+{
+  debMsg("Reading grid " << grid->getName() << " from mcc file " << name, 1);
+
+#if NO_ZLIB != 1
+  FILE *fp = fopen(name.c_str(), "rb");
+  if (!fp)
+    errMsg("readGridMcc: can't open file " << name);
+
+  char ID[5] = {0, 0, 0, 0, 0};
+  MccHeader head;
+  if (fread(ID, 4, 1, fp) != 1 || strcmp(ID, "MCC1") ||
+      fread(&head, sizeof(MccHeader), 1, fp) != 1) {
+    fclose(fp);
+    errMsg("readGridMcc: Unknown header '" << ID << "' ");
+  }
+
+  const IndexInt numCells = (IndexInt)head.dimX * head.dimY * head.dimZ;
+  int bytesPerElement = sizeof(T);
+#  if FLOATINGPOINT_PRECISION != 1
+  const int floats = mccFloatsPerElement<T>();
+  if (floats > 0)
+    bytesPerElement = floats * sizeof(float);
+#  endif
+  const IndexInt bytes = numCells * bytesPerElement;
+
+  // validate the header before anything is allocated or decoded from it
+  std::ostringstream error;
+  if (head.dimX != grid->getSizeX() || head.dimY != grid->getSizeY() ||
+      head.dimZ != grid->getSizeZ())
+    error << "grid dim doesn't match, " << Vec3(head.dimX, head.dimY, head.dimZ) << " vs "
+          << grid->getSize();
+  else if (unifyGridType(head.gridType) != unifyGridType(grid->getType()))
+    error << "grid type doesn't match " << head.gridType << " vs " << grid->getType();
+  else if (head.bytesPerElement != bytesPerElement)
+    error << "grid element size doesn't match " << head.bytesPerElement << " vs "
+          << bytesPerElement;
+  else if (!mccCodecSupported(head.codec))
+    error << "file " << name << " uses "
+          << (head.codec == MccLzo ? "lzo compression, which is not compiled in" :
+                                     "an unknown codec");
+  else if (head.numChunks < 0 || head.chunkSize == 0 ||
+           head.chunkSize > (unsigned long long)std::max(bytes, MCC_CHUNK_SIZE) ||
+           (IndexInt)head.chunkSize * head.numChunks < bytes ||
+           (IndexInt)head.chunkSize * (head.numChunks - 1) >= bytes)
+    error << "invalid chunk table in " << name;
+  else if (head.quantBlock < 0 ||
+           (head.quantBlock > 0 && (head.elementType != 1 || head.chunkSize % sizeof(float))))
+    error << "invalid quantization in " << name;
+  if (!error.str().empty()) {
+    fclose(fp);
+    errMsg("readGridMcc: " << error.str());
+  }
+
+  std::vector<unsigned long long> offsets(head.numChunks + 1), rawSizes;
+  bool ok = fread(&offsets[0], sizeof(unsigned long long), offsets.size(), fp) == offsets.size();
+  if (ok && head.quantBlock > 0) {
+    rawSizes.resize(head.numChunks);
+    ok = fread(&rawSizes[0], sizeof(unsigned long long), rawSizes.size(), fp) == rawSizes.size();
+  }
+  if (ok && !mccValidTables(head, bytes, offsets, rawSizes)) {
+    fclose(fp);
+    errMsg("readGridMcc: invalid chunk table in " << name);
+  }
+  // the tables bound the chunk data by the grid size, reading it checks it is in the file
+  std::vector<char> compressed(ok ? offsets[head.numChunks] : 0);
+  if (ok && !compressed.empty())
+    ok = fread(&compressed[0], 1, compressed.size(), fp) == compressed.size();
+  fclose(fp);
+  assertMsg(ok, "readGridMcc: file " << name << " is truncated");
+
+  char *data = (char *)&((*grid)[0]);
+#  if FLOATINGPOINT_PRECISION != 1
+  std::vector<float> converted;
+  if (floats > 0) {
+    converted.resize(numCells * floats);
+    data = (char *)&converted[0];
+  }
+#  endif
+
+  std::vector<char> failed(head.numChunks, 0);
+  knMccDecode(compressed,
+              offsets,
+              rawSizes,
+              data,
+              bytes,
+              head.chunkSize,
+              head.codec,
+              head.quantBlock,
+              failed);
+  for (int c = 0; c < head.numChunks; ++c)
+    assertMsg(!failed[c], "readGridMcc: can't decode chunk " << c << " of " << name);
+
+#  if FLOATINGPOINT_PRECISION != 1
+  if (floats > 0) {
+    Real *ptr = (Real *)&((*grid)[0]);
+    for (IndexInt i = 0; i < numCells * floats; ++i)
+      ptr[i] = (Real)converted[i];
+  }
+#  endif
+#else
+  errMsg("readGridMcc: mcc files are not supported without zlib");
+#endif
+};
+
 template<class T> void writeGridVol(const string &name, Grid<T> *grid)
 {
   debMsg("writing grid " << grid->getName() << " to vol file " << name, 1);
@@ -1301,6 +1981,7 @@ struct knQuantize : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Real> &grid, Real step) const
   {
@@ -1322,6 +2003,7 @@ struct knQuantize : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knQuantize");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1376,6 +2058,7 @@ struct knQuantizeVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Vec3> &grid, Real step) const
   {
@@ -1398,6 +2081,7 @@ struct knQuantizeVec3 : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knQuantizeVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1447,6 +2131,50 @@ void PbRegister_quantizeGridVec3()
 }
 }
 
+//! Save a Real grid with lossy quantization, every value is kept within maxError of the
+//! original. Only the chunked .mcc format supports this, other formats are written lossless
+
+void saveQuantized(Grid<Real> &grid, std::string name, Real maxError)
+{
+  const size_t dot = name.find_last_of('.');
+  if (maxError > 0 && dot != string::npos && name.substr(dot) == ".mcc")
+    writeGridMcc(name, &grid, maxError);
+  else
+    grid.save(name);
+}
+static PyObject *_W_5(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "saveQuantized", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      Grid<Real> &grid = *_args.getPtr<Grid<Real>>("grid", 0, &_lock);
+      std::string name = _args.get<std::string>("name", 1, &_lock);
+      Real maxError = _args.get<Real>("maxError", 2, &_lock);
+      _retval = getPyNone();
+      saveQuantized(grid, name, maxError);
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "saveQuantized", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("saveQuantized", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_saveQuantized("", "saveQuantized", _W_5);
+extern "C" {
+void PbRegister_saveQuantized()
+{
+  KEEP_UNUSED(_RP_saveQuantized);
+}
+}
+
 // explicit instantiation
 template void writeGridRaw<int>(const string &name, Grid<int> *grid);
 template void writeGridRaw<Real>(const string &name, Grid<Real> *grid);
@@ -1454,6 +2182,9 @@ template void writeGridRaw<Vec3>(const string &name, Grid<Vec3> *grid);
 template void writeGridUni<int>(const string &name, Grid<int> *grid);
 template void writeGridUni<Real>(const string &name, Grid<Real> *grid);
 template void writeGridUni<Vec3>(const string &name, Grid<Vec3> *grid);
+template void writeGridMcc<int>(const string &name, Grid<int> *grid, float maxError);
+template void writeGridMcc<Real>(const string &name, Grid<Real> *grid, float maxError);
+template void writeGridMcc<Vec3>(const string &name, Grid<Vec3> *grid, float maxError);
 template void writeGridVol<int>(const string &name, Grid<int> *grid);
 template void writeGridVol<Vec3>(const string &name, Grid<Vec3> *grid);
 template void writeGridTxt<int>(const string &name, Grid<int> *grid);
@@ -1466,6 +2197,9 @@ template void readGridRaw<Vec3>(const string &name, Grid<Vec3> *grid);
 template void readGridUni<int>(const string &name, Grid<int> *grid);
 template void readGridUni<Real>(const string &name, Grid<Real> *grid);
 template void readGridUni<Vec3>(const string &name, Grid<Vec3> *grid);
+template void readGridMcc<int>(const string &name, Grid<int> *grid);
+template void readGridMcc<Real>(const string &name, Grid<Real> *grid);
+template void readGridMcc<Vec3>(const string &name, Grid<Vec3> *grid);
 template void readGridVol<int>(const string &name, Grid<int> *grid);
 template void readGridVol<Vec3>(const string &name, Grid<Vec3> *grid);
 
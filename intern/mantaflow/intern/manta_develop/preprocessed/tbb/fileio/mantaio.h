@@ -41,6 +41,8 @@ template<class T> void writeGridRaw(const std::string &name, Grid<T> *grid);
 template<class T> void writeGridUni(const std::string &name, Grid<T> *grid);
 template<class T> void writeGridVol(const std::string &name, Grid<T> *grid);
 template<class T> void writeGridTxt(const std::string &name, Grid<T> *grid);
+template<class T>
+void writeGridMcc(const std::string &name, Grid<T> *grid, float maxError = 0);
 
 #if OPENVDB == 1
 template<class T> void writeGridVDB(const std::string &name, Grid<T> *grid);
@@ -52,6 +54,7 @@ template<class T> void readGridNumpy(const std::string &name, Grid<T> *grid);
 template<class T> void readGridUni(const std::string &name, Grid<T> *grid);
 template<class T> void readGridRaw(const std::string &name, Grid<T> *grid);
 template<class T> void readGridVol(const std::string &name, Grid<T> *grid);
+template<class T> void readGridMcc(const std::string &name, Grid<T> *grid);
 
 template<class T> void writeGrid4dUni(const std::string &name, Grid4d<T> *grid);
 template<class T>
@@ -131,6 +131,8 @@ template<class T> void Grid<T>::load(string name)
     readGridRaw(name, this);
   else if (ext == ".uni")
     readGridUni(name, this);
+  else if (ext == ".mcc")
+    readGridMcc(name, this);
   else if (ext == ".vol")
     readGridVol(name, this);
   else if (ext == ".npz")
@@ -152,6 +154,8 @@ template<class T> void Grid<T>::save(string name)
     writeGridRaw(name, this);
   else if (ext == ".uni")
     writeGridUni(name, this);
+  else if (ext == ".mcc")
+    writeGridMcc(name, this);
   else if (ext == ".vol")
     writeGridVol(name, this);
 #if OPENVDB == 1
@@ -177,6 +181,7 @@ struct CompMinReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &val, Real &minVal)
   {
@@ -202,6 +207,7 @@ struct CompMinReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMinReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -232,6 +238,7 @@ struct CompMaxReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &val, Real &maxVal)
   {
@@ -257,6 +264,7 @@ struct CompMaxReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMaxReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -287,6 +295,7 @@ struct CompMinInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<int> &val, int &minVal)
   {
@@ -312,6 +321,7 @@ struct CompMinInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMinInt");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -342,6 +352,7 @@ struct CompMaxInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<int> &val, int &maxVal)
   {
@@ -367,6 +378,7 @@ struct CompMaxInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMaxInt");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -397,6 +409,7 @@ struct CompMinVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &val, Real &minVal)
   {
@@ -423,6 +436,7 @@ struct CompMinVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMinVec");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -453,6 +467,7 @@ struct CompMaxVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &val, Real &maxVal)
   {
@@ -479,6 +494,7 @@ struct CompMaxVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CompMaxVec");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -519,6 +535,7 @@ template<class T> struct knGridSetConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, T val) const
   {
@@ -540,6 +557,7 @@ template<class T> struct knGridSetConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridSetConstReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -558,6 +576,7 @@ template<class T> struct knGridAddConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, T val) const
   {
@@ -579,6 +598,7 @@ template<class T> struct knGridAddConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridAddConstReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -597,6 +617,7 @@ template<class T> struct knGridMultConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, T val) const
   {
@@ -618,6 +639,7 @@ template<class T> struct knGridMultConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridMultConst");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -637,6 +659,7 @@ template<class T> struct knGridSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<T> &other) const
   {
@@ -658,6 +681,7 @@ template<class T> struct knGridSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridSafeDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -680,6 +704,7 @@ template<class T> struct knGridClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const T &min, const T &max) const
   {
@@ -706,6 +731,7 @@ template<class T> struct knGridClamp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridClamp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -740,6 +766,7 @@ template<class T> struct knGridStomp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const T &threshold) const
   {
@@ -761,6 +788,7 @@ template<class T> struct knGridStomp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridStomp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -781,6 +809,7 @@ template<class T> struct knPermuteAxes : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, Grid<T> &self, Grid<T> &target, int axis0, int axis1, int axis2) const
@@ -821,6 +850,7 @@ template<class T> struct knPermuteAxes : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knPermuteAxes");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1005,6 +1035,7 @@ struct knCountCells : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, int flag, int bnd, Grid<Real> *mask, int &cnt)
@@ -1053,6 +1084,7 @@ struct knCountCells : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCountCells");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1689,6 +1721,7 @@ struct knResetUvGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &target, const Vec3 *offset) const
   {
@@ -1713,6 +1746,7 @@ struct knResetUvGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knResetUvGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1853,6 +1887,7 @@ template<class T> struct knSetBoundary : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<T> &grid, T value, int w) const
   {
@@ -1882,6 +1917,7 @@ template<class T> struct knSetBoundary : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundary");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1922,6 +1958,7 @@ template<class T> struct knSetBoundaryNeumann : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<T> &grid, int w) const
   {
@@ -1972,6 +2009,7 @@ template<class T> struct knSetBoundaryNeumann : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundaryNeumann");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2013,6 +2051,7 @@ struct knSetBoundaryMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &grid, Vec3 value, int w) const
   {
@@ -2047,6 +2086,7 @@ struct knSetBoundaryMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundaryMAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2084,6 +2124,7 @@ struct knSetBoundaryMACNorm : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Vec3> &grid, Vec3 value, int w) const
   {
@@ -2115,6 +2156,7 @@ struct knSetBoundaryMACNorm : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetBoundaryMACNorm");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2163,6 +2205,7 @@ struct knGridTotalSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &a, FlagGrid *flags, double &result)
   {
@@ -2198,6 +2241,7 @@ struct knGridTotalSum : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGridTotalSum");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2226,6 +2270,7 @@ struct knCountFluidCells : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, FlagGrid &flags, int &numEmpty)
   {
@@ -2251,6 +2296,7 @@ struct knCountFluidCells : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCountFluidCells");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2331,6 +2377,7 @@ struct knGetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Vec3> &source, Grid<Real> &target, int component) const
   {
@@ -2357,6 +2404,7 @@ struct knGetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGetComponent");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2414,6 +2462,7 @@ struct knSetComponent : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &source, Grid<Vec3> &target, int component) const
   {
@@ -2440,6 +2489,7 @@ struct knSetComponent : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetComponent");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2788,6 +2838,7 @@ struct knMarkIsolatedFluidCell : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, FlagGrid &flags, const int mark) const
   {
@@ -2810,6 +2861,7 @@ struct knMarkIsolatedFluidCell : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knMarkIsolatedFluidCell");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -553,6 +553,15 @@ template<class T> class Grid : public GridBase {
     DEBUG_ONLY(checkIndex(idx));
     return mData[idx];
   }
+  //! raw data pointer, e.g. for vectorized loops
+  inline T *getData()
+  {
+    return mData;
+  }
+  inline const T *getData() const
+  {
+    return mData;
+  }
 
   // interpolated access
   inline T getInterpolated(const Vec3 &pos) const
@@ -1739,6 +1748,7 @@ template<class T, class S> struct gridAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other) const
   {
@@ -1760,6 +1770,7 @@ template<class T, class S> struct gridAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1778,6 +1789,7 @@ template<class T, class S> struct gridSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other) const
   {
@@ -1799,6 +1811,7 @@ template<class T, class S> struct gridSub : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridSub");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1817,6 +1830,7 @@ template<class T, class S> struct gridMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other) const
   {
@@ -1838,6 +1852,7 @@ template<class T, class S> struct gridMult : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridMult");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1856,6 +1871,7 @@ template<class T, class S> struct gridDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<S> &other) const
   {
@@ -1877,6 +1893,7 @@ template<class T, class S> struct gridDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1895,6 +1912,7 @@ template<class T, class S> struct gridAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const S &other) const
   {
@@ -1916,6 +1934,7 @@ template<class T, class S> struct gridAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridAddScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1934,6 +1953,7 @@ template<class T, class S> struct gridMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const S &other) const
   {
@@ -1955,6 +1975,7 @@ template<class T, class S> struct gridMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridMultScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1974,6 +1995,7 @@ template<class T, class S> struct gridScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &me, const Grid<T> &other, const S &factor) const
   {
@@ -2000,6 +2022,7 @@ template<class T, class S> struct gridScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridScaledAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2020,6 +2043,7 @@ template<class T> struct gridSetConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<T> &grid, T value) const
   {
@@ -2041,6 +2065,7 @@ template<class T> struct gridSetConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("gridSetConst");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2143,6 +2168,7 @@ template<class S> struct knInterpolateGridTempl : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2189,6 +2215,7 @@ template<class S> struct knInterpolateGridTempl : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knInterpolateGridTempl");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -158,6 +158,7 @@ struct kn4dMinReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<Real> &val, Real &minVal)
   {
@@ -183,6 +184,7 @@ struct kn4dMinReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMinReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -213,6 +215,7 @@ struct kn4dMaxReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<Real> &val, Real &maxVal)
   {
@@ -238,6 +241,7 @@ struct kn4dMaxReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMaxReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -268,6 +272,7 @@ struct kn4dMinInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<int> &val, int &minVal)
   {
@@ -293,6 +298,7 @@ struct kn4dMinInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMinInt");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -323,6 +329,7 @@ struct kn4dMaxInt : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<int> &val, int &maxVal)
   {
@@ -348,6 +355,7 @@ struct kn4dMaxInt : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMaxInt");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -378,6 +386,7 @@ template<class VEC> struct kn4dMinVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<VEC> &val, Real &minVal)
   {
@@ -404,6 +413,7 @@ template<class VEC> struct kn4dMinVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMinVec");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -434,6 +444,7 @@ template<class VEC> struct kn4dMaxVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<VEC> &val, Real &maxVal)
   {
@@ -460,6 +471,7 @@ template<class VEC> struct kn4dMaxVec : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMaxVec");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -506,6 +518,7 @@ template<class T> struct kn4dSetConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T val) const
   {
@@ -527,6 +540,7 @@ template<class T> struct kn4dSetConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dSetConstReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -545,6 +559,7 @@ template<class T> struct kn4dAddConstReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T val) const
   {
@@ -566,6 +581,7 @@ template<class T> struct kn4dAddConstReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dAddConstReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -584,6 +600,7 @@ template<class T> struct kn4dMultConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T val) const
   {
@@ -605,6 +622,7 @@ template<class T> struct kn4dMultConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dMultConst");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -623,6 +641,7 @@ template<class T> struct kn4dClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T min, T max) const
   {
@@ -649,6 +668,7 @@ template<class T> struct kn4dClamp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kn4dClamp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -787,6 +807,7 @@ struct knGetComp4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid4d<Vec4> &src, Grid4d<Real> &dst, int c) const
   {
@@ -813,6 +834,7 @@ struct knGetComp4d : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knGetComp4d");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -834,6 +856,7 @@ struct knSetComp4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid4d<Real> &src, Grid4d<Vec4> &dst, int c) const
   {
@@ -860,6 +883,7 @@ struct knSetComp4d : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetComp4d");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -958,6 +982,7 @@ template<class T> struct knSetBnd4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, int t, Grid4d<T> &grid, T value, int w) const
   {
@@ -990,6 +1015,7 @@ template<class T> struct knSetBnd4d : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knSetBnd4d");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1042,6 +1068,7 @@ template<class T> struct knSetBnd4dNeumann : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, int t, Grid4d<T> &grid, int w) const
   {
@@ -1101,6 +1128,7 @@ template<class T> struct knSetBnd4dNeumann : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knSetBnd4dNeumann");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1328,6 +1356,7 @@ template<class S> struct knSetRegion4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, int t, Grid4d<S> &dst, Vec4 start, Vec4 end, S value) const
   {
@@ -1366,6 +1395,7 @@ template<class S> struct knSetRegion4d : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knSetRegion4d");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1611,6 +1641,7 @@ template<class S> struct knInterpol4d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1653,6 +1684,7 @@ template<class S> struct knInterpol4d : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("knInterpol4d");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
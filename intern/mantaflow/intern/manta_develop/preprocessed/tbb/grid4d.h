@@ -1026,6 +1026,7 @@ template<class T, class S> struct Grid4dAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other) const
   {
@@ -1047,6 +1048,7 @@ template<class T, class S> struct Grid4dAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1065,6 +1067,7 @@ template<class T, class S> struct Grid4dSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other) const
   {
@@ -1086,6 +1089,7 @@ template<class T, class S> struct Grid4dSub : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dSub");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1104,6 +1108,7 @@ template<class T, class S> struct Grid4dMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other) const
   {
@@ -1125,6 +1130,7 @@ template<class T, class S> struct Grid4dMult : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dMult");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1143,6 +1149,7 @@ template<class T, class S> struct Grid4dDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<S> &other) const
   {
@@ -1164,6 +1171,7 @@ template<class T, class S> struct Grid4dDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1182,6 +1190,7 @@ template<class T, class S> struct Grid4dAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const S &other) const
   {
@@ -1203,6 +1212,7 @@ template<class T, class S> struct Grid4dAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dAddScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1221,6 +1231,7 @@ template<class T, class S> struct Grid4dMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const S &other) const
   {
@@ -1242,6 +1253,7 @@ template<class T, class S> struct Grid4dMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dMultScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1261,6 +1273,7 @@ template<class T, class S> struct Grid4dScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<T> &other, const S &factor) const
   {
@@ -1287,6 +1300,7 @@ template<class T, class S> struct Grid4dScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dScaledAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1307,6 +1321,7 @@ template<class T> struct Grid4dSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, const Grid4d<T> &other) const
   {
@@ -1328,6 +1343,7 @@ template<class T> struct Grid4dSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dSafeDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1346,6 +1362,7 @@ template<class T> struct Grid4dSetConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid4d<T> &me, T value) const
   {
@@ -1367,6 +1384,7 @@ template<class T> struct Grid4dSetConst : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("Grid4dSetConst");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1465,6 +1483,7 @@ template<class S> struct KnInterpolateGrid4dTempl : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1511,6 +1530,7 @@ template<class S> struct KnInterpolateGrid4dTempl : public KernelBase {
                   " t "
                << minT << " - " << maxT,
            4);
+    profileBegin("KnInterpolateGrid4dTempl");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
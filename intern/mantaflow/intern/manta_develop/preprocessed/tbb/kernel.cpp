@@ -16,13 +16,17 @@
  *
  ******************************************************************************/
 
+#include <tbb/task_arena.h>
 #include "kernel.h"
 #include "grid.h"
 #include "grid4d.h"
 #include "particle.h"
+#include "timing.h"
 
 namespace Manta {
 
+KernelScheduling gKernelScheduling = {false, 64, 16, 16};
+
 KernelBase::KernelBase(const GridBase *base, int bnd)
     : maxX(base->getSizeX() - bnd),
       maxY(base->getSizeY() - bnd),
@@ -34,12 +38,23 @@ KernelBase::KernelBase(const GridBase *base, int bnd)
       Y(base->getStrideY()),
       Z(base->getStrideZ()),
       dimT(0),
-      size(base->getSizeX() * base->getSizeY() * (IndexInt)base->getSizeZ())
+      size(base->getSizeX() * base->getSizeY() * (IndexInt)base->getSizeZ()),
+      profiled(false)
 {
 }
 
 KernelBase::KernelBase(IndexInt num)
-    : maxX(0), maxY(0), maxZ(0), minZ(0), maxT(0), X(0), Y(0), Z(0), dimT(0), size(num)
+    : maxX(0),
+      maxY(0),
+      maxZ(0),
+      minZ(0),
+      maxT(0),
+      X(0),
+      Y(0),
+      Z(0),
+      dimT(0),
+      size(num),
+      profiled(false)
 {
 }
 
@@ -54,8 +69,112 @@ KernelBase::KernelBase(const Grid4dBase *base, int bnd)
       Y(base->getStrideY()),
       Z(base->getStrideZ()),
       dimT(base->getStrideT()),
-      size(base->getSizeX() * base->getSizeY() * base->getSizeZ() * (IndexInt)base->getSizeT())
+      size(base->getSizeX() * base->getSizeY() * base->getSizeZ() * (IndexInt)base->getSizeT()),
+      profiled(false)
+{
+}
+
+KernelBase::KernelBase(const KernelBase &o)
+    : maxX(o.maxX),
+      maxY(o.maxY),
+      maxZ(o.maxZ),
+      minZ(o.minZ),
+      maxT(o.maxT),
+      minT(o.minT),
+      X(o.X),
+      Y(o.Y),
+      Z(o.Z),
+      dimT(o.dimT),
+      size(o.size),
+      profiled(false)
+{
+}
+
+void KernelBase::profileBegin(const char *name)
+{
+  if (ProfileData::enabled() && !profiled) {
+    ProfileData::instance().beginKernel(name, size);
+    profiled = true;
+  }
+}
+
+void KernelBase::profileEnd()
+{
+  if (profiled) {
+    ProfileData::instance().endKernel();
+    profiled = false;
+  }
+}
+
+// parallel helpers
+
+static int numThreads()
+{
+  return tbb::this_task_arena::max_concurrency();
+}
+
+void parallelForRange(IndexInt size,
+                      const std::function<void(IndexInt, IndexInt)> &fn,
+                      IndexInt grain)
 {
+  tbb::parallel_for(tbb::blocked_range<IndexInt>(0, size, std::max<IndexInt>(grain, 1)),
+                    [&](const tbb::blocked_range<IndexInt> &r) { fn(r.begin(), r.end()); });
+}
+
+void computeBucketOrder(const std::vector<int> &keys,
+                        int numBuckets,
+                        std::vector<IndexInt> &order,
+                        std::vector<IndexInt> *bucketStart)
+{
+  // per chunk histograms, a few chunks per thread. the order does not depend on the chunking,
+  // only their memory is limited for very fine bucketings
+  const IndexInt sz = keys.size();
+  IndexInt numChunks = std::min<IndexInt>(4 * numThreads(), sz / 4096);
+  numChunks = std::min<IndexInt>(numChunks, (1 << 24) / std::max(numBuckets, 1));
+  numChunks = std::max<IndexInt>(numChunks, 1);
+  const IndexInt chunkSize = (sz + numChunks - 1) / numChunks;
+  std::vector<IndexInt> offsets(numChunks * numBuckets, 0);
+
+  parallelForRange(
+      numChunks,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt c = begin; c < end; c++) {
+          IndexInt *count = &offsets[c * numBuckets];
+          for (IndexInt i = c * chunkSize, stop = std::min(sz, (c + 1) * chunkSize); i < stop; i++)
+            if (keys[i] >= 0)
+              count[keys[i]]++;
+        }
+      },
+      1);
+
+  // exclusive prefix sum, bucket major so each bucket stays in original order
+  IndexInt total = 0;
+  if (bucketStart)
+    bucketStart->resize(numBuckets + 1);
+  for (int b = 0; b < numBuckets; b++) {
+    if (bucketStart)
+      (*bucketStart)[b] = total;
+    for (IndexInt c = 0; c < numChunks; c++) {
+      const IndexInt n = offsets[c * numBuckets + b];
+      offsets[c * numBuckets + b] = total;
+      total += n;
+    }
+  }
+  if (bucketStart)
+    (*bucketStart)[numBuckets] = total;
+
+  order.resize(total);
+  parallelForRange(
+      numChunks,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt c = begin; c < end; c++) {
+          IndexInt *offset = &offsets[c * numBuckets];
+          for (IndexInt i = c * chunkSize, stop = std::min(sz, (c + 1) * chunkSize); i < stop; i++)
+            if (keys[i] >= 0)
+              order[offset[keys[i]]++] = i;
+        }
+      },
+      1);
 }
 
 }  // namespace Manta
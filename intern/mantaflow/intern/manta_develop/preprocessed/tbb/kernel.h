@@ -30,6 +30,9 @@
 #  include <omp.h>
 #endif
 
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include "general.h"
 
 namespace Manta {
@@ -80,6 +83,19 @@ struct KernelBase {
   KernelBase(IndexInt num);
   KernelBase(const GridBase *base, int bnd);
   KernelBase(const Grid4dBase *base, int bnd);
+  //! copies (e.g. tbb body splits) never own the profiler scope of the original kernel
+  KernelBase(const KernelBase &o);
+  ~KernelBase()
+  {
+    if (profiled)
+      profileEnd();
+  }
+
+  //! open and close the profiler scope of this kernel, no-ops if the profiler is disabled.
+  //! An unclosed scope is closed on destruction, e.g. if the kernel threw
+  void profileBegin(const char *name);
+  void profileEnd();
+  bool profiled;
 
   // specify in your derived classes:
 
@@ -92,6 +108,73 @@ struct KernelBase {
   // void setup()
 };
 
+//! Scheduling of 3D ijk kernels. By default threads work on whole z slices; with blocked3D,
+//! kernels that support it (i.e. call runBlocked3D) are split into tiles of
+//! tileX * tileY * tileZ cells instead, so stencil neighbors stay in cache
+struct KernelScheduling {
+  bool blocked3D;
+  int tileX, tileY, tileZ;
+};
+extern KernelScheduling gKernelScheduling;
+
+//! run kernel.runTile(i0, i1, j0, j1, k0, k1) for all tiles of the kernel range, the
+//! kernel's boundary width is taken from minZ, so only use for 3D grids
+template<class Kernel> void runBlocked3D(Kernel &kernel)
+{
+  const KernelScheduling &s = gKernelScheduling;
+  const int bnd = kernel.minZ;
+#if TBB == 1
+  tbb::parallel_for(tbb::blocked_range3d<int>(kernel.minZ,
+                                              kernel.maxZ,
+                                              s.tileZ,
+                                              bnd,
+                                              kernel.maxY,
+                                              s.tileY,
+                                              bnd,
+                                              kernel.maxX,
+                                              s.tileX),
+                    [&](const tbb::blocked_range3d<int> &r) {
+                      kernel.runTile(r.cols().begin(),
+                                     r.cols().end(),
+                                     r.rows().begin(),
+                                     r.rows().end(),
+                                     r.pages().begin(),
+                                     r.pages().end());
+                    });
+#else
+  const int numX = (kernel.maxX - bnd + s.tileX - 1) / s.tileX;
+  const int numY = (kernel.maxY - bnd + s.tileY - 1) / s.tileY;
+  const int numZ = (kernel.maxZ - kernel.minZ + s.tileZ - 1) / s.tileZ;
+  const int numTiles = numX * numY * numZ;
+#  if OPENMP == 1
+#    pragma omp parallel for schedule(dynamic)
+#  endif
+  for (int t = 0; t < numTiles; t++) {
+    const int i0 = bnd + (t % numX) * s.tileX;
+    const int j0 = bnd + ((t / numX) % numY) * s.tileY;
+    const int k0 = kernel.minZ + (t / (numX * numY)) * s.tileZ;
+    kernel.runTile(i0,
+                   std::min(i0 + s.tileX, kernel.maxX),
+                   j0,
+                   std::min(j0 + s.tileY, kernel.maxY),
+                   k0,
+                   std::min(k0 + s.tileZ, kernel.maxZ));
+  }
+#endif
+}
+
+//! run fn(begin, end) for sub ranges of [0, size) in parallel, ranges have about grain entries
+void parallelForRange(IndexInt size,
+                      const std::function<void(IndexInt, IndexInt)> &fn,
+                      IndexInt grain = 4096);
+//! stable counting sort by bucket: order receives the indices of all entries with key >= 0,
+//! grouped by key, in their original order within each bucket. optionally returns the start of
+//! each bucket in order (numBuckets + 1 entries)
+void computeBucketOrder(const std::vector<int> &keys,
+                        int numBuckets,
+                        std::vector<IndexInt> &order,
+                        std::vector<IndexInt> *bucketStart = NULL);
+
 }  // namespace Manta
 
 // all kernels will automatically be added to the "Kernels" group in doxygen
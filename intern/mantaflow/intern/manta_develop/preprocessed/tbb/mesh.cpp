@@ -288,26 +288,44 @@ void Mesh::rebuildCorners(int from, int to)
     }
   }
 
-  // set opposite info
-  int maxc = to * 3;
-  for (int c = from * 3; c < maxc; c++) {
-    int next = mCorners[mCorners[c].next].node;
-    int prev = mCorners[mCorners[c].prev].node;
-
-    // find corner with same next/prev nodes
-    for (int c2 = c + 1; c2 < maxc; c2++) {
-      int next2 = mCorners[mCorners[c2].next].node;
-      if (next2 != next && next2 != prev)
-        continue;
-      int prev2 = mCorners[mCorners[c2].prev].node;
-      if (prev2 != next && prev2 != prev)
-        continue;
+  // set opposite info: corners are grouped by the lower node of their opposite edge, then
+  // sorted by the other node within each group in parallel. corners on the same edge are
+  // paired in index order, as a search for the next corner with the same edge would do
+  const int numNodes = mNodes.size();
+  const int minc = from * 3, maxc = to * 3;
+  std::vector<int> start(numNodes + 1, 0), edgeCorners(maxc - minc);
+  for (int c = minc; c < maxc; c++)
+    start[std::min(mCorners[mCorners[c].next].node, mCorners[mCorners[c].prev].node) + 1]++;
+  for (int n = 0; n < numNodes; n++)
+    start[n + 1] += start[n];
+  std::vector<int> fill(start.begin(), start.end() - 1);
+  for (int c = minc; c < maxc; c++)
+    edgeCorners[fill[std::min(mCorners[mCorners[c].next].node,
+                              mCorners[mCorners[c].prev].node)]++] = c;
+
+  parallelForRange(
+      numNodes,
+      [&](IndexInt begin, IndexInt end) {
+        std::vector<std::pair<int, int>> group;
+        for (IndexInt n = begin; n < end; n++) {
+          group.clear();
+          for (int i = start[n]; i < start[n + 1]; i++) {
+            const int c = edgeCorners[i];
+            group.push_back(std::make_pair(
+                std::max(mCorners[mCorners[c].next].node, mCorners[mCorners[c].prev].node), c));
+          }
+          std::sort(group.begin(), group.end());
+          for (size_t i = 0; i + 1 < group.size(); i++) {
+            if (group[i].first != group[i + 1].first)
+              continue;
+            mCorners[group[i].second].opposite = group[i + 1].second;
+            mCorners[group[i + 1].second].opposite = group[i].second;
+          }
+        }
+      },
+      1024);
 
-      // found
-      mCorners[c].opposite = c2;
-      mCorners[c2].opposite = c;
-      break;
-    }
+  for (int c = minc; c < maxc; c++) {
     if (mCorners[c].opposite < 0) {
       // didn't find opposite
       errMsg("can't rebuild corners, index without an opposite");
@@ -319,8 +337,10 @@ void Mesh::rebuildCorners(int from, int to)
 
 void Mesh::rebuildLookup(int from, int to)
 {
-  if (from == 0 && to < 0)
-    m1RingLookup.clear();
+  if (from == 0 && to < 0) {
+    rebuildLookupFromTris();
+    return;
+  }
   m1RingLookup.resize(mNodes.size());
   if (to < 0)
     to = mTris.size();
@@ -334,6 +354,84 @@ void Mesh::rebuildLookup(int from, int to)
   }
 }
 
+void Mesh::buildAdjacency(MeshAdjacency &adj, bool withNodes) const
+{
+  // counting sort of the corners by node. the two passes are serial, they are cheap compared to
+  // the work per node afterwards
+  const int numNodes = mNodes.size();
+  const int numCorners = 3 * mTris.size();
+  adj.cornerStart.assign(numNodes + 1, 0);
+  adj.corners.resize(numCorners);
+  for (int i = 0; i < numCorners; i++)
+    adj.cornerStart[mTris[i / 3].c[i % 3] + 1]++;
+  for (int n = 0; n < numNodes; n++)
+    adj.cornerStart[n + 1] += adj.cornerStart[n];
+  std::vector<int> fill(adj.cornerStart.begin(), adj.cornerStart.end() - 1);
+  for (int i = 0; i < numCorners; i++)
+    adj.corners[fill[mTris[i / 3].c[i % 3]]++] = i;
+
+  adj.nodeStart.clear();
+  adj.nodes.clear();
+  if (!withNodes)
+    return;
+
+  // next and prev nodes of all corners of a node, sorted and made unique in place
+  std::vector<int> ring(2 * numCorners), count(numNodes);
+  parallelForRange(
+      numNodes,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++) {
+          int *r = ring.data() + 2 * adj.cornerStart[n];
+          int num = 0;
+          for (int i = adj.cornerStart[n]; i < adj.cornerStart[n + 1]; i++) {
+            const int tri = adj.corners[i] / 3, c = adj.corners[i] % 3;
+            r[num++] = mTris[tri].c[(c + 1) % 3];
+            r[num++] = mTris[tri].c[(c + 2) % 3];
+          }
+          std::sort(r, r + num);
+          count[n] = std::unique(r, r + num) - r;
+        }
+      },
+      1024);
+
+  adj.nodeStart.resize(numNodes + 1);
+  adj.nodeStart[0] = 0;
+  for (int n = 0; n < numNodes; n++)
+    adj.nodeStart[n + 1] = adj.nodeStart[n] + count[n];
+  adj.nodes.resize(adj.nodeStart[numNodes]);
+  parallelForRange(
+      numNodes,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++)
+          std::copy(ring.begin() + 2 * adj.cornerStart[n],
+                    ring.begin() + 2 * adj.cornerStart[n] + count[n],
+                    adj.nodes.begin() + adj.nodeStart[n]);
+      },
+      1024);
+}
+
+void Mesh::rebuildLookupFromTris()
+{
+  MeshAdjacency adj;
+  buildAdjacency(adj);
+
+  m1RingLookup.clear();
+  m1RingLookup.resize(mNodes.size());
+  parallelForRange(
+      mNodes.size(),
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++) {
+          // both lists are sorted, so every insert goes to the end
+          OneRing &ring = m1RingLookup[n];
+          for (int i = adj.nodeStart[n]; i < adj.nodeStart[n + 1]; i++)
+            ring.nodes.insert(ring.nodes.end(), adj.nodes[i]);
+          for (int i = adj.cornerStart[n]; i < adj.cornerStart[n + 1]; i++)
+            ring.tris.insert(ring.tris.end(), adj.corners[i] / 3);
+        }
+      },
+      1024);
+}
+
 void Mesh::rebuildChannels()
 {
   for (size_t i = 0; i < mTriChannels.size(); i++)
@@ -393,6 +491,7 @@ struct KnAdvectMeshInGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   void run()
   {
@@ -432,6 +531,7 @@ struct KnAdvectMeshInGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnAdvectMeshInGrid");
   };
   _KnAdvectMeshInGrid _inner;
   vector<Node> &nodes;
@@ -730,23 +830,34 @@ int Mesh::addNode(Node a)
 
 void Mesh::computeVertexNormals()
 {
-  for (size_t i = 0; i < mNodes.size(); i++) {
-    mNodes[i].normal = 0.0;
-  }
-  for (size_t t = 0; t < mTris.size(); t++) {
-    Vec3 p0 = getNode(t, 0), p1 = getNode(t, 1), p2 = getNode(t, 2);
-    Vec3 n0 = p0 - p1, n1 = p1 - p2, n2 = p2 - p0;
-    Real l0 = normSquare(n0), l1 = normSquare(n1), l2 = normSquare(n2);
-
-    Vec3 nm = cross(n0, n1);
-
-    mNodes[mTris[t].c[0]].normal += nm * (1.0 / (l0 * l2));
-    mNodes[mTris[t].c[1]].normal += nm * (1.0 / (l0 * l1));
-    mNodes[mTris[t].c[2]].normal += nm * (1.0 / (l1 * l2));
-  }
-  for (size_t i = 0; i < mNodes.size(); i++) {
-    normalize(mNodes[i].normal);
-  }
+  // gather the weighted face normals per node, in the same triangle order as a serial loop over
+  // the triangles would add them
+  MeshAdjacency adj;
+  buildAdjacency(adj, false);
+  parallelForRange(
+      mNodes.size(),
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt n = begin; n < end; n++) {
+          Vec3 normal(0.0);
+          for (int i = adj.cornerStart[n]; i < adj.cornerStart[n + 1]; i++) {
+            const int t = adj.corners[i] / 3, c = adj.corners[i] % 3;
+            Vec3 p0 = getNode(t, 0), p1 = getNode(t, 1), p2 = getNode(t, 2);
+            Vec3 n0 = p0 - p1, n1 = p1 - p2, n2 = p2 - p0;
+            Real l0 = normSquare(n0), l1 = normSquare(n1), l2 = normSquare(n2);
+
+            Vec3 nm = cross(n0, n1);
+            if (c == 0)
+              normal += nm * (1.0 / (l0 * l2));
+            else if (c == 1)
+              normal += nm * (1.0 / (l0 * l1));
+            else
+              normal += nm * (1.0 / (l1 * l2));
+          }
+          normalize(normal);
+          mNodes[n].normal = normal;
+        }
+      },
+      1024);
 }
 
 void Mesh::fastNodeLookupRebuild(int corner)
@@ -1006,6 +1117,7 @@ template<class T> struct ApplyMeshToGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, Grid<T> *grid, Grid<Real> &sdf, T value, FlagGrid *respectFlags) const
@@ -1042,6 +1154,7 @@ template<class T> struct ApplyMeshToGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyMeshToGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1424,6 +1537,7 @@ template<class T> struct knSetMdataConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &mdata, T value) const
   {
@@ -1445,6 +1559,7 @@ template<class T> struct knSetMdataConst : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetMdataConst");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1465,6 +1580,7 @@ template<class T, class S> struct knMdataSet : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other) const
   {
@@ -1486,6 +1602,7 @@ template<class T, class S> struct knMdataSet : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSet");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1505,6 +1622,7 @@ template<class T, class S> struct knMdataAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other) const
   {
@@ -1526,6 +1644,7 @@ template<class T, class S> struct knMdataAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1545,6 +1664,7 @@ template<class T, class S> struct knMdataSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other) const
   {
@@ -1566,6 +1686,7 @@ template<class T, class S> struct knMdataSub : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSub");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1585,6 +1706,7 @@ template<class T, class S> struct knMdataMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other) const
   {
@@ -1606,6 +1728,7 @@ template<class T, class S> struct knMdataMult : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataMult");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1625,6 +1748,7 @@ template<class T, class S> struct knMdataDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<S> &other) const
   {
@@ -1646,6 +1770,7 @@ template<class T, class S> struct knMdataDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1666,6 +1791,7 @@ template<class T, class S> struct knMdataSetScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const S &other) const
   {
@@ -1687,6 +1813,7 @@ template<class T, class S> struct knMdataSetScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSetScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1706,6 +1833,7 @@ template<class T, class S> struct knMdataAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const S &other) const
   {
@@ -1727,6 +1855,7 @@ template<class T, class S> struct knMdataAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataAddScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1746,6 +1875,7 @@ template<class T, class S> struct knMdataMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const S &other) const
   {
@@ -1767,6 +1897,7 @@ template<class T, class S> struct knMdataMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataMultScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1786,6 +1917,7 @@ template<class T, class S> struct knMdataScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  MeshDataImpl<T> &me,
@@ -1815,6 +1947,7 @@ template<class T, class S> struct knMdataScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataScaledAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1836,6 +1969,7 @@ template<class T> struct knMdataSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const MeshDataImpl<T> &other) const
   {
@@ -1857,6 +1991,7 @@ template<class T> struct knMdataSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSafeDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1876,6 +2011,7 @@ template<class T> struct knMdataSetConst : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &mdata, T value) const
   {
@@ -1897,6 +2033,7 @@ template<class T> struct knMdataSetConst : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSetConst");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1917,6 +2054,7 @@ template<class T> struct knMdataClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, T min, T max) const
   {
@@ -1943,6 +2081,7 @@ template<class T> struct knMdataClamp : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClamp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1962,6 +2101,7 @@ template<class T> struct knMdataClampMin : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const T vmin) const
   {
@@ -1983,6 +2123,7 @@ template<class T> struct knMdataClampMin : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMin");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2001,6 +2142,7 @@ template<class T> struct knMdataClampMax : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<T> &me, const T vmax) const
   {
@@ -2022,6 +2164,7 @@ template<class T> struct knMdataClampMax : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMax");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2041,6 +2184,7 @@ struct knMdataClampMinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<Vec3> &me, const Real vmin) const
   {
@@ -2064,6 +2208,7 @@ struct knMdataClampMinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMinVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2083,6 +2228,7 @@ struct knMdataClampMaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, MeshDataImpl<Vec3> &me, const Real vmax) const
   {
@@ -2106,6 +2252,7 @@ struct knMdataClampMaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataClampMaxVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2151,6 +2298,7 @@ template<class T, class S> struct knMdataSetScalarIntFlag : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  MeshDataImpl<T> &me,
@@ -2187,6 +2335,7 @@ template<class T, class S> struct knMdataSetScalarIntFlag : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMdataSetScalarIntFlag");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2271,6 +2420,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const MeshDataImpl<T> &val,
@@ -2311,6 +2461,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSum");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2339,6 +2490,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &result)
   {
@@ -2363,6 +2515,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumSquare");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2388,6 +2541,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &result)
   {
@@ -2412,6 +2566,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumMagnitude");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2454,6 +2609,7 @@ struct CompMdata_Min : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &minVal)
   {
@@ -2479,6 +2635,7 @@ struct CompMdata_Min : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_Min");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2509,6 +2666,7 @@ struct CompMdata_Max : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<T> &val, Real &maxVal)
   {
@@ -2534,6 +2692,7 @@ struct CompMdata_Max : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_Max");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2606,6 +2765,7 @@ struct CompMdata_MinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<Vec3> &val, Real &minVal)
   {
@@ -2632,6 +2792,7 @@ struct CompMdata_MinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_MinVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -2660,6 +2821,7 @@ struct CompMdata_MaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const MeshDataImpl<Vec3> &val, Real &maxVal)
   {
@@ -2686,6 +2848,7 @@ struct CompMdata_MaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompMdata_MaxVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -168,6 +168,15 @@ struct OneRing {
   std::set<int> tris;
 };
 
+//! Compressed (CSR) node adjacency of a mesh, built from the triangles only
+struct MeshAdjacency {
+  //! corners (3 * tri + c) of each node in triangle order, node n has the corners
+  //! [cornerStart[n], cornerStart[n + 1])
+  std::vector<int> cornerStart, corners;
+  //! one-ring neighbor nodes of each node in ascending order, same layout as the corners
+  std::vector<int> nodeStart, nodes;
+};
+
 //! Triangle mesh class
 /*! note: this is only a temporary solution, details are bound to change
           long term goal is integration with Split&Merge code by Wojtan et al.*/
@@ -213,6 +222,8 @@ class Mesh : public PbClass {
 
   Real computeCenterOfMass(Vec3 &cm) const;
   void computeVertexNormals();
+  //! build the CSR adjacency of the current triangles, the one-ring nodes are optional
+  void buildAdjacency(MeshAdjacency &adj, bool withNodes = true) const;
 
   // plugins
   void clear();
@@ -697,6 +708,10 @@ class Mesh : public PbClass {
   {
     return mNodes;
   }
+  inline std::vector<Triangle> &getTriData()
+  {
+    return mTris;
+  }
 
   void mergeNode(int node, int delnode);
   int addNode(Node a);
@@ -707,6 +722,8 @@ class Mesh : public PbClass {
   void removeNodes(const std::vector<int> &deletedNodes);
   void rebuildCorners(int from = 0, int to = -1);
   void rebuildLookup(int from = 0, int to = -1);
+  //! rebuild the whole one-ring lookup from the triangles only (no corners needed), in parallel
+  void rebuildLookupFromTris();
   void rebuildQuickCheck();
   void fastNodeLookupRebuild(int corner);
   void sanityCheck(bool strict = true,
@@ -1616,6 +1633,12 @@ template<class T> class MeshDataImpl : public MeshDataBase {
     }
   }
 
+  //! low level access to the data vector, used by Blender
+  std::vector<T> &getData()
+  {
+    return mData;
+  }
+
   //! get data pointer of mesh data
   std::string getDataPointer();
   static PyObject *_W_43(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
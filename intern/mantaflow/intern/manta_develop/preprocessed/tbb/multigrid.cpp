@@ -257,7 +257,8 @@ GridMg::GridMg(const Vec3i &gridSize)
       mCoarsestLevelAccuracy(Real(1E-8)),
       mTrivialEquationScale(Real(1E-6)),
       mIsASet(false),
-      mIsRhsSet(false)
+      mIsRhsSet(false),
+      mHasCoarseGrids(false)
 {
   MG_TIMINGS(MuTime time;)
 
@@ -419,6 +420,7 @@ struct knCopyA : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<Real> &sizeRef,
@@ -482,6 +484,7 @@ struct knCopyA : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCopyA");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -517,6 +520,7 @@ struct knActivateVertices : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<GridMg::VertexType> &type_0,
@@ -578,6 +582,7 @@ struct knActivateVertices : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knActivateVertices");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -605,12 +610,20 @@ void GridMg::setA(const Grid<Real> *pA0,
   // Copy level 0
   knCopyA(mx[0], mA[0], mStencilSize0, mIs3D, pA0, pAi, pAj, pAk);
 
+  // Keep previous vertex types, coarse grids only need to be regenerated if they change
+  if (mHasCoarseGrids)
+    mPrevType0 = mType[0];
+
   // Determine active vertices and scale trivial equations
   bool nonZeroStencilSumFound = false;
   bool trivialEquationsFound = false;
 
   knActivateVertices(mType[0], mA[0], nonZeroStencilSumFound, trivialEquationsFound, *this);
 
+  const bool genCoarseGrids = !mHasCoarseGrids || mPrevType0 != mType[0];
+  if (!genCoarseGrids)
+    debMsg("GridMg::setA: Active vertices unchanged, reusing coarse grids", 2);
+
   if (trivialEquationsFound)
     debMsg("GridMg::setA: Found at least one trivial equation", 2);
 
@@ -625,12 +638,18 @@ void GridMg::setA(const Grid<Real> *pA0,
   // Create coarse grids and operators on levels >0
   for (int l = 1; l < mA.size(); l++) {
     MG_TIMINGS(time.get();)
-    genCoarseGrid(l);
+    if (genCoarseGrids) {
+      // start from cleared operators as in a newly created hierarchy
+      if (mHasCoarseGrids)
+        std::fill(mA[l].begin(), mA[l].end(), Real(0));
+      genCoarseGrid(l);
+    }
     MG_TIMINGS(debMsg("GridMg: Generated level " << l << " in " << time.update(), 1);)
     genCoraseGridOperator(l);
     MG_TIMINGS(debMsg("GridMg: Generated operator " << l << " in " << time.update(), 1);)
   }
 
+  mHasCoarseGrids = true;
   mIsASet = true;
   mIsRhsSet = false;  // invalidate rhs
 }
@@ -641,6 +660,7 @@ struct knSetRhs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<Real> &b, const Grid<Real> &rhs, const GridMg &mg) const
   {
@@ -672,6 +692,7 @@ struct knSetRhs : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetRhs");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -701,6 +722,7 @@ template<class T> struct knSet : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<T> &data, T value) const
   {
@@ -722,6 +744,7 @@ template<class T> struct knSet : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSet");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -742,6 +765,7 @@ template<class T> struct knCopyToVector : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<T> &dst, const Grid<T> &src) const
   {
@@ -763,6 +787,7 @@ template<class T> struct knCopyToVector : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCopyToVector");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -783,6 +808,7 @@ template<class T> struct knCopyToGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const std::vector<T> &src, Grid<T> &dst) const
   {
@@ -804,6 +830,7 @@ template<class T> struct knCopyToGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCopyToGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -824,6 +851,7 @@ template<class T> struct knAddAssign : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<T> &dst, const std::vector<T> &src) const
   {
@@ -845,6 +873,7 @@ template<class T> struct knAddAssign : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knAddAssign");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -929,6 +958,7 @@ struct knActivateCoarseVertices : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<GridMg::VertexType> &type, int unused) const
   {
@@ -958,6 +988,7 @@ struct knActivateCoarseVertices : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knActivateCoarseVertices");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1051,6 +1082,7 @@ struct knGenCoarseGridOperator : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<Real> &sizeRef,
@@ -1184,6 +1216,7 @@ struct knGenCoarseGridOperator : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knGenCoarseGridOperator");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1225,6 +1258,7 @@ struct knSmoothColor : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ThreadSize &numBlocks,
@@ -1324,6 +1358,7 @@ struct knSmoothColor : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSmoothColor");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1385,6 +1420,7 @@ struct knCalcResidual : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<Real> &r, int l, const GridMg &mg) const
   {
@@ -1449,6 +1485,7 @@ struct knCalcResidual : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knCalcResidual");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1475,6 +1512,7 @@ struct knResidualNormSumSqr : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const vector<Real> &r, int l, const GridMg &mg, Real &result)
   {
@@ -1512,6 +1550,7 @@ struct knResidualNormSumSqr : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knResidualNormSumSqr");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1695,6 +1734,7 @@ struct knRestrict : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<Real> &dst,
@@ -1752,6 +1792,7 @@ struct knRestrict : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knRestrict");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1779,6 +1820,7 @@ struct knInterpolate : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<Real> &dst,
@@ -1833,6 +1875,7 @@ struct knInterpolate : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knInterpolate");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
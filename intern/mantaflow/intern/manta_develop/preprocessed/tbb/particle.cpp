@@ -337,6 +337,15 @@ template<class T> void ParticleDataImpl<T>::copyValueSlow(IndexInt from, IndexIn
 {
   this->copyValue(from, to);
 }
+template<class T> void ParticleDataImpl<T>::permute(const std::vector<IndexInt> &order)
+{
+  std::vector<T> data(order.size());
+  parallelForRange(order.size(), [&](IndexInt begin, IndexInt end) {
+    for (IndexInt i = begin; i < end; i++)
+      data[i] = mData[order[i]];
+  });
+  mData.swap(data);
+}
 template<class T> ParticleDataBase *ParticleDataImpl<T>::clone()
 {
   ParticleDataImpl<T> *npd = new ParticleDataImpl<T>(getParent(), this);
@@ -424,6 +433,7 @@ template<class T, class S> struct knPdataAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other) const
   {
@@ -445,6 +455,7 @@ template<class T, class S> struct knPdataAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -464,6 +475,7 @@ template<class T, class S> struct knPdataSub : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other) const
   {
@@ -485,6 +497,7 @@ template<class T, class S> struct knPdataSub : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSub");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -504,6 +517,7 @@ template<class T, class S> struct knPdataMult : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other) const
   {
@@ -525,6 +539,7 @@ template<class T, class S> struct knPdataMult : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataMult");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -544,6 +559,7 @@ template<class T, class S> struct knPdataDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<S> &other) const
   {
@@ -565,6 +581,7 @@ template<class T, class S> struct knPdataDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -584,6 +601,7 @@ template<class T> struct knPdataSafeDiv : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const ParticleDataImpl<T> &other) const
   {
@@ -605,6 +623,7 @@ template<class T> struct knPdataSafeDiv : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSafeDiv");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -625,6 +644,7 @@ template<class T, class S> struct knPdataSetScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const S &other) const
   {
@@ -646,6 +666,7 @@ template<class T, class S> struct knPdataSetScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSetScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -665,6 +686,7 @@ template<class T, class S> struct knPdataAddScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const S &other) const
   {
@@ -686,6 +708,7 @@ template<class T, class S> struct knPdataAddScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataAddScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -705,6 +728,7 @@ template<class T, class S> struct knPdataMultScalar : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const S &other) const
   {
@@ -726,6 +750,7 @@ template<class T, class S> struct knPdataMultScalar : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataMultScalar");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -745,6 +770,7 @@ template<class T, class S> struct knPdataScaledAdd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<T> &me,
@@ -774,6 +800,7 @@ template<class T, class S> struct knPdataScaledAdd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataScaledAdd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -795,6 +822,7 @@ template<class T> struct knPdataClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const T vmin, const T vmax) const
   {
@@ -821,6 +849,7 @@ template<class T> struct knPdataClamp : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClamp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -841,6 +870,7 @@ template<class T> struct knPdataClampMin : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const T vmin) const
   {
@@ -862,6 +892,7 @@ template<class T> struct knPdataClampMin : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMin");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -881,6 +912,7 @@ template<class T> struct knPdataClampMax : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<T> &me, const T vmax) const
   {
@@ -902,6 +934,7 @@ template<class T> struct knPdataClampMax : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMax");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -922,6 +955,7 @@ struct knPdataClampMinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<Vec3> &me, const Real vmin) const
   {
@@ -945,6 +979,7 @@ struct knPdataClampMinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMinVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -965,6 +1000,7 @@ struct knPdataClampMaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleDataImpl<Vec3> &me, const Real vmax) const
   {
@@ -988,6 +1024,7 @@ struct knPdataClampMaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataClampMaxVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1036,6 +1073,7 @@ template<class T, class S> struct knPdataSetScalarIntFlag : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<T> &me,
@@ -1072,6 +1110,7 @@ template<class T, class S> struct knPdataSetScalarIntFlag : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPdataSetScalarIntFlag");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1159,6 +1198,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const ParticleDataImpl<T> &val,
@@ -1199,6 +1239,7 @@ template<typename T> struct KnPtsSum : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSum");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1227,6 +1268,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &result)
   {
@@ -1251,6 +1293,7 @@ template<typename T> struct KnPtsSumSquare : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumSquare");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1276,6 +1319,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &result)
   {
@@ -1300,6 +1344,7 @@ template<typename T> struct KnPtsSumMagnitude : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnPtsSumMagnitude");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1343,6 +1388,7 @@ struct CompPdata_Min : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &minVal)
   {
@@ -1368,6 +1414,7 @@ struct CompPdata_Min : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_Min");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1398,6 +1445,7 @@ struct CompPdata_Max : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<T> &val, Real &maxVal)
   {
@@ -1423,6 +1471,7 @@ struct CompPdata_Max : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_Max");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1495,6 +1544,7 @@ struct CompPdata_MinVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<Vec3> &val, Real &minVal)
   {
@@ -1521,6 +1571,7 @@ struct CompPdata_MinVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_MinVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -1549,6 +1600,7 @@ struct CompPdata_MaxVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const ParticleDataImpl<Vec3> &val, Real &maxVal)
   {
@@ -1575,6 +1627,7 @@ struct CompPdata_MaxVec3 : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("CompPdata_MaxVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -429,6 +429,13 @@ template<class S> class ParticleSystem : public ParticleBase {
     if (mDeletes > mDeleteChunk)
       compress();
   }
+  //! recount particles flagged as deleted; kill() from parallel kernels does not update the
+  //! counter atomically, so call this before doCompress() to make its decision deterministic
+  void recountDeletes();
+  //! reorder particles and pdata so that particles in the same 8^3 tile of a grid with the
+  //! given size are stored contiguously; also drops deleted particles like compress() does.
+  //! only the storage order changes, particles stay an array of structs (no SoA layout)
+  void sortByTile(const Vec3i &gridSize);
   //! insert buffered positions as new particles, update additional particle data
   void insertBufferedParticles();
   //! resize data vector, and all pdata fields
@@ -437,6 +444,9 @@ template<class S> class ParticleSystem : public ParticleBase {
   //! adding and deleting
   inline void kill(IndexInt idx);
   IndexInt add(const S &data);
+  //! append num zero initialized particles (and pdata entries) in one go, returns the index of
+  //! the first one, so parallel emitters can fill pre-sized buffers instead of calling add()
+  IndexInt addEmpty(IndexInt num);
   //! remove all particles, init 0 length arrays (also pdata)
   void clear();
   static PyObject *_W_8(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
@@ -1013,6 +1023,12 @@ class ParticleDataBase : public PbClass {
     assertMsg(false, "Dont use, override...");
     return;
   }
+  //! replace entries by the ones at order[i], resizes to order.size()
+  virtual void permute(const std::vector<IndexInt> &order)
+  {
+    assertMsg(false, "Dont use, override...");
+    return;
+  }
 
   //! set base pointer
   void setParticleSys(ParticleBase *set)
@@ -1148,6 +1164,7 @@ template<class T> class ParticleDataImpl : public ParticleDataBase {
   virtual PdataType getType() const;
   virtual void resize(IndexInt s);
   virtual void copyValueSlow(IndexInt from, IndexInt to);
+  virtual void permute(const std::vector<IndexInt> &order);
 
   IndexInt size() const
   {
@@ -1760,6 +1777,12 @@ template<class T> class ParticleDataImpl : public ParticleDataBase {
     }
   }
 
+  //! low level access to the data vector, used by Blender
+  std::vector<T> &getData()
+  {
+    return mData;
+  }
+
   //! get data pointer of particle data
   std::string getDataPointer();
   static PyObject *_W_48(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
@@ -1804,6 +1827,92 @@ template<class T> class ParticleDataImpl : public ParticleDataBase {
 
 const int DELETE_PART = 20;  // chunk size for compression
 
+//! Flat acceleration grid for particle neighbor queries
+/*! particle indices are kept sorted by cell (computeBucketOrder) with one offset per cell, so
+ *  refills run in parallel and do not allocate once the arrays have grown. res cells per axis
+ *  cover [0, size) of the domain, positions outside are clamped to the border cells. candidates
+ *  are visited cell by cell in (i, j, k) order, k innermost, and in ascending particle index
+ *  within each cell */
+class ParticleNeighborGrid {
+ public:
+  ParticleNeighborGrid() : mRes(0), mSize(0.)
+  {
+  }
+
+  //! set domain size and number of cells per axis, the grid is empty afterwards
+  void init(const Vec3 &size, int res)
+  {
+    mSize = size;
+    mRes = std::max(res, 1);
+    mCellStart.assign((IndexInt)mRes * mRes * mRes + 1, 0);
+    mIds.clear();
+  }
+
+  //! rebuild from num positions, getPos(IndexInt) returns the position of an entry
+  template<class POS> void fill(IndexInt num, const POS &getPos)
+  {
+    mKeys.resize(num);
+    parallelForRange(num, [&](IndexInt begin, IndexInt end) {
+      for (IndexInt n = begin; n < end; n++) {
+        const Vec3i c = cellOf(getPos(n));
+        mKeys[n] = cellIndex(c.x, c.y, c.z);
+      }
+    });
+    computeBucketOrder(mKeys, (int)mCellStart.size() - 1, mIds, &mCellStart);
+  }
+
+  inline Vec3i cellOf(const Vec3 &pos) const
+  {
+    return Vec3i(clamp<int>(floor(pos.x / mSize.x * mRes), 0, mRes - 1),
+                 clamp<int>(floor(pos.y / mSize.y * mRes), 0, mRes - 1),
+                 clamp<int>(floor(pos.z / mSize.z * mRes), 0, mRes - 1));
+  }
+  inline int cellIndex(int i, int j, int k) const
+  {
+    return k + mRes * (j + mRes * i);
+  }
+  //! entries of cell c are the particles getId(n) for n in [cellBegin(c), cellEnd(c))
+  inline IndexInt cellBegin(int c) const
+  {
+    return mCellStart[c];
+  }
+  inline IndexInt cellEnd(int c) const
+  {
+    return mCellStart[c + 1];
+  }
+  inline int getId(IndexInt n) const
+  {
+    return (int)mIds[n];
+  }
+  inline int getRes() const
+  {
+    return mRes;
+  }
+
+  //! call func(id) for all particles in the cells touched by the box of half width radius around
+  //! center, stops as soon as func returns false. returns false if stopped
+  template<class FUNC> bool forEachCandidate(const Vec3 &center, Real radius, FUNC func) const
+  {
+    const Vec3i lo = cellOf(center - Vec3(radius)), hi = cellOf(center + Vec3(radius));
+    for (int i = lo.x; i <= hi.x; i++)
+      for (int j = lo.y; j <= hi.y; j++)
+        for (int k = lo.z; k <= hi.z; k++) {
+          const int c = cellIndex(i, j, k);
+          for (IndexInt n = mCellStart[c]; n < mCellStart[c + 1]; n++)
+            if (!func((int)mIds[n]))
+              return false;
+        }
+    return true;
+  }
+
+ protected:
+  int mRes;
+  Vec3 mSize;
+  std::vector<int> mKeys;
+  std::vector<IndexInt> mIds;
+  std::vector<IndexInt> mCellStart;
+};
+
 void ParticleBase::addBuffered(const Vec3 &pos, int flag)
 {
   mNewBufferPos.push_back(pos);
@@ -1824,6 +1933,14 @@ template<class S> IndexInt ParticleSystem<S>::add(const S &data)
   return mData.size() - 1;
 }
 
+template<class S> IndexInt ParticleSystem<S>::addEmpty(IndexInt num)
+{
+  const IndexInt first = mData.size();
+  resizeAll(first + num);
+  mDeleteChunk = mData.size() / DELETE_PART;
+  return first;
+}
+
 template<class S> inline void ParticleSystem<S>::kill(IndexInt idx)
 {
   assertMsg(idx >= 0 && idx < size(), "Index out of bounds");
@@ -1958,6 +2075,7 @@ template<class S> struct GridAdvectKernel : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   void run()
   {
@@ -2017,6 +2135,7 @@ template<class S> struct GridAdvectKernel : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("GridAdvectKernel");
   };
   _GridAdvectKernel<S> _inner;
   std::vector<S> &p;
@@ -2040,6 +2159,7 @@ template<class S> struct KnDeleteInObstacle : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, std::vector<S> &p, const FlagGrid &flags) const
   {
@@ -2065,6 +2185,7 @@ template<class S> struct KnDeleteInObstacle : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnDeleteInObstacle");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2111,6 +2232,7 @@ template<class S> struct KnClampPositions : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  std::vector<S> &p,
@@ -2170,6 +2292,7 @@ template<class S> struct KnClampPositions : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnClampPositions");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2227,6 +2350,7 @@ template<class S> struct KnProjectParticles : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, ParticleSystem<S> &part, Grid<Vec3> &gradient)
   {
@@ -2264,6 +2388,7 @@ template<class S> struct KnProjectParticles : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnProjectParticles");
   };
   void run()
   {
@@ -2297,6 +2422,7 @@ template<class S> struct KnProjectOutOfBnd : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleSystem<S> &part,
@@ -2359,6 +2485,7 @@ template<class S> struct KnProjectOutOfBnd : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnProjectOutOfBnd");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2410,6 +2537,15 @@ template<class S> void ParticleSystem<S>::resizeAll(IndexInt size)
     mPartData[i]->resize(size);
 }
 
+template<class S> void ParticleSystem<S>::recountDeletes()
+{
+  IndexInt deletes = 0;
+  for (IndexInt i = 0; i < (IndexInt)mData.size(); i++)
+    if (mData[i].flag & PDELETE)
+      deletes++;
+  mDeletes = deletes;
+}
+
 template<class S> void ParticleSystem<S>::compress()
 {
   IndexInt nextRead = mData.size();
@@ -2435,6 +2571,101 @@ template<class S> void ParticleSystem<S>::compress()
   mDeleteChunk = mData.size() / DELETE_PART;
 }
 
+template<class S> void ParticleSystem<S>::sortByTile(const Vec3i &gridSize)
+{
+  // 8^3 cell tiles, as used by TileMask
+  const int bits = 3;
+  const Vec3i tiles(
+      (gridSize.x + 7) >> bits, (gridSize.y + 7) >> bits, (gridSize.z + 7) >> bits);
+  const int numTiles = tiles.x * tiles.y * tiles.z;
+
+  std::vector<int> keys(mData.size());
+  parallelForRange(mData.size(), [&](IndexInt begin, IndexInt end) {
+    for (IndexInt i = begin; i < end; i++) {
+      if (mData[i].flag & PDELETE) {
+        keys[i] = -1;
+        continue;
+      }
+      const Vec3i p = toVec3i(mData[i].pos);
+      const int ti = clamp(p.x, 0, gridSize.x - 1) >> bits;
+      const int tj = clamp(p.y, 0, gridSize.y - 1) >> bits;
+      const int tk = clamp(p.z, 0, gridSize.z - 1) >> bits;
+      keys[i] = ti + tiles.x * (tj + tiles.y * tk);
+    }
+  });
+
+  std::vector<IndexInt> order;
+  computeBucketOrder(keys, numTiles, order);
+
+  std::vector<S> data(order.size());
+  parallelForRange(order.size(), [&](IndexInt begin, IndexInt end) {
+    for (IndexInt i = begin; i < end; i++)
+      data[i] = mData[order[i]];
+  });
+  if (data.size() < mData.size())
+    debMsg("Deleted " << (IndexInt)(mData.size() - data.size()) << " particles", 1);
+  mData.swap(data);
+  for (IndexInt pd = 0; pd < (IndexInt)mPartData.size(); ++pd)
+    mPartData[pd]->permute(order);
+
+  mDeletes = 0;
+  mDeleteChunk = mData.size() / DELETE_PART;
+}
+
+//! parallel particle to grid scatter without write conflicts: fn(idx) is called for all active
+//! particles (not matching exclude), it may write to the grid cells within one cell of the
+//! particle's cell. particles are binned into the 8^3 cell tiles of sortByTile, tiles with the same
+//! coordinate parity are more than two cells apart, so the eight parities run one after another
+//! with all tiles of a parity in parallel. the order of the writes per cell only depends on the
+//! particle order, not on the number of threads
+template<class S, class Fn>
+void parallelParticleScatter(const ParticleSystem<S> &p,
+                             const GridBase &grid,
+                             const ParticleDataImpl<int> *ptype,
+                             const int exclude,
+                             const Fn &fn)
+{
+  const int bits = 3;
+  const Vec3i gs = grid.getSize();
+  const Vec3i blocks((gs.x + 7) >> bits, (gs.y + 7) >> bits, (gs.z + 7) >> bits);
+  const int numBlocks = blocks.x * blocks.y * blocks.z;
+
+  std::vector<int> keys(p.size());
+  parallelForRange(p.size(), [&](IndexInt begin, IndexInt end) {
+    for (IndexInt idx = begin; idx < end; idx++) {
+      if (!p.isActive(idx) || (ptype && ((*ptype)[idx] & exclude))) {
+        keys[idx] = -1;
+        continue;
+      }
+      const Vec3 &pos = p[idx].pos;
+      const int bi = clamp((int)pos.x, 0, gs.x - 1) >> bits;
+      const int bj = clamp((int)pos.y, 0, gs.y - 1) >> bits;
+      const int bk = clamp((int)pos.z, 0, gs.z - 1) >> bits;
+      keys[idx] = bi + blocks.x * (bj + blocks.y * bk);
+    }
+  });
+  std::vector<IndexInt> order, start;
+  computeBucketOrder(keys, numBlocks, order, &start);
+
+  for (int parity = 0; parity < 8; parity++) {
+    const Vec3i o(parity & 1, (parity >> 1) & 1, (parity >> 2) & 1);
+    const Vec3i n((blocks.x + 1 - o.x) / 2, (blocks.y + 1 - o.y) / 2, (blocks.z + 1 - o.z) / 2);
+    parallelForRange(
+        (IndexInt)n.x * n.y * n.z,
+        [&](IndexInt begin, IndexInt end) {
+          for (IndexInt b = begin; b < end; b++) {
+            const int bi = o.x + 2 * (int)(b % n.x);
+            const int bj = o.y + 2 * (int)((b / n.x) % n.y);
+            const int bk = o.z + 2 * (int)(b / ((IndexInt)n.x * n.y));
+            const int block = bi + blocks.x * (bj + blocks.y * bk);
+            for (IndexInt i = start[block]; i < start[block + 1]; i++)
+              fn(order[i]);
+          }
+        },
+        1);
+  }
+}
+
 //! insert buffered positions as new particles, update additional particle data
 template<class S> void ParticleSystem<S>::insertBufferedParticles()
 {
@@ -19,6 +19,7 @@
 #include "vectorbase.h"
 #include "grid.h"
 #include "kernel.h"
+#include <algorithm>
 #include <limits>
 
 using namespace std;
@@ -48,6 +49,7 @@ template<class T> struct SemiLagrange : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -123,6 +125,7 @@ template<class T> struct SemiLagrange : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SemiLagrange");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -179,6 +182,7 @@ struct SemiLagrangeMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -265,6 +269,7 @@ struct SemiLagrangeMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SemiLagrangeMAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -322,6 +327,7 @@ template<class T> struct MacCormackCorrect : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const FlagGrid &flags,
@@ -386,6 +392,7 @@ template<class T> struct MacCormackCorrect : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MacCormackCorrect");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -429,6 +436,7 @@ template<class T> struct MacCormackCorrectMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -511,6 +519,7 @@ template<class T> struct MacCormackCorrectMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MacCormackCorrectMAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -752,6 +761,7 @@ template<class T> struct MacCormackClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -836,6 +846,7 @@ template<class T> struct MacCormackClamp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MacCormackClamp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -891,6 +902,7 @@ struct MacCormackClampMAC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -963,6 +975,7 @@ struct MacCormackClampMAC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MacCormackClampMAC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1079,6 +1092,7 @@ struct extrapolateVelConvectiveBC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1160,6 +1174,7 @@ struct extrapolateVelConvectiveBC : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("extrapolateVelConvectiveBC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1199,6 +1214,7 @@ struct copyChangedVels : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, const MACGrid &velDst, MACGrid &vel) const
@@ -1227,6 +1243,7 @@ struct copyChangedVels : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("copyChangedVels");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1274,6 +1291,7 @@ struct knResetPhiInObs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const FlagGrid &flags, Grid<Real> &sdf) const
   {
@@ -1297,6 +1315,7 @@ struct knResetPhiInObs : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knResetPhiInObs");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1518,4 +1537,509 @@ void PbRegister_advectSemiLagrange()
 }
 }
 
+// batched advection
+
+//! backtraced position of cell (i,j,k), same as computed by SemiLagrange
+inline Vec3 traceBack(const MACGrid &vel, int i, int j, int k, Real dt, int orderTrace)
+{
+  if (orderTrace == 1) {
+    return Vec3(i + 0.5f, j + 0.5f, k + 0.5f) - vel.getCentered(i, j, k) * dt;
+  }
+  // explicit midpoint
+  Vec3 p0 = Vec3(i + 0.5f, j + 0.5f, k + 0.5f);
+  Vec3 p1 = p0 - vel.getCentered(i, j, k) * dt * 0.5;
+  return p0 - vel.getInterpolated(p1) * dt;
+}
+
+//! Kernel: Semi-Lagrange step for a batch of grids, the backtraced position and the
+//! interpolation weights of each cell are shared by all grids
+
+template<class T> struct SemiLagrangeBatch : public KernelBase {
+  SemiLagrangeBatch(const FlagGrid &flags,
+                    const MACGrid &vel,
+                    const std::vector<Grid<T> *> &dst,
+                    const std::vector<Grid<T> *> &src,
+                    Real dt,
+                    int orderSpace,
+                    int orderTrace)
+      : KernelBase(&flags, 1),
+        flags(flags),
+        vel(vel),
+        dst(dst),
+        src(src),
+        dt(dt),
+        orderSpace(orderSpace),
+        orderTrace(orderTrace)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(int i,
+                 int j,
+                 int k,
+                 const FlagGrid &flags,
+                 const MACGrid &vel,
+                 const std::vector<Grid<T> *> &dst,
+                 const std::vector<Grid<T> *> &src,
+                 Real dt,
+                 int orderSpace,
+                 int orderTrace) const
+  {
+    const Vec3 pos = traceBack(vel, i, j, k, dt, orderTrace);
+    if (orderSpace == 1) {
+      const InterpolWeights w(flags.getSize(), flags.getStrideZ(), pos);
+      for (size_t n = 0; n < src.size(); ++n)
+        (*dst[n])(i, j, k) = w.get(src[n]->getData());
+    }
+    else {
+      for (size_t n = 0; n < src.size(); ++n)
+        (*dst[n])(i, j, k) = src[n]->getInterpolatedHi(pos, orderSpace);
+    }
+  }
+  inline const FlagGrid &getArg0()
+  {
+    return flags;
+  }
+  typedef FlagGrid type0;
+  inline const MACGrid &getArg1()
+  {
+    return vel;
+  }
+  typedef MACGrid type1;
+  inline const std::vector<Grid<T> *> &getArg2()
+  {
+    return dst;
+  }
+  typedef std::vector<Grid<T> *> type2;
+  inline const std::vector<Grid<T> *> &getArg3()
+  {
+    return src;
+  }
+  typedef std::vector<Grid<T> *> type3;
+  inline Real &getArg4()
+  {
+    return dt;
+  }
+  typedef Real type4;
+  inline int &getArg5()
+  {
+    return orderSpace;
+  }
+  typedef int type5;
+  inline int &getArg6()
+  {
+    return orderTrace;
+  }
+  typedef int type6;
+  void runMessage()
+  {
+    debMsg("Executing kernel SemiLagrangeBatch ", 3);
+    debMsg("Kernel range"
+               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+           4);
+    profileBegin("SemiLagrangeBatch");
+  };
+  void operator()(const tbb::blocked_range<IndexInt> &__r) const
+  {
+    const int _maxX = maxX;
+    const int _maxY = maxY;
+    if (maxZ > 1) {
+      for (int k = __r.begin(); k != (int)__r.end(); k++)
+        for (int j = 1; j < _maxY; j++)
+          for (int i = 1; i < _maxX; i++)
+            op(i, j, k, flags, vel, dst, src, dt, orderSpace, orderTrace);
+    }
+    else {
+      const int k = 0;
+      for (int j = __r.begin(); j != (int)__r.end(); j++)
+        for (int i = 1; i < _maxX; i++)
+          op(i, j, k, flags, vel, dst, src, dt, orderSpace, orderTrace);
+    }
+  }
+  void run()
+  {
+    if (maxZ > 1)
+      tbb::parallel_for(tbb::blocked_range<IndexInt>(minZ, maxZ), *this);
+    else
+      tbb::parallel_for(tbb::blocked_range<IndexInt>(1, maxY), *this);
+  }
+  const FlagGrid &flags;
+  const MACGrid &vel;
+  const std::vector<Grid<T> *> &dst;
+  const std::vector<Grid<T> *> &src;
+  Real dt;
+  int orderSpace;
+  int orderTrace;
+};
+
+//! Kernel: MacCormack backward step, correction and clamping for a batch of grids, gives
+//! the same values as SemiLagrange(-dt), MacCormackCorrect and MacCormackClamp combined
+
+template<class T> struct MacCormackBatch : public KernelBase {
+  MacCormackBatch(const FlagGrid &flags,
+                  const MACGrid &vel,
+                  const std::vector<Grid<T> *> &dst,
+                  const std::vector<Grid<T> *> &orig,
+                  const std::vector<Grid<T> *> &fwd,
+                  Real dt,
+                  Real strength,
+                  int orderSpace,
+                  int clampMode,
+                  int orderTrace)
+      : KernelBase(&flags, 0),
+        flags(flags),
+        vel(vel),
+        dst(dst),
+        orig(orig),
+        fwd(fwd),
+        dt(dt),
+        strength(strength),
+        orderSpace(orderSpace),
+        clampMode(clampMode),
+        orderTrace(orderTrace)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(int i,
+                 int j,
+                 int k,
+                 const FlagGrid &flags,
+                 const MACGrid &vel,
+                 const std::vector<Grid<T> *> &dst,
+                 const std::vector<Grid<T> *> &orig,
+                 const std::vector<Grid<T> *> &fwd,
+                 Real dt,
+                 Real strength,
+                 int orderSpace,
+                 int clampMode,
+                 int orderTrace) const
+  {
+    const IndexInt idx = flags.index(i, j, k);
+    const bool isFluid = flags.isFluid(idx);
+
+    // outer layer is not traced, only apply the correction like MacCormackCorrect does
+    if (!flags.isInBounds(Vec3i(i, j, k), 1)) {
+      for (size_t n = 0; n < dst.size(); ++n) {
+        T dval = (*fwd[n])[idx];
+        if (isFluid)
+          dval += strength * 0.5 * ((*orig[n])[idx]);
+        (*dst[n])[idx] = dval;
+      }
+      return;
+    }
+
+    // backward step through the forward result
+    const Vec3 pos = traceBack(vel, i, j, k, -dt, orderTrace);
+
+    // collect the clamping neighborhood once for all grids, same cells as doClampComponent
+    const Vec3i gridUpper = flags.getSize() - 1;
+    const Vec3 v = vel.getCentered(i, j, k) * dt;
+    Vec3i positions[2];
+    int numPos = 1;
+    positions[0] = toVec3i(Vec3(i, j, k) - v);
+    if (clampMode == 1) {
+      numPos = 2;
+      positions[1] = toVec3i(Vec3(i, j, k) + v);
+    }
+    const int nbMask = FlagGrid::TypeFluid | FlagGrid::TypeEmpty;
+    IndexInt nbs[16];
+    int numNbs = 0;
+    for (int l = 0; l < numPos; ++l) {
+      const int i0 = clamp(positions[l].x, 0, gridUpper.x - 1);
+      const int j0 = clamp(positions[l].y, 0, gridUpper.y - 1);
+      const int k0 = clamp(positions[l].z, 0, (flags.is3D() ? (gridUpper.z - 1) : 1));
+      const int i1 = i0 + 1, j1 = j0 + 1, k1 = (flags.is3D() ? (k0 + 1) : k0);
+      const int kCount = flags.is3D() ? 2 : 1;
+      for (int kk = 0; kk < kCount; ++kk) {
+        const int kn = kk ? k1 : k0;
+        if (flags(i0, j0, kn) & nbMask)
+          nbs[numNbs++] = flags.index(i0, j0, kn);
+        if (flags(i1, j0, kn) & nbMask)
+          nbs[numNbs++] = flags.index(i1, j0, kn);
+        if (flags(i0, j1, kn) & nbMask)
+          nbs[numNbs++] = flags.index(i0, j1, kn);
+        if (flags(i1, j1, kn) & nbMask)
+          nbs[numNbs++] = flags.index(i1, j1, kn);
+      }
+    }
+
+    // same rounded lookup test as in MacCormackClamp
+    bool revertToFwd = false;
+    if (clampMode == 1) {
+      Vec3i posFwd = toVec3i(Vec3(i, j, k) + Vec3(0.5, 0.5, 0.5) - v);
+      Vec3i posBwd = toVec3i(Vec3(i, j, k) + Vec3(0.5, 0.5, 0.5) + v);
+      revertToFwd = posFwd.x < 0 || posFwd.y < 0 || posFwd.z < 0 || posBwd.x < 0 ||
+                    posBwd.y < 0 || posBwd.z < 0 || posFwd.x > gridUpper.x ||
+                    posFwd.y > gridUpper.y || ((posFwd.z > gridUpper.z) && flags.is3D()) ||
+                    posBwd.x > gridUpper.x || posBwd.y > gridUpper.y ||
+                    ((posBwd.z > gridUpper.z) && flags.is3D()) || flags.isObstacle(posFwd) ||
+                    flags.isObstacle(posBwd);
+    }
+
+    const bool linear = (orderSpace == 1);
+    const InterpolWeights w(flags.getSize(), flags.getStrideZ(), linear ? pos : Vec3(0.5));
+    for (size_t n = 0; n < dst.size(); ++n) {
+      const Grid<T> &fwdGrid = *fwd[n];
+      const Grid<T> &origGrid = *orig[n];
+      const T fwdVal = fwdGrid[idx];
+      if (!numNbs || revertToFwd) {
+        (*dst[n])[idx] = fwdVal;
+        continue;
+      }
+
+      // correction
+      T dval = fwdVal;
+      if (isFluid) {
+        const T bwdVal = linear ? w.get(fwdGrid.getData()) :
+                                  fwdGrid.getInterpolatedHi(pos, orderSpace);
+        dval += strength * 0.5 * (origGrid[idx] - bwdVal);
+      }
+
+      // clamp
+      T minv(std::numeric_limits<Real>::max()), maxv(-std::numeric_limits<Real>::max());
+      for (int l = 0; l < numNbs; ++l)
+        getMinMax(minv, maxv, origGrid[nbs[l]]);
+      if (clampMode == 1) {
+        dval = clamp(dval, minv, maxv);
+      }
+      else {
+        if (cmpMinMax(minv, maxv, dval))
+          dval = fwdVal;
+      }
+      (*dst[n])[idx] = dval;
+    }
+  }
+  inline const FlagGrid &getArg0()
+  {
+    return flags;
+  }
+  typedef FlagGrid type0;
+  inline const MACGrid &getArg1()
+  {
+    return vel;
+  }
+  typedef MACGrid type1;
+  inline const std::vector<Grid<T> *> &getArg2()
+  {
+    return dst;
+  }
+  typedef std::vector<Grid<T> *> type2;
+  inline const std::vector<Grid<T> *> &getArg3()
+  {
+    return orig;
+  }
+  typedef std::vector<Grid<T> *> type3;
+  inline const std::vector<Grid<T> *> &getArg4()
+  {
+    return fwd;
+  }
+  typedef std::vector<Grid<T> *> type4;
+  inline Real &getArg5()
+  {
+    return dt;
+  }
+  typedef Real type5;
+  inline Real &getArg6()
+  {
+    return strength;
+  }
+  typedef Real type6;
+  inline int &getArg7()
+  {
+    return orderSpace;
+  }
+  typedef int type7;
+  inline int &getArg8()
+  {
+    return clampMode;
+  }
+  typedef int type8;
+  inline int &getArg9()
+  {
+    return orderTrace;
+  }
+  typedef int type9;
+  void runMessage()
+  {
+    debMsg("Executing kernel MacCormackBatch ", 3);
+    debMsg("Kernel range"
+               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+           4);
+    profileBegin("MacCormackBatch");
+  };
+  void operator()(const tbb::blocked_range<IndexInt> &__r) const
+  {
+    const int _maxX = maxX;
+    const int _maxY = maxY;
+    if (maxZ > 1) {
+      for (int k = __r.begin(); k != (int)__r.end(); k++)
+        for (int j = 0; j < _maxY; j++)
+          for (int i = 0; i < _maxX; i++)
+            op(i, j, k, flags, vel, dst, orig, fwd, dt, strength, orderSpace, clampMode, orderTrace);
+    }
+    else {
+      const int k = 0;
+      for (int j = __r.begin(); j != (int)__r.end(); j++)
+        for (int i = 0; i < _maxX; i++)
+          op(i, j, k, flags, vel, dst, orig, fwd, dt, strength, orderSpace, clampMode, orderTrace);
+    }
+  }
+  void run()
+  {
+    if (maxZ > 1)
+      tbb::parallel_for(tbb::blocked_range<IndexInt>(minZ, maxZ), *this);
+    else
+      tbb::parallel_for(tbb::blocked_range<IndexInt>(0, maxY), *this);
+  }
+  const FlagGrid &flags;
+  const MACGrid &vel;
+  const std::vector<Grid<T> *> &dst;
+  const std::vector<Grid<T> *> &orig;
+  const std::vector<Grid<T> *> &fwd;
+  Real dt;
+  Real strength;
+  int orderSpace;
+  int clampMode;
+  int orderTrace;
+};
+
+//! advect a list of equally typed grids, allocates all temporaries up front
+template<class T>
+void fnAdvectSemiLagrangeBatch(FluidSolver *parent,
+                               const FlagGrid &flags,
+                               const MACGrid &vel,
+                               std::vector<Grid<T> *> &grids,
+                               int order,
+                               Real strength,
+                               int orderSpace,
+                               int clampMode,
+                               int orderTrace)
+{
+  if (grids.empty())
+    return;
+  Real dt = parent->getDt();
+
+  // forward step
+  std::vector<Grid<T> *> fwd(grids.size());
+  for (size_t n = 0; n < grids.size(); ++n)
+    fwd[n] = new Grid<T>(parent);
+  SemiLagrangeBatch<T>(flags, vel, fwd, grids, dt, orderSpace, orderTrace);
+
+  if (order == 1) {
+    for (size_t n = 0; n < grids.size(); ++n)
+      grids[n]->swap(*fwd[n]);
+  }
+  else if (order == 2) {  // MacCormack: backward step, correction and clamping in one pass
+    std::vector<Grid<T> *> newGrids(grids.size());
+    for (size_t n = 0; n < grids.size(); ++n)
+      newGrids[n] = new Grid<T>(parent);
+    MacCormackBatch<T>(
+        flags, vel, newGrids, grids, fwd, dt, strength, orderSpace, clampMode, orderTrace);
+    for (size_t n = 0; n < grids.size(); ++n) {
+      grids[n]->swap(*newGrids[n]);
+      delete newGrids[n];
+    }
+  }
+
+  for (size_t n = 0; n < grids.size(); ++n)
+    delete fwd[n];
+}
+
+//! Perform semi-lagrangian advection of several grids with the same velocity field
+//! Real and Vec3 grids are traced back once per cell and sampled together (the same holds
+//! for the MacCormack backward step), MAC grids are advected afterwards one by one, so the
+//! advecting velocity itself may be part of the list. Results match separate
+//! advectSemiLagrange calls; note that all temporaries of a batch are alive at the same time.
+
+void advectSemiLagrangeMulti(const FlagGrid *flags,
+                             const MACGrid *vel,
+                             const PbClassVec &grids,
+                             int order = 1,
+                             Real strength = 1.0,
+                             int orderSpace = 1,
+                             int clampMode = 2,
+                             int orderTrace = 1)
+{
+  assertMsg(order == 1 || order == 2,
+            "AdvectSemiLagrangeMulti: Only order 1 (regular SL) and 2 (MacCormack) supported");
+  assertMsg(orderTrace == 1 || orderTrace == 2,
+            "AdvectSemiLagrangeMulti: Unknown backtracing order " << orderTrace);
+  // sort grids by type, each type is advected as one batch
+  std::vector<Grid<Real> *> realGrids;
+  std::vector<Grid<Vec3> *> vecGrids;
+  std::vector<MACGrid *> macGrids;
+  std::vector<GridBase *> all;
+  for (size_t n = 0; n < grids.size(); ++n) {
+    GridBase *grid = dynamic_cast<GridBase *>(grids[n]);
+    if (!grid)
+      errMsg("AdvectSemiLagrangeMulti: '" << grids[n]->getName() << "' is not a grid");
+    if (std::find(all.begin(), all.end(), grid) != all.end())
+      errMsg("AdvectSemiLagrangeMulti: grid '" << grid->getName() << "' is listed twice");
+    if (grid->getSize() != flags->getSize())
+      errMsg("AdvectSemiLagrangeMulti: grid '" << grid->getName() << "' has a different size");
+    all.push_back(grid);
+
+    if (grid->getType() & GridBase::TypeReal)
+      realGrids.push_back((Grid<Real> *)grid);
+    else if (grid->getType() & GridBase::TypeMAC)
+      macGrids.push_back((MACGrid *)grid);
+    else if (grid->getType() & GridBase::TypeVec3)
+      vecGrids.push_back((Grid<Vec3> *)grid);
+    else
+      errMsg(
+          "AdvectSemiLagrangeMulti: Grid Type is not supported (only Real, Vec3, MAC, Levelset)");
+  }
+
+  FluidSolver *parent = flags->getParent();
+  fnAdvectSemiLagrangeBatch<Real>(
+      parent, *flags, *vel, realGrids, order, strength, orderSpace, clampMode, orderTrace);
+  fnAdvectSemiLagrangeBatch<Vec3>(
+      parent, *flags, *vel, vecGrids, order, strength, orderSpace, clampMode, orderTrace);
+  for (size_t n = 0; n < macGrids.size(); ++n) {
+    fnAdvectSemiLagrange<MACGrid>(
+        parent, *flags, *vel, *macGrids[n], order, strength, orderSpace, clampMode, orderTrace);
+  }
+}
+static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "advectSemiLagrangeMulti", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      const FlagGrid *flags = _args.getPtr<FlagGrid>("flags", 0, &_lock);
+      const MACGrid *vel = _args.getPtr<MACGrid>("vel", 1, &_lock);
+      PbClassVec grids = _args.get<PbClassVec>("grids", 2, &_lock);
+      int order = _args.getOpt<int>("order", 3, 1, &_lock);
+      Real strength = _args.getOpt<Real>("strength", 4, 1.0, &_lock);
+      int orderSpace = _args.getOpt<int>("orderSpace", 5, 1, &_lock);
+      int clampMode = _args.getOpt<int>("clampMode", 6, 2, &_lock);
+      int orderTrace = _args.getOpt<int>("orderTrace", 7, 1, &_lock);
+      _retval = getPyNone();
+      advectSemiLagrangeMulti(
+          flags, vel, grids, order, strength, orderSpace, clampMode, orderTrace);
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "advectSemiLagrangeMulti", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("advectSemiLagrangeMulti", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_advectSemiLagrangeMulti("", "advectSemiLagrangeMulti", _W_2);
+extern "C" {
+void PbRegister_advectSemiLagrangeMulti()
+{
+  KEEP_UNUSED(_RP_advectSemiLagrangeMulti);
+}
+}
+
 }  // namespace Manta
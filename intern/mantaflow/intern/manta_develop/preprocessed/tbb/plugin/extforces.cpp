@@ -43,6 +43,7 @@ struct KnApplyForceField : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -111,6 +112,7 @@ struct KnApplyForceField : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyForceField");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -157,6 +159,7 @@ struct KnApplyForce : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -212,6 +215,7 @@ struct KnApplyForce : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyForce");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -337,6 +341,7 @@ struct KnAddBuoyancy : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -381,6 +386,7 @@ struct KnAddBuoyancy : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddBuoyancy");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -654,6 +660,7 @@ struct KnSetInflow : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, MACGrid &vel, int dim, int p0, const Vec3 &val) const
   {
@@ -687,6 +694,7 @@ struct KnSetInflow : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnSetInflow");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -776,6 +784,7 @@ struct KnSetWallBcs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, MACGrid &vel, const MACGrid *obvel) const
@@ -847,6 +856,7 @@ struct KnSetWallBcs : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnSetWallBcs");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -896,6 +906,7 @@ struct KnSetWallBcsFrac : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1036,6 +1047,7 @@ struct KnSetWallBcsFrac : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnSetWallBcsFrac");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1131,6 +1143,7 @@ struct KnAddForceIfLower : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, MACGrid &vel, const Grid<Vec3> &force) const
@@ -1183,6 +1196,7 @@ struct KnAddForceIfLower : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddForceIfLower");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1258,6 +1272,7 @@ struct KnConfForce : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1301,6 +1316,7 @@ struct KnConfForce : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnConfForce");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
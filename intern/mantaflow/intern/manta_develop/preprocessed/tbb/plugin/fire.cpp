@@ -55,6 +55,7 @@ struct KnProcessBurn : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -185,6 +186,7 @@ struct KnProcessBurn : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnProcessBurn");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -343,6 +345,7 @@ struct KnUpdateFlame : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Real> &react, Grid<Real> &flame) const
   {
@@ -367,6 +370,7 @@ struct KnUpdateFlame : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnUpdateFlame");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -281,6 +281,7 @@ struct knClearFluidFlags : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, FlagGrid &flags, int dummy = 0) const
   {
@@ -304,6 +305,7 @@ struct knClearFluidFlags : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knClearFluidFlags");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -339,6 +341,7 @@ struct knSetNbObstacle : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, FlagGrid &nflags, const FlagGrid &flags, const Grid<Real> &phiObs) const
@@ -386,6 +389,7 @@ struct knSetNbObstacle : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetNbObstacle");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -807,6 +811,7 @@ struct ComputeUnionLevelsetPindex : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -891,6 +896,7 @@ struct ComputeUnionLevelsetPindex : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ComputeUnionLevelsetPindex");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1006,6 +1012,7 @@ struct ComputeAveragedLevelsetWeight : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1122,6 +1129,7 @@ struct ComputeAveragedLevelsetWeight : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ComputeAveragedLevelsetWeight");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1171,6 +1179,7 @@ template<class T> struct knSmoothGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<T> &me, Grid<T> &tmp, Real factor) const
   {
@@ -1201,6 +1210,7 @@ template<class T> struct knSmoothGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSmoothGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1237,6 +1247,7 @@ template<class T> struct knSmoothGridNeg : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<T> &me, Grid<T> &tmp, Real factor) const
   {
@@ -1271,6 +1282,7 @@ template<class T> struct knSmoothGridNeg : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSmoothGridNeg");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1394,6 +1406,7 @@ struct correctLevelset : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1477,6 +1490,7 @@ struct correctLevelset : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("correctLevelset");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1624,6 +1638,7 @@ struct knPushOutofObs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystem &parts,
@@ -1689,6 +1704,7 @@ struct knPushOutofObs : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knPushOutofObs");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1766,6 +1782,7 @@ template<class T> struct knSafeDivReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  Grid<T> &me,
@@ -1801,6 +1818,7 @@ template<class T> struct knSafeDivReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSafeDivReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1837,6 +1855,7 @@ struct knMapLinearVec3ToMACGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -1893,12 +1912,13 @@ struct knMapLinearVec3ToMACGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinearVec3ToMACGrid");
   };
   void run()
   {
-    const IndexInt _sz = size;
-    for (IndexInt i = 0; i < _sz; i++)
+    parallelParticleScatter(p, flags, ptype, exclude, [&](IndexInt i) {
       op(i, p, flags, vel, tmp, pvel, ptype, exclude);
+    });
   }
   const BasicParticleSystem &p;
   const FlagGrid &flags;
@@ -1992,6 +2012,7 @@ template<class T> struct knMapLinear : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2036,12 +2057,12 @@ template<class T> struct knMapLinear : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinear");
   };
   void run()
   {
-    const IndexInt _sz = size;
-    for (IndexInt i = 0; i < _sz; i++)
-      op(i, p, flags, target, gtmp, psource);
+    parallelParticleScatter(
+        p, flags, NULL, 0, [&](IndexInt i) { op(i, p, flags, target, gtmp, psource); });
   }
   const BasicParticleSystem &p;
   const FlagGrid &flags;
@@ -2157,6 +2178,7 @@ template<class T> struct knMapFromGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2188,6 +2210,7 @@ template<class T> struct knMapFromGrid : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapFromGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2299,6 +2322,7 @@ struct knMapLinearMACGridToVec3_PIC : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2349,6 +2373,7 @@ struct knMapLinearMACGridToVec3_PIC : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinearMACGridToVec3_PIC");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2437,6 +2462,7 @@ struct knMapLinearMACGridToVec3_FLIP : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -2500,6 +2526,7 @@ struct knMapLinearMACGridToVec3_FLIP : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knMapLinearMACGridToVec3_FLIP");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2591,6 +2618,7 @@ struct knCombineVels : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2662,6 +2690,7 @@ struct knCombineVels : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCombineVels");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2816,4 +2845,44 @@ void PbRegister_getCurvature()
 }
 }
 
+//! sort particles by 8^3 grid tiles, so that particle-grid transfers (mapPartsToMAC,
+//! mapGridToParts, advectInGrid) touch grid memory coherently; deleted particles are removed.
+//! Particle indices change, rebuild index systems (gridParticleIndex) afterwards
+
+void sortParticlesByTile(BasicParticleSystem &parts, const FlagGrid &flags)
+{
+  parts.sortByTile(flags.getSize());
+}
+static PyObject *_W_22(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "sortParticlesByTile", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      BasicParticleSystem &parts = *_args.getPtr<BasicParticleSystem>("parts", 0, &_lock);
+      const FlagGrid &flags = *_args.getPtr<FlagGrid>("flags", 1, &_lock);
+      _retval = getPyNone();
+      sortParticlesByTile(parts, flags);
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "sortParticlesByTile", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("sortParticlesByTile", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_sortParticlesByTile("", "sortParticlesByTile", _W_22);
+extern "C" {
+void PbRegister_sortParticlesByTile()
+{
+  KEEP_UNUSED(_RP_sortParticlesByTile);
+}
+}
+
 }  // namespace Manta
@@ -61,6 +61,7 @@ struct apply1DKernelDirX : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid &in, MACGrid &out, const Matrix &kernel) const
   {
@@ -97,6 +98,7 @@ struct apply1DKernelDirX : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("apply1DKernelDirX");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -135,6 +137,7 @@ struct apply1DKernelDirY : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid &in, MACGrid &out, const Matrix &kernel) const
   {
@@ -171,6 +174,7 @@ struct apply1DKernelDirY : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("apply1DKernelDirY");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -209,6 +213,7 @@ struct apply1DKernelDirZ : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const MACGrid &in, MACGrid &out, const Matrix &kernel) const
   {
@@ -245,6 +250,7 @@ struct apply1DKernelDirZ : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("apply1DKernelDirZ");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -587,7 +593,10 @@ void solvePressure(MACGrid &vel,
                    bool zeroPressureFixing = false,
                    const Grid<Real> *curv = NULL,
                    const Real surfTens = 0.0,
-                   Grid<Real> *retRhs = NULL);
+                   Grid<Real> *retRhs = NULL,
+                   const bool warmStart = false,
+                   const bool warmStartExtrapolate = false,
+                   const bool compactMatrix = false);
 
 //! Main function for fluid guiding , includes "regular" pressure solve
 
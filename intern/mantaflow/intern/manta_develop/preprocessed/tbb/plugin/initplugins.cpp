@@ -47,6 +47,7 @@ struct KnApplyNoiseInfl : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -102,6 +103,7 @@ struct KnApplyNoiseInfl : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyNoiseInfl");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -194,6 +196,7 @@ struct KnAddNoise : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -239,6 +242,7 @@ struct KnAddNoise : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddNoise");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -324,6 +328,7 @@ template<class T> struct knSetPdataNoise : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &parts,
@@ -359,6 +364,7 @@ template<class T> struct knSetPdataNoise : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetPdataNoise");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -384,6 +390,7 @@ template<class T> struct knSetPdataNoiseVec : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &parts,
@@ -419,6 +426,7 @@ template<class T> struct knSetPdataNoiseVec : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knSetPdataNoiseVec");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -679,6 +687,7 @@ struct KnApplyEmission : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -739,6 +748,7 @@ struct KnApplyEmission : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyEmission");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -829,6 +839,7 @@ struct KnApplyDensity : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -874,6 +885,7 @@ struct KnApplyDensity : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyDensity");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1428,6 +1440,7 @@ struct KnUpdateFractions : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1531,6 +1544,7 @@ struct KnUpdateFractions : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnUpdateFractions");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1620,6 +1634,7 @@ struct KnUpdateFlagsObs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1697,6 +1712,7 @@ struct KnUpdateFlagsObs : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnUpdateFlagsObs");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1784,6 +1800,7 @@ struct kninitVortexVelocity : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -1845,6 +1862,7 @@ struct kninitVortexVelocity : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("kninitVortexVelocity");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2035,6 +2053,7 @@ template<class T> struct knBlurGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2072,6 +2091,7 @@ template<class T> struct knBlurGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knBlurGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2129,6 +2149,7 @@ struct KnBlurMACGridGauss : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2192,6 +2213,7 @@ struct KnBlurMACGridGauss : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnBlurMACGridGauss");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
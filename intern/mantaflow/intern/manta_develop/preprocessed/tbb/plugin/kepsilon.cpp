@@ -54,6 +54,7 @@ struct KnTurbulenceClamp : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  Grid<Real> &kgrid,
@@ -110,6 +111,7 @@ struct KnTurbulenceClamp : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnTurbulenceClamp");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -152,6 +154,7 @@ struct KnComputeProduction : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -240,6 +243,7 @@ struct KnComputeProduction : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnComputeProduction");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -343,6 +347,7 @@ struct KnAddTurbulenceSource : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       IndexInt idx, Grid<Real> &kgrid, Grid<Real> &egrid, const Grid<Real> &pgrid, Real dt) const
@@ -385,6 +390,7 @@ struct KnAddTurbulenceSource : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAddTurbulenceSource");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
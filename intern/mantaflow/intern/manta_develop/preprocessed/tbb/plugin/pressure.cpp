@@ -26,7 +26,7 @@ namespace Manta {
 //! Preconditioner for CG solver
 // - None: Use standard CG
 // - MIC: Modified incomplete Cholesky preconditioner
-// - MGDynamic: Multigrid preconditioner, rebuilt for each solve
+// - MGDynamic: Multigrid preconditioner, updated whenever the matrix changes
 // - MGStatic: Multigrid preconditioner, built only once (faster than
 //       MGDynamic, but works only if Poisson equation does not change)
 enum Preconditioner { PcNone = 0, PcMIC = 1, PcMGDynamic = 2, PcMGStatic = 3 };
@@ -65,6 +65,7 @@ struct MakeRhs : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -185,6 +186,7 @@ struct MakeRhs : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MakeRhs");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -277,6 +279,7 @@ struct knCorrectVelocity : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, MACGrid &vel, const Grid<Real> &pressure) const
@@ -336,6 +339,7 @@ struct knCorrectVelocity : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCorrectVelocity");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -411,6 +415,7 @@ struct ApplyGhostFluidDiagonal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -466,6 +471,7 @@ struct ApplyGhostFluidDiagonal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyGhostFluidDiagonal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -518,6 +524,7 @@ struct knCorrectVelocityGhostFluid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -623,6 +630,7 @@ struct knCorrectVelocityGhostFluid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCorrectVelocityGhostFluid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -679,6 +687,7 @@ struct knReplaceClampedGhostFluidVels : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -741,6 +750,7 @@ struct knReplaceClampedGhostFluidVels : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knReplaceClampedGhostFluidVels");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -780,6 +790,7 @@ struct CountEmptyCells : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const FlagGrid &flags, int &numEmpty)
   {
@@ -805,6 +816,7 @@ struct CountEmptyCells : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CountEmptyCells");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -826,6 +838,160 @@ struct CountEmptyCells : public KernelBase {
   int numEmpty;
 };
 
+//! Kernel: initial guess for warm-started pressure solves
+//! prev0/prev1 hold the last two pressure solutions divided by their timestep
+
+struct knPressureGuess : public KernelBase {
+  knPressureGuess(const FlagGrid &flags,
+                  Grid<Real> &pressure,
+                  const Grid<Real> &prev0,
+                  const Grid<Real> &prev1,
+                  const Real dt,
+                  const bool extrapolate)
+      : KernelBase(&flags, 0),
+        flags(flags),
+        pressure(pressure),
+        prev0(prev0),
+        prev1(prev1),
+        dt(dt),
+        extrapolate(extrapolate)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(IndexInt idx,
+                 const FlagGrid &flags,
+                 Grid<Real> &pressure,
+                 const Grid<Real> &prev0,
+                 const Grid<Real> &prev1,
+                 const Real dt,
+                 const bool extrapolate) const
+  {
+    if (!flags.isFluid(idx))
+      pressure[idx] = 0.;
+    else if (extrapolate)
+      pressure[idx] = dt * (2. * prev0[idx] - prev1[idx]);
+    else
+      pressure[idx] = dt * prev0[idx];
+  }
+  inline const FlagGrid &getArg0()
+  {
+    return flags;
+  }
+  typedef FlagGrid type0;
+  inline Grid<Real> &getArg1()
+  {
+    return pressure;
+  }
+  typedef Grid<Real> type1;
+  inline const Grid<Real> &getArg2()
+  {
+    return prev0;
+  }
+  typedef Grid<Real> type2;
+  inline const Grid<Real> &getArg3()
+  {
+    return prev1;
+  }
+  typedef Grid<Real> type3;
+  inline const Real &getArg4()
+  {
+    return dt;
+  }
+  typedef Real type4;
+  inline const bool &getArg5()
+  {
+    return extrapolate;
+  }
+  typedef bool type5;
+  void runMessage()
+  {
+    debMsg("Executing kernel knPressureGuess ", 3);
+    debMsg("Kernel range"
+               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+           4);
+    profileBegin("knPressureGuess");
+  };
+  void operator()(const tbb::blocked_range<IndexInt> &__r) const
+  {
+    for (IndexInt idx = __r.begin(); idx != (IndexInt)__r.end(); idx++)
+      op(idx, flags, pressure, prev0, prev1, dt, extrapolate);
+  }
+  void run()
+  {
+    tbb::parallel_for(tbb::blocked_range<IndexInt>(0, size), *this);
+  }
+  const FlagGrid &flags;
+  Grid<Real> &pressure;
+  const Grid<Real> &prev0;
+  const Grid<Real> &prev1;
+  const Real dt;
+  const bool extrapolate;
+};
+
+//! Kernel: store pressure solution for the next warm start, shifts prev0 into prev1
+
+struct knStorePressure : public KernelBase {
+  knStorePressure(const Grid<Real> &pressure, Grid<Real> &prev0, Grid<Real> &prev1, const Real dt)
+      : KernelBase(&pressure, 0), pressure(pressure), prev0(prev0), prev1(prev1), dt(dt)
+  {
+    runMessage();
+    run();
+    profileEnd();
+  }
+  inline void op(IndexInt idx,
+                 const Grid<Real> &pressure,
+                 Grid<Real> &prev0,
+                 Grid<Real> &prev1,
+                 const Real dt) const
+  {
+    prev1[idx] = prev0[idx];
+    prev0[idx] = pressure[idx] / dt;
+  }
+  inline const Grid<Real> &getArg0()
+  {
+    return pressure;
+  }
+  typedef Grid<Real> type0;
+  inline Grid<Real> &getArg1()
+  {
+    return prev0;
+  }
+  typedef Grid<Real> type1;
+  inline Grid<Real> &getArg2()
+  {
+    return prev1;
+  }
+  typedef Grid<Real> type2;
+  inline const Real &getArg3()
+  {
+    return dt;
+  }
+  typedef Real type3;
+  void runMessage()
+  {
+    debMsg("Executing kernel knStorePressure ", 3);
+    debMsg("Kernel range"
+               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
+           4);
+    profileBegin("knStorePressure");
+  };
+  void operator()(const tbb::blocked_range<IndexInt> &__r) const
+  {
+    for (IndexInt idx = __r.begin(); idx != (IndexInt)__r.end(); idx++)
+      op(idx, pressure, prev0, prev1, dt);
+  }
+  void run()
+  {
+    tbb::parallel_for(tbb::blocked_range<IndexInt>(0, size), *this);
+  }
+  const Grid<Real> &pressure;
+  Grid<Real> &prev0;
+  Grid<Real> &prev1;
+  const Real dt;
+};
+
 // *****************************************************************************
 // Misc helpers
 
@@ -859,16 +1025,134 @@ void fixPressure(int fixPidx,
   }
 }
 
-// for "static" MG mode, keep one MG data structure per fluid solver
-// leave cleanup to OS/user if nonzero at program termination (PcMGStatic mode)
+//! Pressure solve data of one fluid solver that is kept between steps
+/*! Holds matrix, CG temporaries, preconditioner grids and the multigrid hierarchy, so that
+ *  consecutive solves neither reallocate nor rebuild them. The matrix is only rebuilt if the
+ *  flags changed or it depends on per-step data (levelset, fractions, pressure fixing). */
+class PressureContext {
+ public:
+  enum Buffer {
+    BufResidual = 0,
+    BufSearch,
+    BufTmp,
+    BufA0,
+    BufAi,
+    BufAj,
+    BufAk,
+    BufPca0,
+    BufPca1,
+    BufPca2,
+    BufPca3,
+    BufPrev0,
+    BufPrev1,
+    BufNum
+  };
+
+  PressureContext(const Vec3i &size)
+      : mNumPrevPressure(0),
+        mStencilValid(false),
+        mPcaValid(false),
+        mSize(size),
+        mMatrixValid(false),
+        mMG(nullptr)
+  {
+  }
+  ~PressureContext()
+  {
+    if (mMG)
+      delete mMG;
+  }
+
+  //! grid memory for given buffer, allocated on first use
+  Real *getBuffer(Buffer buf)
+  {
+    std::vector<Real> &data = mBuffers[buf];
+    if (data.empty())
+      data.resize((size_t)mSize.x * mSize.y * mSize.z, Real(0));
+    return &data[0];
+  }
+
+  //! true if the stored matrix was built for exactly these flags
+  bool isMatrixBuiltFor(const FlagGrid &flags) const
+  {
+    if (!mMatrixValid)
+      return false;
+    FOR_IDX(flags)
+    {
+      if (flags[idx] != mMatrixFlags[idx])
+        return false;
+    }
+    return true;
+  }
+
+  //! remember the flags the matrix was built for, null if it can not be reused
+  void setMatrixFlags(const FlagGrid *flags)
+  {
+    mMatrixValid = (flags != nullptr);
+    if (!flags)
+      return;
+    mMatrixFlags.resize((size_t)mSize.x * mSize.y * mSize.z);
+    FOR_IDX(*flags)
+    {
+      mMatrixFlags[idx] = (*flags)[idx];
+    }
+  }
+
+  const Vec3i &getSize() const
+  {
+    return mSize;
+  }
+
+  //! multigrid hierarchy, created on first use
+  GridMg *getMG()
+  {
+    if (!mMG)
+      mMG = new GridMg(mSize);
+    return mMG;
+  }
+
+  //! tiles containing fluid cells, updated together with the matrix
+  TileMask mTiles;
+  //! number of solutions stored in BufPrev0/BufPrev1 for warm starts
+  int mNumPrevPressure;
+  //! compact stencil of the current matrix, see buildCompactStencil
+  std::vector<unsigned char> mStencil;
+  bool mStencilValid;
+  //! BufPca0 holds the mICP factors of the current matrix
+  bool mPcaValid;
+
+ protected:
+  Vec3i mSize;
+  std::vector<Real> mBuffers[BufNum];
+  std::vector<int> mMatrixFlags;
+  bool mMatrixValid;
+  GridMg *mMG;
+};
+
+// keep one pressure context per fluid solver
+// leave cleanup to OS/user if nonzero at program termination
 // alternatively, manually release in scene file with releaseMG
-static std::map<FluidSolver *, GridMg *> gMapMG;
+static std::map<FluidSolver *, PressureContext *> gMapPressure;
 
+static PressureContext &getPressureContext(FluidSolver *solver)
+{
+  PressureContext *&ctx = gMapPressure[solver];
+  if (ctx && ctx->getSize() != solver->getGridSize()) {
+    delete ctx;
+    ctx = nullptr;
+  }
+  if (!ctx)
+    ctx = new PressureContext(solver->getGridSize());
+  return *ctx;
+}
+
+//! Release multigrid and all other pressure data kept for a solver (or all solvers if null)
 void releaseMG(FluidSolver *solver = nullptr)
 {
   // release all?
   if (!solver) {
-    for (std::map<FluidSolver *, GridMg *>::iterator it = gMapMG.begin(); it != gMapMG.end();
+    for (std::map<FluidSolver *, PressureContext *>::iterator it = gMapPressure.begin();
+         it != gMapPressure.end();
          it++) {
       if (it->first != nullptr)
         releaseMG(it->first);
@@ -876,10 +1160,10 @@ void releaseMG(FluidSolver *solver = nullptr)
     return;
   }
 
-  GridMg *mg = gMapMG[solver];
-  if (mg) {
-    delete mg;
-    gMapMG[solver] = nullptr;
+  PressureContext *ctx = gMapPressure[solver];
+  if (ctx) {
+    delete ctx;
+    gMapPressure[solver] = nullptr;
   }
 }
 static PyObject *_W_0(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
@@ -913,6 +1197,45 @@ void PbRegister_releaseMG()
 }
 }
 
+//! Forget the previous solutions warm started solves take their initial guess from, e.g. after
+//! the grids of a solver were shifted
+void resetPressureWarmStart(FluidSolver *solver)
+{
+  std::map<FluidSolver *, PressureContext *>::iterator it = gMapPressure.find(solver);
+  if (it != gMapPressure.end() && it->second)
+    it->second->mNumPrevPressure = 0;
+}
+static PyObject *_W_1(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "resetPressureWarmStart", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      FluidSolver *solver = _args.getPtr<FluidSolver>("solver", 0, &_lock);
+      _retval = getPyNone();
+      resetPressureWarmStart(solver);
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "resetPressureWarmStart", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("resetPressureWarmStart", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_resetPressureWarmStart("", "resetPressureWarmStart", _W_1);
+extern "C" {
+void PbRegister_resetPressureWarmStart()
+{
+  KEEP_UNUSED(_RP_resetPressureWarmStart);
+}
+}
+
 // *****************************************************************************
 // Main pressure solve
 
@@ -945,7 +1268,7 @@ void computePressureRhs(Grid<Real> &rhs,
   if (enforceCompatibility)
     rhs += (Real)(-kernMakeRhs.sum / (Real)kernMakeRhs.cnt);
 }
-static PyObject *_W_1(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
 {
   try {
     PbArgs _args(_linargs, _kwds);
@@ -1000,7 +1323,7 @@ static PyObject *_W_1(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
     return 0;
   }
 }
-static const Pb::Register _RP_computePressureRhs("", "computePressureRhs", _W_1);
+static const Pb::Register _RP_computePressureRhs("", "computePressureRhs", _W_2);
 extern "C" {
 void PbRegister_computePressureRhs()
 {
@@ -1008,6 +1331,9 @@ void PbRegister_computePressureRhs()
 }
 }
 
+//! Use active tiles in CG solve if at most this fraction of tiles contains fluid cells
+static const Real cgMaxTileFraction = 0.75;
+
 //! Build and solve pressure system of equations
 //! perCellCorr: a divergence correction for each cell, optional
 //! fractions: for 2nd order obstacle boundaries, optional
@@ -1017,6 +1343,10 @@ void PbRegister_computePressureRhs()
 //! default, can be turned to L2 here zeroPressureFixing: remove null space by fixing a single
 //! pressure value, needed for MG curv: curvature for surface tension effects surfTens: surface
 //! tension coefficient retRhs: return RHS divergence, e.g., for debugging; optional
+//! warmStart: start CG from the previous solution (rescaled to the current timestep) instead of
+//! zero warmStartExtrapolate: linearly extrapolate the guess from the last two solutions
+//! compactMatrix: use neighbor bits instead of Ai/Aj/Ak and SIMD kernels in the CG iterations,
+//! falls back to the regular path for matrices that can not be represented (e.g. fractions)
 
 void solvePressureSystem(Grid<Real> &rhs,
                          MACGrid &vel,
@@ -1034,31 +1364,57 @@ void solvePressureSystem(Grid<Real> &rhs,
                          const bool useL2Norm = false,
                          const bool zeroPressureFixing = false,
                          const Grid<Real> *curv = NULL,
-                         const Real surfTens = 0.)
+                         const Real surfTens = 0.,
+                         const bool warmStart = false,
+                         const bool warmStartExtrapolate = false,
+                         const bool compactMatrix = false)
 {
   if (precondition == false)
     preconditioner = PcNone;  // for backwards compatibility
 
-  // reserve temp grids
+  // temp grids, persistent for this solver
   FluidSolver *parent = flags.getParent();
-  Grid<Real> residual(parent);
-  Grid<Real> search(parent);
-  Grid<Real> A0(parent);
-  Grid<Real> Ai(parent);
-  Grid<Real> Aj(parent);
-  Grid<Real> Ak(parent);
-  Grid<Real> tmp(parent);
-
-  // setup matrix and boundaries
-  MakeLaplaceMatrix(flags, A0, Ai, Aj, Ak, fractions);
+  PressureContext &ctx = getPressureContext(parent);
+  Grid<Real> residual(parent, ctx.getBuffer(PressureContext::BufResidual), false);
+  Grid<Real> search(parent, ctx.getBuffer(PressureContext::BufSearch), false);
+  Grid<Real> A0(parent, ctx.getBuffer(PressureContext::BufA0), false);
+  Grid<Real> Ai(parent, ctx.getBuffer(PressureContext::BufAi), false);
+  Grid<Real> Aj(parent, ctx.getBuffer(PressureContext::BufAj), false);
+  Grid<Real> Ak(parent, ctx.getBuffer(PressureContext::BufAk), false);
+  Grid<Real> tmp(parent, ctx.getBuffer(PressureContext::BufTmp), false);
+
+  // fix a pressure value? manually enabled, or automatically for high accuracy
+  const bool fixPressureValue = zeroPressureFixing || cgAccuracy < 1e-07;
+
+  // without levelset, fractions and pressure fixing the matrix only depends on the flags
+  const bool flagsOnlyMatrix = !phi && !fractions && !fixPressureValue;
+  const bool reuseMatrix = flagsOnlyMatrix && ctx.isMatrixBuiltFor(flags);
+
+  if (!reuseMatrix) {
+    // matrix kernels and preconditioners expect cleared grids
+    A0.clear();
+    Ai.clear();
+    Aj.clear();
+    Ak.clear();
+    tmp.clear();
+
+    // setup matrix and boundaries
+    MakeLaplaceMatrix(flags, A0, Ai, Aj, Ak, fractions);
+
+    if (phi) {
+      ApplyGhostFluidDiagonal(A0, flags, *phi, gfClamp);
+    }
 
-  if (phi) {
-    ApplyGhostFluidDiagonal(A0, flags, *phi, gfClamp);
+    ctx.mTiles.resize(flags.getSize());
+    ctx.mTiles.activateFromFlags(flags, FlagGrid::TypeFluid);
+    ctx.setMatrixFlags(flagsOnlyMatrix ? &flags : nullptr);
+    ctx.mStencilValid = false;
+    ctx.mPcaValid = false;
   }
 
   // check whether we need to fix some pressure value...
   // (manually enable, or automatically for high accuracy, can cause asymmetries otherwise)
-  if (zeroPressureFixing || cgAccuracy < 1e-07) {
+  if (fixPressureValue) {
     if (FLOATINGPOINT_PRECISION == 1)
       debMsg(
           "Warning - high CG accuracy with single-precision floating point accuracy might not "
@@ -1106,6 +1462,17 @@ void solvePressureSystem(Grid<Real> &rhs,
     }
   }
 
+  // compact stencil, built after pressure fixing as that changes the matrix too
+  if (compactMatrix && !ctx.mStencilValid) {
+    ctx.mStencilValid = buildCompactStencil(flags, Ai, Aj, Ak, ctx.mStencil);
+    if (!ctx.mStencilValid) {
+      debMsg("Compact matrix not possible for this system, using regular CG kernels", 2);
+    }
+    else {
+      debMsg("Compact matrix CG, SIMD level " << getSimdLevelName(getSimdLevel()), 2);
+    }
+  }
+
   // CG setup
   // note: the last factor increases the max iterations for 2d, which right now can't use a
   // preconditioner
@@ -1118,41 +1485,68 @@ void solvePressureSystem(Grid<Real> &rhs,
 
   gcg->setAccuracy(cgAccuracy);
   gcg->setUseL2Norm(useL2Norm);
+  if (compactMatrix && ctx.mStencilValid)
+    gcg->setCompactStencil(&ctx.mStencil);
+
+  // initial guess from previous solves, pressure scales linearly with the timestep
+  const Real dt = parent->getDt();
+  if (!warmStart || dt <= 0.)
+    ctx.mNumPrevPressure = 0;
+  if (ctx.mNumPrevPressure > 0) {
+    Grid<Real> prev0(parent, ctx.getBuffer(PressureContext::BufPrev0), false);
+    Grid<Real> prev1(parent, ctx.getBuffer(PressureContext::BufPrev1), false);
+    knPressureGuess(
+        flags, pressure, prev0, prev1, dt, warmStartExtrapolate && ctx.mNumPrevPressure > 1);
+    gcg->setWarmStart(true);
+  }
 
   int maxIter = 0;
 
   Grid<Real> *pca0 = nullptr, *pca1 = nullptr, *pca2 = nullptr, *pca3 = nullptr;
-  GridMg *pmg = nullptr;
 
   // optional preconditioning
   if (preconditioner == PcNone || preconditioner == PcMIC) {
     maxIter = (int)(cgMaxIterFac * flags.getSize().max()) * (flags.is3D() ? 1 : 4);
 
-    pca0 = new Grid<Real>(parent);
-    pca1 = new Grid<Real>(parent);
-    pca2 = new Grid<Real>(parent);
-    pca3 = new Grid<Real>(parent);
+    // skip empty regions in the CG loops, only worth it if a good part of the domain is not fluid
+    if (ctx.mTiles.getActiveFraction() < cgMaxTileFraction)
+      gcg->setActiveTiles(&ctx.mTiles);
+
+    pca0 = new Grid<Real>(parent, ctx.getBuffer(PressureContext::BufPca0), false);
+    pca1 = new Grid<Real>(parent, ctx.getBuffer(PressureContext::BufPca1), false);
+    pca2 = new Grid<Real>(parent, ctx.getBuffer(PressureContext::BufPca2), false);
+    pca3 = new Grid<Real>(parent, ctx.getBuffer(PressureContext::BufPca3), false);
+    // the mICP factors only depend on the matrix, keep them while it is reused
+    const bool reusePca = preconditioner == PcMIC && reuseMatrix && ctx.mPcaValid;
+    if (!reusePca) {
+      pca0->clear();
+      pca1->clear();
+      pca2->clear();
+      pca3->clear();
+    }
 
     gcg->setICPreconditioner(preconditioner == PcMIC ? GridCgInterface::PC_mICP :
                                                        GridCgInterface::PC_None,
                              pca0,
                              pca1,
                              pca2,
-                             pca3);
+                             pca3,
+                             reusePca);
+    ctx.mPcaValid = (preconditioner == PcMIC);
   }
   else if (preconditioner == PcMGDynamic || preconditioner == PcMGStatic) {
     maxIter = 100;
 
-    pmg = gMapMG[parent];
-    if (!pmg) {
-      pmg = new GridMg(pressure.getSize());
-      gMapMG[parent] = pmg;
-    }
+    // dynamic mode updates the hierarchy for each new matrix, static mode keeps the first one
+    GridMg *pmg = ctx.getMG();
+    if (preconditioner == PcMGDynamic && !reuseMatrix)
+      pmg->invalidateA();
 
     gcg->setMGPreconditioner(GridCgInterface::PC_MGP, pmg);
   }
 
   // CG solve
+  MuTime timer;
   for (int iter = 0; iter < maxIter; iter++) {
     if (!gcg->iterate())
       iter = maxIter;
@@ -1165,7 +1559,22 @@ void solvePressureSystem(Grid<Real> &rhs,
                                                         << ", residual:" << gcg->getResNorm(),
          2);
 
-  // Cleanup
+  PressureSolveInfo info;
+  info.frame = parent->mFrame;
+  info.iterations = gcg->getIterations();
+  info.residualInitial = gcg->getInitialResNorm();
+  info.residualFinal = gcg->getResNorm();
+  info.time = (Real)timer.update().time;
+  parent->addPressureSolveInfo(info);
+
+  if (warmStart && dt > 0.) {
+    Grid<Real> prev0(parent, ctx.getBuffer(PressureContext::BufPrev0), false);
+    Grid<Real> prev1(parent, ctx.getBuffer(PressureContext::BufPrev1), false);
+    knStorePressure(pressure, prev0, prev1, dt);
+    ctx.mNumPrevPressure = std::min(ctx.mNumPrevPressure + 1, 2);
+  }
+
+  // Cleanup, grid data stays in the pressure context for the next solve
   if (gcg)
     delete gcg;
   if (pca0)
@@ -1176,13 +1585,8 @@ void solvePressureSystem(Grid<Real> &rhs,
     delete pca2;
   if (pca3)
     delete pca3;
-
-  // PcMGDynamic: always delete multigrid solver after use
-  // PcMGStatic: keep multigrid solver for next solve
-  if (pmg && preconditioner == PcMGDynamic)
-    releaseMG(parent);
 }
-static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+static PyObject *_W_3(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
 {
   try {
     PbArgs _args(_linargs, _kwds);
@@ -1210,6 +1614,10 @@ static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
       const bool zeroPressureFixing = _args.getOpt<bool>("zeroPressureFixing", 14, false, &_lock);
       const Grid<Real> *curv = _args.getPtrOpt<Grid<Real>>("curv", 15, NULL, &_lock);
       const Real surfTens = _args.getOpt<Real>("surfTens", 16, 0., &_lock);
+      const bool warmStart = _args.getOpt<bool>("warmStart", 17, false, &_lock);
+      const bool warmStartExtrapolate = _args.getOpt<bool>(
+          "warmStartExtrapolate", 18, false, &_lock);
+      const bool compactMatrix = _args.getOpt<bool>("compactMatrix", 19, false, &_lock);
       _retval = getPyNone();
       solvePressureSystem(rhs,
                           vel,
@@ -1227,7 +1635,10 @@ static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
                           useL2Norm,
                           zeroPressureFixing,
                           curv,
-                          surfTens);
+                          surfTens,
+                          warmStart,
+                          warmStartExtrapolate,
+                          compactMatrix);
       _args.check();
     }
     pbFinalizePlugin(parent, "solvePressureSystem", !noTiming);
@@ -1238,7 +1649,7 @@ static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
     return 0;
   }
 }
-static const Pb::Register _RP_solvePressureSystem("", "solvePressureSystem", _W_2);
+static const Pb::Register _RP_solvePressureSystem("", "solvePressureSystem", _W_3);
 extern "C" {
 void PbRegister_solvePressureSystem()
 {
@@ -1272,7 +1683,7 @@ void correctVelocity(MACGrid &vel,
     knReplaceClampedGhostFluidVels(vel, flags, pressure, *phi, gfClamp);
   }
 }
-static PyObject *_W_3(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+static PyObject *_W_4(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
 {
   try {
     PbArgs _args(_linargs, _kwds);
@@ -1325,7 +1736,7 @@ static PyObject *_W_3(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
     return 0;
   }
 }
-static const Pb::Register _RP_correctVelocity("", "correctVelocity", _W_3);
+static const Pb::Register _RP_correctVelocity("", "correctVelocity", _W_4);
 extern "C" {
 void PbRegister_correctVelocity()
 {
@@ -1352,7 +1763,10 @@ void solvePressure(MACGrid &vel,
                    bool zeroPressureFixing = false,
                    const Grid<Real> *curv = NULL,
                    const Real surfTens = 0.,
-                   Grid<Real> *retRhs = NULL)
+                   Grid<Real> *retRhs = NULL,
+                   const bool warmStart = false,
+                   const bool warmStartExtrapolate = false,
+                   const bool compactMatrix = false)
 {
   Grid<Real> rhs(vel.getParent());
 
@@ -1390,7 +1804,10 @@ void solvePressure(MACGrid &vel,
                       useL2Norm,
                       zeroPressureFixing,
                       curv,
-                      surfTens);
+                      surfTens,
+                      warmStart,
+                      warmStartExtrapolate,
+                      compactMatrix);
 
   correctVelocity(vel,
                   pressure,
@@ -1414,7 +1831,7 @@ void solvePressure(MACGrid &vel,
     retRhs->copyFrom(rhs);
   }
 }
-static PyObject *_W_4(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+static PyObject *_W_5(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
 {
   try {
     PbArgs _args(_linargs, _kwds);
@@ -1441,6 +1858,10 @@ static PyObject *_W_4(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
       const Grid<Real> *curv = _args.getPtrOpt<Grid<Real>>("curv", 14, NULL, &_lock);
       const Real surfTens = _args.getOpt<Real>("surfTens", 15, 0., &_lock);
       Grid<Real> *retRhs = _args.getPtrOpt<Grid<Real>>("retRhs", 16, NULL, &_lock);
+      const bool warmStart = _args.getOpt<bool>("warmStart", 17, false, &_lock);
+      const bool warmStartExtrapolate = _args.getOpt<bool>(
+          "warmStartExtrapolate", 18, false, &_lock);
+      const bool compactMatrix = _args.getOpt<bool>("compactMatrix", 19, false, &_lock);
       _retval = getPyNone();
       solvePressure(vel,
                     pressure,
@@ -1458,7 +1879,10 @@ static PyObject *_W_4(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
                     zeroPressureFixing,
                     curv,
                     surfTens,
-                    retRhs);
+                    retRhs,
+                    warmStart,
+                    warmStartExtrapolate,
+                    compactMatrix);
       _args.check();
     }
     pbFinalizePlugin(parent, "solvePressure", !noTiming);
@@ -1469,7 +1893,7 @@ static PyObject *_W_4(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
     return 0;
   }
 }
-static const Pb::Register _RP_solvePressure("", "solvePressure", _W_4);
+static const Pb::Register _RP_solvePressure("", "solvePressure", _W_5);
 extern "C" {
 void PbRegister_solvePressure()
 {
@@ -29,6 +29,7 @@ struct KnAddForcePvel : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<Vec3> &v,
@@ -66,6 +67,7 @@ struct KnAddForcePvel : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnAddForcePvel");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -143,6 +145,7 @@ struct KnUpdateVelocityFromDeltaPos : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystem &p,
@@ -192,6 +195,7 @@ struct KnUpdateVelocityFromDeltaPos : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnUpdateVelocityFromDeltaPos");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -267,6 +271,7 @@ struct KnStepEuler : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystem &p,
@@ -310,6 +315,7 @@ struct KnStepEuler : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnStepEuler");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -386,6 +392,7 @@ struct KnSetPartType : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  ParticleDataImpl<int> &ptype,
@@ -435,6 +442,7 @@ struct KnSetPartType : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnSetPartType");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
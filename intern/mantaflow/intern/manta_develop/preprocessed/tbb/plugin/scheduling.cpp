@@ -0,0 +1,182 @@
+
+
+// DO NOT EDIT !
+// This file is generated using the MantaFlow preprocessor (prep generate).
+
+/******************************************************************************
+ *
+ * MantaFlow fluid solver framework
+ * Copyright 2011 Tobias Pfaff, Nils Thuerey
+ *
+ * This program is free software, distributed under the terms of the
+ * Apache License, Version 2.0
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Plugins for kernel scheduling: cache blocked iteration and its benchmark
+ *
+ ******************************************************************************/
+
+#include <sstream>
+#include "vectorbase.h"
+#include "grid.h"
+#include "kernel.h"
+#include "commonkernels.h"
+#include "conjugategrad.h"
+
+using namespace std;
+namespace Manta {
+
+//! Enable or disable the cache blocked scheduling of 3D stencil kernels (curl, divergence,
+//! gradient, laplace and matrix setup), tile sizes in cells
+
+void setKernelScheduling(bool blocked3D = false, int tileX = 64, int tileY = 16, int tileZ = 16)
+{
+  assertMsg(tileX > 0 && tileY > 0 && tileZ > 0, "setKernelScheduling: invalid tile size");
+  gKernelScheduling.blocked3D = blocked3D;
+  gKernelScheduling.tileX = tileX;
+  gKernelScheduling.tileY = tileY;
+  gKernelScheduling.tileZ = tileZ;
+}
+static PyObject *_W_0(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "setKernelScheduling", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      bool blocked3D = _args.getOpt<bool>("blocked3D", 0, false, &_lock);
+      int tileX = _args.getOpt<int>("tileX", 1, 64, &_lock);
+      int tileY = _args.getOpt<int>("tileY", 2, 16, &_lock);
+      int tileZ = _args.getOpt<int>("tileZ", 3, 16, &_lock);
+      _retval = getPyNone();
+      setKernelScheduling(blocked3D, tileX, tileY, tileZ);
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "setKernelScheduling", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("setKernelScheduling", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_setKernelScheduling("", "setKernelScheduling", _W_0);
+extern "C" {
+void PbRegister_setKernelScheduling()
+{
+  KEEP_UNUSED(_RP_setKernelScheduling);
+}
+}
+
+//! time the blockable stencil kernels with slice and with blocked scheduling on the given
+//! flags / velocity, returns a table with milliseconds per call (averaged over repeats)
+
+//! restores the kernel scheduling on scope exit, also if a benchmarked kernel throws
+struct KernelSchedulingRestore {
+  KernelSchedulingRestore() : saved(gKernelScheduling)
+  {
+  }
+  ~KernelSchedulingRestore()
+  {
+    gKernelScheduling = saved;
+  }
+  const KernelScheduling saved;
+};
+
+std::string benchmarkKernelScheduling(const FlagGrid &flags, const MACGrid &vel, int repeats = 5)
+{
+  assertMsg(flags.is3D(), "benchmarkKernelScheduling: only 3D grids use blocked scheduling");
+  FluidSolver *parent = flags.getParent();
+  const KernelSchedulingRestore restore;
+  const KernelScheduling &previous = restore.saved;
+
+  Grid<Vec3> center(parent), curl(parent);
+  Grid<Real> div(parent), laplace(parent), A0(parent), Ai(parent), Aj(parent), Ak(parent);
+  MACGrid grad(parent);
+  GetCentered(center, vel);
+
+  const char *names[] = {"CurlOp",
+                         "DivergenceOpMAC",
+                         "GradientOpMAC",
+                         "LaplaceOp",
+                         "MakeLaplaceMatrix"};
+  const int numKernels = sizeof(names) / sizeof(names[0]);
+  double times[2][numKernels];
+
+  for (int mode = 0; mode < 2; ++mode) {
+    gKernelScheduling.blocked3D = (mode == 1);
+    for (int n = 0; n < numKernels; ++n) {
+      unsigned long total = 0;
+      for (int r = 0; r < repeats; ++r) {
+        MuTime t;
+        switch (n) {
+          case 0:
+            CurlOp(center, curl);
+            break;
+          case 1:
+            DivergenceOpMAC(div, vel);
+            break;
+          case 2:
+            GradientOpMAC(grad, div);
+            break;
+          case 3:
+            LaplaceOp(laplace, div);
+            break;
+          case 4:
+            MakeLaplaceMatrix(flags, A0, Ai, Aj, Ak);
+            break;
+        }
+        total += (MuTime() - t).time;
+      }
+      times[mode][n] = (double)total / std::max(repeats, 1);
+    }
+  }
+
+  std::ostringstream out;
+  out << "Kernel scheduling benchmark, grid " << flags.getSize() << ", tiles "
+      << previous.tileX << "x" << previous.tileY << "x" << previous.tileZ << "\n";
+  for (int n = 0; n < numKernels; ++n) {
+    out << "  " << names[n] << ": slices " << times[0][n] << " ms, blocked " << times[1][n]
+        << " ms\n";
+  }
+  debMsg(out.str(), 2);
+  return out.str();
+}
+static PyObject *_W_1(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
+{
+  try {
+    PbArgs _args(_linargs, _kwds);
+    FluidSolver *parent = _args.obtainParent();
+    bool noTiming = _args.getOpt<bool>("notiming", -1, 0);
+    pbPreparePlugin(parent, "benchmarkKernelScheduling", !noTiming);
+    PyObject *_retval = 0;
+    {
+      ArgLocker _lock;
+      const FlagGrid &flags = *_args.getPtr<FlagGrid>("flags", 0, &_lock);
+      const MACGrid &vel = *_args.getPtr<MACGrid>("vel", 1, &_lock);
+      int repeats = _args.getOpt<int>("repeats", 2, 5, &_lock);
+      _retval = toPy(benchmarkKernelScheduling(flags, vel, repeats));
+      _args.check();
+    }
+    pbFinalizePlugin(parent, "benchmarkKernelScheduling", !noTiming);
+    return _retval;
+  }
+  catch (std::exception &e) {
+    pbSetError("benchmarkKernelScheduling", e.what());
+    return 0;
+  }
+}
+static const Pb::Register _RP_benchmarkKernelScheduling("",
+                                                        "benchmarkKernelScheduling",
+                                                        _W_1);
+extern "C" {
+void PbRegister_benchmarkKernelScheduling()
+{
+  KEEP_UNUSED(_RP_benchmarkKernelScheduling);
+}
+}
+
+}  // namespace Manta
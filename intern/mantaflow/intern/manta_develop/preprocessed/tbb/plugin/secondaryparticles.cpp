@@ -78,6 +78,7 @@ struct knFlipComputeSecondaryParticlePotentials : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -257,6 +258,7 @@ struct knFlipComputeSecondaryParticlePotentials : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knFlipComputeSecondaryParticlePotentials");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -453,519 +455,168 @@ void PbRegister_flipComputeSecondaryParticlePotentials()
 }
 }
 
-// adds secondary particles to &pts_sec for every fluid cell in &flags according to the potential
-// grids &potTA, &potWC and &potKE secondary particles are uniformly sampled in every fluid cell in
-// a randomly offset cylinder in fluid movement direction In contrast to
-// flipSampleSecondaryParticles this uses more cylinders per cell and interpolates velocity and
-// potentials. To control number of cylinders in each dimension adjust radius(0.25=>2 cyl,
-// 0.1666=>3 cyl, 0.125=>3cyl etc.).
-
-struct knFlipSampleSecondaryParticlesMoreCylinders : public KernelBase {
-  knFlipSampleSecondaryParticlesMoreCylinders(const FlagGrid &flags,
-                                              const MACGrid &v,
-                                              BasicParticleSystem &pts_sec,
-                                              ParticleDataImpl<Vec3> &v_sec,
-                                              ParticleDataImpl<Real> &l_sec,
-                                              const Real lMin,
-                                              const Real lMax,
-                                              const Grid<Real> &potTA,
-                                              const Grid<Real> &potWC,
-                                              const Grid<Real> &potKE,
-                                              const Grid<Real> &neighborRatio,
-                                              const Real c_s,
-                                              const Real c_b,
-                                              const Real k_ta,
-                                              const Real k_wc,
-                                              const Real dt,
-                                              const int itype = FlagGrid::TypeFluid)
-      : KernelBase(&flags, 0),
-        flags(flags),
-        v(v),
-        pts_sec(pts_sec),
-        v_sec(v_sec),
-        l_sec(l_sec),
-        lMin(lMin),
-        lMax(lMax),
-        potTA(potTA),
-        potWC(potWC),
-        potKE(potKE),
-        neighborRatio(neighborRatio),
-        c_s(c_s),
-        c_b(c_b),
-        k_ta(k_ta),
-        k_wc(k_wc),
-        dt(dt),
-        itype(itype)
-  {
-    runMessage();
-    run();
-  }
-  inline void op(int i,
-                 int j,
-                 int k,
-                 const FlagGrid &flags,
-                 const MACGrid &v,
-                 BasicParticleSystem &pts_sec,
-                 ParticleDataImpl<Vec3> &v_sec,
-                 ParticleDataImpl<Real> &l_sec,
-                 const Real lMin,
-                 const Real lMax,
-                 const Grid<Real> &potTA,
-                 const Grid<Real> &potWC,
-                 const Grid<Real> &potKE,
-                 const Grid<Real> &neighborRatio,
-                 const Real c_s,
-                 const Real c_b,
-                 const Real k_ta,
-                 const Real k_wc,
-                 const Real dt,
-                 const int itype = FlagGrid::TypeFluid)
-  {
-
-    if (!(flags(i, j, k) & itype))
-      return;
-
-    RandomStream mRand(9832);
-    Real radius =
-        0.25;  // diameter=0.5 => sampling with two cylinders in each dimension since cell size=1
-    for (Real x = i - radius; x <= i + radius; x += 2 * radius) {
-      for (Real y = j - radius; y <= j + radius; y += 2 * radius) {
-        for (Real z = k - radius; z <= k + radius; z += 2 * radius) {
-
-          Vec3 xi = Vec3(x, y, z);
-          Real KE = potKE.getInterpolated(xi);
-          Real TA = potTA.getInterpolated(xi);
-          Real WC = potWC.getInterpolated(xi);
-
-          const int n = KE * (k_ta * TA + k_wc * WC) * dt;  // number of secondary particles
-          if (n == 0)
-            continue;
-          Vec3 vi = v.getInterpolated(xi);
-          Vec3 dir = dt * vi;  // direction of movement of current particle
-          Vec3 e1 = getNormalized(Vec3(dir.z, 0, -dir.x));  // perpendicular to dir
-          Vec3 e2 = getNormalized(
-              cross(e1, dir));  // perpendicular to dir and e1, so e1 and e1 create reference plane
-
-          for (int di = 0; di < n; di++) {
-            const Real r = radius * sqrt(mRand.getReal());        // distance to cylinder axis
-            const Real theta = mRand.getReal() * Real(2) * M_PI;  // azimuth
-            const Real h = mRand.getReal() * norm(dt * vi);       // distance to reference plane
-            Vec3 xd = xi + r * cos(theta) * e1 + r * sin(theta) * e2 + h * getNormalized(vi);
-            if (!flags.is3D())
-              xd.z = 0;
-            pts_sec.add(xd);
-
-            v_sec[v_sec.size() - 1] = r * cos(theta) * e1 + r * sin(theta) * e2 +
-                                      vi;  // init velocity of new particle
-            Real temp = (KE + TA + WC) / 3;
-            l_sec[l_sec.size() - 1] = ((lMax - lMin) * temp) + lMin +
-                                      mRand.getReal() * 0.1;  // init lifetime of new particle
-
-            // init type of new particle
-            if (neighborRatio(i, j, k) < c_s) {
-              pts_sec[pts_sec.size() - 1].flag = ParticleBase::PSPRAY;
-            }
-            else if (neighborRatio(i, j, k) > c_b) {
-              pts_sec[pts_sec.size() - 1].flag = ParticleBase::PBUBBLE;
-            }
-            else {
-              pts_sec[pts_sec.size() - 1].flag = ParticleBase::PFOAM;
-            }
-          }
-        }
-      }
-    }
-  }
-  inline const FlagGrid &getArg0()
-  {
-    return flags;
-  }
-  typedef FlagGrid type0;
-  inline const MACGrid &getArg1()
-  {
-    return v;
-  }
-  typedef MACGrid type1;
-  inline BasicParticleSystem &getArg2()
-  {
-    return pts_sec;
-  }
-  typedef BasicParticleSystem type2;
-  inline ParticleDataImpl<Vec3> &getArg3()
-  {
-    return v_sec;
-  }
-  typedef ParticleDataImpl<Vec3> type3;
-  inline ParticleDataImpl<Real> &getArg4()
-  {
-    return l_sec;
-  }
-  typedef ParticleDataImpl<Real> type4;
-  inline const Real &getArg5()
-  {
-    return lMin;
-  }
-  typedef Real type5;
-  inline const Real &getArg6()
-  {
-    return lMax;
-  }
-  typedef Real type6;
-  inline const Grid<Real> &getArg7()
-  {
-    return potTA;
-  }
-  typedef Grid<Real> type7;
-  inline const Grid<Real> &getArg8()
+// counter based random numbers for secondary particle sampling: every cell draws from its own
+// stream keyed by the cell index, so the samples do not depend on the order in which cells are
+// processed or on the number of threads
+class CellRandom {
+ public:
+  CellRandom(unsigned long long key, IndexInt cell) : mKey(mix(key ^ mix(cell))), mCounter(0)
   {
-    return potWC;
   }
-  typedef Grid<Real> type8;
-  inline const Grid<Real> &getArg9()
+  //! uniform in [0, 1), 24 bits so that the value is exact in single precision
+  Real getReal()
   {
-    return potKE;
+    mCounter++;
+    return Real(mix(mKey + mCounter * 0x9E3779B97F4A7C15ULL) >> 40) * Real(1. / 16777216.);
   }
-  typedef Grid<Real> type9;
-  inline const Grid<Real> &getArg10()
+  //! splitmix64 finalizer
+  static unsigned long long mix(unsigned long long x)
   {
-    return neighborRatio;
-  }
-  typedef Grid<Real> type10;
-  inline const Real &getArg11()
-  {
-    return c_s;
-  }
-  typedef Real type11;
-  inline const Real &getArg12()
-  {
-    return c_b;
-  }
-  typedef Real type12;
-  inline const Real &getArg13()
-  {
-    return k_ta;
-  }
-  typedef Real type13;
-  inline const Real &getArg14()
-  {
-    return k_wc;
-  }
-  typedef Real type14;
-  inline const Real &getArg15()
-  {
-    return dt;
-  }
-  typedef Real type15;
-  inline const int &getArg16()
-  {
-    return itype;
-  }
-  typedef int type16;
-  void runMessage()
-  {
-    debMsg("Executing kernel knFlipSampleSecondaryParticlesMoreCylinders ", 3);
-    debMsg("Kernel range"
-               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
-           4);
-  };
-  void run()
-  {
-    const int _maxX = maxX;
-    const int _maxY = maxY;
-    for (int k = minZ; k < maxZ; k++)
-      for (int j = 0; j < _maxY; j++)
-        for (int i = 0; i < _maxX; i++)
-          op(i,
-             j,
-             k,
-             flags,
-             v,
-             pts_sec,
-             v_sec,
-             l_sec,
-             lMin,
-             lMax,
-             potTA,
-             potWC,
-             potKE,
-             neighborRatio,
-             c_s,
-             c_b,
-             k_ta,
-             k_wc,
-             dt,
-             itype);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
   }
+
+ private:
+  unsigned long long mKey, mCounter;
+};
+
+// adds secondary particles to &pts_sec for every fluid cell in &flags according to the potential
+// grids &potTA, &potWC and &potKE secondary particles are uniformly sampled in every fluid cell in
+// a randomly offset cylinder in fluid movement direction. With moreCylinders, every cell is
+// sampled with more cylinders and velocity and potentials are interpolated. To control number of
+// cylinders in each dimension adjust radius(0.25=>2 cyl, 0.1666=>3 cyl, 0.125=>3cyl etc.).
+// count() and fill() visit the same samples, so the number of particles per cell is known before
+// any particle is written.
+struct SecondaryParticleSampler {
   const FlagGrid &flags;
   const MACGrid &v;
-  BasicParticleSystem &pts_sec;
-  ParticleDataImpl<Vec3> &v_sec;
-  ParticleDataImpl<Real> &l_sec;
-  const Real lMin;
-  const Real lMax;
   const Grid<Real> &potTA;
   const Grid<Real> &potWC;
   const Grid<Real> &potKE;
   const Grid<Real> &neighborRatio;
-  const Real c_s;
-  const Real c_b;
-  const Real k_ta;
-  const Real k_wc;
-  const Real dt;
-  const int itype;
-};
+  Real lMin, lMax, c_s, c_b, k_ta, k_wc, dt;
+  int itype;
+  bool moreCylinders;
+  unsigned long long seed;
 
-// adds secondary particles to &pts_sec for every fluid cell in &flags according to the potential
-// grids &potTA, &potWC and &potKE secondary particles are uniformly sampled in every fluid cell in
-// a randomly offset cylinder in fluid movement direction
-
-struct knFlipSampleSecondaryParticles : public KernelBase {
-  knFlipSampleSecondaryParticles(const FlagGrid &flags,
-                                 const MACGrid &v,
-                                 BasicParticleSystem &pts_sec,
-                                 ParticleDataImpl<Vec3> &v_sec,
-                                 ParticleDataImpl<Real> &l_sec,
-                                 const Real lMin,
-                                 const Real lMax,
-                                 const Grid<Real> &potTA,
-                                 const Grid<Real> &potWC,
-                                 const Grid<Real> &potKE,
-                                 const Grid<Real> &neighborRatio,
-                                 const Real c_s,
-                                 const Real c_b,
-                                 const Real k_ta,
-                                 const Real k_wc,
-                                 const Real dt,
-                                 const int itype = FlagGrid::TypeFluid)
-      : KernelBase(&flags, 0),
-        flags(flags),
-        v(v),
-        pts_sec(pts_sec),
-        v_sec(v_sec),
-        l_sec(l_sec),
-        lMin(lMin),
-        lMax(lMax),
-        potTA(potTA),
-        potWC(potWC),
-        potKE(potKE),
-        neighborRatio(neighborRatio),
-        c_s(c_s),
-        c_b(c_b),
-        k_ta(k_ta),
-        k_wc(k_wc),
-        dt(dt),
-        itype(itype)
+  // number of secondary particles for the potentials of one cylinder
+  int numParticles(Real KE, Real TA, Real WC) const
   {
-    runMessage();
-    run();
+    const int n = KE * (k_ta * TA + k_wc * WC) * dt;
+    return std::max(n, 0);
   }
-  inline void op(int i,
-                 int j,
-                 int k,
-                 const FlagGrid &flags,
-                 const MACGrid &v,
-                 BasicParticleSystem &pts_sec,
-                 ParticleDataImpl<Vec3> &v_sec,
-                 ParticleDataImpl<Real> &l_sec,
-                 const Real lMin,
-                 const Real lMax,
-                 const Grid<Real> &potTA,
-                 const Grid<Real> &potWC,
-                 const Grid<Real> &potKE,
-                 const Grid<Real> &neighborRatio,
-                 const Real c_s,
-                 const Real c_b,
-                 const Real k_ta,
-                 const Real k_wc,
-                 const Real dt,
-                 const int itype = FlagGrid::TypeFluid)
-  {
 
+  int count(int i, int j, int k) const
+  {
     if (!(flags(i, j, k) & itype))
-      return;
+      return 0;
+    if (!moreCylinders)
+      return numParticles(potKE(i, j, k), potTA(i, j, k), potWC(i, j, k));
+
+    int n = 0;
+    const Real radius = 0.25;
+    for (Real x = i - radius; x <= i + radius; x += 2 * radius) {
+      for (Real y = j - radius; y <= j + radius; y += 2 * radius) {
+        for (Real z = k - radius; z <= k + radius; z += 2 * radius) {
+          const Vec3 xi = Vec3(x, y, z);
+          n += numParticles(
+              potKE.getInterpolated(xi), potTA.getInterpolated(xi), potWC.getInterpolated(xi));
+        }
+      }
+    }
+    return n;
+  }
 
-    Real KE = potKE(i, j, k);
-    Real TA = potTA(i, j, k);
-    Real WC = potWC(i, j, k);
+  // writes the particles of cell (i,j,k) to idx, idx+1, ... and returns the next free index
+  IndexInt fill(int i,
+                int j,
+                int k,
+                IndexInt idx,
+                BasicParticleSystem &pts_sec,
+                ParticleDataImpl<Vec3> &v_sec,
+                ParticleDataImpl<Real> &l_sec) const
+  {
+    if (!(flags(i, j, k) & itype))
+      return idx;
+
+    // init type of new particles
+    int type = ParticleBase::PFOAM;
+    if (neighborRatio(i, j, k) < c_s)
+      type = ParticleBase::PSPRAY;
+    else if (neighborRatio(i, j, k) > c_b)
+      type = ParticleBase::PBUBBLE;
+
+    CellRandom rand(seed, flags.index(i, j, k));
+    if (!moreCylinders) {
+      const Real KE = potKE(i, j, k);
+      const Real TA = potTA(i, j, k);
+      const Real WC = potWC(i, j, k);
+      const int n = numParticles(KE, TA, WC);
+      if (n == 0)
+        return idx;
+      const Vec3 xi = Vec3(i + rand.getReal(),
+                           j + rand.getReal(),
+                           k + rand.getReal());  // randomized offset uniform in cell
+      return emitCylinder(
+          xi, Real(0.5), n, KE, TA, WC, type, rand, idx, pts_sec, v_sec, l_sec);
+    }
 
-    const int n = KE * (k_ta * TA + k_wc * WC) * dt;  // number of secondary particles
-    if (n == 0)
-      return;
-    RandomStream mRand(9832);
-
-    Vec3 xi = Vec3(i + mRand.getReal(),
-                   j + mRand.getReal(),
-                   k + mRand.getReal());  // randomized offset uniform in cell
-    Vec3 vi = v.getInterpolated(xi);
-    Vec3 dir = dt * vi;                               // direction of movement of current particle
-    Vec3 e1 = getNormalized(Vec3(dir.z, 0, -dir.x));  // perpendicular to dir
-    Vec3 e2 = getNormalized(
+    // diameter=0.5 => sampling with two cylinders in each dimension since cell size=1
+    const Real radius = 0.25;
+    for (Real x = i - radius; x <= i + radius; x += 2 * radius) {
+      for (Real y = j - radius; y <= j + radius; y += 2 * radius) {
+        for (Real z = k - radius; z <= k + radius; z += 2 * radius) {
+          const Vec3 xi = Vec3(x, y, z);
+          const Real KE = potKE.getInterpolated(xi);
+          const Real TA = potTA.getInterpolated(xi);
+          const Real WC = potWC.getInterpolated(xi);
+          const int n = numParticles(KE, TA, WC);
+          if (n == 0)
+            continue;
+          idx = emitCylinder(xi, radius, n, KE, TA, WC, type, rand, idx, pts_sec, v_sec, l_sec);
+        }
+      }
+    }
+    return idx;
+  }
+
+  IndexInt emitCylinder(const Vec3 &xi,
+                        const Real radius,
+                        const int n,
+                        const Real KE,
+                        const Real TA,
+                        const Real WC,
+                        const int type,
+                        CellRandom &rand,
+                        IndexInt idx,
+                        BasicParticleSystem &pts_sec,
+                        ParticleDataImpl<Vec3> &v_sec,
+                        ParticleDataImpl<Real> &l_sec) const
+  {
+    const Vec3 vi = v.getInterpolated(xi);
+    const Vec3 dir = dt * vi;  // direction of movement of current particle
+    const Vec3 e1 = getNormalized(Vec3(dir.z, 0, -dir.x));  // perpendicular to dir
+    const Vec3 e2 = getNormalized(
         cross(e1, dir));  // perpendicular to dir and e1, so e1 and e1 create reference plane
+    const Real temp = (KE + TA + WC) / 3;
 
-    for (int di = 0; di < n; di++) {
-      const Real r = Real(0.5) * sqrt(mRand.getReal());     // distance to cylinder axis
-      const Real theta = mRand.getReal() * Real(2) * M_PI;  // azimuth
-      const Real h = mRand.getReal() * norm(dt * vi);       // distance to reference plane
+    for (int di = 0; di < n; di++, idx++) {
+      const Real r = radius * sqrt(rand.getReal());        // distance to cylinder axis
+      const Real theta = rand.getReal() * Real(2) * M_PI;  // azimuth
+      const Real h = rand.getReal() * norm(dt * vi);       // distance to reference plane
       Vec3 xd = xi + r * cos(theta) * e1 + r * sin(theta) * e2 + h * getNormalized(vi);
       if (!flags.is3D())
         xd.z = 0;
-      pts_sec.add(xd);
-
-      v_sec[v_sec.size() - 1] = r * cos(theta) * e1 + r * sin(theta) * e2 +
-                                vi;  // init velocity of new particle
-      Real temp = (KE + TA + WC) / 3;
-      l_sec[l_sec.size() - 1] = ((lMax - lMin) * temp) + lMin +
-                                mRand.getReal() * 0.1;  // init lifetime of new particle
-
-      // init type of new particle
-      if (neighborRatio(i, j, k) < c_s) {
-        pts_sec[pts_sec.size() - 1].flag = ParticleBase::PSPRAY;
-      }
-      else if (neighborRatio(i, j, k) > c_b) {
-        pts_sec[pts_sec.size() - 1].flag = ParticleBase::PBUBBLE;
-      }
-      else {
-        pts_sec[pts_sec.size() - 1].flag = ParticleBase::PFOAM;
-      }
+      pts_sec[idx].pos = xd;
+      pts_sec[idx].flag = type;
+      v_sec[idx] = r * cos(theta) * e1 + r * sin(theta) * e2 +
+                   vi;  // init velocity of new particle
+      l_sec[idx] = ((lMax - lMin) * temp) + lMin +
+                   rand.getReal() * 0.1;  // init lifetime of new particle
     }
+    return idx;
   }
-  inline const FlagGrid &getArg0()
-  {
-    return flags;
-  }
-  typedef FlagGrid type0;
-  inline const MACGrid &getArg1()
-  {
-    return v;
-  }
-  typedef MACGrid type1;
-  inline BasicParticleSystem &getArg2()
-  {
-    return pts_sec;
-  }
-  typedef BasicParticleSystem type2;
-  inline ParticleDataImpl<Vec3> &getArg3()
-  {
-    return v_sec;
-  }
-  typedef ParticleDataImpl<Vec3> type3;
-  inline ParticleDataImpl<Real> &getArg4()
-  {
-    return l_sec;
-  }
-  typedef ParticleDataImpl<Real> type4;
-  inline const Real &getArg5()
-  {
-    return lMin;
-  }
-  typedef Real type5;
-  inline const Real &getArg6()
-  {
-    return lMax;
-  }
-  typedef Real type6;
-  inline const Grid<Real> &getArg7()
-  {
-    return potTA;
-  }
-  typedef Grid<Real> type7;
-  inline const Grid<Real> &getArg8()
-  {
-    return potWC;
-  }
-  typedef Grid<Real> type8;
-  inline const Grid<Real> &getArg9()
-  {
-    return potKE;
-  }
-  typedef Grid<Real> type9;
-  inline const Grid<Real> &getArg10()
-  {
-    return neighborRatio;
-  }
-  typedef Grid<Real> type10;
-  inline const Real &getArg11()
-  {
-    return c_s;
-  }
-  typedef Real type11;
-  inline const Real &getArg12()
-  {
-    return c_b;
-  }
-  typedef Real type12;
-  inline const Real &getArg13()
-  {
-    return k_ta;
-  }
-  typedef Real type13;
-  inline const Real &getArg14()
-  {
-    return k_wc;
-  }
-  typedef Real type14;
-  inline const Real &getArg15()
-  {
-    return dt;
-  }
-  typedef Real type15;
-  inline const int &getArg16()
-  {
-    return itype;
-  }
-  typedef int type16;
-  void runMessage()
-  {
-    debMsg("Executing kernel knFlipSampleSecondaryParticles ", 3);
-    debMsg("Kernel range"
-               << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
-           4);
-  };
-  void run()
-  {
-    const int _maxX = maxX;
-    const int _maxY = maxY;
-    for (int k = minZ; k < maxZ; k++)
-      for (int j = 0; j < _maxY; j++)
-        for (int i = 0; i < _maxX; i++)
-          op(i,
-             j,
-             k,
-             flags,
-             v,
-             pts_sec,
-             v_sec,
-             l_sec,
-             lMin,
-             lMax,
-             potTA,
-             potWC,
-             potKE,
-             neighborRatio,
-             c_s,
-             c_b,
-             k_ta,
-             k_wc,
-             dt,
-             itype);
-  }
-  const FlagGrid &flags;
-  const MACGrid &v;
-  BasicParticleSystem &pts_sec;
-  ParticleDataImpl<Vec3> &v_sec;
-  ParticleDataImpl<Real> &l_sec;
-  const Real lMin;
-  const Real lMax;
-  const Grid<Real> &potTA;
-  const Grid<Real> &potWC;
-  const Grid<Real> &potKE;
-  const Grid<Real> &neighborRatio;
-  const Real c_s;
-  const Real c_b;
-  const Real k_ta;
-  const Real k_wc;
-  const Real dt;
-  const int itype;
 };
 
 void flipSampleSecondaryParticles(const std::string mode,
@@ -987,47 +638,65 @@ void flipSampleSecondaryParticles(const std::string mode,
                                   const Real dt,
                                   const int itype = FlagGrid::TypeFluid)
 {
-  if (mode == "single") {
-    knFlipSampleSecondaryParticles(flags,
-                                   v,
-                                   pts_sec,
-                                   v_sec,
-                                   l_sec,
-                                   lMin,
-                                   lMax,
-                                   potTA,
-                                   potWC,
-                                   potKE,
-                                   neighborRatio,
-                                   c_s,
-                                   c_b,
-                                   k_ta,
-                                   k_wc,
-                                   dt,
-                                   itype);
-  }
-  else if (mode == "multiple") {
-    knFlipSampleSecondaryParticlesMoreCylinders(flags,
-                                                v,
-                                                pts_sec,
-                                                v_sec,
-                                                l_sec,
-                                                lMin,
-                                                lMax,
-                                                potTA,
-                                                potWC,
-                                                potKE,
-                                                neighborRatio,
-                                                c_s,
-                                                c_b,
-                                                k_ta,
-                                                k_wc,
-                                                dt,
-                                                itype);
-  }
-  else {
+  if (mode != "single" && mode != "multiple")
     throw std::invalid_argument("Unknown mode: use \"single\" or \"multiple\" instead!");
-  }
+
+  // random streams are keyed by cell and frame, reruns of a frame give the same particles
+  const FluidSolver *parent = flags.getParent();
+  const unsigned long long seed = CellRandom::mix(9832ULL ^ CellRandom::mix(parent->mFrame));
+  const SecondaryParticleSampler sampler = {flags,
+                                            v,
+                                            potTA,
+                                            potWC,
+                                            potKE,
+                                            neighborRatio,
+                                            lMin,
+                                            lMax,
+                                            c_s,
+                                            c_b,
+                                            k_ta,
+                                            k_wc,
+                                            dt,
+                                            itype,
+                                            mode == "multiple",
+                                            seed};
+
+  // pass 1: number of new particles per grid row
+  const int sx = flags.getSizeX(), sy = flags.getSizeY();
+  const IndexInt rows = (IndexInt)sy * flags.getSizeZ();
+  std::vector<IndexInt> rowStart(rows + 1, 0);
+  parallelForRange(
+      rows,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt r = begin; r < end; r++) {
+          const int j = r % sy, k = r / sy;
+          IndexInt n = 0;
+          for (int i = 0; i < sx; i++)
+            n += sampler.count(i, j, k);
+          rowStart[r + 1] = n;
+        }
+      },
+      16);
+  for (IndexInt r = 0; r < rows; r++)
+    rowStart[r + 1] += rowStart[r];
+  if (rowStart[rows] == 0)
+    return;
+
+  // pass 2: every row fills its own range of the grown buffers, particles end up in the same
+  // order as with a serial i,j,k sweep
+  const IndexInt first = pts_sec.addEmpty(rowStart[rows]);
+  parallelForRange(
+      rows,
+      [&](IndexInt begin, IndexInt end) {
+        for (IndexInt r = begin; r < end; r++) {
+          const int j = r % sy, k = r / sy;
+          IndexInt idx = first + rowStart[r];
+          for (int i = 0; i < sx; i++)
+            idx = sampler.fill(i, j, k, idx, pts_sec, v_sec, l_sec);
+          assertMsg(idx == first + rowStart[r + 1], "secondary particle count mismatch");
+        }
+      },
+      16);
 }
 static PyObject *_W_1(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
 {
@@ -1148,6 +817,7 @@ struct knFlipUpdateSecondaryParticlesLinear : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystem &pts_sec,
@@ -1323,6 +993,7 @@ struct knFlipUpdateSecondaryParticlesLinear : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knFlipUpdateSecondaryParticlesLinear");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1406,6 +1077,7 @@ struct knFlipUpdateSecondaryParticlesCubic : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystem &pts_sec,
@@ -1636,6 +1308,7 @@ struct knFlipUpdateSecondaryParticlesCubic : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knFlipUpdateSecondaryParticlesCubic");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1742,6 +1415,8 @@ void flipUpdateSecondaryParticles(const std::string mode,
   else {
     throw std::invalid_argument("Unknown mode: use \"linear\" or \"cubic\" instead!");
   }
+  // the parallel update kills particles without a synchronized counter
+  pts_sec.recountDeletes();
   pts_sec.doCompress();
 }
 static PyObject *_W_2(PyObject *_self, PyObject *_linargs, PyObject *_kwds)
@@ -1821,6 +1496,7 @@ struct knFlipDeleteParticlesInObstacle : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, BasicParticleSystem &pts, const FlagGrid &flags) const
   {
@@ -1857,6 +1533,7 @@ struct knFlipDeleteParticlesInObstacle : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("knFlipDeleteParticlesInObstacle");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1992,6 +1669,7 @@ struct knSetFlagsFromLevelset : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  FlagGrid &flags,
@@ -2028,6 +1706,7 @@ struct knSetFlagsFromLevelset : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetFlagsFromLevelset");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2091,6 +1770,7 @@ struct knSetMACFromLevelset : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, MACGrid &v, const Grid<Real> &phi, const Vec3 c) const
   {
@@ -2118,6 +1798,7 @@ struct knSetMACFromLevelset : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knSetMACFromLevelset");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2222,6 +1903,7 @@ struct knFlipComputePotentialTrappedAir : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2314,6 +1996,7 @@ struct knFlipComputePotentialTrappedAir : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knFlipComputePotentialTrappedAir");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2428,6 +2111,7 @@ struct knFlipComputePotentialKineticEnergy : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2492,6 +2176,7 @@ struct knFlipComputePotentialKineticEnergy : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knFlipComputePotentialKineticEnergy");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2603,6 +2288,7 @@ struct knFlipComputePotentialWaveCrest : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2708,6 +2394,7 @@ struct knFlipComputePotentialWaveCrest : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knFlipComputePotentialWaveCrest");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2825,6 +2512,7 @@ struct knFlipComputeSurfaceNormals : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, Grid<Vec3> &normal, const Grid<Real> &phi) const
   {
@@ -2846,6 +2534,7 @@ struct knFlipComputeSurfaceNormals : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knFlipComputeSurfaceNormals");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -2916,6 +2605,7 @@ struct knFlipUpdateNeighborRatio : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -2980,6 +2670,7 @@ struct knFlipUpdateNeighborRatio : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knFlipUpdateNeighborRatio");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
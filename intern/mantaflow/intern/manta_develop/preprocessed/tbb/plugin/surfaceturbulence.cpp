@@ -78,83 +78,37 @@ SurfaceTurbulenceParameters params;
 //
 struct ParticleAccelGrid {
   int res;
-  vector<int> ***indices;
+  ParticleNeighborGrid grid;
 
   void init(int inRes)
   {
     res = inRes;
-    indices = new vector<int> **[res];
-    for (int i = 0; i < res; i++) {
-      indices[i] = new vector<int> *[res];
-      for (int j = 0; j < res; j++) {
-        indices[i][j] = new vector<int>[res];
-      }
-    }
+    grid.init(Vec3(params.res), res);
   }
 
   void fillWith(const BasicParticleSystem &particles)
   {
-    // clear
-    for (int i = 0; i < res; i++) {
-      for (int j = 0; j < res; j++) {
-        for (int k = 0; k < res; k++) {
-          indices[i][j][k].clear();
-        }
-      }
-    }
-
-    // fill
-    for (int id = 0; id < particles.size(); id++) {
-      Vec3 pos = particles.getPos(id);
-      int i = clamp<int>(floor(pos.x / params.res * res), 0, res - 1);
-      int j = clamp<int>(floor(pos.y / params.res * res), 0, res - 1);
-      int k = clamp<int>(floor(pos.z / params.res * res), 0, res - 1);
-      indices[i][j][k].push_back(id);
-    }
+    grid.fill(particles.size(), [&](IndexInt id) { return particles.getPos(id); });
   }
 
   void fillWith(const ParticleDataImpl<Vec3> &particles)
   {
-    // clear
-    for (int i = 0; i < res; i++) {
-      for (int j = 0; j < res; j++) {
-        for (int k = 0; k < res; k++) {
-          indices[i][j][k].clear();
-        }
-      }
-    }
-
-    // fill
-    for (int id = 0; id < particles.size(); id++) {
-      Vec3 pos = particles[id];
-      int i = clamp<int>(floor(pos.x / params.res * res), 0, res - 1);
-      int j = clamp<int>(floor(pos.y / params.res * res), 0, res - 1);
-      int k = clamp<int>(floor(pos.z / params.res * res), 0, res - 1);
-      indices[i][j][k].push_back(id);
-    }
+    grid.fill(particles.size(), [&](IndexInt id) { return particles[id]; });
   }
 };
 
 #define LOOP_NEIGHBORS_BEGIN(points, center, radius) \
-  int minI = clamp<int>( \
-      floor((center.x - radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int maxI = clamp<int>( \
-      floor((center.x + radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int minJ = clamp<int>( \
-      floor((center.y - radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int maxJ = clamp<int>( \
-      floor((center.y + radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int minK = clamp<int>( \
-      floor((center.z - radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  int maxK = clamp<int>( \
-      floor((center.z + radius) / params.res * points.accel->res), 0, points.accel->res - 1); \
-  for (int i = minI; i <= maxI; i++) { \
-    for (int j = minJ; j <= maxJ; j++) { \
-      for (int k = minK; k <= maxK; k++) { \
-        for (int idLOOPNEIGHBORS = 0; \
-             idLOOPNEIGHBORS < (int)points.accel->indices[i][j][k].size(); \
+  const ParticleNeighborGrid &gridLOOPNEIGHBORS = points.accel->grid; \
+  const Vec3i minLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellOf(center - Vec3(radius)); \
+  const Vec3i maxLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellOf(center + Vec3(radius)); \
+  for (int i = minLOOPNEIGHBORS.x; i <= maxLOOPNEIGHBORS.x; i++) { \
+    for (int j = minLOOPNEIGHBORS.y; j <= maxLOOPNEIGHBORS.y; j++) { \
+      for (int k = minLOOPNEIGHBORS.z; k <= maxLOOPNEIGHBORS.z; k++) { \
+        const int cellLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellIndex(i, j, k); \
+        for (IndexInt idLOOPNEIGHBORS = gridLOOPNEIGHBORS.cellBegin(cellLOOPNEIGHBORS); \
+             idLOOPNEIGHBORS < gridLOOPNEIGHBORS.cellEnd(cellLOOPNEIGHBORS); \
              idLOOPNEIGHBORS++) { \
-          int idn = points.accel->indices[i][j][k][idLOOPNEIGHBORS]; \
+          int idn = gridLOOPNEIGHBORS.getId(idLOOPNEIGHBORS); \
           if (points.isActive(idn)) {
 #define LOOP_NEIGHBORS_END \
   } \
@@ -307,66 +261,17 @@ struct BasicParticleSystemWrapper : PointSetWrapper {
 
   bool hasNeighbor(Vec3 pos, Real radius) const
   {
-    bool answer = false;
-    int minI = clamp<int>(floor((pos.x - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxI = clamp<int>(floor((pos.x + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minJ = clamp<int>(floor((pos.y - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxJ = clamp<int>(floor((pos.y + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minK = clamp<int>(floor((pos.z - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxK = clamp<int>(floor((pos.z + radius) / params.res * accel->res), 0, accel->res - 1);
-    for (int i = minI; i <= maxI; i++) {
-      for (int j = minJ; j <= maxJ; j++) {
-        for (int k = minK; k <= maxK; k++) {
-          for (int id = 0; id < (int)accel->indices[i][j][k].size(); id++) {
-            if (points->isActive(accel->indices[i][j][k][id]) &&
-                norm(points->getPos(accel->indices[i][j][k][id]) - pos) <= radius) {
-              answer = true;
-              break;
-            }
-          }
-          if (answer)
-            break;
-        }
-        if (answer)
-          break;
-      }
-      if (answer)
-        break;
-    }
-    return answer;
+    return !accel->grid.forEachCandidate(pos, radius, [&](int id) {
+      return !(points->isActive(id) && norm(points->getPos(id) - pos) <= radius);
+    });
   }
 
   bool hasNeighborOtherThanItself(int idx, Real radius) const
   {
-    bool answer = false;
     Vec3 pos = points->getPos(idx);
-    int minI = clamp<int>(floor((pos.x - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxI = clamp<int>(floor((pos.x + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minJ = clamp<int>(floor((pos.y - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxJ = clamp<int>(floor((pos.y + radius) / params.res * accel->res), 0, accel->res - 1);
-    int minK = clamp<int>(floor((pos.z - radius) / params.res * accel->res), 0, accel->res - 1);
-    int maxK = clamp<int>(floor((pos.z + radius) / params.res * accel->res), 0, accel->res - 1);
-    for (int i = minI; i <= maxI; i++) {
-      for (int j = minJ; j <= maxJ; j++) {
-        for (int k = minK; k <= maxK; k++) {
-          for (int id = 0; id < (int)accel->indices[i][j][k].size(); id++) {
-            if (accel->indices[i][j][k][id] != idx &&
-                points->isActive(accel->indices[i][j][k][id]) &&
-                norm(points->getPos(accel->indices[i][j][k][id]) - pos) <= radius) {
-              answer = true;
-              break;
-            }
-          }
-          if (answer)
-            break;
-        }
-        if (answer)
-          break;
-      }
-      if (answer)
-        break;
-    }
-    return answer;
+    return !accel->grid.forEachCandidate(pos, radius, [&](int id) {
+      return !(id != idx && points->isActive(id) && norm(points->getPos(id) - pos) <= radius);
+    });
   }
 
   void removeInvalidIndices(vector<int> &indices)
@@ -565,6 +470,7 @@ struct advectSurfacePoints : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystemWrapper &surfacePoints,
@@ -612,6 +518,7 @@ struct advectSurfacePoints : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("advectSurfacePoints");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -669,6 +576,7 @@ struct computeSurfaceNormals : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -749,6 +657,7 @@ struct computeSurfaceNormals : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceNormals");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -777,6 +686,7 @@ struct computeAveragedNormals : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -806,6 +716,7 @@ struct computeAveragedNormals : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeAveragedNormals");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -829,6 +740,7 @@ struct assignNormals : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -852,6 +764,7 @@ struct assignNormals : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("assignNormals");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -962,6 +875,7 @@ struct computeSurfaceDensities : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const BasicParticleSystemWrapper &surfacePoints, void *dummy) const
   {
@@ -990,6 +904,7 @@ struct computeSurfaceDensities : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceDensities");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1013,6 +928,7 @@ struct computeSurfaceDisplacements : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1074,6 +990,7 @@ struct computeSurfaceDisplacements : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceDisplacements");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1094,6 +1011,7 @@ struct applySurfaceDisplacements : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, BasicParticleSystemWrapper &surfacePoints, void *dummy) const
   {
@@ -1115,6 +1033,7 @@ struct applySurfaceDisplacements : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("applySurfaceDisplacements");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1149,6 +1068,7 @@ struct constrainSurface : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  BasicParticleSystemWrapper &surfacePoints,
@@ -1185,6 +1105,7 @@ struct constrainSurface : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("constrainSurface");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1214,6 +1135,7 @@ struct interpolateNewWaveData : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1276,6 +1198,7 @@ struct interpolateNewWaveData : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("interpolateNewWaveData");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1341,6 +1264,7 @@ struct addSeed : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1370,6 +1294,7 @@ struct addSeed : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("addSeed");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1396,6 +1321,7 @@ struct computeSurfaceWaveNormal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1470,6 +1396,7 @@ struct computeSurfaceWaveNormal : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceWaveNormal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1496,6 +1423,7 @@ struct computeSurfaceWaveLaplacians : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1567,6 +1495,7 @@ struct computeSurfaceWaveLaplacians : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceWaveLaplacians");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1595,6 +1524,7 @@ struct evolveWave : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1641,6 +1571,7 @@ struct evolveWave : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("evolveWave");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1666,6 +1597,7 @@ struct computeSurfaceCurvature : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1716,6 +1648,7 @@ struct computeSurfaceCurvature : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("computeSurfaceCurvature");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1739,6 +1672,7 @@ struct smoothCurvature : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1774,6 +1708,7 @@ struct smoothCurvature : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("smoothCurvature");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1801,6 +1736,7 @@ struct seedWaves : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  const BasicParticleSystemWrapper &surfacePoints,
@@ -1856,6 +1792,7 @@ struct seedWaves : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("seedWaves");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
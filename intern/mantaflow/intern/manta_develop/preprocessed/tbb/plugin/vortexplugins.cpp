@@ -187,6 +187,7 @@ struct KnAcceleration : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       IndexInt idx, MACGrid &a, const MACGrid &v1, const MACGrid &v0, const Real idt) const
@@ -219,6 +220,7 @@ struct KnAcceleration : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnAcceleration");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -162,6 +162,7 @@ struct KnInterpolateMACGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -213,6 +214,7 @@ struct KnInterpolateMACGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnInterpolateMACGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -311,6 +313,7 @@ struct knApplySimpleNoiseVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -359,6 +362,7 @@ struct knApplySimpleNoiseVec3 : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knApplySimpleNoiseVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -453,6 +457,7 @@ struct knApplySimpleNoiseReal : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -501,6 +506,7 @@ struct knApplySimpleNoiseReal : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knApplySimpleNoiseReal");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -603,6 +609,7 @@ struct knApplyNoiseVec3 : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -700,6 +707,7 @@ struct knApplyNoiseVec3 : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knApplyNoiseVec3");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -832,6 +840,7 @@ struct KnApplyComputeEnergy : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const FlagGrid &flags, const MACGrid &vel, Grid<Real> &energy) const
@@ -864,6 +873,7 @@ struct KnApplyComputeEnergy : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnApplyComputeEnergy");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -1017,6 +1027,7 @@ struct KnComputeStrainRateMag : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, const MACGrid &vel, const Grid<Vec3> &velCenter, Grid<Real> &prod) const
@@ -1062,6 +1073,7 @@ struct KnComputeStrainRateMag : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("KnComputeStrainRateMag");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -37,6 +37,7 @@ struct knCalcSecDeriv2d : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, const Grid<Real> &v, Grid<Real> &ret) const
   {
@@ -59,6 +60,7 @@ struct knCalcSecDeriv2d : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knCalcSecDeriv2d");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -133,6 +135,7 @@ struct knTotalSum : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &h, double &sum)
   {
@@ -157,6 +160,7 @@ struct knTotalSum : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("knTotalSum");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -287,6 +291,7 @@ struct MakeRhsWE : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -340,6 +345,7 @@ struct MakeRhsWE : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("MakeRhsWE");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
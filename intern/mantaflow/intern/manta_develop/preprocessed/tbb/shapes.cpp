@@ -51,6 +51,7 @@ template<class T> struct ApplyShapeToGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, Grid<T> *grid, Shape *shape, T value, FlagGrid *respectFlags) const
@@ -86,6 +87,7 @@ template<class T> struct ApplyShapeToGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyShapeToGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -132,6 +134,7 @@ template<class T> struct ApplyShapeToGridSmooth : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -187,6 +190,7 @@ template<class T> struct ApplyShapeToGridSmooth : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyShapeToGridSmooth");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -228,6 +232,7 @@ struct ApplyShapeToMACGrid : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, MACGrid *grid, Shape *shape, Vec3 value, FlagGrid *respectFlags) const
@@ -267,6 +272,7 @@ struct ApplyShapeToMACGrid : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("ApplyShapeToMACGrid");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -428,6 +434,7 @@ struct BoxSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &phi, const Vec3 &p1, const Vec3 &p2) const
   {
@@ -511,6 +518,7 @@ struct BoxSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("BoxSDF");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -646,6 +654,7 @@ struct SphereSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i, int j, int k, Grid<Real> &phi, Vec3 center, Real radius, Vec3 scale) const
   {
@@ -677,6 +686,7 @@ struct SphereSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SphereSDF");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -772,6 +782,7 @@ struct CylinderSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(
       int i, int j, int k, Grid<Real> &phi, Vec3 center, Real radius, Vec3 zaxis, Real maxz) const
@@ -826,6 +837,7 @@ struct CylinderSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("CylinderSDF");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -919,6 +931,7 @@ struct SlopeSDF : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(int i,
                  int j,
@@ -957,6 +970,7 @@ struct SlopeSDF : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("SlopeSDF");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
@@ -32,6 +32,7 @@ struct reductionTest : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &v, double &sum)
   {
@@ -56,6 +57,7 @@ struct reductionTest : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("reductionTest");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -82,6 +84,7 @@ struct minReduction : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx, const Grid<Real> &v, double &sum)
   {
@@ -107,6 +110,7 @@ struct minReduction : public KernelBase {
     debMsg("Kernel range"
                << " x " << maxX << " y " << maxY << " z " << minZ << " - " << maxZ << " ",
            4);
+    profileBegin("minReduction");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r)
   {
@@ -17,7 +17,29 @@
  ******************************************************************************/
 
 #include "timing.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#if defined(WIN32) || defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+#if OPENMP == 1
+#  include <omp.h>
+#endif
 
 using namespace std;
 namespace Manta {
@@ -125,4 +147,263 @@ void TimingData::saveMean(const string &filename)
   ofs.close();
 }
 
+//******************************************************************************
+// ProfileData
+
+static const int PROFILE_MAX_DEPTH = 64;
+
+struct ProfileData::ThreadBuffer {
+  int thread;
+  std::vector<Scope> ring;
+  // total number of scopes written, ring index is written % size. Published with release
+  // after the scope is stored, readers acquire it
+  std::atomic<uint64_t> written;
+  uint64_t summarized;  // scopes before this one were already summarized
+  int depth;
+  Scope open[PROFILE_MAX_DEPTH];
+  std::set<std::string> names;  // plugin names of this thread, the scopes point into this set
+};
+
+std::atomic<bool> ProfileData::sEnabled(false);
+thread_local ProfileData::ThreadBuffer *ProfileData::sBuffer = nullptr;
+
+static inline int64_t profileWallTime()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+//! cpu time of the whole process in ns, i.e. summed over all threads. Thread pools keep idle
+//! workers spinning for a while, which is counted as well
+static inline int64_t profileCpuTime()
+{
+#if defined(WIN32) || defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+    return 0;
+  ULARGE_INTEGER k, u;
+  k.LowPart = kernel.dwLowDateTime;
+  k.HighPart = kernel.dwHighDateTime;
+  u.LowPart = user.dwLowDateTime;
+  u.HighPart = user.dwHighDateTime;
+  return (int64_t)(k.QuadPart + u.QuadPart) * 100;
+#else
+  timespec t;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t) != 0)
+    return 0;
+  return (int64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+ProfileData::ProfileData() : mBufferSize(65536), mThreads(1), mEpoch(profileWallTime())
+{
+}
+
+void ProfileData::enable(bool on, int bufferSize)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (on) {
+    mBufferSize = std::max(bufferSize, 16);
+#if OPENMP == 1
+    mThreads = omp_get_max_threads();
+#else
+    mThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+#endif
+    mEpoch = profileWallTime();
+    for (size_t i = 0; i < mBuffers.size(); i++) {
+      mBuffers[i]->ring.assign(mBufferSize, Scope());
+      mBuffers[i]->written = 0;
+      mBuffers[i]->summarized = 0;
+      mBuffers[i]->depth = 0;
+    }
+  }
+  sEnabled = on;
+}
+
+ProfileData::ThreadBuffer *ProfileData::threadBuffer()
+{
+  if (!sBuffer) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    ThreadBuffer *b = new ThreadBuffer();
+    b->thread = (int)mBuffers.size();
+    b->ring.assign(mBufferSize, Scope());
+    b->written = 0;
+    b->summarized = 0;
+    b->depth = 0;
+    mBuffers.push_back(b);  // never freed, summaries may still read it after the thread exits
+    sBuffer = b;
+  }
+  return sBuffer;
+}
+
+void ProfileData::begin(const char *name, bool kernel, IndexInt range)
+{
+  ThreadBuffer *b = threadBuffer();
+  if (b->depth < PROFILE_MAX_DEPTH) {
+    Scope &s = b->open[b->depth];
+    s.name = name;
+    s.kernel = kernel;
+    s.depth = b->depth;
+    s.range = range;
+    s.child = 0;
+    s.cpu = profileCpuTime();
+    s.begin = profileWallTime() - mEpoch;
+  }
+  b->depth++;
+}
+
+void ProfileData::end()
+{
+  const int64_t now = profileWallTime() - mEpoch;
+  ThreadBuffer *b = threadBuffer();
+  if (b->depth == 0)
+    return;
+  b->depth--;
+  if (b->depth >= PROFILE_MAX_DEPTH)
+    return;
+  Scope s = b->open[b->depth];
+  s.end = now;
+  s.cpu = profileCpuTime() - s.cpu;
+  if (b->depth > 0 && b->depth <= PROFILE_MAX_DEPTH)
+    b->open[b->depth - 1].child += s.end - s.begin;
+  const uint64_t written = b->written.load(std::memory_order_relaxed);
+  b->ring[written % b->ring.size()] = s;
+  b->written.store(written + 1, std::memory_order_release);
+}
+
+void ProfileData::beginPlugin(const string &name)
+{
+  // only the first call of a plugin on this thread allocates, buffers and names are never freed
+  ThreadBuffer *b = threadBuffer();
+  begin(b->names.insert(name).first->c_str(), false, 0);
+}
+
+void ProfileData::endPlugin(const string &name)
+{
+  // close everything up to the matching plugin, scopes of plugins that failed may still be open
+  ThreadBuffer *b = threadBuffer();
+  for (int d = std::min(b->depth, PROFILE_MAX_DEPTH) - 1; d >= 0; d--) {
+    if (!b->open[d].kernel && name == b->open[d].name) {
+      while (b->depth > d)
+        end();
+      return;
+    }
+  }
+}
+
+void ProfileData::beginKernel(const char *name, IndexInt range)
+{
+  begin(name, true, range);
+}
+
+void ProfileData::endKernel()
+{
+  end();
+}
+
+//! copy scope n of a buffer, fails if its thread may have started to overwrite the slot
+bool ProfileData::readScope(ThreadBuffer *b, uint64_t n, Scope &s)
+{
+  const uint64_t size = b->ring.size();
+  s = b->ring[n % size];
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return b->written.load(std::memory_order_relaxed) < n + size;
+}
+
+vector<ProfileData::Summary> ProfileData::summary(bool reset)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  std::map<std::string, Summary> sums;
+  std::map<std::string, double> ranges, cpu;
+  for (size_t i = 0; i < mBuffers.size(); i++) {
+    ThreadBuffer *b = mBuffers[i];
+    const uint64_t size = b->ring.size();
+    const uint64_t written = b->written.load(std::memory_order_acquire);
+    uint64_t first = std::max(b->summarized, written > size ? written - size : 0);
+    for (uint64_t n = first; n < written; n++) {
+      Scope s;
+      if (!readScope(b, n, s))
+        continue;
+      const std::string key = string(s.kernel ? "K" : "P") + s.name;
+      Summary &sum = sums[key];
+      if (sum.calls == 0) {
+        sum.name = s.name;
+        sum.kernel = s.kernel;
+      }
+      sum.calls++;
+      sum.total += (s.end - s.begin) * 1e-6;
+      sum.self += (s.end - s.begin - s.child) * 1e-6;
+      ranges[key] += (double)s.range;
+      cpu[key] += s.cpu * 1e-6;
+    }
+    if (reset)
+      b->summarized = written;
+  }
+
+  vector<Summary> result;
+  for (std::map<std::string, Summary>::iterator it = sums.begin(); it != sums.end(); it++) {
+    Summary &sum = it->second;
+    sum.range = (IndexInt)(ranges[it->first] / sum.calls);
+    sum.utilization = (sum.total > 0) ? std::min(cpu[it->first] / (sum.total * mThreads), 1.0) :
+                                        0.;
+    result.push_back(sum);
+  }
+  std::sort(result.begin(), result.end(), [](const Summary &a, const Summary &b) {
+    return a.total > b.total;
+  });
+  return result;
+}
+
+string ProfileData::summaryString(bool reset)
+{
+  vector<Summary> sums = summary(reset);
+  std::ostringstream out;
+  char line[512];
+  snprintf(line, sizeof(line), "%-40s %8s %12s %12s %6s %12s\n", "Scope", "Calls", "Total ms",
+           "Self ms", "Util", "Range");
+  out << line;
+  for (size_t i = 0; i < sums.size(); i++) {
+    const Summary &s = sums[i];
+    snprintf(line, sizeof(line), "%-40s %8d %12.3f %12.3f %5.0f%% %12lld\n",
+             (string(s.kernel ? "  " : "") + s.name).c_str(), s.calls, s.total, s.self,
+             100. * s.utilization, (long long)s.range);
+    out << line;
+  }
+  return out.str();
+}
+
+void ProfileData::saveTrace(const string &filename)
+{
+  ofstream ofs(filename.c_str());
+  if (!ofs.good())
+    errMsg("can't open " + filename + " as profiler trace");
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  char event[512];
+  for (size_t i = 0; i < mBuffers.size(); i++) {
+    ThreadBuffer *b = mBuffers[i];
+    const uint64_t size = b->ring.size();
+    const uint64_t written = b->written.load(std::memory_order_acquire);
+    for (uint64_t n = (written > size ? written - size : 0); n < written; n++) {
+      Scope s;
+      if (!readScope(b, n, s))
+        continue;
+      const double wall = (double)(s.end - s.begin);
+      const double util = wall > 0 ? std::min(s.cpu / (wall * mThreads), 1.0) : 0.;
+      // names are C++ identifiers, no json escaping needed
+      snprintf(event, sizeof(event),
+               "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+               "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"range\":%lld,\"utilization\":%.3f}}",
+               first ? "" : ",", s.name, s.kernel ? "kernel" : "plugin", b->thread,
+               s.begin * 1e-3, wall * 1e-3, (long long)s.range, util);
+      ofs << event;
+      first = false;
+    }
+  }
+  ofs << "\n]}\n";
+}
+
 }  // namespace Manta
@@ -125,6 +125,7 @@ struct KnSynthesizeTurbulence : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   inline void op(IndexInt idx,
                  TurbulenceParticleSystem &p,
@@ -223,6 +224,7 @@ struct KnSynthesizeTurbulence : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnSynthesizeTurbulence");
   };
   void operator()(const tbb::blocked_range<IndexInt> &__r) const
   {
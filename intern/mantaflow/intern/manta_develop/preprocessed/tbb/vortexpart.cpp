@@ -105,6 +105,7 @@ struct KnVpAdvectMesh : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   void run()
   {
@@ -139,6 +140,7 @@ struct KnVpAdvectMesh : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnVpAdvectMesh");
   };
   _KnVpAdvectMesh _inner;
   vector<Node> &nodes;
@@ -185,6 +187,7 @@ struct KnVpAdvectSelf : public KernelBase {
   {
     runMessage();
     run();
+    profileEnd();
   }
   void run()
   {
@@ -214,6 +217,7 @@ struct KnVpAdvectSelf : public KernelBase {
     debMsg("Kernel range"
                << " size " << size << " ",
            4);
+    profileBegin("KnVpAdvectSelf");
   };
   _KnVpAdvectSelf _inner;
   vector<VortexParticleData> &vp;
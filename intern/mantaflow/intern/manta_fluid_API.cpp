@@ -152,6 +152,13 @@ extern "C" int manta_update_particle_structures(MANTA *fluid, MantaModifierData
   return fluid->updateParticleStructures(mmd, framenr);
 }
 
+extern "C" void manta_flush_cache_writes(MANTA *fluid)
+{
+  if (!fluid)
+    return;
+  fluid->flushCacheWrites();
+}
+
 extern "C" int manta_bake_data(MANTA *fluid, MantaModifierData *mmd, int framenr)
 {
   if (!fluid || !mmd)
@@ -213,6 +220,12 @@ extern "C" void manta_adapt_timestep(MANTA *fluid)
     fluid->adaptTimestep();
 }
 
+extern "C" void manta_reset_pressure_warm_start(MANTA *fluid)
+{
+  if (fluid)
+    fluid->resetPressureWarmStart();
+}
+
 extern "C" bool manta_needs_realloc(MANTA *fluid, MantaModifierData *mmd)
 {
   if (fluid)
@@ -686,6 +699,11 @@ extern "C" void manta_smoke_turbulence_get_res(MANTA *smoke, int *res)
     res[2] = smoke->getResZHigh();
   }
 }
+extern "C" void manta_smoke_turbulence_set_uv_offset(MANTA *smoke, const int *res_min)
+{
+  if (smoke && smoke->usingNoise())
+    smoke->setNoiseUvOffset(res_min);
+}
 extern "C" int manta_smoke_turbulence_get_cells(MANTA *smoke)
 {
   int total_cells_high = smoke->getResXHigh() * smoke->getResYHigh() * smoke->getResZHigh();
@@ -809,6 +827,35 @@ extern "C" float manta_liquid_get_vertvel_z_at(MANTA *liquid, int i)
   return liquid->getVertVelZAt(i);
 }
 
+extern "C" int manta_liquid_get_num_vertvels(MANTA *liquid)
+{
+  return liquid->getNumVertVels();
+}
+extern "C" const float *manta_liquid_get_vertices(MANTA *liquid, int *r_stride)
+{
+  const MANTA::Node *nodes = liquid->getMeshNodes();
+  *r_stride = sizeof(MANTA::Node);
+  return (nodes) ? nodes->pos : NULL;
+}
+extern "C" const float *manta_liquid_get_normals(MANTA *liquid, int *r_stride)
+{
+  const MANTA::Node *nodes = liquid->getMeshNodes();
+  *r_stride = sizeof(MANTA::Node);
+  return (nodes) ? nodes->normal : NULL;
+}
+extern "C" const int *manta_liquid_get_triangles(MANTA *liquid, int *r_stride)
+{
+  const MANTA::Triangle *triangles = liquid->getMeshTriangles();
+  *r_stride = sizeof(MANTA::Triangle);
+  return (triangles) ? triangles->c : NULL;
+}
+extern "C" const float *manta_liquid_get_vertvels(MANTA *liquid, int *r_stride)
+{
+  const MANTA::pVel *velocities = liquid->getMeshVelocities();
+  *r_stride = sizeof(MANTA::pVel);
+  return (velocities) ? velocities->pos : NULL;
+}
+
 extern "C" int manta_liquid_get_num_flip_particles(MANTA *liquid)
 {
   return liquid->getNumFlipParticles();
@@ -39,7 +39,8 @@ from manta import *\n\
 import os.path, shutil, math, sys, gc, multiprocessing, platform, time\n\
 \n\
 withMPBake = False # Bake files asynchronously\n\
-withMPSave = True # Save files asynchronously\n\
+withMPSave = False # Save files asynchronously in a forked process\n\
+withAsyncSave = True # Save files asynchronously on writer threads (grids and particles only)\n\
 isWindows = platform.system() != 'Darwin' and platform.system() != 'Linux'\n\
 # TODO (sebbas): Use this to simulate Windows multiprocessing (has default mode spawn)\n\
 #try:\n\
@@ -116,6 +117,8 @@ using_invel_s$ID$        = $USING_INVEL$\n\
 using_outflow_s$ID$      = $USING_OUTFLOW$\n\
 using_sndparts_s$ID$     = $USING_SNDPARTS$\n\
 using_speedvectors_s$ID$ = $USING_SPEEDVECTORS$\n\
+using_warmstart_s$ID$    = $USING_PRESSURE_WARMSTART$\n\
+using_compactmat_s$ID$   = $USING_COMPACT_MATRIX$\n\
 \n\
 # Fluid time params\n\
 timeTotal_s$ID$    = $TIME_TOTAL$\n\
@@ -389,6 +392,12 @@ def fluid_post_step_$ID$():\n\
 const std::string fluid_delete_all =
     "\n\
 mantaMsg('Deleting fluid')\n\
+# Pending writes still reference the solvers, finish them first\n\
+mantaMsg('Flush pending cache writes')\n\
+try:\n\
+    flushAsyncWrites()\n\
+except Exception as e:\n\
+    mantaMsg(str(e))\n\
 # Clear all helper dictionaries first\n\
 mantaMsg('Clear helper dictionaries')\n\
 if 'liquid_data_dict_s$ID$' in globals(): liquid_data_dict_s$ID$.clear()\n\
@@ -598,6 +607,11 @@ def bake_guiding_$ID$(path_guiding, framenr, format_guiding):\n\
 const std::string fluid_file_import =
     "\n\
 def fluid_file_import_s$ID$(dict, path, framenr, file_format):\n\
+    # Files that are still queued for writing must be on disk before loading\n\
+    try:\n\
+        flushAsyncWrites()\n\
+    except Exception as e:\n\
+        mantaMsg(str(e))\n\
     try:\n\
         framenr = fluid_cache_get_framenr_formatted_$ID$(framenr)\n\
         for name, object in dict.items():\n\
@@ -645,7 +659,7 @@ def fluid_load_vel_$ID$(path, framenr, file_format):\n\
 
 const std::string fluid_file_export =
     "\n\
-def fluid_file_export_s$ID$(framenr, file_format, path, dict, mode_override=True, skip_subframes=True):\n\
+def fluid_file_export_s$ID$(framenr, file_format, path, dict, mode_override=True, skip_subframes=True, quantize=(), max_error=0):\n\
     if skip_subframes and ((timePerFrame_s$ID$ + dt0_s$ID$) < frameLength_s$ID$):\n\
         return\n\
     mantaMsg('Fluid file export, frame: ' + str(framenr))\n\
@@ -655,7 +669,11 @@ def fluid_file_export_s$ID$(framenr, file_format, path, dict, mode_override=True
             os.makedirs(path)\n\
         for name, object in dict.items():\n\
             file = os.path.join(path, name + '_' + framenr + file_format)\n\
-            if not os.path.isfile(file) or mode_override: object.save(file)\n\
+            if not os.path.isfile(file) or mode_override:\n\
+                error = max_error if name in quantize else 0 # lossy channels, chunked format only\n\
+                if withAsyncSave and saveAsync(obj=object, name=file, maxError=error): continue\n\
+                if error > 0: saveQuantized(grid=object, name=file, maxError=error)\n\
+                else: object.save(file)\n\
     except Exception as e:\n\
         mantaMsg(str(e))\n\
         pass # Just skip file save errors for now\n";
@@ -51,7 +51,9 @@ concaveLower_s$ID$     = $MESH_CONCAVE_LOWER$\n\
 smoothenPos_s$ID$      = $MESH_SMOOTHEN_POS$\n\
 smoothenNeg_s$ID$      = $MESH_SMOOTHEN_NEG$\n\
 randomness_s$ID$       = $PARTICLE_RANDOMNESS$\n\
-surfaceTension_s$ID$   = $LIQUID_SURFACE_TENSION$\n";
+surfaceTension_s$ID$   = $LIQUID_SURFACE_TENSION$\n\
+sortInterval_s$ID$     = 0 # frames between tile sorts of the FLIP particles, 0 (default) disables, opt-in until a gain is measured\n\
+lastSortFrame_s$ID$    = -sortInterval_s$ID$\n";
 
 const std::string liquid_variables_particles =
     "\n\
@@ -147,6 +149,7 @@ phiIn_s$ID$.initFromFlags(flags_s$ID$)\n";
 const std::string liquid_adaptive_step =
     "\n\
 def liquid_adaptive_step_$ID$(framenr):\n\
+    global lastSortFrame_s$ID$\n\
     mantaMsg('Manta step, frame ' + str(framenr))\n\
     s$ID$.frame = framenr\n\
     \n\
@@ -190,6 +193,12 @@ def liquid_adaptive_step_$ID$(framenr):\n\
     sampleLevelsetWithParticles(phi=phiIn_s$ID$, flags=flags_s$ID$, parts=pp_s$ID$, discretization=particleNumber_s$ID$, randomness=randomness_s$ID$)\n\
     flags_s$ID$.updateFromLevelset(phi_s$ID$)\n\
     \n\
+    # keep particles of the same 8^3 tile together in memory, also drops deleted particles\n\
+    if sortInterval_s$ID$ > 0 and abs(framenr - lastSortFrame_s$ID$) >= sortInterval_s$ID$:\n\
+        mantaMsg('Sorting particles')\n\
+        sortParticlesByTile(parts=pp_s$ID$, flags=flags_s$ID$)\n\
+        lastSortFrame_s$ID$ = framenr\n\
+    \n\
     mantaMsg('Liquid step / s$ID$.frame: ' + str(s$ID$.frame))\n\
     liquid_step_$ID$()\n\
     \n\
@@ -269,7 +278,7 @@ def liquid_step_$ID$():\n\
         PD_fluid_guiding(vel=vel_s$ID$, velT=velT_s$ID$, flags=flags_s$ID$, phi=phi_s$ID$, curv=curvature_s$ID$, surfTens=surfaceTension_s$ID$, fractions=fractions_s$ID$, weight=weightGuide_s$ID$, blurRadius=beta_sg$ID$, pressure=pressure_s$ID$, tau=tau_sg$ID$, sigma=sigma_sg$ID$, theta=theta_sg$ID$, zeroPressureFixing=not doOpen_s$ID$)\n\
     else:\n\
         mantaMsg('Pressure')\n\
-        solvePressure(flags=flags_s$ID$, vel=vel_s$ID$, pressure=pressure_s$ID$, phi=phi_s$ID$, curv=curvature_s$ID$, surfTens=surfaceTension_s$ID$)#, fractions=fractions_s$ID$)\n\
+        solvePressure(flags=flags_s$ID$, vel=vel_s$ID$, pressure=pressure_s$ID$, phi=phi_s$ID$, curv=curvature_s$ID$, surfTens=surfaceTension_s$ID$, warmStart=using_warmstart_s$ID$, compactMatrix=using_compactmat_s$ID$)#, fractions=fractions_s$ID$)\n\
     \n\
     extrapolateMACSimple(flags=flags_s$ID$, vel=vel_s$ID$, distance=4) #, intoObs=True) # TODO (sebbas): uncomment for fraction support\n\
     setWallBcs(flags=flags_s$ID$, vel=vel_s$ID$, obvel=obvel_s$ID$ if using_obstacle_s$ID$ else None, phiObs=phiObs_s$ID$)#, fractions=fractions_s$ID$)\n\
@@ -46,7 +46,9 @@ buoyancy_dens_s$ID$     = float($BUOYANCY_ALPHA$) / float($FLUID_DOMAIN_SIZE$)\n
 buoyancy_heat_s$ID$     = float($BUOYANCY_BETA$) / float($FLUID_DOMAIN_SIZE$)\n\
 dissolveSpeed_s$ID$     = $DISSOLVE_SPEED$\n\
 using_logdissolve_s$ID$ = $USING_LOG_DISSOLVE$\n\
-using_dissolve_s$ID$    = $USING_DISSOLVE$\n";
+using_dissolve_s$ID$    = $USING_DISSOLVE$\n\
+quantize_s$ID$          = $QUANTIZE_CHANNELS$ # channels cached with lossy quantization\n\
+quantize_error_s$ID$    = $QUANTIZE_ERROR$\n";
 
 const std::string smoke_variables_noise =
     "\n\
@@ -305,23 +307,16 @@ def smoke_step_$ID$():\n\
         mantaMsg('Dissolving smoke')\n\
         dissolveSmoke(flags=flags_s$ID$, density=density_s$ID$, heat=heat_s$ID$, red=color_r_s$ID$, green=color_g_s$ID$, blue=color_b_s$ID$, speed=dissolveSpeed_s$ID$, logFalloff=using_logdissolve_s$ID$)\n\
     \n\
-    mantaMsg('Advecting density')\n\
-    advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=density_s$ID$, order=2)\n\
-    \n\
+    # all scalar grids share the velocity field, advect them in one batch\n\
+    advectGrids_s$ID$ = [density_s$ID$]\n\
     if using_heat_s$ID$:\n\
-        mantaMsg('Advecting heat')\n\
-        advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=heat_s$ID$, order=2)\n\
-    \n\
+        advectGrids_s$ID$.append(heat_s$ID$)\n\
     if using_fire_s$ID$:\n\
-        mantaMsg('Advecting fire')\n\
-        advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=fuel_s$ID$, order=2)\n\
-        advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=react_s$ID$, order=2)\n\
-    \n\
+        advectGrids_s$ID$.extend([fuel_s$ID$, react_s$ID$])\n\
     if using_colors_s$ID$:\n\
-        mantaMsg('Advecting colors')\n\
-        advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=color_r_s$ID$, order=2)\n\
-        advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=color_g_s$ID$, order=2)\n\
-        advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=color_b_s$ID$, order=2)\n\
+        advectGrids_s$ID$.extend([color_r_s$ID$, color_g_s$ID$, color_b_s$ID$])\n\
+    mantaMsg('Advecting density, heat, fire and colors')\n\
+    advectSemiLagrangeMulti(flags=flags_s$ID$, vel=vel_s$ID$, grids=advectGrids_s$ID$, order=2)\n\
     \n\
     mantaMsg('Advecting velocity')\n\
     advectSemiLagrange(flags=flags_s$ID$, vel=vel_s$ID$, grid=vel_s$ID$, order=2)\n\
@@ -361,7 +356,7 @@ def smoke_step_$ID$():\n\
         PD_fluid_guiding(vel=vel_s$ID$, velT=velT_s$ID$, flags=flags_s$ID$, weight=weightGuide_s$ID$, blurRadius=beta_sg$ID$, pressure=pressure_s$ID$, tau=tau_sg$ID$, sigma=sigma_sg$ID$, theta=theta_sg$ID$, preconditioner=preconditioner_s$ID$, zeroPressureFixing=not doOpen_s$ID$)\n\
     else:\n\
         mantaMsg('Pressure')\n\
-        solvePressure(flags=flags_s$ID$, vel=vel_s$ID$, pressure=pressure_s$ID$, preconditioner=preconditioner_s$ID$, zeroPressureFixing=not doOpen_s$ID$) # closed domains require pressure fixing\n\
+        solvePressure(flags=flags_s$ID$, vel=vel_s$ID$, pressure=pressure_s$ID$, preconditioner=preconditioner_s$ID$, zeroPressureFixing=not doOpen_s$ID$, warmStart=using_warmstart_s$ID$, compactMatrix=using_compactmat_s$ID$) # closed domains require pressure fixing\n\
 \n\
 def process_burn_$ID$():\n\
     mantaMsg('Process burn')\n\
@@ -462,19 +457,13 @@ def step_noise_$ID$():\n\
         sPos_s$ID$ *= 2.0 \n\
     \n\
     for substep in range(int(upres_sn$ID$)):\n\
+        advectGrids_sn$ID$ = [density_sn$ID$]\n\
         if using_colors_s$ID$: \n\
-            mantaMsg('Advecting colors noise')\n\
-            advectSemiLagrange(flags=flags_sn$ID$, vel=vel_sn$ID$, grid=color_r_sn$ID$, order=2)\n\
-            advectSemiLagrange(flags=flags_sn$ID$, vel=vel_sn$ID$, grid=color_g_sn$ID$, order=2)\n\
-            advectSemiLagrange(flags=flags_sn$ID$, vel=vel_sn$ID$, grid=color_b_sn$ID$, order=2)\n\
-        \n\
+            advectGrids_sn$ID$.extend([color_r_sn$ID$, color_g_sn$ID$, color_b_sn$ID$])\n\
         if using_fire_s$ID$: \n\
-            mantaMsg('Advecting fire noise')\n\
-            advectSemiLagrange(flags=flags_sn$ID$, vel=vel_sn$ID$, grid=fuel_sn$ID$, order=2)\n\
-            advectSemiLagrange(flags=flags_sn$ID$, vel=vel_sn$ID$, grid=react_sn$ID$, order=2)\n\
-        \n\
-        mantaMsg('Advecting density noise')\n\
-        advectSemiLagrange(flags=flags_sn$ID$, vel=vel_sn$ID$, grid=density_sn$ID$, order=2)\n\
+            advectGrids_sn$ID$.extend([fuel_sn$ID$, react_sn$ID$])\n\
+        mantaMsg('Advecting density, colors and fire noise')\n\
+        advectSemiLagrangeMulti(flags=flags_sn$ID$, vel=vel_sn$ID$, grids=advectGrids_sn$ID$, order=2)\n\
 \n\
 def process_burn_noise_$ID$():\n\
     mantaMsg('Process burn noise')\n\
@@ -510,7 +499,7 @@ def smoke_save_data_$ID$(path, framenr, file_format):\n\
     mantaMsg('Smoke save data')\n\
     start_time = time.time()\n\
     if not withMPSave or isWindows:\n\
-        fluid_file_export_s$ID$(framenr=framenr, file_format=file_format, path=path, dict=smoke_data_dict_s$ID$,)\n\
+        fluid_file_export_s$ID$(framenr=framenr, file_format=file_format, path=path, dict=smoke_data_dict_s$ID$, quantize=quantize_s$ID$, max_error=quantize_error_s$ID$)\n\
     else:\n\
         fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=smoke_data_dict_s$ID$, do_join=False)\n\
     mantaMsg('--- Save: %s seconds ---' % (time.time() - start_time))\n";
@@ -520,7 +509,7 @@ const std::string smoke_save_noise =
 def smoke_save_noise_$ID$(path, framenr, file_format):\n\
     mantaMsg('Smoke save noise')\n\
     if not withMPSave or isWindows:\n\
-        fluid_file_export_s$ID$(dict=smoke_noise_dict_s$ID$, framenr=framenr, file_format=file_format, path=path)\n\
+        fluid_file_export_s$ID$(dict=smoke_noise_dict_s$ID$, framenr=framenr, file_format=file_format, path=path, quantize=quantize_s$ID$, max_error=quantize_error_s$ID$)\n\
     else:\n\
         fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=smoke_noise_dict_s$ID$, do_join=False)\n";
 
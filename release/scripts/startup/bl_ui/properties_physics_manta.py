@@ -152,6 +152,8 @@ class PHYSICS_PT_manta_fluid(PhysicButtonsPanel, Panel):
             col.prop(domain, "use_adaptive_stepping", text="Use Adaptive Stepping")
             col.prop(domain, "time_scale", text="Time Scale")
             col.prop(domain, "cfl_condition", text="CFL Number")
+            col.prop(domain, "use_pressure_warm_start", text="Warm Start Pressure")
+            col.prop(domain, "use_pressure_compact_matrix", text="Compact Pressure Matrix")
 
             col.separator()
 
@@ -1027,6 +1029,17 @@ class PHYSICS_PT_manta_cache(PhysicButtonsPanel, Panel):
             if domain.use_noise:
                 col.prop(domain, "cache_noise_format", text="Noise file format")
 
+            # Lossy quantization is only supported by the chunked cache format
+            if domain.cache_data_format == 'CHUNKED' or (domain.use_noise and domain.cache_noise_format == 'CHUNKED'):
+                col.separator()
+                col.prop(domain, "use_quantize_density", text="Quantize Density")
+                col.prop(domain, "use_quantize_heat", text="Heat")
+                col.prop(domain, "use_quantize_fire", text="Fire")
+                col.prop(domain, "use_quantize_colors", text="Colors")
+                sub = col.column()
+                sub.active = domain.use_quantize_density or domain.use_quantize_heat or domain.use_quantize_fire or domain.use_quantize_colors
+                sub.prop(domain, "cache_quantize_error", text="Max Error")
+
         if md.domain_settings.domain_type in {'LIQUID'}:
             # File format for all particle systemes (FLIP and secondary)
             col.prop(domain, "cache_particle_format", text="Particle file format")
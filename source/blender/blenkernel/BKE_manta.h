@@ -28,9 +28,6 @@ struct Scene;
 struct MantaDomainSettings;
 struct MantaModifierData;
 
-typedef float (*bresenham_callback)(
-    float *result, float *input, int res[3], int *pixel, float *tRay, float correct);
-
 struct Mesh *mantaModifier_do(struct MantaModifierData *mmd,
                               struct Depsgraph *depsgraph,
                               struct Scene *scene,
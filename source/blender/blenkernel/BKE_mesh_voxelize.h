@@ -0,0 +1,82 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) Blender Foundation.
+ * All rights reserved.
+ */
+
+#ifndef __BKE_MESH_VOXELIZE_H__
+#define __BKE_MESH_VOXELIZE_H__
+
+/** \file
+ * \ingroup bke
+ *
+ * Narrow band voxelization of triangle meshes by scan conversion: every triangle writes exact
+ * distances to the cells around it, inside/outside comes from ray crossings along the grid axes.
+ * Mesh coordinates are in grid space, the sample of cell (x, y, z) sits at
+ * ((x + 0.5) * cell_size, (y + 0.5) * cell_size, (z + 0.5) * cell_size).
+ */
+
+struct MLoop;
+struct MLoopTri;
+struct MVert;
+
+typedef struct MeshVoxelGrid {
+  /* Cells min .. min + res - 1 are sampled, arrays are indexed x-fastest relative to min. */
+  int min[3], res[3];
+  float cell_size;
+  /* Narrow band width, in the units of the mesh coordinates. */
+  float band;
+
+  /* Distance to the nearest triangle for cells closer than band, FLT_MAX elsewhere. */
+  float *dist;
+  /* Nearest looptri for cells closer than band, -1 elsewhere. */
+  int *tri;
+  /* Vertex velocity interpolated at the nearest point (only with vert_vel, 3 floats per cell). */
+  float *velocity;
+  /* Non-zero for cells inside the mesh (only with MESH_VOXELIZE_INSIDE). */
+  unsigned char *inside;
+} MeshVoxelGrid;
+
+enum {
+  /* Classify all cells as inside or outside. */
+  MESH_VOXELIZE_INSIDE = (1 << 0),
+};
+
+MeshVoxelGrid *BKE_mesh_voxelize(const struct MVert *mvert,
+                                 const struct MLoop *mloop,
+                                 const struct MLoopTri *looptri,
+                                 const int looptri_len,
+                                 const float *vert_vel,
+                                 const int min[3],
+                                 const int res[3],
+                                 const float cell_size,
+                                 const float band,
+                                 const int flag);
+void BKE_mesh_voxel_grid_free(MeshVoxelGrid *grid);
+
+int BKE_mesh_voxel_grid_index(const MeshVoxelGrid *grid, int x, int y, int z);
+void BKE_mesh_voxel_grid_sample_co(const MeshVoxelGrid *grid, int x, int y, int z, float r_co[3]);
+bool BKE_mesh_voxel_grid_nearest(const MeshVoxelGrid *grid,
+                                 const struct MVert *mvert,
+                                 const struct MLoop *mloop,
+                                 const struct MLoopTri *looptri,
+                                 int x,
+                                 int y,
+                                 int z,
+                                 float r_co[3],
+                                 float r_weights[3]);
+
+#endif /* __BKE_MESH_VOXELIZE_H__ */
@@ -32,7 +32,6 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
-#include "BLI_kdopbvh.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -52,7 +51,6 @@
 #include "BKE_appdir.h"
 #include "BKE_animsys.h"
 #include "BKE_armature.h"
-#include "BKE_bvhutils.h"
 #include "BKE_collision.h"
 #include "BKE_colortools.h"
 #include "BKE_constraint.h"
@@ -62,6 +60,7 @@
 #include "BKE_library.h"
 #include "BKE_mesh.h"
 #include "BKE_mesh_runtime.h"
+#include "BKE_mesh_voxelize.h"
 #include "BKE_modifier.h"
 #include "BKE_object.h"
 #include "BKE_particle.h"
@@ -123,6 +122,88 @@ void BKE_manta_reallocate_fluid(MantaDomainSettings *mds, int res[3], int free_o
   mds->res_noise[2] = res[2] * mds->noise_scale;
 }
 
+/* Copy the cells lo .. hi - 1 of dst from src, where dst cell c reads src cell c + offset.
+ * Rows are moved with memmove, in an order that also allows shifting within one grid. */
+static void manta_grid_copy_box(float *dst,
+                                const int dst_res[3],
+                                const float *src,
+                                const int src_res[3],
+                                const int lo[3],
+                                const int hi[3],
+                                const int offset[3])
+{
+  if (lo[0] >= hi[0] || lo[1] >= hi[1] || lo[2] >= hi[2]) {
+    return;
+  }
+  const size_t row_size = sizeof(float) * (size_t)(hi[0] - lo[0]);
+  const int rows_y = hi[1] - lo[1];
+  const int rows = rows_y * (hi[2] - lo[2]);
+  /* Moving towards higher indices within one grid: go backwards so that no row is
+   * overwritten before it was read. */
+  const bool backwards = (dst == src) &&
+                         (offset[0] + dst_res[0] * (offset[1] + dst_res[1] * offset[2]) < 0);
+
+  for (int r = 0; r < rows; r++) {
+    const int row = backwards ? rows - 1 - r : r;
+    const int y = lo[1] + row % rows_y;
+    const int z = lo[2] + row / rows_y;
+    memmove(&dst[manta_get_index(lo[0], dst_res[0], y, dst_res[1], z)],
+            &src[manta_get_index(
+                lo[0] + offset[0], src_res[0], y + offset[1], src_res[1], z + offset[2])],
+            row_size);
+  }
+}
+
+/* Reset all cells of grid outside of lo .. hi - 1 to the values of a freshly allocated grid:
+ * zero, or for texture coordinates (axis >= 0) the cell coordinate along axis plus base. */
+static void manta_grid_clear_outside(
+    float *grid, const int res[3], const int lo[3], const int hi[3], int axis, float base)
+{
+  for (int z = 0; z < res[2]; z++) {
+    for (int y = 0; y < res[1]; y++) {
+      const bool row_inside = lo[0] < hi[0] && y >= lo[1] && y < hi[1] && z >= lo[2] &&
+                              z < hi[2];
+      float *row = &grid[manta_get_index(0, res[0], y, res[1], z)];
+
+      for (int x = 0; x < res[0]; x++) {
+        if (row_inside && x == lo[0]) {
+          x = hi[0] - 1;
+          continue;
+        }
+        if (axis < 0) {
+          row[x] = 0.0f;
+        }
+        else {
+          const int co[3] = {x, y, z};
+          row[x] = (float)co[axis] + base;
+        }
+      }
+    }
+  }
+}
+
+/* Move the content of o_grid into n_grid (see manta_grid_copy_box). A grid shifted in place
+ * additionally resets the cells that received no data, a new grid already has fresh values. */
+static void manta_grid_transfer(float *n_grid,
+                                const int n_res[3],
+                                const float *o_grid,
+                                const int o_res[3],
+                                const int lo[3],
+                                const int hi[3],
+                                const int offset[3],
+                                const bool in_place,
+                                int axis,
+                                float base)
+{
+  if (!n_grid || !o_grid) {
+    return;
+  }
+  manta_grid_copy_box(n_grid, n_res, o_grid, o_res, lo, hi, offset);
+  if (in_place) {
+    manta_grid_clear_outside(n_grid, n_res, lo, hi, axis, base);
+  }
+}
+
 void BKE_manta_reallocate_copy_fluid(MantaDomainSettings *mds,
                                      int o_res[3],
                                      int n_res[3],
@@ -132,14 +213,11 @@ void BKE_manta_reallocate_copy_fluid(MantaDomainSettings *mds,
                                      int o_shift[3],
                                      int n_shift[3])
 {
-  int x, y, z;
   struct MANTA *fluid_old = mds->fluid;
   const int block_size = mds->noise_scale;
   int new_shift[3] = {0};
   sub_v3_v3v3_int(new_shift, n_shift, o_shift);
-
-  /* allocate new fluid data */
-  BKE_manta_reallocate_fluid(mds, n_res, 0);
+  UNUSED_VARS(o_max);
 
   int o_total_cells = o_res[0] * o_res[1] * o_res[2];
   int n_total_cells = n_res[0] * n_res[1] * n_res[2];
@@ -147,6 +225,29 @@ void BKE_manta_reallocate_copy_fluid(MantaDomainSettings *mds,
   /* boundary cells will be skipped when copying data */
   int bwidth = mds->boundary_width;
 
+  /* New cell c takes the old cell c + offset. Copy only where both are inside their domain
+   * boundaries, all other new cells keep the values of a fresh grid. */
+  int offset[3], lo[3], hi[3];
+  int offset_high[3], lo_high[3], hi_high[3];
+  for (int i = 0; i < 3; i++) {
+    offset[i] = n_min[i] + new_shift[i] - o_min[i];
+    lo[i] = max_ii(bwidth, bwidth - offset[i]);
+    hi[i] = min_ii(n_res[i] - bwidth, o_res[i] - bwidth - offset[i]);
+    offset_high[i] = offset[i] * block_size;
+    lo_high[i] = lo[i] * block_size;
+    hi_high[i] = hi[i] * block_size;
+  }
+
+  /* A domain that only moves keeps its solver: the grids are shifted in place and just the
+   * newly exposed cells are reset, instead of setting up a new solver and copying all cells. */
+  const bool in_place = fluid_old && o_total_cells > 1 && o_res[0] == n_res[0] &&
+                        o_res[1] == n_res[1] && o_res[2] == n_res[2];
+
+  /* allocate new fluid data */
+  if (!in_place) {
+    BKE_manta_reallocate_fluid(mds, n_res, 0);
+  }
+
   /* copy values from old fluid to new */
   if (o_total_cells > 1 && n_total_cells > 1) {
     /* base smoke */
@@ -228,106 +329,83 @@ void BKE_manta_reallocate_copy_fluid(MantaDomainSettings *mds,
          &dummy_p,
          &dummy_s);
 
-    for (x = o_min[0]; x < o_max[0]; x++) {
-      for (y = o_min[1]; y < o_max[1]; y++) {
-        for (z = o_min[2]; z < o_max[2]; z++) {
-          /* old grid index */
-          int xo = x - o_min[0];
-          int yo = y - o_min[1];
-          int zo = z - o_min[2];
-          int index_old = manta_get_index(xo, o_res[0], yo, o_res[1], zo);
-          /* new grid index */
-          int xn = x - n_min[0] - new_shift[0];
-          int yn = y - n_min[1] - new_shift[1];
-          int zn = z - n_min[2] - new_shift[2];
-          int index_new = manta_get_index(xn, n_res[0], yn, n_res[1], zn);
-
-          /* skip if outside new domain */
-          if (xn < 0 || xn >= n_res[0] || yn < 0 || yn >= n_res[1] || zn < 0 || zn >= n_res[2]) {
-            continue;
-          }
-          /* skip if trying to copy from old boundary cell */
-          if (xo < bwidth || yo < bwidth || zo < bwidth ||
-              xo >= o_res[0]-bwidth || yo >= o_res[1]-bwidth || zo >= o_res[2]-bwidth) {
-              continue;
-          }
-          /* skip if trying to copy into new boundary cell */
-          if (xn < bwidth || yn < bwidth || zn < bwidth ||
-              xn >= n_res[0]-bwidth || yn >= n_res[1]-bwidth || zn >= n_res[2]-bwidth) {
-              continue;
-          }
-
-          /* copy data */
-          if (mds->flags & FLUID_DOMAIN_USE_NOISE) {
-            int i, j, k;
-            /* old grid index */
-            int xx_o = xo * block_size;
-            int yy_o = yo * block_size;
-            int zz_o = zo * block_size;
-            /* new grid index */
-            int xx_n = xn * block_size;
-            int yy_n = yn * block_size;
-            int zz_n = zn * block_size;
-
-            /* insert old texture values into new texture grids */
-            n_wt_tcu[index_new] = o_wt_tcu[index_old];
-            n_wt_tcv[index_new] = o_wt_tcv[index_old];
-            n_wt_tcw[index_new] = o_wt_tcw[index_old];
-
-            n_wt_tcu2[index_new] = o_wt_tcu2[index_old];
-            n_wt_tcv2[index_new] = o_wt_tcv2[index_old];
-            n_wt_tcw2[index_new] = o_wt_tcw2[index_old];
-
-            for (i = 0; i < block_size; i++) {
-              for (j = 0; j < block_size; j++) {
-                for (k = 0; k < block_size; k++) {
-                  int big_index_old = manta_get_index(
-                    xx_o + i, wt_res_old[0], yy_o + j, wt_res_old[1], zz_o + k);
-                  int big_index_new = manta_get_index(
-                    xx_n + i, mds->res_noise[0], yy_n + j, mds->res_noise[1], zz_n + k);
-                  /* copy data */
-                  n_wt_dens[big_index_new] = o_wt_dens[big_index_old];
-                  if (n_wt_flame && o_wt_flame) {
-                    n_wt_flame[big_index_new] = o_wt_flame[big_index_old];
-                    n_wt_fuel[big_index_new] = o_wt_fuel[big_index_old];
-                    n_wt_react[big_index_new] = o_wt_react[big_index_old];
-                  }
-                  if (n_wt_r && o_wt_r) {
-                    n_wt_r[big_index_new] = o_wt_r[big_index_old];
-                    n_wt_g[big_index_new] = o_wt_g[big_index_old];
-                    n_wt_b[big_index_new] = o_wt_b[big_index_old];
-                  }
-                }
-              }
-            }
-          }
+    float *grids[][2] = {
+        {n_dens, o_dens},
+        {n_heat, o_heat},
+        {n_fuel ? n_flame : NULL, o_flame},
+        {n_fuel, o_fuel},
+        {n_fuel ? n_react : NULL, o_react},
+        {n_r, o_r},
+        {n_r ? n_g : NULL, o_g},
+        {n_r ? n_b : NULL, o_b},
+        {n_vx, o_vx},
+        {n_vy, o_vy},
+        {n_vz, o_vz},
+    };
+    for (int i = 0; i < ARRAY_SIZE(grids); i++) {
+      manta_grid_transfer(grids[i][0], n_res, grids[i][1], o_res, lo, hi, offset, in_place, -1, 0);
+    }
 
-          n_dens[index_new] = o_dens[index_old];
-          /* heat */
-          if (n_heat && o_heat) {
-            n_heat[index_new] = o_heat[index_old];
-          }
-          /* fuel */
-          if (n_fuel && o_fuel) {
-            n_flame[index_new] = o_flame[index_old];
-            n_fuel[index_new] = o_fuel[index_old];
-            n_react[index_new] = o_react[index_old];
-          }
-          /* color */
-          if (o_r && n_r) {
-            n_r[index_new] = o_r[index_old];
-            n_g[index_new] = o_g[index_old];
-            n_b[index_new] = o_b[index_old];
-          }
-          n_vx[index_new] = o_vx[index_old];
-          n_vy[index_new] = o_vy[index_old];
-          n_vz[index_new] = o_vz[index_old];
+    if (mds->flags & FLUID_DOMAIN_USE_NOISE) {
+      /* Texture coordinates of fresh grids are the cell coordinates offset by the new domain
+       * minimum, see resetUvGrid(). A solver kept in place gets the new minimum as well, its
+       * noise resets the coordinates against it. */
+      float *grids_tex[][2] = {
+          {n_wt_tcu, o_wt_tcu},
+          {n_wt_tcv, o_wt_tcv},
+          {n_wt_tcw, o_wt_tcw},
+          {n_wt_tcu2, o_wt_tcu2},
+          {n_wt_tcv2, o_wt_tcv2},
+          {n_wt_tcw2, o_wt_tcw2},
+      };
+      for (int i = 0; i < ARRAY_SIZE(grids_tex); i++) {
+        const int axis = i % 3;
+        manta_grid_transfer(grids_tex[i][0],
+                            n_res,
+                            grids_tex[i][1],
+                            o_res,
+                            lo,
+                            hi,
+                            offset,
+                            in_place,
+                            axis,
+                            (float)n_min[axis]);
+      }
+      if (in_place) {
+        manta_smoke_turbulence_set_uv_offset(mds->fluid, n_min);
+      }
 
-        }
+      float *grids_high[][2] = {
+          {n_wt_dens, o_wt_dens},
+          {n_wt_flame, o_wt_flame},
+          {n_wt_flame ? n_wt_fuel : NULL, o_wt_fuel},
+          {n_wt_flame ? n_wt_react : NULL, o_wt_react},
+          {n_wt_r, o_wt_r},
+          {n_wt_r ? n_wt_g : NULL, o_wt_g},
+          {n_wt_r ? n_wt_b : NULL, o_wt_b},
+      };
+      for (int i = 0; i < ARRAY_SIZE(grids_high); i++) {
+        manta_grid_transfer(grids_high[i][0],
+                            mds->res_noise,
+                            grids_high[i][1],
+                            wt_res_old,
+                            lo_high,
+                            hi_high,
+                            offset_high,
+                            in_place,
+                            -1,
+                            0);
       }
     }
   }
-  manta_free(fluid_old);
+
+  if (in_place) {
+    /* The previous solutions of warm started pressure solves are not shifted. */
+    manta_reset_pressure_warm_start(mds->fluid);
+  }
+  else {
+    manta_free(fluid_old);
+  }
 }
 
 /* convert global position to domain cell space */
@@ -340,6 +418,151 @@ static void manta_pos_to_cell(MantaDomainSettings *mds, float pos[3])
   pos[2] *= 1.0f / mds->cell_size[2];
 }
 
+/* Voxelization of a flow or effector mesh, kept in the (copy-on-write) modifier settings so
+ * that objects which neither move nor deform are not voxelized again every (sub)frame.
+ * A depsgraph update of the object replaces the settings and with them the cache. */
+typedef struct MantaVoxelCache {
+  /* Mesh with vertices and normals in domain cell space. */
+  Mesh *mesh;
+  int shift[3];
+  MeshVoxelGrid *grid, *grid_high;
+} MantaVoxelCache;
+
+static void manta_voxel_cache_clear(MantaVoxelCache *cache)
+{
+  if (cache->mesh) {
+    BKE_id_free(NULL, cache->mesh);
+    cache->mesh = NULL;
+  }
+  if (cache->grid) {
+    BKE_mesh_voxel_grid_free(cache->grid);
+    cache->grid = NULL;
+  }
+  if (cache->grid_high) {
+    BKE_mesh_voxel_grid_free(cache->grid_high);
+    cache->grid_high = NULL;
+  }
+}
+
+static void manta_voxel_cache_free(void **voxel_cache)
+{
+  if (*voxel_cache) {
+    manta_voxel_cache_clear(*voxel_cache);
+    MEM_freeN(*voxel_cache);
+    *voxel_cache = NULL;
+  }
+}
+
+/* Does the cached mesh match me transformed by ob into the current domain? Positions are
+ * compared exactly, so a hit means all vertex velocities are zero. */
+static bool manta_voxel_cache_matches(const MantaVoxelCache *cache,
+                                      MantaDomainSettings *mds,
+                                      Object *ob,
+                                      const Mesh *me)
+{
+  const Mesh *cache_me = cache->mesh;
+
+  if (cache_me == NULL || cache_me->totvert != me->totvert || cache_me->totloop != me->totloop ||
+      cache_me->totpoly != me->totpoly || memcmp(cache->shift, mds->shift, sizeof(cache->shift)) != 0) {
+    return false;
+  }
+  if (memcmp(cache_me->mloop, me->mloop, sizeof(MLoop) * me->totloop) != 0 ||
+      memcmp(cache_me->mpoly, me->mpoly, sizeof(MPoly) * me->totpoly) != 0) {
+    return false;
+  }
+  for (int i = 0; i < me->totvert; i++) {
+    float co[3];
+    copy_v3_v3(co, me->mvert[i].co);
+    mul_m4_v3(ob->obmat, co);
+    manta_pos_to_cell(mds, co);
+    if (!equals_v3v3(co, cache_me->mvert[i].co)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Return the mesh of ob in domain cell space, from the cache if it did not change. */
+static Mesh *manta_voxel_cache_mesh_ensure(void **voxel_cache,
+                                           MantaDomainSettings *mds,
+                                           Object *ob,
+                                           Mesh *me)
+{
+  if (*voxel_cache == NULL) {
+    *voxel_cache = MEM_callocN(sizeof(MantaVoxelCache), "manta_voxel_cache");
+  }
+  MantaVoxelCache *cache = *voxel_cache;
+
+  if (manta_voxel_cache_matches(cache, mds, ob, me)) {
+    return cache->mesh;
+  }
+  manta_voxel_cache_clear(cache);
+
+  /* Own copy, the modifier replaces its input mesh on every evaluation. */
+  Mesh *cache_me = BKE_mesh_copy_for_eval(me, false);
+  BKE_mesh_ensure_normals(cache_me);
+  MVert *mvert = cache_me->mvert;
+
+  /*  Transform mesh vertices to
+   *   domain grid space for fast lookups */
+  for (int i = 0; i < cache_me->totvert; i++) {
+    float n[3];
+
+    /* vert pos */
+    mul_m4_v3(ob->obmat, mvert[i].co);
+    manta_pos_to_cell(mds, mvert[i].co);
+
+    /* vert normal */
+    normal_short_to_float_v3(n, mvert[i].no);
+    mul_mat3_m4_v3(ob->obmat, n);
+    mul_mat3_m4_v3(mds->imat, n);
+    normalize_v3(n);
+    normal_float_to_short_v3(mvert[i].no, n);
+  }
+  BKE_mesh_runtime_looptri_ensure(cache_me);
+
+  cache->mesh = cache_me;
+  copy_v3_v3_int(cache->shift, mds->shift);
+  return cache_me;
+}
+
+/* Voxelize me into *grid_p, unless the grid there was made for the same mesh and settings.
+ * Reused grids drop their velocity: the mesh did not move since they were made. */
+static const MeshVoxelGrid *manta_voxel_cache_grid_ensure(MeshVoxelGrid **grid_p,
+                                                          Mesh *me,
+                                                          const float *vert_vel,
+                                                          const int min[3],
+                                                          const int res[3],
+                                                          const float cell_size,
+                                                          const float band,
+                                                          const int flag)
+{
+  MeshVoxelGrid *grid = *grid_p;
+
+  if (grid && memcmp(grid->min, min, sizeof(grid->min)) == 0 &&
+      memcmp(grid->res, res, sizeof(grid->res)) == 0 &&
+      grid->cell_size == cell_size && grid->band == band &&
+      (grid->inside != NULL) == ((flag & MESH_VOXELIZE_INSIDE) != 0)) {
+    MEM_SAFE_FREE(grid->velocity);
+    return grid;
+  }
+  if (grid) {
+    BKE_mesh_voxel_grid_free(grid);
+  }
+
+  *grid_p = BKE_mesh_voxelize(me->mvert,
+                              me->mloop,
+                              BKE_mesh_runtime_looptri_ensure(me),
+                              BKE_mesh_runtime_looptri_len(me),
+                              vert_vel,
+                              min,
+                              res,
+                              cell_size,
+                              band,
+                              flag);
+  return *grid_p;
+}
+
 /* set domain transformations and base resolution from object mesh */
 static void manta_set_domain_from_mesh(MantaDomainSettings *mds,
                                        Object *ob,
@@ -560,6 +783,7 @@ static void mantaModifier_freeFlow(MantaModifierData *mmd)
     }
     mmd->flow->verts_old = NULL;
     mmd->flow->numverts = 0;
+    manta_voxel_cache_free(&mmd->flow->voxel_cache);
 
     MEM_freeN(mmd->flow);
     mmd->flow = NULL;
@@ -579,6 +803,7 @@ static void mantaModifier_freeCollision(MantaModifierData *mmd)
     }
     mmd->effec->verts_old = NULL;
     mmd->effec->numverts = 0;
+    manta_voxel_cache_free(&mmd->effec->voxel_cache);
 
     MEM_freeN(mmd->effec);
     mmd->effec = NULL;
@@ -612,6 +837,7 @@ static void mantaModifier_reset_ex(struct MantaModifierData *mmd, bool need_lock
       }
       mmd->flow->verts_old = NULL;
       mmd->flow->numverts = 0;
+      manta_voxel_cache_free(&mmd->flow->voxel_cache);
     }
     else if (mmd->effec) {
       if (mmd->effec->verts_old) {
@@ -619,6 +845,7 @@ static void mantaModifier_reset_ex(struct MantaModifierData *mmd, bool need_lock
       }
       mmd->effec->verts_old = NULL;
       mmd->effec->numverts = 0;
+      manta_voxel_cache_free(&mmd->effec->voxel_cache);
     }
   }
 }
@@ -664,7 +891,8 @@ void mantaModifier_createType(struct MantaModifierData *mmd)
       mmd->domain->maxres = 64;
       mmd->domain->solver_res = 3;
       mmd->domain->border_collisions = 0;  // open domain
-      mmd->domain->flags = FLUID_DOMAIN_USE_DISSOLVE_LOG | FLUID_DOMAIN_USE_ADAPTIVE_TIME;
+      mmd->domain->flags = FLUID_DOMAIN_USE_DISSOLVE_LOG | FLUID_DOMAIN_USE_ADAPTIVE_TIME |
+                           FLUID_DOMAIN_USE_PRESSURE_WARMSTART | FLUID_DOMAIN_USE_COMPACT_MATRIX;
       mmd->domain->gravity[0] = 0.0f;
       mmd->domain->gravity[1] = 0.0f;
       mmd->domain->gravity[2] = -1.0f;
@@ -765,6 +993,8 @@ void mantaModifier_createType(struct MantaModifierData *mmd)
       mmd->domain->cache_data_format = FLUID_DOMAIN_FILE_UNI;
       mmd->domain->cache_particle_format = FLUID_DOMAIN_FILE_UNI;
       mmd->domain->cache_noise_format = FLUID_DOMAIN_FILE_UNI;
+      mmd->domain->cache_quantize_channels = 0;
+      mmd->domain->cache_quantize_error = 0.001f;
       modifier_path_init(mmd->domain->cache_directory,
                          sizeof(mmd->domain->cache_directory),
                          FLUID_DOMAIN_DIR_DEFAULT);
@@ -822,6 +1052,7 @@ void mantaModifier_createType(struct MantaModifierData *mmd)
 
       /* initial velocity */
       mmd->flow->verts_old = NULL;
+      mmd->flow->voxel_cache = NULL;
       mmd->flow->numverts = 0;
       mmd->flow->vel_multi = 1.0f;
       mmd->flow->vel_normal = 0.0f;
@@ -861,6 +1092,7 @@ void mantaModifier_createType(struct MantaModifierData *mmd)
       mmd->effec->mmd = mmd;
       mmd->effec->mesh = NULL;
       mmd->effec->verts_old = NULL;
+      mmd->effec->voxel_cache = NULL;
       mmd->effec->numverts = 0;
       mmd->effec->surface_distance = 0.5f;
       mmd->effec->type = FLUID_EFFECTOR_TYPE_COLLISION;
@@ -999,6 +1231,8 @@ void mantaModifier_copy(const struct MantaModifierData *mmd,
     tmds->cache_data_format = mds->cache_data_format;
     tmds->cache_particle_format = mds->cache_particle_format;
     tmds->cache_noise_format = mds->cache_noise_format;
+    tmds->cache_quantize_channels = mds->cache_quantize_channels;
+    tmds->cache_quantize_error = mds->cache_quantize_error;
     BLI_strncpy(tmds->cache_directory, mds->cache_directory, sizeof(tmds->cache_directory));
 
     /* time options */
@@ -1094,12 +1328,10 @@ void mantaModifier_copy(const struct MantaModifierData *mmd,
 
 // forward declaration
 static void manta_smoke_calc_transparency(MantaDomainSettings *mds, ViewLayer *view_layer);
-static float calc_voxel_transp(
-    float *result, float *input, int res[3], int *pixel, float *tRay, float correct);
 static void update_mesh_distances(int index,
                                   float *mesh_distances,
-                                  BVHTreeFromMesh *treeData,
-                                  const float ray_start[3],
+                                  const MeshVoxelGrid *grid,
+                                  int grid_index,
                                   float surface_thickness);
 
 static int get_light(ViewLayer *view_layer, float *light)
@@ -1133,68 +1365,45 @@ static int get_light(ViewLayer *view_layer, float *light)
 typedef struct ObstaclesFromDMData {
   MantaDomainSettings *mds;
   MantaCollSettings *mcs;
-  const MVert *mvert;
-  const MLoop *mloop;
-  const MLoopTri *looptri;
-  BVHTreeFromMesh *tree;
+  const MeshVoxelGrid *grid;
 
   bool has_velocity;
-  float *vert_vel;
   float *velocityX, *velocityY, *velocityZ;
   int *num_objects;
   float *distances_map;
 } ObstaclesFromDMData;
 
+/* slightly rounded-up sqrt(3 * (0.5)^2) == max. distance of cell boundary along the diagonal */
+#define OBSTACLE_SURFACE_DISTANCE 2.0f  //0.867f;
+/* Note: Use larger surface distance to cover larger area with obvel. Manta will use these obvels and extrapolate them (inside and outside obstacle) */
+
 static void obstacles_from_mesh_task_cb(void *__restrict userdata,
                                         const int z,
                                         const TaskParallelTLS *__restrict UNUSED(tls))
 {
   ObstaclesFromDMData *data = userdata;
   MantaDomainSettings *mds = data->mds;
-
-  /* slightly rounded-up sqrt(3 * (0.5)^2) == max. distance of cell boundary along the diagonal */
-  const float surface_distance = 2.0f;  //0.867f;
-  /* Note: Use larger surface distance to cover larger area with obvel. Manta will use these obvels and extrapolate them (inside and outside obstacle) */
+  const MeshVoxelGrid *grid = data->grid;
 
   for (int x = mds->res_min[0]; x < mds->res_max[0]; x++) {
     for (int y = mds->res_min[1]; y < mds->res_max[1]; y++) {
       const int index = manta_get_index(
           x - mds->res_min[0], mds->res[0], y - mds->res_min[1], mds->res[1], z - mds->res_min[2]);
-
-      float ray_start[3] = {(float)x + 0.5f, (float)y + 0.5f, (float)z + 0.5f};
-      BVHTreeNearest nearest = {0};
-      nearest.index = -1;
-      nearest.dist_sq = surface_distance *
-                        surface_distance; /* find_nearest uses squared distance */
+      const int grid_index = BKE_mesh_voxel_grid_index(grid, x, y, z);
       bool hasIncObj = false;
 
-      /* find the nearest point on the mesh */
-      if (BLI_bvhtree_find_nearest(
-              data->tree->tree, ray_start, &nearest, data->tree->nearest_callback, data->tree) !=
-          -1) {
-        const MLoopTri *lt = &data->looptri[nearest.index];
-        float weights[3];
-        int v1, v2, v3;
-
-        /* calculate barycentric weights for nearest point */
-        v1 = data->mloop[lt->tri[0]].v;
-        v2 = data->mloop[lt->tri[1]].v;
-        v3 = data->mloop[lt->tri[2]].v;
-        interp_weights_tri_v3(
-            weights, data->mvert[v1].co, data->mvert[v2].co, data->mvert[v3].co, nearest.co);
-
+      /* nearest point on the mesh, its velocity is interpolated by the voxelizer */
+      if (grid_index != -1 && grid->dist[grid_index] < OBSTACLE_SURFACE_DISTANCE) {
         if (data->has_velocity) {
           /* increase object count */
           data->num_objects[index]++;
           hasIncObj = true;
 
-          /* apply object velocity */
-          float hit_vel[3];
-          interp_v3_v3v3v3(hit_vel,
-                           &data->vert_vel[v1 * 3],
-                           &data->vert_vel[v2 * 3],
-                           &data->vert_vel[v3 * 3],
-                           weights);
+          /* apply object velocity, a grid without velocity belongs to a collider at rest */
+          float hit_vel[3] = {0.0f, 0.0f, 0.0f};
+          if (grid->velocity) {
+            copy_v3_v3(hit_vel, &grid->velocity[grid_index * 3]);
+          }
 
           /* Guiding has additional velocity multiplier */
           if (data->mcs->type == FLUID_EFFECTOR_TYPE_GUIDE) {
@@ -1243,7 +1452,7 @@ static void obstacles_from_mesh_task_cb(void *__restrict userdata,
       /* Get distance to mesh surface from both within and outside grid (mantaflow phi grid) */
       if (data->distances_map) {
         update_mesh_distances(
-            index, data->distances_map, data->tree, ray_start, data->mcs->surface_distance);
+            index, data->distances_map, grid, grid_index, data->mcs->surface_distance);
 
         /* Ensure that num objects are also counted inside object. But dont count twice (see object inc for nearest point) */
         if (data->distances_map[index] < 0 && !hasIncObj) {
@@ -1270,26 +1479,16 @@ static void obstacles_from_mesh(Object *coll_ob,
   {
     Mesh *me = NULL;
     MVert *mvert = NULL;
-    const MLoopTri *looptri;
-    const MLoop *mloop;
-    BVHTreeFromMesh treeData = {NULL};
-    int numverts, i;
+    int numverts, looptri_len, i;
 
     float *vert_vel = NULL;
     bool has_velocity = false;
+    float bb_min[3], bb_max[3];
 
-    me = BKE_mesh_copy_for_eval(mcs->mesh, true);
-
-    /* Duplicate vertices to modify. */
-    if (me->mvert) {
-      me->mvert = MEM_dupallocN(me->mvert);
-      CustomData_set_layer(&me->vdata, CD_MVERT, me->mvert);
-    }
-
-    BKE_mesh_ensure_normals(me);
+    /* Collider vertices in domain grid space, reused while the collider does not move. */
+    me = manta_voxel_cache_mesh_ensure(&mcs->voxel_cache, mds, coll_ob, mcs->mesh);
     mvert = me->mvert;
-    mloop = me->mloop;
-    looptri = BKE_mesh_runtime_looptri_ensure(me);
+    looptri_len = BKE_mesh_runtime_looptri_len(me);
     numverts = me->totvert;
 
     /* TODO (sebbas):
@@ -1311,22 +1510,11 @@ static void obstacles_from_mesh(Object *coll_ob,
       }
     }
 
-    /*  Transform collider vertices to
-     *   domain grid space for fast lookups */
+    INIT_MINMAX(bb_min, bb_max);
     for (i = 0; i < numverts; i++) {
-      float n[3];
       float co[3];
 
-      /* vert pos */
-      mul_m4_v3(coll_ob->obmat, mvert[i].co);
-      manta_pos_to_cell(mds, mvert[i].co);
-
-      /* vert normal */
-      normal_short_to_float_v3(n, mvert[i].no);
-      mul_mat3_m4_v3(coll_ob->obmat, n);
-      mul_mat3_m4_v3(mds->imat, n);
-      normalize_v3(n);
-      normal_float_to_short_v3(mvert[i].no, n);
+      minmax_v3v3_v3(bb_min, bb_max, mvert[i].co);
 
       /* vert velocity */
       add_v3fl_v3fl_v3i(co, mvert[i].co, mds->shift);
@@ -1337,15 +1525,32 @@ static void obstacles_from_mesh(Object *coll_ob,
       copy_v3_v3(&mcs->verts_old[i * 3], co);
     }
 
-    if (BKE_bvhtree_from_mesh_get(&treeData, me, BVHTREE_FROM_LOOPTRI, 4)) {
+    if (looptri_len > 0) {
+      /* Only the cells around the collider need the exact distances,
+       * everything else is outside (see update_mesh_distances). */
+      const float band = MAX2(OBSTACLE_SURFACE_DISTANCE, mcs->surface_distance);
+      int grid_min[3], grid_res[3];
+      for (i = 0; i < 3; i++) {
+        const int lo = max_ii((int)floorf(bb_min[i] - band) - 1, mds->res_min[i]);
+        const int hi = min_ii((int)ceilf(bb_max[i] + band) + 1, mds->res_max[i]);
+        grid_min[i] = lo;
+        grid_res[i] = max_ii(hi - lo, 0);
+      }
+
+      MantaVoxelCache *cache = mcs->voxel_cache;
+      const MeshVoxelGrid *grid = manta_voxel_cache_grid_ensure(&cache->grid,
+                                                                me,
+                                                                has_velocity ? vert_vel : NULL,
+                                                                grid_min,
+                                                                grid_res,
+                                                                1.0f,
+                                                                band,
+                                                                MESH_VOXELIZE_INSIDE);
+
       ObstaclesFromDMData data = {.mds = mds,
                                   .mcs = mcs,
-                                  .mvert = mvert,
-                                  .mloop = mloop,
-                                  .looptri = looptri,
-                                  .tree = &treeData,
+                                  .grid = grid,
                                   .has_velocity = has_velocity,
-                                  .vert_vel = vert_vel,
                                   .velocityX = velocityX,
                                   .velocityY = velocityY,
                                   .velocityZ = velocityZ,
@@ -1357,16 +1562,10 @@ static void obstacles_from_mesh(Object *coll_ob,
       BLI_task_parallel_range(
           mds->res_min[2], mds->res_max[2], &data, obstacles_from_mesh_task_cb, &settings);
     }
-    /* free bvh tree */
-    free_bvhtree_from_mesh(&treeData);
-    BKE_id_free(NULL, me);
 
     if (vert_vel) {
       MEM_freeN(vert_vel);
     }
-    if (me->mvert) {
-      MEM_freeN(me->mvert);
-    }
   }
 }
 
@@ -2079,68 +2278,20 @@ static void emit_from_particles(Object *flow_ob,
 /* Calculate map of (minimum) distances to flow/obstacle surface. Distances outside mesh are positive, inside negative */
 static void update_mesh_distances(int index,
                                   float *mesh_distances,
-                                  BVHTreeFromMesh *treeData,
-                                  const float ray_start[3],
+                                  const MeshVoxelGrid *grid,
+                                  int grid_index,
                                   float surface_thickness)
 {
-
-  /* First pass: Raycasts in 26 directions (6 main axis + 12 quadrant diagonals (2D) + 8 octant diagonals (3D)) */
-  float ray_dirs[26][3] = {
-      {1.0f, 0.0f, 0.0f},   {0.0f, 1.0f, 0.0f},   {0.0f, 0.0f, 1.0f},  {-1.0f, 0.0f, 0.0f},
-      {0.0f, -1.0f, 0.0f},  {0.0f, 0.0f, -1.0f},  {1.0f, 1.0f, 0.0f},  {1.0f, -1.0f, 0.0f},
-      {-1.0f, 1.0f, 0.0f},  {-1.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 1.0f},  {1.0f, 0.0f, -1.0f},
-      {-1.0f, 0.0f, 1.0f},  {-1.0f, 0.0f, -1.0f}, {0.0f, 1.0f, 1.0f},  {0.0f, 1.0f, -1.0f},
-      {0.0f, -1.0f, 1.0f},  {0.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f},  {1.0f, -1.0f, 1.0f},
-      {-1.0f, 1.0f, 1.0f},  {-1.0f, -1.0f, 1.0f}, {1.0f, 1.0f, -1.0f}, {1.0f, -1.0f, -1.0f},
-      {-1.0f, 1.0f, -1.0f}, {-1.0f, -1.0f, -1.0f}};
-  size_t ray_cnt = sizeof ray_dirs / sizeof ray_dirs[0];
-
-  /* Count for ray misses (no face hit) and cases where ray direction matches face normal direction. */
-  int miss_cnt = 0;
-  int dir_cnt = 0;
-
-  for (int i = 0; i < ray_cnt; i++) {
-    BVHTreeRayHit hit_tree = {0};
-    hit_tree.index = -1;
-    hit_tree.dist = 9999;
-
-    normalize_v3(ray_dirs[i]);
-    BLI_bvhtree_ray_cast(treeData->tree,
-                         ray_start,
-                         ray_dirs[i],
-                         0.0f,
-                         &hit_tree,
-                         treeData->raycast_callback,
-                         treeData);
-
-    /* Ray did not hit mesh. Current point definitely not inside mesh. Inside mesh all rays have to hit. */
-    if (hit_tree.index == -1) {
-      miss_cnt++;
-      continue;
-    }
-
-    /* Ray and normal are in pointing opposite directions. */
-    if (dot_v3v3(ray_dirs[i], hit_tree.no) <= 0) {
-      dir_cnt++;
-    }
-  }
-
   /* Initialize grid points to -0.5 inside and 0.5 outside mesh.
-   * Inside mesh: All rays have to hit (no misses) or all face normals have to match ray direction */
+   * Inside mesh: The axis aligned crossing counts of the voxelizer agree on inside. */
+  const bool inside = grid_index != -1 && grid->inside[grid_index];
   if (mesh_distances[index] != -0.5f) {
-    mesh_distances[index] = (miss_cnt > 0 || dir_cnt == ray_cnt) ? 0.5f : -0.5f;
+    mesh_distances[index] = inside ? -0.5f : 0.5f;
   }
 
-  /* Second pass: Ensure that single planes get initialized. */
-  BVHTreeNearest nearest = {0};
-  nearest.index = -1;
-  nearest.dist_sq = surface_thickness * surface_thickness; /* find_nearest uses squared distance */
-
-  if (BLI_bvhtree_find_nearest(
-          treeData->tree, ray_start, &nearest, treeData->nearest_callback, treeData) != -1) {
-    if (mesh_distances[index] != -0.5f) {
-      mesh_distances[index] = -0.5f;
-    }
+  /* Ensure that single planes get initialized. */
+  if (grid_index != -1 && grid->dist[grid_index] < surface_thickness) {
+    mesh_distances[index] = -0.5f;
   }
 }
 
@@ -2154,8 +2305,8 @@ static void sample_mesh(MantaFlowSettings *mfs,
                         int index,
                         const int base_res[3],
                         float flow_center[3],
-                        BVHTreeFromMesh *treeData,
-                        const float ray_start[3],
+                        const MeshVoxelGrid *grid,
+                        const int cell[3],
                         const float *vert_vel,
                         bool has_velocity,
                         int defgrp_index,
@@ -2164,57 +2315,27 @@ static void sample_mesh(MantaFlowSettings *mfs,
                         float y,
                         float z)
 {
-  float ray_dir[3] = {1.0f, 0.0f, 0.0f};
-  BVHTreeRayHit hit = {0};
-  BVHTreeNearest nearest = {0};
+  const int grid_index = BKE_mesh_voxel_grid_index(grid, UNPACK3(cell));
+  float nearest_co[3], weights[3];
 
   float volume_factor = 0.0f;
   float sample_str = 0.0f;
 
-  hit.index = -1;
-  hit.dist = 9999;
-  nearest.index = -1;
-  nearest.dist_sq = mfs->surface_distance *
-                    mfs->surface_distance; /* find_nearest uses squared distance */
-
   /* Check volume collision */
-  if (mfs->volume_density) {
-    if (BLI_bvhtree_ray_cast(treeData->tree,
-                             ray_start,
-                             ray_dir,
-                             0.0f,
-                             &hit,
-                             treeData->raycast_callback,
-                             treeData) != -1) {
-      float dot = ray_dir[0] * hit.no[0] + ray_dir[1] * hit.no[1] + ray_dir[2] * hit.no[2];
-      /* If ray and hit face normal are facing same direction
-       * hit point is inside a closed mesh. */
-      if (dot >= 0) {
-        /* Also cast a ray in opposite direction to make sure
-         * point is at least surrounded by two faces */
-        negate_v3(ray_dir);
-        hit.index = -1;
-        hit.dist = 9999;
-
-        BLI_bvhtree_ray_cast(
-            treeData->tree, ray_start, ray_dir, 0.0f, &hit, treeData->raycast_callback, treeData);
-        if (hit.index != -1) {
-          volume_factor = mfs->volume_density;
-        }
-      }
-    }
+  if (mfs->volume_density && grid->inside && grid_index != -1 && grid->inside[grid_index]) {
+    volume_factor = mfs->volume_density;
   }
 
-  /* find the nearest point on the mesh */
-  if (BLI_bvhtree_find_nearest(
-          treeData->tree, ray_start, &nearest, treeData->nearest_callback, treeData) != -1) {
-    float weights[3];
-    int v1, v2, v3, f_index = nearest.index;
+  /* find the nearest point on the mesh, the voxelizer keeps it for cells closer than
+   * surface_distance */
+  if (BKE_mesh_voxel_grid_nearest(
+          grid, mvert, mloop, mlooptri, UNPACK3(cell), nearest_co, weights)) {
+    int v1, v2, v3, f_index = grid->tri[grid_index];
     float n1[3], n2[3], n3[3], hit_normal[3];
 
     /* emit from surface based on distance */
     if (mfs->surface_distance) {
-      sample_str = sqrtf(nearest.dist_sq) / mfs->surface_distance;
+      sample_str = grid->dist[grid_index] / mfs->surface_distance;
       CLAMP(sample_str, 0.0f, 1.0f);
       sample_str = pow(1.0f - sample_str, 0.5f);
     }
@@ -2222,11 +2343,9 @@ static void sample_mesh(MantaFlowSettings *mfs,
       sample_str = 0.0f;
     }
 
-    /* calculate barycentric weights for nearest point */
     v1 = mloop[mlooptri[f_index].tri[0]].v;
     v2 = mloop[mlooptri[f_index].tri[1]].v;
     v3 = mloop[mlooptri[f_index].tri[2]].v;
-    interp_weights_tri_v3(weights, mvert[v1].co, mvert[v2].co, mvert[v3].co, nearest.co);
 
     if (mfs->flags & FLUID_FLOW_INITVELOCITY && velocity_map) {
       /* apply normal directional velocity */
@@ -2317,7 +2436,8 @@ typedef struct EmitFromDMData {
   MDeformVert *dvert;
   int defgrp_index;
 
-  BVHTreeFromMesh *tree;
+  /* Low resolution voxelization and the one at hires_multiplier resolution (if used). */
+  const MeshVoxelGrid *grid, *grid_high;
   int hires_multiplier;
   float hr;
 
@@ -2349,7 +2469,7 @@ static void emit_from_mesh_task_cb(void *__restrict userdata,
 
         const int index = manta_get_index(
             lx - em->min[0], em->res[0], ly - em->min[1], em->res[1], lz - em->min[2]);
-        const float ray_start[3] = {((float)lx) + 0.5f, ((float)ly) + 0.5f, ((float)lz) + 0.5f};
+        const int cell[3] = {lx, ly, lz};
 
         /* Emission for smoke and fire. Result in em->influence. Also, calculate invels */
         sample_mesh(data->mfs,
@@ -2362,8 +2482,8 @@ static void emit_from_mesh_task_cb(void *__restrict userdata,
                     index,
                     data->mds->base_res,
                     data->flow_center,
-                    data->tree,
-                    ray_start,
+                    data->grid,
+                    cell,
                     data->vert_vel,
                     data->has_velocity,
                     data->defgrp_index,
@@ -2373,8 +2493,11 @@ static void emit_from_mesh_task_cb(void *__restrict userdata,
                     (float)lz);
 
         /* Calculate levelset from meshes. Result in em->distances */
-        update_mesh_distances(
-            index, em->distances, data->tree, ray_start, data->mfs->surface_distance);
+        update_mesh_distances(index,
+                              em->distances,
+                              data->grid,
+                              BKE_mesh_voxel_grid_index(data->grid, UNPACK3(cell)),
+                              data->mfs->surface_distance);
       }
 
       /* take high res samples if required */
@@ -2386,11 +2509,7 @@ static void emit_from_mesh_task_cb(void *__restrict userdata,
 
         const int index = manta_get_index(
             x - data->min[0], data->res[0], y - data->min[1], data->res[1], z - data->min[2]);
-        const float ray_start[3] = {
-            lx + 0.5f * data->hr,
-            ly + 0.5f * data->hr,
-            lz + 0.5f * data->hr,
-        };
+        const int cell[3] = {x, y, z};
 
         /* Emission for smoke and fire high. Result in em->influence_high */
         if (data->mfs->type == FLUID_FLOW_TYPE_SMOKE || data->mfs->type == FLUID_FLOW_TYPE_FIRE ||
@@ -2405,8 +2524,8 @@ static void emit_from_mesh_task_cb(void *__restrict userdata,
                       index,
                       data->mds->base_res,
                       data->flow_center,
-                      data->tree,
-                      ray_start,
+                      data->grid_high,
+                      cell,
                       data->vert_vel,
                       data->has_velocity,
                       data->defgrp_index,
@@ -2431,8 +2550,7 @@ static void emit_from_mesh(
     const MLoop *mloop = NULL;
     const MLoopUV *mloopuv = NULL;
     MDeformVert *dvert = NULL;
-    BVHTreeFromMesh treeData = {NULL};
-    int numverts, i;
+    int numverts, looptri_len, i;
 
     float *vert_vel = NULL;
     bool has_velocity = false;
@@ -2442,24 +2560,16 @@ static void emit_from_mesh(
     int min[3], max[3], res[3];
     int hires_multiplier = 1;
 
-    /* copy mesh for thread safety because we modify it,
-     * main issue is its VertArray being modified, then replaced and freed
-     */
-    me = BKE_mesh_copy_for_eval(mfs->mesh, true);
-
-    /* Duplicate vertices to modify. */
-    if (me->mvert) {
-      me->mvert = MEM_dupallocN(me->mvert);
-      CustomData_set_layer(&me->vdata, CD_MVERT, me->mvert);
-    }
-
-    BKE_mesh_ensure_normals(me);
+    /* Flow vertices in domain grid space, reused while the flow object does not move. */
+    me = manta_voxel_cache_mesh_ensure(&mfs->voxel_cache, mds, flow_ob, mfs->mesh);
     mvert = me->mvert;
     mloop = me->mloop;
     mlooptri = BKE_mesh_runtime_looptri_ensure(me);
+    looptri_len = BKE_mesh_runtime_looptri_len(me);
     numverts = me->totvert;
-    dvert = CustomData_get_layer(&me->vdata, CD_MDEFORMVERT);
-    mloopuv = CustomData_get_layer_named(&me->ldata, CD_MLOOPUV, mfs->uvlayer_name);
+    /* Same topology as the cached mesh, but weights and UVs may be animated. */
+    dvert = CustomData_get_layer(&mfs->mesh->vdata, CD_MDEFORMVERT);
+    mloopuv = CustomData_get_layer_named(&mfs->mesh->ldata, CD_MLOOPUV, mfs->uvlayer_name);
 
     if (mfs->flags & FLUID_FLOW_INITVELOCITY) {
       vert_vel = MEM_callocN(sizeof(float) * numverts * 3, "manta_flow_velocity");
@@ -2476,22 +2586,7 @@ static void emit_from_mesh(
       }
     }
 
-    /*  Transform mesh vertices to
-     *   domain grid space for fast lookups */
     for (i = 0; i < numverts; i++) {
-      float n[3];
-
-      /* vert pos */
-      mul_m4_v3(flow_ob->obmat, mvert[i].co);
-      manta_pos_to_cell(mds, mvert[i].co);
-
-      /* vert normal */
-      normal_short_to_float_v3(n, mvert[i].no);
-      mul_mat3_m4_v3(flow_ob->obmat, n);
-      mul_mat3_m4_v3(mds->imat, n);
-      normalize_v3(n);
-      normal_float_to_short_v3(mvert[i].no, n);
-
       /* vert velocity */
       if (mfs->flags & FLUID_FLOW_INITVELOCITY) {
         float co[3];
@@ -2525,8 +2620,36 @@ static void emit_from_mesh(
       res[i] = em->res[i] * hires_multiplier;
     }
 
-    if (BKE_bvhtree_from_mesh_get(&treeData, me, BVHTREE_FROM_LOOPTRI, 4)) {
+    if (looptri_len > 0) {
       const float hr = 1.0f / ((float)hires_multiplier);
+      const bool use_high = hires_multiplier > 1 && (mfs->type == FLUID_FLOW_TYPE_SMOKE ||
+                                                     mfs->type == FLUID_FLOW_TYPE_FIRE ||
+                                                     mfs->type == FLUID_FLOW_TYPE_SMOKEFIRE);
+
+      MantaVoxelCache *cache = mfs->voxel_cache;
+
+      /* Distances only matter within surface_distance of the mesh, inside/outside is always
+       * needed for the levelset. */
+      const MeshVoxelGrid *grid = manta_voxel_cache_grid_ensure(&cache->grid,
+                                                                me,
+                                                                NULL,
+                                                                em->min,
+                                                                em->res,
+                                                                1.0f,
+                                                                mfs->surface_distance,
+                                                                MESH_VOXELIZE_INSIDE);
+      const MeshVoxelGrid *grid_high = NULL;
+      if (use_high) {
+        grid_high = manta_voxel_cache_grid_ensure(&cache->grid_high,
+                                                  me,
+                                                  NULL,
+                                                  min,
+                                                  res,
+                                                  hr,
+                                                  mfs->surface_distance,
+                                                  mfs->volume_density ? MESH_VOXELIZE_INSIDE :
+                                                                        0);
+      }
 
       EmitFromDMData data = {
           .mds = mds,
@@ -2537,7 +2660,8 @@ static void emit_from_mesh(
           .mloopuv = mloopuv,
           .dvert = dvert,
           .defgrp_index = defgrp_index,
-          .tree = &treeData,
+          .grid = grid,
+          .grid_high = grid_high,
           .hires_multiplier = hires_multiplier,
           .hr = hr,
           .em = em,
@@ -2554,17 +2678,10 @@ static void emit_from_mesh(
       settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
       BLI_task_parallel_range(min[2], max[2], &data, emit_from_mesh_task_cb, &settings);
     }
-    /* free bvh tree */
-    free_bvhtree_from_mesh(&treeData);
 
     if (vert_vel) {
       MEM_freeN(vert_vel);
     }
-
-    if (me->mvert) {
-      MEM_freeN(me->mvert);
-    }
-    BKE_id_free(NULL, me);
   }
 }
 
@@ -3448,14 +3565,62 @@ static void update_effectors(
   BKE_effectors_free(effectors);
 }
 
-static Mesh *createLiquidGeometry(MantaDomainSettings *mds, Mesh *orgmesh, Object *ob)
-{
-  Mesh *me;
+typedef struct LiquidGeometryData {
   MVert *mverts;
   MPoly *mpolys;
   MLoop *mloops;
-  short *normals, *no_s;
-  float no[3];
+
+  const float *vertices, *normals;
+  const int *triangles;
+  int vertex_stride, normal_stride, triangle_stride;
+
+  /* Raw vertices are in mesh cells, co = (raw - offset) * factor. */
+  float offset[3], factor[3];
+
+  short mp_mat_nr;
+  char mp_flag;
+} LiquidGeometryData;
+
+static void liquid_geometry_verts_task_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidGeometryData *data = userdata;
+  MVert *mv = &data->mverts[i];
+  const float *co = POINTER_OFFSET(data->vertices, (size_t)i * data->vertex_stride);
+  const float *no = POINTER_OFFSET(data->normals, (size_t)i * data->normal_stride);
+
+  mv->co[0] = (co[0] - data->offset[0]) * data->factor[0];
+  mv->co[1] = (co[1] - data->offset[1]) * data->factor[1];
+  mv->co[2] = (co[2] - data->offset[2]) * data->factor[2];
+
+  normal_float_to_short_v3(mv->no, no);
+}
+
+static void liquid_geometry_faces_task_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LiquidGeometryData *data = userdata;
+  MPoly *mp = &data->mpolys[i];
+  MLoop *ml = &data->mloops[i * 3];
+  const int *tri = POINTER_OFFSET(data->triangles, (size_t)i * data->triangle_stride);
+
+  /* initialize from existing face */
+  mp->mat_nr = data->mp_mat_nr;
+  mp->flag = data->mp_flag;
+
+  mp->loopstart = i * 3;
+  mp->totloop = 3;
+
+  ml[0].v = tri[0];
+  ml[1].v = tri[1];
+  ml[2].v = tri[2];
+}
+
+static Mesh *createLiquidGeometry(MantaDomainSettings *mds, Mesh *orgmesh, Object *ob)
+{
+  Mesh *me;
   float min[3];
   float max[3];
   float size[3];
@@ -3471,33 +3636,35 @@ static Mesh *createLiquidGeometry(MantaDomainSettings *mds, Mesh *orgmesh, Objec
   }
   /* else leave NULL'd */
 
-  const short mp_mat_nr = mp_example.mat_nr;
-  const char mp_flag = mp_example.flag;
-
   int i;
-  int num_verts, num_normals, num_faces;
+  int num_verts, num_faces;
+  LiquidGeometryData data;
 
   if (!mds->fluid) {
     return NULL;
   }
 
   num_verts = manta_liquid_get_num_verts(mds->fluid);
-  num_normals = manta_liquid_get_num_normals(mds->fluid);
   num_faces = manta_liquid_get_num_triangles(mds->fluid);
 
-  //printf("num_verts: %d, num_normals: %d, num_faces: %d\n", num_verts, num_normals, num_faces);
+  /* The decoded cache buffers are read in place, without per element calls into Mantaflow. */
+  data.vertices = manta_liquid_get_vertices(mds->fluid, &data.vertex_stride);
+  data.normals = manta_liquid_get_normals(mds->fluid, &data.normal_stride);
+  data.triangles = manta_liquid_get_triangles(mds->fluid, &data.triangle_stride);
 
-  if (!num_verts || !num_faces) {
+  if (!num_verts || !num_faces || !data.vertices || !data.triangles) {
     return NULL;
   }
 
   me = BKE_mesh_new_nomain(num_verts, 0, 0, num_faces * 3, num_faces);
-  mverts = me->mvert;
-  mpolys = me->mpoly;
-  mloops = me->mloop;
   if (!me) {
     return NULL;
   }
+  data.mverts = me->mvert;
+  data.mpolys = me->mpoly;
+  data.mloops = me->mloop;
+  data.mp_mat_nr = mp_example.mat_nr;
+  data.mp_flag = mp_example.flag;
 
   // Get size (dimension) but considering scaling scaling
   copy_v3_v3(cell_size_scaled, mds->cell_size);
@@ -3509,65 +3676,26 @@ static Mesh *createLiquidGeometry(MantaDomainSettings *mds, Mesh *orgmesh, Objec
   // Biggest dimension will be used for upscaling
   float max_size = MAX3(size[0], size[1], size[2]);
 
-  // Vertices
-  for (i = 0; i < num_verts; i++, mverts++) {
-    // read raw data. is normalized cube around domain origin
-    mverts->co[0] = manta_liquid_get_vertex_x_at(mds->fluid, i);
-    mverts->co[1] = manta_liquid_get_vertex_y_at(mds->fluid, i);
-    mverts->co[2] = manta_liquid_get_vertex_z_at(mds->fluid, i);
-
-    // if reading raw data directly from manta, normalize now, otherwise omit this, ie when reading from files
-    {
-      // normalize to unit cube around 0
-      mverts->co[0] -= ((float)mds->res[0] * mds->mesh_scale) * 0.5f;
-      mverts->co[1] -= ((float)mds->res[1] * mds->mesh_scale) * 0.5f;
-      mverts->co[2] -= ((float)mds->res[2] * mds->mesh_scale) * 0.5f;
-      mverts->co[0] *= mds->dx / mds->mesh_scale;
-      mverts->co[1] *= mds->dx / mds->mesh_scale;
-      mverts->co[2] *= mds->dx / mds->mesh_scale;
-    }
-
-    mverts->co[0] *= max_size / fabsf(ob->scale[0]);
-    mverts->co[1] *= max_size / fabsf(ob->scale[1]);
-    mverts->co[2] *= max_size / fabsf(ob->scale[2]);
-
-    //printf("mverts->co[0]: %f, mverts->co[1]: %f, mverts->co[2]: %f\n", mverts->co[0], mverts->co[1], mverts->co[2]);
+  // Raw vertices are a normalized cube around the domain origin, scaled by mesh_scale
+  for (i = 0; i < 3; i++) {
+    data.offset[i] = ((float)mds->res[i] * mds->mesh_scale) * 0.5f;
+    data.factor[i] = (mds->dx / mds->mesh_scale) * (max_size / fabsf(ob->scale[i]));
   }
 
-  // Normals
-  normals = MEM_callocN(sizeof(short) * num_normals * 3, "Fluidmesh_tmp_normals");
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4096;
 
-  for (i = 0, no_s = normals; i < num_normals; no_s += 3, i++) {
-    no[0] = manta_liquid_get_normal_x_at(mds->fluid, i);
-    no[1] = manta_liquid_get_normal_y_at(mds->fluid, i);
-    no[2] = manta_liquid_get_normal_z_at(mds->fluid, i);
-
-    normal_float_to_short_v3(no_s, no);
-
-    //printf("no_s[0]: %d, no_s[1]: %d, no_s[2]: %d\n", no_s[0], no_s[1], no_s[2]);
-  }
+  // Vertices and normals
+  BLI_task_parallel_range(0, num_verts, &data, liquid_geometry_verts_task_cb, &settings);
 
   // Triangles
-  for (i = 0; i < num_faces; i++, mpolys++, mloops += 3) {
-    /* initialize from existing face */
-    mpolys->mat_nr = mp_mat_nr;
-    mpolys->flag = mp_flag;
+  BLI_task_parallel_range(0, num_faces, &data, liquid_geometry_faces_task_cb, &settings);
 
-    mpolys->loopstart = i * 3;
-    mpolys->totloop = 3;
-
-    mloops[0].v = manta_liquid_get_triangle_x_at(mds->fluid, i);
-    mloops[1].v = manta_liquid_get_triangle_y_at(mds->fluid, i);
-    mloops[2].v = manta_liquid_get_triangle_z_at(mds->fluid, i);
-
-    //printf("mloops[0].v: %d, mloops[1].v: %d, mloops[2].v: %d\n", mloops[0].v, mloops[1].v, mloops[2].v);
-  }
-
-  BKE_mesh_ensure_normals(me);
   BKE_mesh_calc_edges(me, false, false);
-  BKE_mesh_vert_normals_apply(me, (short(*)[3])normals);
 
-  MEM_freeN(normals);
+  /* Vertex normals were written from the cache, there is no need to compute them. */
+  me->runtime.cd_dirty_vert &= ~CD_MASK_NORMAL;
 
   /* return early if no mesh vert velocities required */
   if ((mds->flags & FLUID_DOMAIN_USE_SPEED_VECTORS) == 0) {
@@ -3586,13 +3714,13 @@ static Mesh *createLiquidGeometry(MantaDomainSettings *mds, Mesh *orgmesh, Objec
   velarray = mds->mesh_velocities;
 
   float time_mult = 25.f * DT_DEFAULT;
+  int vel_stride;
+  const float *vel = manta_liquid_get_vertvels(mds->fluid, &vel_stride);
+  const int num_vels = min_ii(num_verts, manta_liquid_get_num_vertvels(mds->fluid));
 
-  for (i = 0; i < num_verts; i++, mverts++) {
-    velarray[i].vel[0] = manta_liquid_get_vertvel_x_at(mds->fluid, i) * (mds->dx / time_mult);
-    velarray[i].vel[1] = manta_liquid_get_vertvel_y_at(mds->fluid, i) * (mds->dx / time_mult);
-    velarray[i].vel[2] = manta_liquid_get_vertvel_z_at(mds->fluid, i) * (mds->dx / time_mult);
-
-    //printf("velarray[%d].vel[0]: %f, velarray[%d].vel[1]: %f, velarray[%d].vel[2]: %f\n", i, velarray[i].vel[0], i, velarray[i].vel[1], i, velarray[i].vel[2]);
+  /* vertices without velocity data keep zero velocity */
+  for (i = 0; i < num_vels; i++, vel = POINTER_OFFSET(vel, vel_stride)) {
+    mul_v3_v3fl(velarray[i].vel, vel, mds->dx / time_mult);
   }
 
   return me;
@@ -4338,126 +4466,120 @@ struct Mesh *mantaModifier_do(
   return result;
 }
 
-static float calc_voxel_transp(
-    float *result, float *input, int res[3], int *pixel, float *tRay, float correct)
+/* Smoke shadows are swept outwards from the light in shells of equal Chebyshev distance to the
+ * light cell. Every cell multiplies its own transmittance with the one of the point where its
+ * ray to the light crosses the next slab towards the light, interpolated from the shell inside.
+ * All cells of a shell only depend on inner shells and are computed in parallel. */
+typedef struct SmokeShadowData {
+  float *shadow;
+  const float *density;
+  const int *res;
+  float light[3];
+  int light_cell[3];
+  float correct;
+  int shell;
+} SmokeShadowData;
+
+BLI_INLINE float smoke_shadow_get(const SmokeShadowData *data, const int cell[3])
 {
-  const size_t index = manta_get_index(pixel[0], res[0], pixel[1], res[1], pixel[2]);
+  const int *res = data->res;
 
-  // T_ray *= T_vox
-  *tRay *= expf(input[index] * correct);
+  /* there is no smoke outside of the domain */
+  if (cell[0] < 0 || cell[1] < 0 || cell[2] < 0 || cell[0] >= res[0] || cell[1] >= res[1] ||
+      cell[2] >= res[2]) {
+    return 1.0f;
+  }
+  return data->shadow[manta_get_index(cell[0], res[0], cell[1], res[1], cell[2])];
+}
 
-  if (result[index] < 0.0f) {
-    result[index] = *tRay;
+static void smoke_shadow_cell(const SmokeShadowData *data, const int cell[3])
+{
+  const int *res = data->res;
+  const int *lc = data->light_cell;
+  const int k = data->shell;
+  const size_t index = manta_get_index(cell[0], res[0], cell[1], res[1], cell[2]);
+  float t_ray = 1.0f;
+
+  if (k > 0) {
+    int a = 0;
+    while (abs(cell[a] - lc[a]) != k) {
+      a++;
+    }
+    const int b = (a + 1) % 3, c = (a + 2) % 3;
+    const float step = 1.0f / fabsf((float)cell[a] - data->light[a]);
+
+    /* Previous point along the ray, kept within shell k - 1 on the other two axes. */
+    float p[3];
+    p[b] = (float)cell[b] - ((float)cell[b] - data->light[b]) * step;
+    p[c] = (float)cell[c] - ((float)cell[c] - data->light[c]) * step;
+    CLAMP(p[b], (float)(lc[b] - k + 1), (float)(lc[b] + k - 1));
+    CLAMP(p[c], (float)(lc[c] - k + 1), (float)(lc[c] + k - 1));
+
+    int p0[3], p1[3];
+    p0[a] = p1[a] = cell[a] + ((cell[a] > lc[a]) ? -1 : 1);
+    p0[b] = (int)floorf(p[b]);
+    p0[c] = (int)floorf(p[c]);
+    p1[b] = min_ii(p0[b] + 1, lc[b] + k - 1);
+    p1[c] = min_ii(p0[c] + 1, lc[c] + k - 1);
+    const float fb = p[b] - (float)p0[b];
+    const float fc = p[c] - (float)p0[c];
+
+    int q[3];
+    q[a] = p0[a];
+    q[b] = p0[b], q[c] = p0[c];
+    const float t00 = smoke_shadow_get(data, q);
+    q[b] = p1[b], q[c] = p0[c];
+    const float t10 = smoke_shadow_get(data, q);
+    q[b] = p0[b], q[c] = p1[c];
+    const float t01 = smoke_shadow_get(data, q);
+    q[b] = p1[b], q[c] = p1[c];
+    const float t11 = smoke_shadow_get(data, q);
+
+    t_ray = (1.0f - fc) * ((1.0f - fb) * t00 + fb * t10) + fc * ((1.0f - fb) * t01 + fb * t11);
   }
 
-  return *tRay;
+  // T_ray *= T_vox
+  data->shadow[index] = t_ray * expf(data->density[index] * data->correct);
 }
 
-static void bresenham_linie_3D(int x1,
-                               int y1,
-                               int z1,
-                               int x2,
-                               int y2,
-                               int z2,
-                               float *tRay,
-                               bresenham_callback cb,
-                               float *result,
-                               float *input,
-                               int res[3],
-                               float correct)
+static void smoke_shadow_shell_task_cb(void *__restrict userdata,
+                                       const int z,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  int dx, dy, dz, i, l, m, n, x_inc, y_inc, z_inc, err_1, err_2, dx2, dy2, dz2;
-  int pixel[3];
-
-  pixel[0] = x1;
-  pixel[1] = y1;
-  pixel[2] = z1;
-
-  dx = x2 - x1;
-  dy = y2 - y1;
-  dz = z2 - z1;
-
-  x_inc = (dx < 0) ? -1 : 1;
-  l = abs(dx);
-  y_inc = (dy < 0) ? -1 : 1;
-  m = abs(dy);
-  z_inc = (dz < 0) ? -1 : 1;
-  n = abs(dz);
-  dx2 = l << 1;
-  dy2 = m << 1;
-  dz2 = n << 1;
-
-  if ((l >= m) && (l >= n)) {
-    err_1 = dy2 - l;
-    err_2 = dz2 - l;
-    for (i = 0; i < l; i++) {
-      if (cb(result, input, res, pixel, tRay, correct) <= FLT_EPSILON) {
-        break;
-      }
-      if (err_1 > 0) {
-        pixel[1] += y_inc;
-        err_1 -= dx2;
-      }
-      if (err_2 > 0) {
-        pixel[2] += z_inc;
-        err_2 -= dx2;
+  const SmokeShadowData *data = userdata;
+  const int *res = data->res;
+  const int *lc = data->light_cell;
+  const int k = data->shell;
+  const bool full_slab = abs(z - lc[2]) == k;
+  const int x_min = max_ii(lc[0] - k, 0), x_max = min_ii(lc[0] + k, res[0] - 1);
+  const int y_min = max_ii(lc[1] - k, 0), y_max = min_ii(lc[1] + k, res[1] - 1);
+  int cell[3];
+
+  cell[2] = z;
+  for (cell[1] = y_min; cell[1] <= y_max; cell[1]++) {
+    if (full_slab || abs(cell[1] - lc[1]) == k) {
+      for (cell[0] = x_min; cell[0] <= x_max; cell[0]++) {
+        smoke_shadow_cell(data, cell);
       }
-      err_1 += dy2;
-      err_2 += dz2;
-      pixel[0] += x_inc;
     }
-  }
-  else if ((m >= l) && (m >= n)) {
-    err_1 = dx2 - m;
-    err_2 = dz2 - m;
-    for (i = 0; i < m; i++) {
-      if (cb(result, input, res, pixel, tRay, correct) <= FLT_EPSILON) {
-        break;
-      }
-      if (err_1 > 0) {
-        pixel[0] += x_inc;
-        err_1 -= dy2;
-      }
-      if (err_2 > 0) {
-        pixel[2] += z_inc;
-        err_2 -= dy2;
-      }
-      err_1 += dx2;
-      err_2 += dz2;
-      pixel[1] += y_inc;
-    }
-  }
-  else {
-    err_1 = dy2 - n;
-    err_2 = dx2 - n;
-    for (i = 0; i < n; i++) {
-      if (cb(result, input, res, pixel, tRay, correct) <= FLT_EPSILON) {
-        break;
-      }
-      if (err_1 > 0) {
-        pixel[1] += y_inc;
-        err_1 -= dz2;
+    else {
+      /* only the two ends of the row lie on the shell */
+      if (lc[0] - k >= 0 && lc[0] - k < res[0]) {
+        cell[0] = lc[0] - k;
+        smoke_shadow_cell(data, cell);
       }
-      if (err_2 > 0) {
-        pixel[0] += x_inc;
-        err_2 -= dz2;
+      if (lc[0] + k >= 0 && lc[0] + k < res[0]) {
+        cell[0] = lc[0] + k;
+        smoke_shadow_cell(data, cell);
       }
-      err_1 += dy2;
-      err_2 += dx2;
-      pixel[2] += z_inc;
     }
   }
-  cb(result, input, res, pixel, tRay, correct);
 }
 
 static void manta_smoke_calc_transparency(MantaDomainSettings *mds, ViewLayer *view_layer)
 {
-  float bv[6] = {0};
   float light[3];
-  int a, z, slabsize = mds->res[0] * mds->res[1], size = mds->res[0] * mds->res[1] * mds->res[2];
-  float *density = manta_smoke_get_density(mds->fluid);
-  float *shadow = manta_smoke_get_shadow(mds->fluid);
-  float correct = -7.0f * mds->dx;
+  int shell_min = 0, shell_max = 0;
 
   if (!get_light(view_layer, light)) {
     return;
@@ -4469,69 +4591,32 @@ static void manta_smoke_calc_transparency(MantaDomainSettings *mds, ViewLayer *v
   light[1] = (light[1] - mds->p0[1]) / mds->cell_size[1] - 0.5f - (float)mds->res_min[1];
   light[2] = (light[2] - mds->p0[2]) / mds->cell_size[2] - 0.5f - (float)mds->res_min[2];
 
-  for (a = 0; a < size; a++) {
-    shadow[a] = -1.0f;
-  }
+  SmokeShadowData data = {
+      .shadow = manta_smoke_get_shadow(mds->fluid),
+      .density = manta_smoke_get_density(mds->fluid),
+      .res = mds->res,
+      .correct = -7.0f * mds->dx,
+  };
+  copy_v3_v3(data.light, light);
 
-  /* calculate domain bounds in sim cell space */
-  // 0,2,4 = 0.0f
-  bv[1] = (float)mds->res[0];  // x
-  bv[3] = (float)mds->res[1];  // y
-  bv[5] = (float)mds->res[2];  // z
+  /* shells that touch the domain */
+  for (int i = 0; i < 3; i++) {
+    const int lc = (int)floorf(light[i] + 0.5f);
+    data.light_cell[i] = lc;
+    shell_min = max_iii(shell_min, -lc, lc - (mds->res[i] - 1));
+    shell_max = max_iii(shell_max, abs(lc), abs(mds->res[i] - 1 - lc));
+  }
 
-  for (z = 0; z < mds->res[2]; z++) {
-    size_t index = z * slabsize;
-    int x, y;
+  for (int k = shell_min; k <= shell_max; k++) {
+    const int z_min = max_ii(data.light_cell[2] - k, 0);
+    const int z_max = min_ii(data.light_cell[2] + k, mds->res[2] - 1);
 
-    for (y = 0; y < mds->res[1]; y++) {
-      for (x = 0; x < mds->res[0]; x++, index++) {
-        float voxelCenter[3];
-        float pos[3];
-        int cell[3];
-        float tRay = 1.0;
+    data.shell = k;
 
-        if (shadow[index] >= 0.0f) {
-          continue;
-        }
-        voxelCenter[0] = (float)x;
-        voxelCenter[1] = (float)y;
-        voxelCenter[2] = (float)z;
-
-        // get starting cell (light pos)
-        if (BLI_bvhtree_bb_raycast(bv, light, voxelCenter, pos) > FLT_EPSILON) {
-          // we're ouside -> use point on side of domain
-          cell[0] = (int)floor(pos[0]);
-          cell[1] = (int)floor(pos[1]);
-          cell[2] = (int)floor(pos[2]);
-        }
-        else {
-          // we're inside -> use light itself
-          cell[0] = (int)floor(light[0]);
-          cell[1] = (int)floor(light[1]);
-          cell[2] = (int)floor(light[2]);
-        }
-        /* clamp within grid bounds */
-        CLAMP(cell[0], 0, mds->res[0] - 1);
-        CLAMP(cell[1], 0, mds->res[1] - 1);
-        CLAMP(cell[2], 0, mds->res[2] - 1);
-
-        bresenham_linie_3D(cell[0],
-                           cell[1],
-                           cell[2],
-                           x,
-                           y,
-                           z,
-                           &tRay,
-                           calc_voxel_transp,
-                           shadow,
-                           density,
-                           mds->res,
-                           correct);
-
-        // convention -> from a RGBA float array, use G value for tRay
-        shadow[index] = tRay;
-      }
-    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (k >= 8);
+    BLI_task_parallel_range(z_min, z_max + 1, &data, smoke_shadow_shell_task_cb, &settings);
   }
 }
 
@@ -0,0 +1,510 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup bke
+ *
+ * Triangles are binned into slabs of grid layers along z. Slabs are processed in parallel and
+ * only write cells of their own layers, so no locking is needed and the result does not depend
+ * on the number of threads: within a slab triangles are visited in index order and a cell keeps
+ * the first of equally distant triangles.
+ *
+ * Inside/outside: for each axis, every triangle adds its orientation to the first cell behind
+ * its crossing with the ray through the cell samples, a prefix sum along the axis then gives the
+ * winding number. A cell is inside when the winding is non-zero along at least two of the three
+ * axes, which tolerates single leaking rays through small holes or unlucky edge hits.
+ */
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math.h"
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
+#include "DNA_meshdata_types.h"
+
+#include "BKE_mesh_voxelize.h" /* own include */
+
+/* Number of grid layers per slab. */
+#define VOXELIZE_SLAB 8
+
+typedef struct VoxelizeData {
+  MeshVoxelGrid *grid;
+  const MVert *mvert;
+  const MLoop *mloop;
+  const MLoopTri *looptri;
+  const float *vert_vel;
+
+  /* Triangles per slab, in increasing index order. */
+  int *slab_start;
+  int *slab_tris;
+
+  /* Current crossing axis and per cell crossing counts for it. */
+  int axis;
+  short *crossings;
+  /* Number of axes with non-zero winding per cell. */
+  unsigned char *votes;
+} VoxelizeData;
+
+BLI_INLINE int voxel_index(const MeshVoxelGrid *grid, int i, int j, int k)
+{
+  return i + grid->res[0] * (j + grid->res[1] * k);
+}
+
+/* Triangle corners in sample space, where sample (i, j, k) sits at integer coordinates. */
+static void voxelize_tri_coords(const VoxelizeData *data, int t, float r_co[3][3])
+{
+  const MeshVoxelGrid *grid = data->grid;
+  const MLoopTri *lt = &data->looptri[t];
+
+  for (int n = 0; n < 3; n++) {
+    const float *co = data->mvert[data->mloop[lt->tri[n]].v].co;
+    for (int a = 0; a < 3; a++) {
+      r_co[n][a] = co[a] / grid->cell_size - (float)grid->min[a] - 0.5f;
+    }
+  }
+}
+
+/* Sample range covered by the triangle expanded by the band. Returns false if it misses the
+ * grid. The upper z bound is one layer more than the band needs, because the crossing of a ray
+ * along z is stored in the first cell behind the triangle. With use_before, triangles lying
+ * before the grid along an axis are kept at its first layer, as their crossings still count. */
+static bool voxelize_tri_range(
+    const VoxelizeData *data, int t, bool use_before, int r_min[3], int r_max[3])
+{
+  const MeshVoxelGrid *grid = data->grid;
+  const float band = grid->band / grid->cell_size;
+  float co[3][3];
+
+  voxelize_tri_coords(data, t, co);
+  for (int a = 0; a < 3; a++) {
+    const float lo = min_fff(co[0][a], co[1][a], co[2][a]) - band;
+    const float hi = max_fff(co[0][a], co[1][a], co[2][a]) + band;
+    r_min[a] = max_ii((int)ceilf(lo), 0);
+    r_max[a] = min_ii((int)floorf(hi) + (a == 2 ? 1 : 0), grid->res[a] - 1);
+    if (use_before) {
+      r_max[a] = max_ii(r_max[a], 0);
+    }
+    if (r_min[a] > r_max[a]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Write the exact distance to triangle t for all band cells of the slab layers k0 .. k1 - 1. */
+static void voxelize_tri_band(VoxelizeData *data, int t, int k0, int k1)
+{
+  MeshVoxelGrid *grid = data->grid;
+  const MLoopTri *lt = &data->looptri[t];
+  const float *v1 = data->mvert[data->mloop[lt->tri[0]].v].co;
+  const float *v2 = data->mvert[data->mloop[lt->tri[1]].v].co;
+  const float *v3 = data->mvert[data->mloop[lt->tri[2]].v].co;
+  const float band_sq = grid->band * grid->band;
+  int min[3], max[3];
+
+  if (grid->band <= 0.0f || !voxelize_tri_range(data, t, false, min, max)) {
+    return;
+  }
+  k0 = max_ii(k0, min[2]);
+  k1 = min_ii(k1, max[2] + 1);
+
+  for (int k = k0; k < k1; k++) {
+    for (int j = min[1]; j <= max[1]; j++) {
+      for (int i = min[0]; i <= max[0]; i++) {
+        const int index = voxel_index(grid, i, j, k);
+        float co[3], nearest[3];
+
+        BKE_mesh_voxel_grid_sample_co(
+            grid, i + grid->min[0], j + grid->min[1], k + grid->min[2], co);
+        closest_on_tri_to_point_v3(nearest, co, v1, v2, v3);
+        const float dist_sq = len_squared_v3v3(co, nearest);
+
+        /* dist holds squared distances until the final pass */
+        if (dist_sq < band_sq && dist_sq < grid->dist[index]) {
+          grid->dist[index] = dist_sq;
+          grid->tri[index] = t;
+        }
+      }
+    }
+  }
+}
+
+/* Top-left rule for the edge a -> b: a sample exactly on an edge shared by two triangles counts
+ * for exactly one of them, as the edge runs in opposite directions in the two. */
+BLI_INLINE bool voxelize_edge_owns(const double a[2], const double b[2])
+{
+  const double du = b[0] - a[0], dv = b[1] - a[1];
+  return (dv < 0.0) || (dv == 0.0 && du < 0.0);
+}
+
+BLI_INLINE bool voxelize_edge_test(const double a[2], const double b[2], const double p[2])
+{
+  const double e = (b[0] - a[0]) * (p[1] - a[1]) - (b[1] - a[1]) * (p[0] - a[0]);
+  return (e > 0.0) || (e == 0.0 && voxelize_edge_owns(a, b));
+}
+
+/* Add the orientation of triangle t to the first cell behind its crossing with every ray along
+ * data->axis through the samples. Only cells of the slab layers k0 .. k1 - 1 are written. */
+static void voxelize_tri_crossings(VoxelizeData *data, int t, int k0, int k1)
+{
+  const MeshVoxelGrid *grid = data->grid;
+  const int a = data->axis, b = (a + 1) % 3, c = (a + 2) % 3;
+  float co[3][3];
+  double nor[3], uv[3][2];
+
+  voxelize_tri_coords(data, t, co);
+  {
+    const double e1[3] = {co[1][0] - co[0][0], co[1][1] - co[0][1], co[1][2] - co[0][2]};
+    const double e2[3] = {co[2][0] - co[0][0], co[2][1] - co[0][1], co[2][2] - co[0][2]};
+    nor[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    nor[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    nor[2] = e1[0] * e2[1] - e1[1] * e2[0];
+  }
+  /* rays along the axis do not cross triangles parallel to it */
+  if (nor[a] == 0.0) {
+    return;
+  }
+  /* entering the mesh (normal against the ray) raises the winding */
+  const short winding = (nor[a] < 0.0) ? 1 : -1;
+
+  /* projected corners, counter-clockwise */
+  for (int n = 0; n < 3; n++) {
+    uv[n][0] = co[n][b];
+    uv[n][1] = co[n][c];
+  }
+  if (nor[a] < 0.0) {
+    SWAP(double, uv[1][0], uv[2][0]);
+    SWAP(double, uv[1][1], uv[2][1]);
+  }
+
+  int min[2], max[2];
+  for (int n = 0; n < 2; n++) {
+    const int ax = (n == 0) ? b : c;
+    const double lo = min_dd(min_dd(uv[0][n], uv[1][n]), uv[2][n]);
+    const double hi = max_dd(max_dd(uv[0][n], uv[1][n]), uv[2][n]);
+    min[n] = max_ii((int)ceil(lo), 0);
+    max[n] = min_ii((int)floor(hi), grid->res[ax] - 1);
+  }
+  /* the slab restricts the z coordinate of the written cells */
+  if (b == 2) {
+    min[0] = max_ii(min[0], k0);
+    max[0] = min_ii(max[0], k1 - 1);
+  }
+  else if (c == 2) {
+    min[1] = max_ii(min[1], k0);
+    max[1] = min_ii(max[1], k1 - 1);
+  }
+
+  for (int jc = min[1]; jc <= max[1]; jc++) {
+    for (int jb = min[0]; jb <= max[0]; jb++) {
+      const double p[2] = {jb, jc};
+      if (!voxelize_edge_test(uv[0], uv[1], p) || !voxelize_edge_test(uv[1], uv[2], p) ||
+          !voxelize_edge_test(uv[2], uv[0], p)) {
+        continue;
+      }
+      /* crossing on the plane of the triangle, the first sample behind it gets the winding */
+      const double t_a = co[0][a] - (nor[b] * (jb - co[0][b]) + nor[c] * (jc - co[0][c])) / nor[a];
+      int ja = (int)floor(t_a) + 1;
+      if (ja >= grid->res[a]) {
+        continue;
+      }
+      ja = max_ii(ja, 0);
+      if (a == 2 && (ja < k0 || ja >= k1)) {
+        continue;
+      }
+
+      int ijk[3];
+      ijk[a] = ja;
+      ijk[b] = jb;
+      ijk[c] = jc;
+      data->crossings[voxel_index(grid, ijk[0], ijk[1], ijk[2])] += winding;
+    }
+  }
+}
+
+static void voxelize_slab_band_cb(void *__restrict userdata,
+                                  const int slab,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VoxelizeData *data = userdata;
+  const int k0 = slab * VOXELIZE_SLAB;
+  const int k1 = min_ii(k0 + VOXELIZE_SLAB, data->grid->res[2]);
+
+  for (int n = data->slab_start[slab]; n < data->slab_start[slab + 1]; n++) {
+    voxelize_tri_band(data, data->slab_tris[n], k0, k1);
+  }
+}
+
+static void voxelize_slab_crossings_cb(void *__restrict userdata,
+                                       const int slab,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VoxelizeData *data = userdata;
+  const int k0 = slab * VOXELIZE_SLAB;
+  const int k1 = min_ii(k0 + VOXELIZE_SLAB, data->grid->res[2]);
+
+  for (int n = data->slab_start[slab]; n < data->slab_start[slab + 1]; n++) {
+    voxelize_tri_crossings(data, data->slab_tris[n], k0, k1);
+  }
+}
+
+/* Prefix sum of the crossings along the current axis, one task per layer of the grid that
+ * contains the rays (z layers for the x and y axis, y layers for the z axis). */
+static void voxelize_sweep_cb(void *__restrict userdata,
+                              const int layer,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VoxelizeData *data = userdata;
+  const MeshVoxelGrid *grid = data->grid;
+  const int a = data->axis;
+  const int other = (a == 0) ? 1 : 0;
+  int ijk[3];
+
+  ijk[(a == 2) ? 1 : 2] = layer;
+  for (ijk[other] = 0; ijk[other] < grid->res[other]; ijk[other]++) {
+    int winding = 0;
+    for (ijk[a] = 0; ijk[a] < grid->res[a]; ijk[a]++) {
+      const int index = voxel_index(grid, ijk[0], ijk[1], ijk[2]);
+      winding += data->crossings[index];
+      if (winding != 0) {
+        data->votes[index]++;
+      }
+    }
+  }
+}
+
+/* Distances from squares, inside from votes and interpolated velocities, per z layer. */
+static void voxelize_finalize_cb(void *__restrict userdata,
+                                 const int k,
+                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  VoxelizeData *data = userdata;
+  MeshVoxelGrid *grid = data->grid;
+
+  for (int j = 0; j < grid->res[1]; j++) {
+    for (int i = 0; i < grid->res[0]; i++) {
+      const int index = voxel_index(grid, i, j, k);
+
+      if (grid->inside) {
+        grid->inside[index] = (data->votes[index] >= 2);
+      }
+      if (grid->tri[index] == -1) {
+        grid->dist[index] = FLT_MAX;
+        continue;
+      }
+      grid->dist[index] = sqrtf(grid->dist[index]);
+
+      if (grid->velocity) {
+        const MLoopTri *lt = &data->looptri[grid->tri[index]];
+        float co[3], weights[3];
+
+        BKE_mesh_voxel_grid_nearest(grid,
+                                    data->mvert,
+                                    data->mloop,
+                                    data->looptri,
+                                    i + grid->min[0],
+                                    j + grid->min[1],
+                                    k + grid->min[2],
+                                    co,
+                                    weights);
+        interp_v3_v3v3v3(&grid->velocity[index * 3],
+                         &data->vert_vel[data->mloop[lt->tri[0]].v * 3],
+                         &data->vert_vel[data->mloop[lt->tri[1]].v * 3],
+                         &data->vert_vel[data->mloop[lt->tri[2]].v * 3],
+                         weights);
+      }
+    }
+  }
+}
+
+/**
+ * Voxelize the triangles of a mesh on the cells min .. min + res - 1.
+ *
+ * \param vert_vel: Optional per vertex velocities (3 floats each), interpolated at the nearest
+ * point of every band cell.
+ * \param band: Cells closer than this to the mesh get distance and nearest triangle.
+ * \param flag: MESH_VOXELIZE_INSIDE to also classify the cells as inside or outside.
+ */
+MeshVoxelGrid *BKE_mesh_voxelize(const MVert *mvert,
+                                 const MLoop *mloop,
+                                 const MLoopTri *looptri,
+                                 const int looptri_len,
+                                 const float *vert_vel,
+                                 const int min[3],
+                                 const int res[3],
+                                 const float cell_size,
+                                 const float band,
+                                 const int flag)
+{
+  MeshVoxelGrid *grid = MEM_callocN(sizeof(MeshVoxelGrid), "mesh_voxel_grid");
+  copy_v3_v3_int(grid->min, min);
+  copy_v3_v3_int(grid->res, res);
+  grid->cell_size = cell_size;
+  grid->band = band;
+
+  if (res[0] <= 0 || res[1] <= 0 || res[2] <= 0) {
+    zero_v3_int(grid->res);
+    return grid;
+  }
+
+  const int total_cells = res[0] * res[1] * res[2];
+  grid->dist = MEM_malloc_arrayN(total_cells, sizeof(float), "mesh_voxel_dist");
+  grid->tri = MEM_malloc_arrayN(total_cells, sizeof(int), "mesh_voxel_tri");
+  copy_vn_fl(grid->dist, total_cells, FLT_MAX);
+  copy_vn_i(grid->tri, total_cells, -1);
+  if (vert_vel) {
+    grid->velocity = MEM_callocN(sizeof(float) * 3 * total_cells, "mesh_voxel_velocity");
+  }
+
+  VoxelizeData data = {
+      .grid = grid,
+      .mvert = mvert,
+      .mloop = mloop,
+      .looptri = looptri,
+      .vert_vel = vert_vel,
+  };
+
+  /* bin the triangles into the slabs their (band expanded) bounds overlap */
+  const int num_slabs = (res[2] + VOXELIZE_SLAB - 1) / VOXELIZE_SLAB;
+  int *tri_slabs = MEM_malloc_arrayN(
+      max_ii(looptri_len, 1), sizeof(int) * 2, "mesh_voxel_tri_slabs");
+  data.slab_start = MEM_callocN(sizeof(int) * (num_slabs + 1), "mesh_voxel_slab_start");
+
+  for (int t = 0; t < looptri_len; t++) {
+    int tmin[3], tmax[3];
+    if (voxelize_tri_range(&data, t, (flag & MESH_VOXELIZE_INSIDE) != 0, tmin, tmax)) {
+      tri_slabs[t * 2] = tmin[2] / VOXELIZE_SLAB;
+      tri_slabs[t * 2 + 1] = tmax[2] / VOXELIZE_SLAB;
+      for (int s = tri_slabs[t * 2]; s <= tri_slabs[t * 2 + 1]; s++) {
+        data.slab_start[s + 1]++;
+      }
+    }
+    else {
+      tri_slabs[t * 2] = 0;
+      tri_slabs[t * 2 + 1] = -1;
+    }
+  }
+  for (int s = 0; s < num_slabs; s++) {
+    data.slab_start[s + 1] += data.slab_start[s];
+  }
+  data.slab_tris = MEM_malloc_arrayN(
+      max_ii(data.slab_start[num_slabs], 1), sizeof(int), "mesh_voxel_slab_tris");
+  {
+    int *fill = MEM_dupallocN(data.slab_start);
+    for (int t = 0; t < looptri_len; t++) {
+      for (int s = tri_slabs[t * 2]; s <= tri_slabs[t * 2 + 1]; s++) {
+        data.slab_tris[fill[s]++] = t;
+      }
+    }
+    MEM_freeN(fill);
+  }
+  MEM_freeN(tri_slabs);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+
+  BLI_task_parallel_range(0, num_slabs, &data, voxelize_slab_band_cb, &settings);
+
+  if (flag & MESH_VOXELIZE_INSIDE) {
+    grid->inside = MEM_malloc_arrayN(total_cells, sizeof(unsigned char), "mesh_voxel_inside");
+    data.votes = MEM_callocN(sizeof(unsigned char) * total_cells, "mesh_voxel_votes");
+    data.crossings = MEM_malloc_arrayN(total_cells, sizeof(short), "mesh_voxel_crossings");
+
+    for (data.axis = 0; data.axis < 3; data.axis++) {
+      memset(data.crossings, 0, sizeof(short) * total_cells);
+      BLI_task_parallel_range(0, num_slabs, &data, voxelize_slab_crossings_cb, &settings);
+      BLI_task_parallel_range(
+          0, res[(data.axis == 2) ? 1 : 2], &data, voxelize_sweep_cb, &settings);
+    }
+    MEM_freeN(data.crossings);
+  }
+
+  BLI_task_parallel_range(0, res[2], &data, voxelize_finalize_cb, &settings);
+
+  if (data.votes) {
+    MEM_freeN(data.votes);
+  }
+  MEM_freeN(data.slab_start);
+  MEM_freeN(data.slab_tris);
+
+  return grid;
+}
+
+void BKE_mesh_voxel_grid_free(MeshVoxelGrid *grid)
+{
+  MEM_SAFE_FREE(grid->dist);
+  MEM_SAFE_FREE(grid->tri);
+  MEM_SAFE_FREE(grid->velocity);
+  MEM_SAFE_FREE(grid->inside);
+  MEM_freeN(grid);
+}
+
+/* Array index of cell (x, y, z), in absolute cell coordinates. Returns -1 outside the grid. */
+int BKE_mesh_voxel_grid_index(const MeshVoxelGrid *grid, int x, int y, int z)
+{
+  x -= grid->min[0];
+  y -= grid->min[1];
+  z -= grid->min[2];
+  if (x < 0 || y < 0 || z < 0 || x >= grid->res[0] || y >= grid->res[1] || z >= grid->res[2]) {
+    return -1;
+  }
+  return voxel_index(grid, x, y, z);
+}
+
+/* Sample position of cell (x, y, z) in mesh coordinates. */
+void BKE_mesh_voxel_grid_sample_co(const MeshVoxelGrid *grid, int x, int y, int z, float r_co[3])
+{
+  r_co[0] = ((float)x + 0.5f) * grid->cell_size;
+  r_co[1] = ((float)y + 0.5f) * grid->cell_size;
+  r_co[2] = ((float)z + 0.5f) * grid->cell_size;
+}
+
+/* Nearest point on the mesh and its barycentric weights in the nearest triangle of cell
+ * (x, y, z). Returns false for cells outside the band. */
+bool BKE_mesh_voxel_grid_nearest(const MeshVoxelGrid *grid,
+                                 const MVert *mvert,
+                                 const MLoop *mloop,
+                                 const MLoopTri *looptri,
+                                 int x,
+                                 int y,
+                                 int z,
+                                 float r_co[3],
+                                 float r_weights[3])
+{
+  const int index = BKE_mesh_voxel_grid_index(grid, x, y, z);
+  if (index == -1 || grid->tri[index] == -1) {
+    return false;
+  }
+  const MLoopTri *lt = &looptri[grid->tri[index]];
+  const float *v1 = mvert[mloop[lt->tri[0]].v].co;
+  const float *v2 = mvert[mloop[lt->tri[1]].v].co;
+  const float *v3 = mvert[mloop[lt->tri[2]].v].co;
+  float co[3];
+
+  BKE_mesh_voxel_grid_sample_co(grid, x, y, z, co);
+  closest_on_tri_to_point_v3(r_co, co, v1, v2, v3);
+  interp_weights_tri_v3(r_weights, v1, v2, v3, r_co);
+  return true;
+}
@@ -5557,6 +5557,7 @@ static void direct_link_modifiers(FileData *fd, ListBase *lb)
         mmd->flow->mmd = mmd;
         mmd->flow->mesh = NULL;
         mmd->flow->verts_old = NULL;
+        mmd->flow->voxel_cache = NULL;
         mmd->flow->numverts = 0;
         mmd->flow->psys = newdataadr(fd, mmd->flow->psys);
       }
@@ -5567,6 +5568,7 @@ static void direct_link_modifiers(FileData *fd, ListBase *lb)
         if (mmd->effec) {
           mmd->effec->mmd = mmd;
           mmd->effec->verts_old = NULL;
+          mmd->effec->voxel_cache = NULL;
           mmd->effec->numverts = 0;
           mmd->effec->mesh = NULL;
         }
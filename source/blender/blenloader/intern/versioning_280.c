@@ -40,6 +40,7 @@
 #include "DNA_light_types.h"
 #include "DNA_layer_types.h"
 #include "DNA_lightprobe_types.h"
+#include "DNA_manta_types.h"
 #include "DNA_material_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
@@ -3900,5 +3901,20 @@ void blo_do_versions_280(FileData *fd, Library *UNUSED(lib), Main *bmain)
         }
       }
     }
+
+    /* Quantized fluid cache channels, files without the error bound would read it as 0. */
+    if (!DNA_struct_elem_find(
+            fd->filesdna, "MantaDomainSettings", "float", "cache_quantize_error")) {
+      LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+        LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+          if (md->type == eModifierType_Manta) {
+            MantaModifierData *mmd = (MantaModifierData *)md;
+            if (mmd->domain) {
+              mmd->domain->cache_quantize_error = 0.001f;
+            }
+          }
+        }
+      }
+    }
   }
 }
@@ -244,6 +244,9 @@ static void manta_bake_sequence(MantaJob *job)
     ED_update_for_newframe(job->bmain, job->depsgraph);
   }
 
+  /* Cache files might still be queued for writing, make sure they are all on disk */
+  manta_flush_cache_writes(mds->fluid);
+
   /* Restore frame position that we were on before bake */
   CFRA = orig_frame;
 }
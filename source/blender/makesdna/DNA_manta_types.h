@@ -35,11 +35,13 @@ enum {
 #endif
   FLUID_DOMAIN_FILE_LOAD = (1 << 6), /* flag for file load */
   FLUID_DOMAIN_USE_ADAPTIVE_DOMAIN = (1 << 7),
-  FLUID_DOMAIN_USE_ADAPTIVE_TIME = (1 << 8),    /* adaptive time stepping in domain */
-  FLUID_DOMAIN_USE_MESH = (1 << 9),             /* use mesh */
-  FLUID_DOMAIN_USE_GUIDING = (1 << 10),         /* use guiding */
-  FLUID_DOMAIN_USE_SPEED_VECTORS = (1 << 11),   /* generate mesh speed vectors */
-  FLUID_DOMAIN_EXPORT_MANTA_SCRIPT = (1 << 12), /* export mantaflow script during bake */
+  FLUID_DOMAIN_USE_ADAPTIVE_TIME = (1 << 8),       /* adaptive time stepping in domain */
+  FLUID_DOMAIN_USE_MESH = (1 << 9),                /* use mesh */
+  FLUID_DOMAIN_USE_GUIDING = (1 << 10),            /* use guiding */
+  FLUID_DOMAIN_USE_SPEED_VECTORS = (1 << 11),      /* generate mesh speed vectors */
+  FLUID_DOMAIN_EXPORT_MANTA_SCRIPT = (1 << 12),    /* export mantaflow script during bake */
+  FLUID_DOMAIN_USE_PRESSURE_WARMSTART = (1 << 13), /* start pressure solves from last solution */
+  FLUID_DOMAIN_USE_COMPACT_MATRIX = (1 << 14),     /* compact stencil SIMD pressure solves */
 };
 
 /* border collisions */
@@ -59,6 +61,7 @@ enum {
   FLUID_DOMAIN_FILE_RAW = (1 << 2),
   FLUID_DOMAIN_FILE_OBJECT = (1 << 3),
   FLUID_DOMAIN_FILE_BIN_OBJECT = (1 << 4),
+  FLUID_DOMAIN_FILE_CHUNKED = (1 << 5),
 };
 
 /* slice method */
@@ -154,6 +157,12 @@ enum {
 #define FLUID_DOMAIN_PARTICLE_FOAM (1 << 3)
 #define FLUID_DOMAIN_PARTICLE_TRACER (1 << 4)
 
+/* quantized cache channels (cache_quantize_channels) */
+#define FLUID_DOMAIN_QUANTIZE_DENSITY (1 << 0)
+#define FLUID_DOMAIN_QUANTIZE_HEAT (1 << 1)
+#define FLUID_DOMAIN_QUANTIZE_FIRE (1 << 2)
+#define FLUID_DOMAIN_QUANTIZE_COLORS (1 << 3)
+
 /* cache options */
 #define FLUID_DOMAIN_BAKING_DATA 1
 #define FLUID_DOMAIN_BAKED_DATA 2
@@ -355,7 +364,9 @@ typedef struct MantaDomainSettings {
   char cache_directory[1024];
   char error[64]; /* Bake error description */
   short cache_type;
-  char _pad7[2];  /* unused */
+  char cache_quantize_channels; /* smoke channels written with lossy quantization */
+  char _pad7[5];                /* unused */
+  float cache_quantize_error;   /* absolute error bound of the quantized channels */
 
   /* time options */
   float dt;
@@ -445,6 +456,8 @@ typedef struct MantaFlowSettings {
   /* initial velocity */
   /** Previous vertex positions in domain space. */
   float *verts_old;
+  /** Runtime: voxelization of the mesh, reused while it does not move. */
+  void *voxel_cache;
   int numverts;
   float vel_multi;  // Multiplier for inherited velocity
   float vel_normal;
@@ -497,6 +510,8 @@ typedef struct MantaCollSettings {
   struct MantaModifierData *mmd;
   struct Mesh *mesh;
   float *verts_old;
+  /** Runtime: voxelization of the mesh, reused while it does not move. */
+  void *voxel_cache;
   int numverts;
   float surface_distance; /* thickness of mesh surface, used in obstacle sdf */
   short type;
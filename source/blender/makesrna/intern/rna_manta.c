@@ -536,6 +536,12 @@ static const EnumPropertyItem *rna_Manta_cachetype_volume_itemf(bContext *UNUSED
   tmp.description = "Uni file format";
   RNA_enum_item_add(&item, &totitem, &tmp);
 
+  tmp.value = FLUID_DOMAIN_FILE_CHUNKED;
+  tmp.identifier = "CHUNKED";
+  tmp.name = "Chunked Cache";
+  tmp.description = "Block compressed file format, read and written with multiple threads";
+  RNA_enum_item_add(&item, &totitem, &tmp);
+
 #  ifdef WITH_OPENVDB
   tmp.value = FLUID_DOMAIN_FILE_OPENVDB;
   tmp.identifier = "OPENVDB";
@@ -1945,6 +1951,50 @@ static void rna_def_manta_domain_settings(BlenderRNA *brna)
       prop, "File Format", "Select the file format to be used for caching noise data");
   RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_reset");
 
+  prop = RNA_def_property(srna, "use_quantize_density", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, NULL, "cache_quantize_channels", FLUID_DOMAIN_QUANTIZE_DENSITY);
+  RNA_def_property_ui_text(
+      prop, "Quantize Density", "Store density with lossy quantization in chunked caches");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_reset");
+
+  prop = RNA_def_property(srna, "use_quantize_heat", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "cache_quantize_channels", FLUID_DOMAIN_QUANTIZE_HEAT);
+  RNA_def_property_ui_text(
+      prop, "Quantize Heat", "Store heat with lossy quantization in chunked caches");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_reset");
+
+  prop = RNA_def_property(srna, "use_quantize_fire", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "cache_quantize_channels", FLUID_DOMAIN_QUANTIZE_FIRE);
+  RNA_def_property_ui_text(prop,
+                           "Quantize Fire",
+                           "Store flame, fuel and reaction with lossy quantization in chunked "
+                           "caches");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_reset");
+
+  prop = RNA_def_property(srna, "use_quantize_colors", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, NULL, "cache_quantize_channels", FLUID_DOMAIN_QUANTIZE_COLORS);
+  RNA_def_property_ui_text(
+      prop, "Quantize Colors", "Store smoke colors with lossy quantization in chunked caches");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_reset");
+
+  prop = RNA_def_property(srna, "cache_quantize_error", PROP_FLOAT, PROP_NONE);
+  RNA_def_property_float_sdna(prop, NULL, "cache_quantize_error");
+  RNA_def_property_range(prop, 0.0, 1.0);
+  RNA_def_property_ui_range(prop, 0.0001, 0.1, 0.01, 4);
+  RNA_def_property_ui_text(
+      prop,
+      "Quantization Error",
+      "Largest absolute error of a value in the quantized channels (lower keeps more detail, "
+      "higher gives smaller files)");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_reset");
+
   prop = RNA_def_property(srna, "cache_type", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, NULL, "cache_type");
   RNA_def_property_enum_items(prop, cache_types);
@@ -2027,6 +2077,24 @@ static void rna_def_manta_domain_settings(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Adaptive stepping", "Enable adaptive time-stepping");
   RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_resetCache");
 
+  prop = RNA_def_property(srna, "use_pressure_warm_start", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", FLUID_DOMAIN_USE_PRESSURE_WARMSTART);
+  RNA_def_property_ui_text(
+      prop,
+      "Warm Start Pressure",
+      "Start every pressure solve from the previous solution (usually needs far fewer solver "
+      "iterations)");
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_resetCache");
+
+  prop = RNA_def_property(srna, "use_pressure_compact_matrix", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", FLUID_DOMAIN_USE_COMPACT_MATRIX);
+  RNA_def_property_ui_text(
+      prop,
+      "Compact Pressure Matrix",
+      "Solve pressure with a compact matrix and SIMD kernels where the domain allows it (faster, "
+      "results differ within the solver accuracy)");
+  RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, "rna_Manta_resetCache");
+
   /* display settings */
 
   prop = RNA_def_property(srna, "slice_method", PROP_ENUM, PROP_NONE);